@@ -0,0 +1,183 @@
+//
+// BLOBStream.h
+//
+// $Id: //poco/Main/Data/SQLite/include/Poco/Data/SQLite/BLOBStream.h#1 $
+//
+// Library: SQLite
+// Package: SQLite
+// Module:  BLOBStream
+//
+// Definition of the BLOBStreamBuf, BLOBIOS and BLOBStream classes.
+//
+// Copyright (c) 2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#ifndef SQLite_BLOBStream_INCLUDED
+#define SQLite_BLOBStream_INCLUDED
+
+
+#include "Poco/Data/SQLite/SQLite.h"
+#include "Poco/Data/Session.h"
+#include "Poco/BufferedStreamBuf.h"
+#include "Poco/Types.h"
+#include <istream>
+
+
+struct sqlite3;
+struct sqlite3_blob;
+
+
+namespace Poco {
+namespace Data {
+namespace SQLite {
+
+
+class SQLite_API BLOBStreamBuf: public Poco::BufferedStreamBuf
+	/// The stream buffer for BLOBStream.
+	///
+	/// Reads a BLOB or TEXT column value incrementally, using
+	/// sqlite3_blob_read(), without loading the complete value
+	/// into memory. Reads of a block at least as large as the
+	/// remaining value go directly into the caller's buffer.
+{
+public:
+	enum
+	{
+		DEFAULT_BUFFER_SIZE = 8192
+	};
+
+	BLOBStreamBuf(sqlite3* pDB,
+		const std::string& table,
+		const std::string& column,
+		Poco::Int64 rowID,
+		const std::string& database,
+		std::streamsize bufferSize);
+		/// Creates the BLOBStreamBuf and opens the value
+		/// of the given column in the row with the given rowid.
+
+	~BLOBStreamBuf();
+		/// Destroys the BLOBStreamBuf.
+
+	std::streamsize size() const;
+		/// Returns the size of the value in bytes.
+
+	void close();
+		/// Closes the underlying BLOB handle.
+
+protected:
+	int readFromDevice(char* buffer, std::streamsize length);
+	std::streamsize xsgetn(char* p, std::streamsize count);
+
+private:
+	sqlite3_blob*   _pBlob;
+	std::streamsize _size;
+	std::streamsize _offset;
+};
+
+
+class SQLite_API BLOBIOS: public virtual std::ios
+	/// The base class for BLOBStream.
+	///
+	/// This class is needed to ensure the correct initialization
+	/// order of the stream buffer and base classes.
+{
+public:
+	BLOBIOS(Session& session,
+		const std::string& table,
+		const std::string& column,
+		Poco::Int64 rowID,
+		const std::string& database,
+		std::streamsize bufferSize);
+		/// Creates the BLOBIOS.
+
+	~BLOBIOS();
+		/// Destroys the BLOBIOS.
+
+	BLOBStreamBuf* rdbuf();
+		/// Returns a pointer to the internal BLOBStreamBuf.
+
+	std::streamsize size() const;
+		/// Returns the size of the value in bytes.
+
+protected:
+	BLOBStreamBuf _buf;
+};
+
+
+class SQLite_API BLOBStream: public BLOBIOS, public std::istream
+	/// An input stream for reading a BLOB or TEXT column value in chunks,
+	/// directly from the database, so that large values can be copied
+	/// into an output stream or a caller-provided buffer without being
+	/// held in memory as a whole.
+	///
+	/// The value is identified by table, column and rowid. The session
+	/// must remain open while the stream is in use. If the row is
+	/// modified or deleted while the stream is open, further reads fail.
+	///
+	/// Usage example:
+	///
+	///     BLOBStream blob(session, "Images", "data", rowID);
+	///     Poco::StreamCopier::copyStream(blob, response.send());
+{
+public:
+	BLOBStream(Session& session,
+		const std::string& table,
+		const std::string& column,
+		Poco::Int64 rowID,
+		const std::string& database = "main",
+		std::streamsize bufferSize = BLOBStreamBuf::DEFAULT_BUFFER_SIZE);
+		/// Creates the BLOBStream.
+
+	~BLOBStream();
+		/// Destroys the BLOBStream.
+};
+
+
+//
+// inlines
+//
+inline std::streamsize BLOBStreamBuf::size() const
+{
+	return _size;
+}
+
+
+inline BLOBStreamBuf* BLOBIOS::rdbuf()
+{
+	return &_buf;
+}
+
+
+inline std::streamsize BLOBIOS::size() const
+{
+	return _buf.size();
+}
+
+
+} } } // namespace Poco::Data::SQLite
+
+
+#endif // SQLite_BLOBStream_INCLUDED
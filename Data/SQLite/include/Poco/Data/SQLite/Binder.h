@@ -43,6 +43,7 @@
 #include "Poco/Data/SQLite/SQLite.h"
 #include "Poco/Data/AbstractBinder.h"
 #include "Poco/Data/LOB.h"
+#include "Poco/Data/DataException.h"
 #include "Poco/Any.h"
 #include "Poco/DynamicAny.h"
 #include "sqlite3.h"
@@ -131,6 +132,140 @@ public:
 	void bind(std::size_t pos, const NullData& val, Direction dir);
 		/// Binds a null.
 
+	void bind(std::size_t pos, const std::vector<Poco::Int8>& val, Direction dir);
+		/// Binds the current row of an Int8 vector.
+
+	void bind(std::size_t pos, const std::vector<Poco::UInt8>& val, Direction dir);
+		/// Binds the current row of an UInt8 vector.
+
+	void bind(std::size_t pos, const std::vector<Poco::Int16>& val, Direction dir);
+		/// Binds the current row of an Int16 vector.
+
+	void bind(std::size_t pos, const std::vector<Poco::UInt16>& val, Direction dir);
+		/// Binds the current row of an UInt16 vector.
+
+	void bind(std::size_t pos, const std::vector<Poco::Int32>& val, Direction dir);
+		/// Binds the current row of an Int32 vector.
+
+	void bind(std::size_t pos, const std::vector<Poco::UInt32>& val, Direction dir);
+		/// Binds the current row of an UInt32 vector.
+
+	void bind(std::size_t pos, const std::vector<Poco::Int64>& val, Direction dir);
+		/// Binds the current row of an Int64 vector.
+
+	void bind(std::size_t pos, const std::vector<Poco::UInt64>& val, Direction dir);
+		/// Binds the current row of an UInt64 vector.
+
+#ifndef POCO_LONG_IS_64_BIT
+	void bind(std::size_t pos, const std::vector<long>& val, Direction dir);
+		/// Binds the current row of a long vector.
+#endif
+
+	void bind(std::size_t pos, const std::vector<bool>& val, Direction dir);
+		/// Binds the current row of a boolean vector.
+
+	void bind(std::size_t pos, const std::vector<float>& val, Direction dir);
+		/// Binds the current row of a float vector.
+
+	void bind(std::size_t pos, const std::vector<double>& val, Direction dir);
+		/// Binds the current row of a double vector.
+
+	void bind(std::size_t pos, const std::vector<char>& val, Direction dir);
+		/// Binds the current row of a character vector.
+
+	void bind(std::size_t pos, const std::vector<std::string>& val, Direction dir);
+		/// Binds the current row of a string vector.
+
+	void bind(std::size_t pos, const std::vector<Poco::Data::BLOB>& val, Direction dir);
+		/// Binds the current row of a BLOB vector.
+
+	void bind(std::size_t pos, const std::vector<Poco::Data::CLOB>& val, Direction dir);
+		/// Binds the current row of a CLOB vector.
+
+	void bind(std::size_t pos, const std::vector<Date>& val, Direction dir);
+		/// Binds the current row of a Date vector.
+
+	void bind(std::size_t pos, const std::vector<Time>& val, Direction dir);
+		/// Binds the current row of a Time vector.
+
+	void bind(std::size_t pos, const std::vector<DateTime>& val, Direction dir);
+		/// Binds the current row of a DateTime vector.
+
+	void bind(std::size_t pos, const std::vector<NullData>& val, Direction dir);
+		/// Binds the current row of a null vector.
+
+	void bind(std::size_t pos, const std::deque<Poco::Int8>& val, Direction dir);
+		/// Binds the current row of an Int8 deque.
+
+	void bind(std::size_t pos, const std::deque<Poco::UInt8>& val, Direction dir);
+		/// Binds the current row of an UInt8 deque.
+
+	void bind(std::size_t pos, const std::deque<Poco::Int16>& val, Direction dir);
+		/// Binds the current row of an Int16 deque.
+
+	void bind(std::size_t pos, const std::deque<Poco::UInt16>& val, Direction dir);
+		/// Binds the current row of an UInt16 deque.
+
+	void bind(std::size_t pos, const std::deque<Poco::Int32>& val, Direction dir);
+		/// Binds the current row of an Int32 deque.
+
+	void bind(std::size_t pos, const std::deque<Poco::UInt32>& val, Direction dir);
+		/// Binds the current row of an UInt32 deque.
+
+	void bind(std::size_t pos, const std::deque<Poco::Int64>& val, Direction dir);
+		/// Binds the current row of an Int64 deque.
+
+	void bind(std::size_t pos, const std::deque<Poco::UInt64>& val, Direction dir);
+		/// Binds the current row of an UInt64 deque.
+
+#ifndef POCO_LONG_IS_64_BIT
+	void bind(std::size_t pos, const std::deque<long>& val, Direction dir);
+		/// Binds the current row of a long deque.
+#endif
+
+	void bind(std::size_t pos, const std::deque<bool>& val, Direction dir);
+		/// Binds the current row of a boolean deque.
+
+	void bind(std::size_t pos, const std::deque<float>& val, Direction dir);
+		/// Binds the current row of a float deque.
+
+	void bind(std::size_t pos, const std::deque<double>& val, Direction dir);
+		/// Binds the current row of a double deque.
+
+	void bind(std::size_t pos, const std::deque<char>& val, Direction dir);
+		/// Binds the current row of a character deque.
+
+	void bind(std::size_t pos, const std::deque<std::string>& val, Direction dir);
+		/// Binds the current row of a string deque.
+
+	void bind(std::size_t pos, const std::deque<Poco::Data::BLOB>& val, Direction dir);
+		/// Binds the current row of a BLOB deque.
+
+	void bind(std::size_t pos, const std::deque<Poco::Data::CLOB>& val, Direction dir);
+		/// Binds the current row of a CLOB deque.
+
+	void bind(std::size_t pos, const std::deque<Date>& val, Direction dir);
+		/// Binds the current row of a Date deque.
+
+	void bind(std::size_t pos, const std::deque<Time>& val, Direction dir);
+		/// Binds the current row of a Time deque.
+
+	void bind(std::size_t pos, const std::deque<DateTime>& val, Direction dir);
+		/// Binds the current row of a DateTime deque.
+
+	void bind(std::size_t pos, const std::deque<NullData>& val, Direction dir);
+		/// Binds the current row of a null deque.
+
+	void setRow(std::size_t row);
+		/// Sets the row bound by the container overloads.
+		///
+		/// SQLite has no native array binding, so bulk bindings are
+		/// executed by resetting the prepared statement and binding
+		/// one container element per execution step.
+
+	std::size_t getRow() const;
+		/// Returns the row bound by the container overloads.
+
 private:
 	void checkReturn(int rc);
 		/// Checks the SQLite return code and throws an appropriate exception
@@ -147,7 +282,17 @@ private:
 		checkReturn(rc);
 	}
 
+	template <typename C>
+	void bindRow(std::size_t pos, const C& val, Direction dir)
+	{
+		if (_row >= val.size())
+			throw BindingException("Bulk binding row out of range.");
+
+		bind(pos, val[_row], dir);
+	}
+
 	sqlite3_stmt* _pStmt;
+	std::size_t   _row;
 };
 
 
@@ -236,6 +381,262 @@ inline void Binder::bind(std::size_t pos, const Poco::Data::CLOB& val, Direction
 }
 
 
+inline void Binder::bind(std::size_t pos, const std::vector<Poco::Int8>& val, Direction dir)
+{
+	bindRow(pos, val, dir);
+}
+
+
+inline void Binder::bind(std::size_t pos, const std::vector<Poco::UInt8>& val, Direction dir)
+{
+	bindRow(pos, val, dir);
+}
+
+
+inline void Binder::bind(std::size_t pos, const std::vector<Poco::Int16>& val, Direction dir)
+{
+	bindRow(pos, val, dir);
+}
+
+
+inline void Binder::bind(std::size_t pos, const std::vector<Poco::UInt16>& val, Direction dir)
+{
+	bindRow(pos, val, dir);
+}
+
+
+inline void Binder::bind(std::size_t pos, const std::vector<Poco::Int32>& val, Direction dir)
+{
+	bindRow(pos, val, dir);
+}
+
+
+inline void Binder::bind(std::size_t pos, const std::vector<Poco::UInt32>& val, Direction dir)
+{
+	bindRow(pos, val, dir);
+}
+
+
+inline void Binder::bind(std::size_t pos, const std::vector<Poco::Int64>& val, Direction dir)
+{
+	bindRow(pos, val, dir);
+}
+
+
+inline void Binder::bind(std::size_t pos, const std::vector<Poco::UInt64>& val, Direction dir)
+{
+	bindRow(pos, val, dir);
+}
+
+
+#ifndef POCO_LONG_IS_64_BIT
+inline void Binder::bind(std::size_t pos, const std::vector<long>& val, Direction dir)
+{
+	bindRow(pos, val, dir);
+}
+#endif
+
+
+inline void Binder::bind(std::size_t pos, const std::vector<bool>& val, Direction dir)
+{
+	bindRow(pos, val, dir);
+}
+
+
+inline void Binder::bind(std::size_t pos, const std::vector<float>& val, Direction dir)
+{
+	bindRow(pos, val, dir);
+}
+
+
+inline void Binder::bind(std::size_t pos, const std::vector<double>& val, Direction dir)
+{
+	bindRow(pos, val, dir);
+}
+
+
+inline void Binder::bind(std::size_t pos, const std::vector<char>& val, Direction dir)
+{
+	bindRow(pos, val, dir);
+}
+
+
+inline void Binder::bind(std::size_t pos, const std::vector<std::string>& val, Direction dir)
+{
+	bindRow(pos, val, dir);
+}
+
+
+inline void Binder::bind(std::size_t pos, const std::vector<Poco::Data::BLOB>& val, Direction dir)
+{
+	bindRow(pos, val, dir);
+}
+
+
+inline void Binder::bind(std::size_t pos, const std::vector<Poco::Data::CLOB>& val, Direction dir)
+{
+	bindRow(pos, val, dir);
+}
+
+
+inline void Binder::bind(std::size_t pos, const std::vector<Date>& val, Direction dir)
+{
+	bindRow(pos, val, dir);
+}
+
+
+inline void Binder::bind(std::size_t pos, const std::vector<Time>& val, Direction dir)
+{
+	bindRow(pos, val, dir);
+}
+
+
+inline void Binder::bind(std::size_t pos, const std::vector<DateTime>& val, Direction dir)
+{
+	bindRow(pos, val, dir);
+}
+
+
+inline void Binder::bind(std::size_t pos, const std::vector<NullData>& val, Direction dir)
+{
+	bindRow(pos, val, dir);
+}
+
+
+inline void Binder::bind(std::size_t pos, const std::deque<Poco::Int8>& val, Direction dir)
+{
+	bindRow(pos, val, dir);
+}
+
+
+inline void Binder::bind(std::size_t pos, const std::deque<Poco::UInt8>& val, Direction dir)
+{
+	bindRow(pos, val, dir);
+}
+
+
+inline void Binder::bind(std::size_t pos, const std::deque<Poco::Int16>& val, Direction dir)
+{
+	bindRow(pos, val, dir);
+}
+
+
+inline void Binder::bind(std::size_t pos, const std::deque<Poco::UInt16>& val, Direction dir)
+{
+	bindRow(pos, val, dir);
+}
+
+
+inline void Binder::bind(std::size_t pos, const std::deque<Poco::Int32>& val, Direction dir)
+{
+	bindRow(pos, val, dir);
+}
+
+
+inline void Binder::bind(std::size_t pos, const std::deque<Poco::UInt32>& val, Direction dir)
+{
+	bindRow(pos, val, dir);
+}
+
+
+inline void Binder::bind(std::size_t pos, const std::deque<Poco::Int64>& val, Direction dir)
+{
+	bindRow(pos, val, dir);
+}
+
+
+inline void Binder::bind(std::size_t pos, const std::deque<Poco::UInt64>& val, Direction dir)
+{
+	bindRow(pos, val, dir);
+}
+
+
+#ifndef POCO_LONG_IS_64_BIT
+inline void Binder::bind(std::size_t pos, const std::deque<long>& val, Direction dir)
+{
+	bindRow(pos, val, dir);
+}
+#endif
+
+
+inline void Binder::bind(std::size_t pos, const std::deque<bool>& val, Direction dir)
+{
+	bindRow(pos, val, dir);
+}
+
+
+inline void Binder::bind(std::size_t pos, const std::deque<float>& val, Direction dir)
+{
+	bindRow(pos, val, dir);
+}
+
+
+inline void Binder::bind(std::size_t pos, const std::deque<double>& val, Direction dir)
+{
+	bindRow(pos, val, dir);
+}
+
+
+inline void Binder::bind(std::size_t pos, const std::deque<char>& val, Direction dir)
+{
+	bindRow(pos, val, dir);
+}
+
+
+inline void Binder::bind(std::size_t pos, const std::deque<std::string>& val, Direction dir)
+{
+	bindRow(pos, val, dir);
+}
+
+
+inline void Binder::bind(std::size_t pos, const std::deque<Poco::Data::BLOB>& val, Direction dir)
+{
+	bindRow(pos, val, dir);
+}
+
+
+inline void Binder::bind(std::size_t pos, const std::deque<Poco::Data::CLOB>& val, Direction dir)
+{
+	bindRow(pos, val, dir);
+}
+
+
+inline void Binder::bind(std::size_t pos, const std::deque<Date>& val, Direction dir)
+{
+	bindRow(pos, val, dir);
+}
+
+
+inline void Binder::bind(std::size_t pos, const std::deque<Time>& val, Direction dir)
+{
+	bindRow(pos, val, dir);
+}
+
+
+inline void Binder::bind(std::size_t pos, const std::deque<DateTime>& val, Direction dir)
+{
+	bindRow(pos, val, dir);
+}
+
+
+inline void Binder::bind(std::size_t pos, const std::deque<NullData>& val, Direction dir)
+{
+	bindRow(pos, val, dir);
+}
+
+
+inline void Binder::setRow(std::size_t row)
+{
+	_row = row;
+}
+
+
+inline std::size_t Binder::getRow() const
+{
+	return _row;
+}
+
+
 } } } // namespace Poco::Data::SQLite
 
 
@@ -43,6 +43,7 @@
 #include "Poco/Data/SQLite/SQLite.h"
 #include "Poco/Data/SQLite/Binder.h"
 #include "Poco/Data/SQLite/Extractor.h"
+#include "Poco/Data/SQLite/StatementCache.h"
 #include "Poco/Data/StatementImpl.h"
 #include "Poco/Data/MetaColumn.h"
 #include "Poco/SharedPtr.h"
@@ -61,8 +62,11 @@ class SQLite_API SQLiteStatementImpl: public Poco::Data::StatementImpl
 	/// Implements statement functionality needed for SQLite
 {
 public:
-	SQLiteStatementImpl(Poco::Data::SessionImpl& rSession, sqlite3* pDB);
+	SQLiteStatementImpl(Poco::Data::SessionImpl& rSession, sqlite3* pDB, StatementCache* pCache = 0);
 		/// Creates the SQLiteStatementImpl.
+		///
+		/// If a StatementCache is given, prepared statements are
+		/// taken from and returned to the cache.
 
 	~SQLiteStatementImpl();
 		/// Destroys the SQLiteStatementImpl.
@@ -102,7 +106,15 @@ protected:
 		/// buffer pointed to by _pLeftover member.
 
 	void bindImpl();
-		/// Binds parameters
+		/// Binds parameters.
+		///
+		/// Bulk bindings are executed by re-binding the same prepared
+		/// statement once per row. When bulk bindings carry more than one
+		/// row and the connection is in autocommit mode, all rows of a
+		/// data-modifying statement are executed inside a single implicit
+		/// transaction, which is committed after the last row and rolled
+		/// back on error. Other container bindings commit every row
+		/// separately, as before.
 
 	AbstractExtractor& extractor();
 		/// Returns the concrete extractor used by the statement.
@@ -112,7 +124,8 @@ protected:
 
 private:
 	void clear();
-		/// Removes the _pStmt
+		/// Removes the _pStmt, returning it to the
+		/// statement cache if possible.
 
 	typedef Poco::SharedPtr<Binder>             BinderPtr;
 	typedef Poco::SharedPtr<Extractor>          ExtractorPtr;
@@ -123,6 +136,20 @@ private:
 	typedef Poco::SharedPtr<std::string>        StrPtr;
 	typedef Bindings::iterator                  BindIt;
 
+	void bindBulk(BindIt bindEnd, std::size_t rowCount);
+		/// Binds the current row of all bulk bindings in [_bindBegin, bindEnd)
+		/// and advances to the next row.
+
+	void beginImplicitTransaction();
+		/// Starts an implicit transaction for a multi-row bulk execution,
+		/// unless the statement is read-only or a transaction is already active.
+
+	void commitImplicitTransaction();
+		/// Commits the implicit transaction, if one is active.
+
+	void rollbackImplicitTransaction();
+		/// Rolls back the implicit transaction, if one is active.
+
 	sqlite3*         _pDB;
 	sqlite3_stmt*    _pStmt;
 	bool             _stepCalled;
@@ -136,6 +163,10 @@ private:
 	bool             _canBind;
 	bool             _isExtracted;
 	bool             _canCompile;
+	StatementCache::Ptr _pCache;
+	std::string      _cacheKey;
+	bool             _cacheable;
+	bool             _inTransaction;
 
 	static const std::size_t POCO_SQLITE_INV_ROW_CNT;
 };
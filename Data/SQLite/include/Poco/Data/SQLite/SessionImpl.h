@@ -43,6 +43,7 @@
 #include "Poco/Data/SQLite/SQLite.h"
 #include "Poco/Data/SQLite/Connector.h"
 #include "Poco/Data/SQLite/Binder.h"
+#include "Poco/Data/SQLite/StatementCache.h"
 #include "Poco/Data/AbstractSessionImpl.h"
 #include "Poco/SharedPtr.h"
 
@@ -61,6 +62,19 @@ namespace SQLite {
 
 class SQLite_API SessionImpl: public Poco::Data::AbstractSessionImpl<SessionImpl>
 	/// Implements SessionImpl interface.
+	///
+	/// Prepared statements are kept in a per-session StatementCache
+	/// and reused when a statement with the same SQL text is executed
+	/// again on the session. The cache is controlled with the following
+	/// properties:
+	///   - statementCacheSize (std::size_t): maximum number of cached
+	///     statements; zero disables caching.
+	///   - statementCacheHits, statementCacheMisses, statementCacheEvictions
+	///     (std::size_t, read-only): cache statistics.
+	///
+	/// The "bulk" feature is enabled for binding only: use(vector, bulk)
+	/// executes one prepared statement per element inside a single
+	/// implicit transaction. Bulk extraction is not supported.
 {
 public:
 	SessionImpl(const std::string& fileName,
@@ -137,6 +151,15 @@ public:
 	const std::string& connectorName() const;
 		/// Returns the name of the connector.
 
+	void setStatementCacheSize(const std::string&, const Poco::Any& value);
+		/// Sets the maximum number of cached prepared statements.
+
+	Poco::Any getStatementCacheSize(const std::string&);
+		/// Returns the maximum number of cached prepared statements.
+
+	Poco::Any getStatementCacheInfo(const std::string& name);
+		/// Returns the statement cache statistic with the given name.
+
 private:
 	std::string _connector;
 	sqlite3*    _pDB;
@@ -144,6 +167,7 @@ private:
 	bool        _isTransaction;
 	int         _timeout;
 	Mutex       _mutex;
+	StatementCache::Ptr _pStatementCache;
 	static const std::string DEFERRED_BEGIN_TRANSACTION;
 	static const std::string COMMIT_TRANSACTION;
 	static const std::string ABORT_TRANSACTION;
@@ -171,6 +195,12 @@ inline const std::string& SessionImpl::connectorName() const
 }
 
 
+inline Poco::Any SessionImpl::getStatementCacheSize(const std::string&)
+{
+	return _pStatementCache->capacity();
+}
+
+
 inline std::size_t SessionImpl::getConnectionTimeout()
 {
 	return static_cast<std::size_t>(_timeout);
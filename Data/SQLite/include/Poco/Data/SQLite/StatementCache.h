@@ -0,0 +1,197 @@
+//
+// StatementCache.h
+//
+// $Id: //poco/Main/Data/SQLite/include/Poco/Data/SQLite/StatementCache.h#1 $
+//
+// Library: SQLite
+// Package: SQLite
+// Module:  StatementCache
+//
+// Definition of StatementCache.
+//
+// Copyright (c) 2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#ifndef SQLite_StatementCache_INCLUDED
+#define SQLite_StatementCache_INCLUDED
+
+
+#include "Poco/Data/SQLite/SQLite.h"
+#include "Poco/RefCountedObject.h"
+#include "Poco/AutoPtr.h"
+#include <list>
+#include <map>
+#include <string>
+
+
+struct sqlite3;
+struct sqlite3_stmt;
+
+
+namespace Poco {
+namespace Data {
+namespace SQLite {
+
+
+class SQLite_API StatementCache: public Poco::RefCountedObject
+	/// A least-recently-used cache of prepared SQLite statements,
+	/// keyed by SQL text.
+	///
+	/// Each SessionImpl owns a StatementCache. When a statement
+	/// is compiled, SQLiteStatementImpl first tries to take a
+	/// prepared statement for the same SQL text from the cache,
+	/// and only calls sqlite3_prepare_v2() on a miss. When the
+	/// statement is cleared or destroyed, the prepared statement
+	/// is reset and handed back to the cache instead of being
+	/// finalized. Since the cache belongs to the session, it
+	/// survives SessionPool check-in and check-out.
+	///
+	/// A prepared statement is owned either by the cache or
+	/// by exactly one SQLiteStatementImpl at any time, so
+	/// statements sharing the same SQL text can be used
+	/// concurrently on the same session.
+	///
+	/// Only statements consisting of a single SQL command are cached.
+	///
+	/// Like the session it belongs to, a StatementCache must not
+	/// be used by multiple threads simultaneously.
+{
+public:
+	typedef Poco::AutoPtr<StatementCache> Ptr;
+
+	enum
+	{
+		DEFAULT_CAPACITY = 32
+	};
+
+	explicit StatementCache(std::size_t capacity = DEFAULT_CAPACITY);
+		/// Creates the StatementCache with the given capacity.
+		/// A capacity of zero disables caching.
+
+	void setDatabase(sqlite3* pDB);
+		/// Sets the database connection the cached statements
+		/// belong to. Finalizes all cached statements.
+		/// Statements belonging to another connection
+		/// are never cached.
+
+	sqlite3_stmt* get(const std::string& sql);
+		/// Removes the prepared statement for the given SQL text
+		/// from the cache and returns it, or returns null if no
+		/// such statement is cached.
+
+	void put(const std::string& sql, sqlite3_stmt* pStmt);
+		/// Resets the given prepared statement and adds it to the
+		/// cache, evicting the least recently used statement if the
+		/// cache is full. The statement is finalized instead if
+		/// caching is disabled, the statement does not belong to the
+		/// current database connection or a statement for the same
+		/// SQL text is already cached.
+
+	void clear();
+		/// Finalizes all cached statements.
+
+	void setCapacity(std::size_t capacity);
+		/// Sets the maximum number of cached statements,
+		/// evicting statements if necessary.
+
+	std::size_t capacity() const;
+		/// Returns the maximum number of cached statements.
+
+	std::size_t size() const;
+		/// Returns the number of currently cached statements.
+
+	std::size_t hits() const;
+		/// Returns the number of calls to get() that returned a statement.
+
+	std::size_t misses() const;
+		/// Returns the number of calls to get() that returned null.
+
+	std::size_t evictions() const;
+		/// Returns the number of statements evicted because the
+		/// cache was full.
+
+protected:
+	~StatementCache();
+		/// Destroys the StatementCache and finalizes all cached statements.
+
+private:
+	StatementCache(const StatementCache&);
+	StatementCache& operator = (const StatementCache&);
+
+	typedef std::pair<std::string, sqlite3_stmt*> Entry;
+	typedef std::list<Entry>                       EntryList;
+	typedef std::map<std::string, EntryList::iterator> EntryMap;
+
+	void evict(std::size_t capacity);
+
+	sqlite3*    _pDB;
+	std::size_t _capacity;
+	EntryList   _entries;
+	EntryMap    _index;
+	std::size_t _hits;
+	std::size_t _misses;
+	std::size_t _evictions;
+};
+
+
+//
+// inlines
+//
+inline std::size_t StatementCache::capacity() const
+{
+	return _capacity;
+}
+
+
+inline std::size_t StatementCache::size() const
+{
+	return _index.size();
+}
+
+
+inline std::size_t StatementCache::hits() const
+{
+	return _hits;
+}
+
+
+inline std::size_t StatementCache::misses() const
+{
+	return _misses;
+}
+
+
+inline std::size_t StatementCache::evictions() const
+{
+	return _evictions;
+}
+
+
+} } } // namespace Poco::Data::SQLite
+
+
+#endif // SQLite_StatementCache_INCLUDED
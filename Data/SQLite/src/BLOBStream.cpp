@@ -0,0 +1,175 @@
+//
+// BLOBStream.cpp
+//
+// $Id: //poco/Main/Data/SQLite/src/BLOBStream.cpp#1 $
+//
+// Library: SQLite
+// Package: SQLite
+// Module:  BLOBStream
+//
+// Implementation of the BLOBStreamBuf, BLOBIOS and BLOBStream classes.
+//
+// Copyright (c) 2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#include "Poco/Data/SQLite/BLOBStream.h"
+#include "Poco/Data/SQLite/Utility.h"
+#include <cstring>
+#if defined(POCO_UNBUNDLED)
+#include <sqlite3.h>
+#else
+#include "sqlite3.h"
+#endif
+
+
+namespace Poco {
+namespace Data {
+namespace SQLite {
+
+
+//
+// BLOBStreamBuf
+//
+
+
+BLOBStreamBuf::BLOBStreamBuf(sqlite3* pDB,
+	const std::string& table,
+	const std::string& column,
+	Poco::Int64 rowID,
+	const std::string& database,
+	std::streamsize bufferSize):
+	Poco::BufferedStreamBuf(bufferSize, std::ios::in),
+	_pBlob(0),
+	_size(0),
+	_offset(0)
+{
+	poco_check_ptr (pDB);
+
+	int rc = sqlite3_blob_open(pDB, database.c_str(), table.c_str(), column.c_str(), rowID, 0, &_pBlob);
+	if (rc != SQLITE_OK)
+	{
+		std::string errMsg = sqlite3_errmsg(pDB);
+		if (_pBlob) sqlite3_blob_close(_pBlob);
+		Utility::throwException(rc, errMsg);
+	}
+	_size = sqlite3_blob_bytes(_pBlob);
+}
+
+
+BLOBStreamBuf::~BLOBStreamBuf()
+{
+	close();
+}
+
+
+void BLOBStreamBuf::close()
+{
+	if (_pBlob)
+	{
+		sqlite3_blob_close(_pBlob);
+		_pBlob = 0;
+	}
+}
+
+
+int BLOBStreamBuf::readFromDevice(char* buffer, std::streamsize length)
+{
+	if (!_pBlob || _offset >= _size) return 0;
+
+	int n = static_cast<int>(length < _size - _offset ? length : _size - _offset);
+	int rc = sqlite3_blob_read(_pBlob, buffer, n, static_cast<int>(_offset));
+	if (rc != SQLITE_OK) Utility::throwException(rc);
+	_offset += n;
+	return n;
+}
+
+
+std::streamsize BLOBStreamBuf::xsgetn(char* p, std::streamsize count)
+{
+	std::streamsize copied = 0;
+	std::streamsize avail = egptr() - gptr();
+	if (avail > 0)
+	{
+		copied = count < avail ? count : avail;
+		std::memcpy(p, gptr(), static_cast<std::size_t>(copied));
+		gbump(static_cast<int>(copied));
+	}
+
+	while (copied < count)
+	{
+		int n = readFromDevice(p + copied, count - copied);
+		if (n <= 0) break;
+		copied += n;
+	}
+	return copied;
+}
+
+
+//
+// BLOBIOS
+//
+
+
+BLOBIOS::BLOBIOS(Session& session,
+	const std::string& table,
+	const std::string& column,
+	Poco::Int64 rowID,
+	const std::string& database,
+	std::streamsize bufferSize):
+	_buf(Utility::dbHandle(session), table, column, rowID, database, bufferSize)
+{
+	poco_ios_init(&_buf);
+}
+
+
+BLOBIOS::~BLOBIOS()
+{
+}
+
+
+//
+// BLOBStream
+//
+
+
+BLOBStream::BLOBStream(Session& session,
+	const std::string& table,
+	const std::string& column,
+	Poco::Int64 rowID,
+	const std::string& database,
+	std::streamsize bufferSize):
+	BLOBIOS(session, table, column, rowID, database, bufferSize),
+	std::istream(&_buf)
+{
+}
+
+
+BLOBStream::~BLOBStream()
+{
+}
+
+
+} } } // namespace Poco::Data::SQLite
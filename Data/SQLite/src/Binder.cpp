@@ -54,7 +54,8 @@ namespace SQLite {
 
 
 Binder::Binder(sqlite3_stmt* pStmt):
-	_pStmt(pStmt)
+	_pStmt(pStmt),
+	_row(0)
 {
 }
 
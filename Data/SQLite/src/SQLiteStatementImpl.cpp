@@ -55,7 +55,7 @@ namespace SQLite {
 const std::size_t SQLiteStatementImpl::POCO_SQLITE_INV_ROW_CNT = std::numeric_limits<std::size_t>::max();
 
 
-SQLiteStatementImpl::SQLiteStatementImpl(Poco::Data::SessionImpl& rSession, sqlite3* pDB):
+SQLiteStatementImpl::SQLiteStatementImpl(Poco::Data::SessionImpl& rSession, sqlite3* pDB, StatementCache* pCache):
 	StatementImpl(rSession),
 	_pDB(pDB),
 	_pStmt(0),
@@ -64,7 +64,10 @@ SQLiteStatementImpl::SQLiteStatementImpl(Poco::Data::SessionImpl& rSession, sqli
 	_affectedRowCount(POCO_SQLITE_INV_ROW_CNT),
 	_canBind(false),
 	_isExtracted(false),
-	_canCompile(true)
+	_canCompile(true),
+	_pCache(pCache, true),
+	_cacheable(false),
+	_inTransaction(false)
 {
 	_columns.resize(1);
 }
@@ -78,6 +81,9 @@ SQLiteStatementImpl::~SQLiteStatementImpl()
 
 void SQLiteStatementImpl::compileImpl()
 {
+	if (!extractions().empty() && extractions().front()->isBulk())
+		throw InvalidAccessException("Bulk extraction not supported by SQLite.");
+
 	if (!_pLeftover)
 	{
 		_bindBegin = bindings().begin();
@@ -94,8 +100,24 @@ void SQLiteStatementImpl::compileImpl()
 	int rc = SQLITE_OK;
 	const char* pLeftover = 0;
 	bool queryFound = false;
+	bool cacheable = false;
+
+	if (_pCache && !_pLeftover)
+	{
+		if (_pStmt && _cacheable)
+		{
+			_pCache->put(_cacheKey, _pStmt);
+			_pStmt = 0;
+		}
+		pStmt = _pCache->get(statement);
+		if (pStmt)
+		{
+			pLeftover = "";
+			queryFound = true;
+		}
+	}
 
-	do
+	while (!queryFound)
 	{
 		rc = sqlite3_prepare_v2(_pDB, pSql, -1, &pStmt, &pLeftover);
 		if (rc != SQLITE_OK)
@@ -119,15 +141,18 @@ void SQLiteStatementImpl::compileImpl()
 				queryFound = true;
 			}
 		}
-	} while (rc == SQLITE_OK && !pStmt && !queryFound);
+	}
 
 	//Finalization call in clear() invalidates the pointer, so the value is remembered here.
 	//For last statement in a batch (or a single statement), pLeftover == "", so the next call
 	// to compileImpl() shall return false immediately when there are no more statements left.
 	std::string leftOver(pLeftover);
 	trimInPlace(leftOver);
+	cacheable = _pCache && !_pLeftover && pStmt && leftOver.empty();
 	clear();
-	_pStmt = pStmt;
+	_pStmt     = pStmt;
+	_cacheable = cacheable;
+	if (_cacheable) _cacheKey = statement;
 	if (!leftOver.empty())
 	{
 		_pLeftover = new std::string(leftOver);
@@ -204,6 +229,13 @@ void SQLiteStatementImpl::bindImpl()
 	{
 		boundRowCount = (*_bindBegin)->numOfRowsHandled();
 
+		if ((*_bindBegin)->isBulk())
+		{
+			if (boundRowCount > 1) beginImplicitTransaction();
+			bindBulk(bindEnd, boundRowCount);
+			return;
+		}
+
 		Bindings::iterator oldBegin = _bindBegin;
 		for (std::size_t pos = 1; _bindBegin != bindEnd && (*_bindBegin)->canBind(); ++_bindBegin)
 		{
@@ -225,16 +257,93 @@ void SQLiteStatementImpl::bindImpl()
 }
 
 
+void SQLiteStatementImpl::bindBulk(BindIt bindEnd, std::size_t rowCount)
+{
+	std::size_t row = _pBinder->getRow();
+	try
+	{
+		std::size_t pos = 1;
+		for (Bindings::iterator it = _bindBegin; it != bindEnd; ++it)
+		{
+			if (rowCount != (*it)->numOfRowsHandled())
+				throw BindingException("Size mismatch in Bindings. All Bindings MUST have the same size");
+
+			(*it)->bind(pos);
+			pos += (*it)->numOfColumnsHandled();
+		}
+	}
+	catch (...)
+	{
+		rollbackImplicitTransaction();
+		throw;
+	}
+
+	if (++row < rowCount)
+	{
+		_pBinder->setRow(row);
+		_canBind = true;
+	}
+	else
+	{
+		_pBinder->setRow(0);
+		_bindBegin = bindEnd;
+		_canBind = false;
+	}
+}
+
+
+void SQLiteStatementImpl::beginImplicitTransaction()
+{
+	if (_inTransaction || !_pStmt || sqlite3_stmt_readonly(_pStmt) || !sqlite3_get_autocommit(_pDB))
+		return;
+
+	int rc = sqlite3_exec(_pDB, "BEGIN", 0, 0, 0);
+	if (rc != SQLITE_OK) Utility::throwException(rc);
+	_inTransaction = true;
+}
+
+
+void SQLiteStatementImpl::commitImplicitTransaction()
+{
+	if (!_inTransaction) return;
+
+	_inTransaction = false;
+	int rc = sqlite3_exec(_pDB, "COMMIT", 0, 0, 0);
+	if (rc != SQLITE_OK)
+	{
+		if (!sqlite3_get_autocommit(_pDB))
+			sqlite3_exec(_pDB, "ROLLBACK", 0, 0, 0);
+		Utility::throwException(rc);
+	}
+}
+
+
+void SQLiteStatementImpl::rollbackImplicitTransaction()
+{
+	if (!_inTransaction) return;
+
+	_inTransaction = false;
+	if (!sqlite3_get_autocommit(_pDB))
+		sqlite3_exec(_pDB, "ROLLBACK", 0, 0, 0);
+}
+
+
 void SQLiteStatementImpl::clear()
 {
+	rollbackImplicitTransaction();
+
 	_columns[currentDataSet()].clear();
 	_affectedRowCount = POCO_SQLITE_INV_ROW_CNT;
 
 	if (_pStmt)
 	{
-		sqlite3_finalize(_pStmt);
+		if (_cacheable)
+			_pCache->put(_cacheKey, _pStmt);
+		else
+			sqlite3_finalize(_pStmt);
 		_pStmt=0;
 	}
+	_cacheable = false;
 	_pLeftover = 0;
 }
 
@@ -260,7 +369,13 @@ bool SQLiteStatementImpl::hasNext()
 		_affectedRowCount += sqlite3_changes(_pDB);
 
 	if (_nextResponse != SQLITE_ROW && _nextResponse != SQLITE_OK && _nextResponse != SQLITE_DONE)
+	{
+		rollbackImplicitTransaction();
 		Utility::throwException(_nextResponse);
+	}
+
+	if (_nextResponse == SQLITE_DONE && !_canBind)
+		commitImplicitTransaction();
 
 	_pExtractor->reset();//clear the cached null indicators
 
@@ -278,11 +393,20 @@ std::size_t SQLiteStatementImpl::next()
 		Extractions::iterator it    = extracts.begin();
 		Extractions::iterator itEnd = extracts.end();
 		std::size_t pos = 0; // sqlite starts with pos 0 for results!
-		for (; it != itEnd; ++it)
+		try
 		{
-			(*it)->extract(pos);
-			pos += (*it)->numOfColumnsHandled();
-			_isExtracted = true;
+			for (; it != itEnd; ++it)
+			{
+				(*it)->extract(pos);
+				pos += (*it)->numOfColumnsHandled();
+				_isExtracted = true;
+			}
+		}
+		catch (...)
+		{
+			// the statement will not be stepped to completion
+			rollbackImplicitTransaction();
+			throw;
 		}
 		_stepCalled = false;
 		if (_affectedRowCount == POCO_SQLITE_INV_ROW_CNT) _affectedRowCount = 0;
@@ -290,10 +414,12 @@ std::size_t SQLiteStatementImpl::next()
 	}
 	else if (SQLITE_DONE == _nextResponse)
 	{
+		rollbackImplicitTransaction();
 		throw Poco::Data::DataException("No data received");
 	}
 	else
 	{
+		rollbackImplicitTransaction();
 		Utility::throwException(_nextResponse, std::string("Iterator Error: trying to access the next value"));
 	}
 	
@@ -63,14 +63,22 @@ SessionImpl::SessionImpl(const std::string& fileName, std::size_t loginTimeout):
 	_connector(Connector::KEY),
 	_pDB(0),
 	_connected(false),
-	_isTransaction(false)
+	_isTransaction(false),
+	_pStatementCache(new StatementCache)
 {
 	open();
 	setConnectionTimeout(CONNECTION_TIMEOUT_DEFAULT);
 	setProperty("handle", _pDB);
+	setFeature("bulk", true);
 	addFeature("autoCommit", 
 		&SessionImpl::autoCommit, 
 		&SessionImpl::isAutoCommit);
+	addProperty("statementCacheSize", 
+		&SessionImpl::setStatementCacheSize, 
+		&SessionImpl::getStatementCacheSize);
+	addProperty("statementCacheHits", 0, &SessionImpl::getStatementCacheInfo);
+	addProperty("statementCacheMisses", 0, &SessionImpl::getStatementCacheInfo);
+	addProperty("statementCacheEvictions", 0, &SessionImpl::getStatementCacheInfo);
 }
 
 
@@ -83,14 +91,14 @@ SessionImpl::~SessionImpl()
 Poco::Data::StatementImpl* SessionImpl::createStatementImpl()
 {
 	poco_check_ptr (_pDB);
-	return new SQLiteStatementImpl(*this, _pDB);
+	return new SQLiteStatementImpl(*this, _pDB, _pStatementCache);
 }
 
 
 void SessionImpl::begin()
 {
 	Poco::Mutex::ScopedLock l(_mutex);
-	SQLiteStatementImpl tmp(*this, _pDB);
+	SQLiteStatementImpl tmp(*this, _pDB, _pStatementCache);
 	tmp.add(DEFERRED_BEGIN_TRANSACTION);
 	tmp.execute();
 	_isTransaction = true;
@@ -100,7 +108,7 @@ void SessionImpl::begin()
 void SessionImpl::commit()
 {
 	Poco::Mutex::ScopedLock l(_mutex);
-	SQLiteStatementImpl tmp(*this, _pDB);
+	SQLiteStatementImpl tmp(*this, _pDB, _pStatementCache);
 	tmp.add(COMMIT_TRANSACTION);
 	tmp.execute();
 	_isTransaction = false;
@@ -110,7 +118,7 @@ void SessionImpl::commit()
 void SessionImpl::rollback()
 {
 	Poco::Mutex::ScopedLock l(_mutex);
-	SQLiteStatementImpl tmp(*this, _pDB);
+	SQLiteStatementImpl tmp(*this, _pDB, _pStatementCache);
 	tmp.add(ABORT_TRANSACTION);
 	tmp.execute();
 	_isTransaction = false;
@@ -201,12 +209,14 @@ void SessionImpl::open(const std::string& connect)
 		throw ConnectionFailedException(ex.displayText());
 	}
 
+	_pStatementCache->setDatabase(_pDB);
 	_connected = true;
 }
 
 
 void SessionImpl::close()
 {
+	_pStatementCache->setDatabase(0);
 	if (_pDB)
 	{
 		sqlite3_close(_pDB);
@@ -249,4 +259,21 @@ bool SessionImpl::isAutoCommit(const std::string&)
 }
 
 
+void SessionImpl::setStatementCacheSize(const std::string&, const Poco::Any& value)
+{
+	_pStatementCache->setCapacity(Poco::AnyCast<std::size_t>(value));
+}
+
+
+Poco::Any SessionImpl::getStatementCacheInfo(const std::string& name)
+{
+	if (name == "statementCacheHits")
+		return _pStatementCache->hits();
+	else if (name == "statementCacheMisses")
+		return _pStatementCache->misses();
+	else
+		return _pStatementCache->evictions();
+}
+
+
 } } } // namespace Poco::Data::SQLite
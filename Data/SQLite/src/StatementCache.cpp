@@ -0,0 +1,138 @@
+//
+// StatementCache.cpp
+//
+// $Id: //poco/Main/Data/SQLite/src/StatementCache.cpp#1 $
+//
+// Library: SQLite
+// Package: SQLite
+// Module:  StatementCache
+//
+// Copyright (c) 2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+
+#include "Poco/Data/SQLite/StatementCache.h"
+#if defined(POCO_UNBUNDLED)
+#include <sqlite3.h>
+#else
+#include "sqlite3.h"
+#endif
+
+
+namespace Poco {
+namespace Data {
+namespace SQLite {
+
+
+StatementCache::StatementCache(std::size_t capacity):
+	_pDB(0),
+	_capacity(capacity),
+	_hits(0),
+	_misses(0),
+	_evictions(0)
+{
+}
+
+
+StatementCache::~StatementCache()
+{
+	clear();
+}
+
+
+void StatementCache::setDatabase(sqlite3* pDB)
+{
+	clear();
+	_pDB = pDB;
+}
+
+
+sqlite3_stmt* StatementCache::get(const std::string& sql)
+{
+	EntryMap::iterator it = _index.find(sql);
+	if (it == _index.end())
+	{
+		++_misses;
+		return 0;
+	}
+	sqlite3_stmt* pStmt = it->second->second;
+	_entries.erase(it->second);
+	_index.erase(it);
+	++_hits;
+	return pStmt;
+}
+
+
+void StatementCache::put(const std::string& sql, sqlite3_stmt* pStmt)
+{
+	poco_check_ptr (pStmt);
+
+	if (_capacity == 0 || !_pDB || sqlite3_db_handle(pStmt) != _pDB || _index.find(sql) != _index.end())
+	{
+		sqlite3_finalize(pStmt);
+		return;
+	}
+	sqlite3_reset(pStmt);
+	sqlite3_clear_bindings(pStmt);
+	evict(_capacity - 1);
+	_entries.push_front(Entry(sql, pStmt));
+	_index[sql] = _entries.begin();
+}
+
+
+void StatementCache::clear()
+{
+	for (EntryList::iterator it = _entries.begin(); it != _entries.end(); ++it)
+	{
+		sqlite3_finalize(it->second);
+	}
+	_entries.clear();
+	_index.clear();
+}
+
+
+void StatementCache::setCapacity(std::size_t capacity)
+{
+	evict(capacity);
+	_capacity = capacity;
+}
+
+
+void StatementCache::evict(std::size_t capacity)
+{
+	while (_index.size() > capacity)
+	{
+		Entry& entry = _entries.back();
+		sqlite3_finalize(entry.second);
+		_index.erase(entry.first);
+		_entries.pop_back();
+		++_evictions;
+	}
+}
+
+
+} } } // namespace Poco::Data::SQLite
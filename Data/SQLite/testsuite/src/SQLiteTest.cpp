@@ -40,9 +40,16 @@
 #include "Poco/Data/RecordSet.h"
 #include "Poco/Data/SQLChannel.h"
 #include "Poco/Data/SessionFactory.h"
+#include "Poco/Data/SessionPool.h"
+#include "Poco/Data/Cursor.h"
+#include "Poco/Data/RecordSetExporter.h"
+#include "Poco/Data/AsyncExecutor.h"
+#include "Poco/Data/BulkExtraction.h"
+#include "Poco/Data/BulkBinding.h"
 #include "Poco/Data/SQLite/Connector.h"
 #include "Poco/Data/SQLite/Utility.h"
 #include "Poco/Data/SQLite/Notifier.h"
+#include "Poco/Data/SQLite/BLOBStream.h"
 #include "Poco/Dynamic/Var.h"
 #include "Poco/Data/TypeHandler.h"
 #include "Poco/Nullable.h"
@@ -57,18 +64,25 @@
 #include "Poco/Logger.h"
 #include "Poco/Message.h"
 #include "Poco/Thread.h"
+#include "Poco/Event.h"
+#include "Poco/Semaphore.h"
 #include "Poco/AutoPtr.h"
 #include "Poco/Exception.h"
 #include "Poco/RefCountedObject.h"
 #include "Poco/Stopwatch.h"
+#include "Poco/StreamCopier.h"
 #include "Poco/Delegate.h"
 #include <iostream>
 
 
 using namespace Poco::Data::Keywords;
 using Poco::Data::Session;
+using Poco::Data::SessionPool;
 using Poco::Data::Statement;
 using Poco::Data::RecordSet;
+using Poco::Data::Cursor;
+using Poco::Data::RecordSetExporter;
+using Poco::Data::AsyncExecutor;
 using Poco::Data::Column;
 using Poco::Data::Row;
 using Poco::Data::SQLChannel;
@@ -81,7 +95,9 @@ using Poco::Data::AbstractExtractionVec;
 using Poco::Data::AbstractExtractionVecVec;
 using Poco::Data::AbstractBindingVec;
 using Poco::Data::NotConnectedException;
+using Poco::Data::SessionPoolExhaustedException;
 using Poco::Data::SQLite::Notifier;
+using Poco::Data::SQLite::BLOBStream;
 using Poco::Nullable;
 using Poco::Tuple;
 using Poco::Any;
@@ -94,6 +110,7 @@ using Poco::AutoPtr;
 using Poco::Thread;
 using Poco::format;
 using Poco::InvalidAccessException;
+using Poco::InvalidArgumentException;
 using Poco::RangeException;
 using Poco::BadCastException;
 using Poco::NotFoundException;
@@ -772,6 +789,131 @@ void SQLiteTest::testInsertSingleBulkVec()
 }
 
 
+void SQLiteTest::testInsertBulk()
+{
+	Session tmp (Poco::Data::SQLite::Connector::KEY, "dummy.db");
+	tmp << "DROP TABLE IF EXISTS Strings", now;
+	tmp << "CREATE TABLE IF NOT EXISTS Strings (i INTEGER UNIQUE, str VARCHAR(30))", now;
+
+	std::vector<int> ints;
+	std::vector<std::string> strings;
+	for (int i = 0; i < 100; ++i)
+	{
+		ints.push_back(i);
+		strings.push_back(format("%d", i));
+	}
+
+	Statement stmt((tmp << "INSERT INTO Strings VALUES(?, ?)", use(ints, bulk), use(strings, bulk)));
+	assert (100 == stmt.execute());
+	assert (tmp.getFeature("autoCommit"));
+
+	int count = 0;
+	tmp << "SELECT COUNT(*) FROM Strings", into(count), now;
+	assert (count == 100);
+	tmp << "SELECT SUM(i) FROM Strings", into(count), now;
+	assert (count == ((0+99)*100/2));
+	std::string str;
+	tmp << "SELECT str FROM Strings WHERE i = 42", into(str), now;
+	assert ("42" == str);
+
+	tmp << "DELETE FROM Strings", now;
+	for (int i = 0; i < 100; ++i) ints[i] = i + 100;
+	stmt.execute();
+	tmp << "SELECT COUNT(*) FROM Strings", into(count), now;
+	assert (count == 100);
+	tmp << "SELECT MIN(i) FROM Strings", into(count), now;
+	assert (count == 100);
+
+	// a failing row rolls back the whole implicit transaction
+	tmp << "DELETE FROM Strings", now;
+	ints[99] = ints[0];
+	try
+	{
+		tmp << "INSERT INTO Strings VALUES(?, ?)", use(ints, bulk), use(strings, bulk), now;
+		fail ("must fail");
+	}
+	catch (ConstraintViolationException&) { }
+	assert (tmp.getFeature("autoCommit"));
+	tmp << "SELECT COUNT(*) FROM Strings", into(count), now;
+	assert (count == 0);
+
+	// without bulk, every row is committed on its own
+	try
+	{
+		tmp << "INSERT INTO Strings VALUES(?, ?)", use(ints), use(strings), now;
+		fail ("must fail");
+	}
+	catch (ConstraintViolationException&) { }
+	assert (tmp.getFeature("autoCommit"));
+	tmp << "SELECT COUNT(*) FROM Strings", into(count), now;
+	assert (count == 99);
+	tmp << "DELETE FROM Strings", now;
+
+	// an explicit transaction is left to the caller
+	ints[99] = 199;
+	tmp.begin();
+	tmp << "INSERT INTO Strings VALUES(?, ?)", use(ints, bulk), use(strings, bulk), now;
+	assert (tmp.isTransaction());
+	tmp.rollback();
+	tmp << "SELECT COUNT(*) FROM Strings", into(count), now;
+	assert (count == 0);
+
+	std::vector<int> result;
+	try
+	{
+		tmp << "SELECT i FROM Strings", into(result, bulk(10)), now;
+		fail ("must fail");
+	}
+	catch (InvalidAccessException&) { }
+}
+
+
+void SQLiteTest::benchmarkBulkInsert()
+{
+	const int rows = 10000;
+	std::vector<int> ints;
+	std::vector<std::string> strings;
+	for (int i = 0; i < rows; ++i)
+	{
+		ints.push_back(i);
+		strings.push_back(format("row %d", i));
+	}
+
+	Session tmp (Poco::Data::SQLite::Connector::KEY, "dummy.db");
+	tmp << "DROP TABLE IF EXISTS Strings", now;
+	tmp << "CREATE TABLE Strings (i INTEGER, str VARCHAR(30))", now;
+
+	Poco::Stopwatch sw;
+	int i = 0;
+	std::string str;
+	Statement single((tmp << "INSERT INTO Strings VALUES(?, ?)", use(i), use(str)));
+	sw.start();
+	for (; i < rows; ++i)
+	{
+		str = strings[i];
+		single.execute();
+	}
+	sw.stop();
+	std::cout << "Row-at-a-time (autocommit): " << rows << " rows, " << sw.elapsed() / 1000.0 << " [ms]" << std::endl;
+
+	tmp << "DELETE FROM Strings", now;
+	sw.restart();
+	tmp << "INSERT INTO Strings VALUES(?, ?)", use(ints), use(strings), now;
+	sw.stop();
+	std::cout << "Vector binding:             " << rows << " rows, " << sw.elapsed() / 1000.0 << " [ms]" << std::endl;
+
+	tmp << "DELETE FROM Strings", now;
+	sw.restart();
+	tmp << "INSERT INTO Strings VALUES(?, ?)", use(ints, bulk), use(strings, bulk), now;
+	sw.stop();
+	std::cout << "Bulk binding:               " << rows << " rows, " << sw.elapsed() / 1000.0 << " [ms]" << std::endl;
+
+	int count = 0;
+	tmp << "SELECT COUNT(*) FROM Strings", into(count), now;
+	assert (count == rows);
+}
+
+
 void SQLiteTest::testLimit()
 {
 	Session tmp (Poco::Data::SQLite::Connector::KEY, "dummy.db");
@@ -1404,6 +1546,54 @@ void SQLiteTest::testCLOB()
 }
 
 
+void SQLiteTest::testBLOBStream()
+{
+	Session tmp (Poco::Data::SQLite::Connector::KEY, "dummy.db");
+	tmp << "DROP TABLE IF EXISTS Images", now;
+	tmp << "CREATE TABLE Images (Name VARCHAR(30), Data BLOB)", now;
+
+	std::string data;
+	for (int i = 0; i < 100000; ++i) data += static_cast<char>(i % 251);
+	Poco::Data::BLOB img(reinterpret_cast<const unsigned char*>(data.data()), data.size());
+	tmp << "INSERT INTO Images VALUES('image', ?)", use(img), now;
+	Poco::Int64 rowID = 0;
+	tmp << "SELECT rowid FROM Images WHERE Name = 'image'", into(rowID), now;
+
+	BLOBStream blob(tmp, "Images", "Data", rowID, "main", 1024);
+	assert (data.size() == blob.size());
+	std::ostringstream ostr;
+	assert (data.size() == Poco::StreamCopier::copyStream(blob, ostr));
+	assert (ostr.str() == data);
+	assert (blob.eof());
+
+	BLOBStream chunked(tmp, "Images", "Data", rowID);
+	assert (data[0] == static_cast<char>(chunked.get()));
+	assert (data[1] == static_cast<char>(chunked.peek()));
+	std::vector<char> buffer(60000);
+	chunked.read(&buffer[0], buffer.size());
+	assert (buffer.size() == chunked.gcount());
+	assert (0 == data.compare(1, buffer.size(), &buffer[0], buffer.size()));
+	chunked.read(&buffer[0], buffer.size());
+	assert (data.size() - 1 - buffer.size() == chunked.gcount());
+	assert (0 == data.compare(1 + buffer.size(), chunked.gcount(), &buffer[0], chunked.gcount()));
+	assert (chunked.eof());
+
+	tmp << "INSERT INTO Images VALUES('text', 'hello, world')", now;
+	tmp << "SELECT rowid FROM Images WHERE Name = 'text'", into(rowID), now;
+	BLOBStream text(tmp, "Images", "Data", rowID);
+	std::string str;
+	Poco::StreamCopier::copyToString(text, str);
+	assert ("hello, world" == str);
+
+	try
+	{
+		BLOBStream bad(tmp, "Images", "NoSuchColumn", rowID);
+		fail ("must fail");
+	}
+	catch (Poco::Data::SQLite::SQLiteException&) { }
+}
+
+
 void SQLiteTest::testTuple10()
 {
 	Session tmp (Poco::Data::SQLite::Connector::KEY, "dummy.db");
@@ -2153,6 +2343,245 @@ void SQLiteTest::testRowIterator()
 }
 
 
+void SQLiteTest::testColumnData()
+{
+	Session ses (Poco::Data::SQLite::Connector::KEY, "dummy.db");
+	ses << "DROP TABLE IF EXISTS Vectors", now;
+	ses << "CREATE TABLE Vectors (int0 INTEGER, flt0 REAL, str0 VARCHAR)", now;
+
+	std::vector<Tuple<int, double, std::string> > v;
+	v.push_back(Tuple<int, double, std::string>(1, 1.5, "3"));
+	v.push_back(Tuple<int, double, std::string>(2, 2.5, "4"));
+	v.push_back(Tuple<int, double, std::string>(3, 3.5, "5"));
+	ses << "INSERT INTO Vectors VALUES (?,?,?)", use(v), now;
+	ses << "INSERT INTO Vectors VALUES (4, NULL, NULL)", now;
+
+	Statement dqStmt = (ses << "SELECT * FROM Vectors", now);
+	RecordSet dqSet(dqStmt);
+	assert (Statement::STORAGE_DEQUE == dqSet.storage());
+	try
+	{
+		dqSet.columnData<int>(0);
+		fail ("must fail");
+	}
+	catch (InvalidAccessException&) { }
+
+	Statement stmt = (ses << "SELECT * FROM Vectors", vector, now);
+	RecordSet rset(stmt);
+
+	const std::vector<int>& ints = rset.columnData<int>(0);
+	const std::vector<double>& dbls = rset.columnData<double>("flt0");
+	const std::vector<std::string>& strs = rset.columnData<std::string>(2);
+	assert (4 == ints.size() && 4 == dbls.size() && 4 == strs.size());
+	assert (&ints[0] == &rset.value<int>(0, 0));
+	for (int i = 0; i < 3; ++i)
+	{
+		assert (i + 1 == ints[i]);
+		assert (i + 1.5 == dbls[i]);
+		assert (!rset.isNull(1, i));
+	}
+	assert (4 == ints[3]);
+	assert (rset.isNull(1, 3));
+	assert (rset.isNull(2, 3));
+
+	const std::vector<bool>& intNulls = rset.nullBitmap(0);
+	const std::vector<bool>& dblNulls = rset.nullBitmap("flt0");
+	assert (4 == intNulls.size() && 4 == dblNulls.size());
+	for (int i = 0; i < 4; ++i)
+	{
+		assert (!intNulls[i]);
+		assert (dblNulls[i] == rset.isNull(1, i));
+	}
+	assert (dblNulls[3]);
+	assert (rset.nullBitmap(2) == dqSet.nullBitmap(2));
+	try
+	{
+		rset.nullBitmap(3);
+		fail ("must fail");
+	}
+	catch (RangeException&) { }
+
+	try
+	{
+		rset.columnData<std::string>(0);
+		fail ("must fail");
+	}
+	catch (BadCastException&) { }
+
+	// session storage setting is honored as well
+	ses.setProperty("storage", std::string("vector"));
+	RecordSet sesSet(ses, "SELECT * FROM Vectors");
+	assert (Statement::STORAGE_VECTOR == sesSet.storage());
+	assert (4 == sesSet.columnData<int>("int0").size());
+	assert (2 == sesSet.value<int>(0, 1));
+	ses.setProperty("storage", std::string("deque"));
+
+	std::ostringstream osCached;
+	osCached << rset;
+
+	rset.setRowCaching(false);
+	assert (!rset.getRowCaching());
+	RecordSet::Iterator it = rset.begin();
+	RecordSet::Iterator end = rset.end();
+	Row* pRow = &(*it);
+	for (int i = 1; it != end; ++it, ++i)
+	{
+		assert (&(*it) == pRow);
+		assert (it->get(0) == i);
+	}
+	assert (pRow->get(1).isEmpty());
+
+	std::ostringstream osTransient;
+	osTransient << rset;
+	assert (osCached.str() == osTransient.str());
+}
+
+
+void SQLiteTest::testCursor()
+{
+	Session ses (Poco::Data::SQLite::Connector::KEY, "dummy.db");
+	ses << "DROP TABLE IF EXISTS Ints", now;
+	ses << "CREATE TABLE Ints (i INTEGER, str VARCHAR)", now;
+
+	const int total = 2500;
+	std::vector<int> ints;
+	for (int i = 0; i < total; ++i) ints.push_back(i);
+	ses << "INSERT INTO Ints (i) VALUES (?)", use(ints), now;
+	ses << "UPDATE Ints SET str = 'x' WHERE i % 2 = 0", now;
+
+	Cursor cursor(ses, "SELECT i, str FROM Ints ORDER BY i", 1000);
+	assert (1000 == cursor.batchSize());
+	try
+	{
+		cursor.batch();
+		fail ("must fail");
+	}
+	catch (InvalidAccessException&) { }
+
+	int count = 0;
+	while (cursor.next())
+	{
+		assert (cursor.batchRowCount() <= 1000);
+		assert (cursor.batch().extractedRowCount() == cursor.batchRowCount());
+		assert (count == cursor.position());
+		assert (count == cursor.value<int>(0));
+		assert (count == cursor["i"]);
+		assert ((count % 2 != 0) == cursor.isNull(1));
+		if (count % 2 == 0) assert ("x" == cursor.value<std::string>("str"));
+		++count;
+	}
+	assert (total == count);
+	assert (!cursor.next());
+	assert (!cursor.fetch());
+
+	Cursor batches(ses, "SELECT i FROM Ints", 700);
+	int nBatches = 0;
+	Poco::Int64 sum = 0;
+	while (batches.fetch())
+	{
+		++nBatches;
+		const std::vector<int>& data = batches.batch().columnData<int>(0);
+		assert (data.size() == batches.batchRowCount());
+		for (std::vector<int>::const_iterator it = data.begin(); it != data.end(); ++it)
+			sum += *it;
+	}
+	assert (4 == nBatches);
+	assert (Poco::Int64(total)*(total - 1)/2 == sum);
+
+	int lower = total - 10;
+	Statement stmt = (ses << "SELECT i FROM Ints WHERE i >= ?", use(lower));
+	Cursor bound(stmt, 3);
+	count = 0;
+	while (bound.next()) assert (lower + count++ == bound.value<int>(0));
+	assert (10 == count);
+
+	Cursor empty(ses, "SELECT i FROM Ints WHERE i < 0");
+	assert (!empty.next());
+
+	int i = 0;
+	Statement intoStmt = (ses << "SELECT i FROM Ints", into(i));
+	try
+	{
+		Cursor c(intoStmt);
+		fail ("must fail");
+	}
+	catch (InvalidArgumentException&) { }
+
+	try
+	{
+		Cursor c(ses, "SELECT i FROM Ints", 0);
+		fail ("must fail");
+	}
+	catch (InvalidArgumentException&) { }
+}
+
+
+void SQLiteTest::testRecordSetExporter()
+{
+	Session tmp (Poco::Data::SQLite::Connector::KEY, "dummy.db");
+	tmp << "DROP TABLE IF EXISTS Export", now;
+	tmp << "CREATE TABLE Export (id INTEGER, name VARCHAR, value REAL, data BLOB)", now;
+	tmp << "INSERT INTO Export VALUES (1, 'plain', 1.5, x'666f6f')", now;
+	tmp << "INSERT INTO Export VALUES (2, 'a, \"b\"', NULL, NULL)", now;
+	tmp << "INSERT INTO Export VALUES (3, 'line' || char(10) || 'break', -2.0, NULL)", now;
+
+	RecordSet rs(tmp, "SELECT * FROM Export ORDER BY id");
+	RecordSetExporter csv;
+	std::ostringstream csvStr;
+	assert (3 == csv.exportTo(rs, csvStr));
+	assert (csvStr.str() ==
+		"id,name,value,data\n"
+		"1,plain,1.5,Zm9v\n"
+		"2,\"a, \"\"b\"\"\",,\n"
+		"3,\"line\nbreak\",-2,\n");
+
+	csv.setDelimiter(';');
+	csv.setHeader(false);
+	csv.setNullValue("NULL");
+	csvStr.str("");
+	csv.exportTo(rs, csvStr);
+	assert (csvStr.str() ==
+		"1;plain;1.5;Zm9v\n"
+		"2;\"a, \"\"b\"\"\";NULL;NULL\n"
+		"3;\"line\nbreak\";-2;NULL\n");
+
+	RecordSetExporter json(RecordSetExporter::FORMAT_JSON_LINES);
+	std::ostringstream jsonStr;
+	assert (3 == json.exportTo(rs, jsonStr));
+	assert (jsonStr.str() ==
+		"{\"id\":1,\"name\":\"plain\",\"value\":1.5,\"data\":\"Zm9v\"}\n"
+		"{\"id\":2,\"name\":\"a, \\\"b\\\"\",\"value\":null,\"data\":null}\n"
+		"{\"id\":3,\"name\":\"line\\nbreak\",\"value\":-2,\"data\":null}\n");
+
+	tmp << "DELETE FROM Export", now;
+	std::vector<int> ids;
+	for (int i = 0; i < 1000; ++i) ids.push_back(i);
+	tmp << "INSERT INTO Export (id, name) VALUES (?, 'row')", use(ids), now;
+	RecordSet all(tmp, "SELECT id, name FROM Export ORDER BY id");
+
+	std::ostringstream sequential;
+	json.exportTo(all, sequential);
+	json.setThreads(3);
+	json.setChunkSize(64);
+	assert (3 == json.getThreads());
+	std::ostringstream parallel;
+	assert (1000 == json.exportTo(all, parallel));
+	assert (sequential.str() == parallel.str());
+	assert (0 == parallel.str().find("{\"id\":0,\"name\":\"row\"}\n{\"id\":1,"));
+
+	Statement listStmt = (tmp << "SELECT id, name FROM Export ORDER BY id", list, now);
+	RecordSet listed(listStmt);
+	assert (Statement::STORAGE_LIST == listed.storage());
+	std::ostringstream listParallel;
+	assert (1000 == json.exportTo(listed, listParallel));
+	assert (sequential.str() == listParallel.str());
+	json.setThreads(1);
+	std::ostringstream listSequential;
+	json.exportTo(listed, listSequential);
+	assert (sequential.str() == listSequential.str());
+}
+
+
 void SQLiteTest::testAsync()
 {
 	Session tmp (Poco::Data::SQLite::Connector::KEY, "dummy.db");
@@ -2237,6 +2666,158 @@ void SQLiteTest::testAsync()
 }
 
 
+namespace
+{
+	class CountJob: public AsyncExecutor::Job
+	{
+	public:
+		CountJob(int& count): _count(count)
+		{
+		}
+
+		std::size_t execute(Session& session)
+		{
+			session << "SELECT COUNT(*) FROM Strings", into(_count), now;
+			return 1;
+		}
+
+	private:
+		int& _count;
+	};
+
+	class BlockingJob: public AsyncExecutor::Job
+	{
+	public:
+		BlockingJob(Poco::Semaphore& started, Poco::Event& release):
+			_started(started),
+			_release(release)
+		{
+		}
+
+		std::size_t execute(Session& session)
+		{
+			_started.set();
+			_release.wait();
+			return 1;
+		}
+
+	private:
+		Poco::Semaphore& _started;
+		Poco::Event& _release;
+	};
+}
+
+
+void SQLiteTest::testAsyncExecutor()
+{
+	Session tmp (Poco::Data::SQLite::Connector::KEY, "dummy.db");
+	tmp << "DROP TABLE IF EXISTS Strings", now;
+	tmp << "CREATE TABLE IF NOT EXISTS Strings (str INTEGER(10) UNIQUE)", now;
+
+	// pooled SQLite sessions do not wait for locks held by other
+	// connections, so a single worker is used for the writes
+	SessionPool pool(Poco::Data::SQLite::Connector::KEY, "dummy.db", 1, 4);
+	AsyncExecutor executor(pool, 1, 8);
+	assert (1 == executor.workers());
+	assert (8 == executor.maxBatch());
+
+	const int rowCount = 100;
+	AsyncExecutor::ResultVec results;
+	for (int i = 0; i < rowCount; ++i)
+		results.push_back(executor.execute(format("INSERT INTO Strings VALUES(%d)", i)));
+	assert (rowCount == AsyncExecutor::waitAll(results));
+	executor.wait();
+	assert (0 == executor.pending());
+	assert (rowCount == executor.executed());
+	assert (executor.batches() <= executor.executed());
+	assert (pool.used() <= 1);
+
+	int count = 0;
+	tmp << "SELECT COUNT(*) FROM Strings", into(count), now;
+	assert (rowCount == count);
+
+	AsyncExecutor::SQLVec batch;
+	batch.push_back("INSERT INTO Strings VALUES(1000)");
+	batch.push_back("INSERT INTO Strings VALUES(1001)");
+	AsyncExecutor::Result result = executor.execute(batch, true);
+	result.wait();
+	assert (2 == result.data());
+
+	batch.push_back("INSERT INTO Strings VALUES(0)");
+	batch[0] = "INSERT INTO Strings VALUES(1002)";
+	batch[1] = "INSERT INTO Strings VALUES(1003)";
+	result = executor.execute(batch, true);
+	result.wait();
+	assert (result.failed());
+	assert (0 != dynamic_cast<ConstraintViolationException*>(result.exception()));
+
+	results.clear();
+	results.push_back(executor.execute("INSERT INTO Strings VALUES(1004)"));
+	results.push_back(executor.execute("INSERT INTO Strings VALUES(1)"));
+	try
+	{
+		AsyncExecutor::waitAll(results);
+		fail ("must fail");
+	}
+	catch (ConstraintViolationException&) { }
+	assert (results[0].available() && !results[0].failed());
+
+	result = executor.execute(new CountJob(count));
+	result.wait();
+	assert (1 == result.data());
+	assert (rowCount + 3 == count);
+
+	// more workers than sessions, the workers wait for each other
+	SessionPool smallPool(Poco::Data::SQLite::Connector::KEY, "dummy.db", 1, 1);
+	AsyncExecutor crowded(smallPool, 4, 1);
+	results.clear();
+	for (int i = 0; i < 20; ++i)
+		results.push_back(crowded.execute(new CountJob(count)));
+	assert (20 == AsyncExecutor::waitAll(results));
+	assert (rowCount + 3 == count);
+	// the results are available before the session is returned
+	crowded.wait();
+
+	// a worker waits for a session only as long as configured
+	{
+		AsyncExecutor impatient(smallPool, 1, 1, 100);
+		assert (100 == impatient.sessionTimeout());
+		Session held(smallPool.get());
+		result = impatient.execute(new CountJob(count));
+		result.wait();
+		assert (result.failed());
+		assert (0 != dynamic_cast<SessionPoolExhaustedException*>(result.exception()));
+	}
+
+	// a burst of jobs is shared among the idle workers
+	{
+		SessionPool burstPool(Poco::Data::SQLite::Connector::KEY, "dummy.db", 1, 4);
+		AsyncExecutor burst(burstPool, 4, 16);
+		Poco::Semaphore started(0, 16);
+		Poco::Event release(false);
+		results.clear();
+		for (int i = 0; i < 16; ++i)
+			results.push_back(burst.execute(new BlockingJob(started, release)));
+		// every worker starts a job before any job completes
+		int running = 0;
+		while (running < 4 && started.tryWait(10000)) ++running;
+		release.set();
+		assert (16 == AsyncExecutor::waitAll(results));
+		assert (4 == running);
+		assert (burst.batches() >= 4);
+	}
+
+	executor.stop();
+	assert (0 == executor.workers());
+	try
+	{
+		executor.execute("DELETE FROM Strings");
+		fail ("must fail");
+	}
+	catch (InvalidAccessException&) { }
+}
+
+
 void SQLiteTest::testAny()
 {
 	Session tmp (Poco::Data::SQLite::Connector::KEY, "dummy.db");
@@ -2398,6 +2979,115 @@ void SQLiteTest::testSQLChannel()
 }
 
 
+void SQLiteTest::testSQLChannelBatch()
+{
+	Session tmp (Poco::Data::SQLite::Connector::KEY, "dummy.db");
+	tmp << "DROP TABLE IF EXISTS T_POCO_LOG", now;
+	tmp << "CREATE TABLE T_POCO_LOG (Source VARCHAR,"
+		"Name VARCHAR,"
+		"ProcessId INTEGER,"
+		"Thread VARCHAR, "
+		"ThreadId INTEGER," 
+		"Priority INTEGER,"
+		"Text VARCHAR,"
+		"DateTime DATE)", now;
+
+	AutoPtr<SQLChannel> pChannel = new SQLChannel(Poco::Data::SQLite::Connector::KEY, "dummy.db", "TestSQLChannel");
+	pChannel->setProperty("flush", "60000");
+	pChannel->setProperty("capacity", "150");
+	pChannel->setProperty("bulk", "1000");
+	assert ("1000" == pChannel->getProperty("bulk"));
+	assert ("60000" == pChannel->getProperty("flush"));
+	assert ("150" == pChannel->getProperty("capacity"));
+
+	for (int i = 0; i < 200; ++i)
+	{
+		Message msg("BatchSource", Poco::format("%03d batch message", i), Message::PRIO_INFORMATION);
+		pChannel->log(msg);
+	}
+	assert (150 == pChannel->backlog());
+	assert (50 == pChannel->dropped());
+	assert (0 == pChannel->logged());
+
+	int count = 0;
+	tmp << "SELECT COUNT(*) FROM T_POCO_LOG", into(count), now;
+	assert (0 == count);
+
+	assert (150 == pChannel->flush());
+	assert (0 == pChannel->backlog());
+	assert (150 == pChannel->logged());
+	tmp << "SELECT COUNT(*) FROM T_POCO_LOG", into(count), now;
+	assert (150 == count);
+
+	RecordSet rs(tmp, "SELECT * FROM T_POCO_LOG ORDER by Text");
+	assert ("BatchSource" == rs["Source"]);
+	assert ("TestSQLChannel" == rs["Name"]);
+	assert ("000 batch message" == rs["Text"]);
+	assert (Message::PRIO_INFORMATION == rs["Priority"]);
+	rs.moveLast();
+	assert ("149 batch message" == rs["Text"]);
+
+	// reaching the bulk size wakes the flush thread
+	pChannel->setProperty("bulk", "10");
+	for (int i = 0; i < 10; ++i)
+	{
+		Message msg("BatchSource", Poco::format("%03d batch message", 200 + i), Message::PRIO_WARNING);
+		pChannel->log(msg);
+	}
+	for (int i = 0; i < 100 && pChannel->logged() < 160; ++i) Thread::sleep(50);
+	assert (160 == pChannel->logged());
+	tmp << "SELECT COUNT(*) FROM T_POCO_LOG", into(count), now;
+	assert (160 == count);
+
+	// remaining entries are inserted on close
+	Message msg("BatchSource", "zzz last message", Message::PRIO_ERROR);
+	pChannel->log(msg);
+	pChannel->close();
+	assert (161 == pChannel->logged());
+	tmp << "SELECT COUNT(*) FROM T_POCO_LOG", into(count), now;
+	assert (161 == count);
+
+	pChannel->setProperty("bulk", "0");
+	pChannel->setProperty("async", "false");
+	pChannel->log(msg);
+	tmp << "SELECT COUNT(*) FROM T_POCO_LOG", into(count), now;
+	assert (162 == count);
+}
+
+
+void SQLiteTest::testSQLChannelBatchReconnect()
+{
+	Session tmp (Poco::Data::SQLite::Connector::KEY, "dummy.db");
+	tmp << "DROP TABLE IF EXISTS T_POCO_LOG", now;
+	tmp << "CREATE TABLE T_POCO_LOG (Source VARCHAR,"
+		"Name VARCHAR,"
+		"ProcessId INTEGER,"
+		"Thread VARCHAR, "
+		"ThreadId INTEGER," 
+		"Priority INTEGER,"
+		"Text VARCHAR,"
+		"DateTime DATE)", now;
+
+	AutoPtr<SQLChannel> pChannel = new SQLChannel(Poco::Data::SQLite::Connector::KEY, "dummy.db", "TestSQLChannel");
+	pChannel->setProperty("flush", "100");
+	pChannel->setProperty("bulk", "1000");
+	// reconnecting must keep the flush thread running
+	pChannel->setProperty("connect", "dummy.db");
+
+	for (int i = 0; i < 5; ++i)
+	{
+		Message msg("BatchSource", Poco::format("%03d batch message", i), Message::PRIO_INFORMATION);
+		pChannel->log(msg);
+	}
+	for (int i = 0; i < 100 && pChannel->logged() < 5; ++i) Thread::sleep(50);
+	assert (5 == pChannel->logged());
+	assert (0 == pChannel->backlog());
+	int count = 0;
+	tmp << "SELECT COUNT(*) FROM T_POCO_LOG", into(count), now;
+	assert (5 == count);
+}
+
+
 void SQLiteTest::testSQLLogger()
 {
 	Session tmp (Poco::Data::SQLite::Connector::KEY, "dummy.db");
@@ -3293,6 +3983,142 @@ void SQLiteTest::testTransactor()
 	assert (!session.isConnected());
 }
 
+void SQLiteTest::testStatementCache()
+{
+	Session session (Poco::Data::SQLite::Connector::KEY, "dummy.db");
+	assert (session.isConnected());
+
+	session << "DROP TABLE IF EXISTS Person", now;
+	session << "CREATE TABLE IF NOT EXISTS Person (LastName VARCHAR(30), FirstName VARCHAR, Address VARCHAR, Age INTEGER(3))", now;
+
+	assert (32 == AnyCast<std::size_t>(session.getProperty("statementCacheSize")));
+	std::size_t hits = AnyCast<std::size_t>(session.getProperty("statementCacheHits"));
+
+	std::string lastName("Simpson");
+	for (int i = 0; i < 10; ++i)
+	{
+		session << "INSERT INTO Person VALUES (?, 'Bart', 'Springfield', ?)", use(lastName), use(i), now;
+	}
+	assert (AnyCast<std::size_t>(session.getProperty("statementCacheHits")) == hits + 9);
+
+	int count = 0;
+	Statement stmt = (session << "SELECT COUNT(*) FROM Person", into(count));
+	stmt.execute();
+	assert (10 == count);
+	session << "DELETE FROM Person WHERE Age < 5", now;
+	stmt.execute();
+	assert (5 == count);
+
+	// statements with the same SQL text can be used simultaneously
+	int count2 = 0;
+	Statement stmt2 = (session << "SELECT COUNT(*) FROM Person", into(count2));
+	stmt2.execute();
+	stmt.execute();
+	assert (5 == count && 5 == count2);
+
+	try
+	{
+		session.setProperty("statementCacheHits", std::size_t(0));
+		fail ("must fail");
+	}
+	catch (NotImplementedException&) { }
+
+	session.setProperty("statementCacheSize", std::size_t(0));
+	hits = AnyCast<std::size_t>(session.getProperty("statementCacheHits"));
+	session << "SELECT COUNT(*) FROM Person", into(count), now;
+	session << "SELECT COUNT(*) FROM Person", into(count), now;
+	assert (AnyCast<std::size_t>(session.getProperty("statementCacheHits")) == hits);
+
+	session.setProperty("statementCacheSize", std::size_t(1));
+	session << "SELECT COUNT(*) FROM Person", into(count), now;
+	std::size_t evictions = AnyCast<std::size_t>(session.getProperty("statementCacheEvictions"));
+	session << "SELECT Age FROM Person LIMIT 1", into(count), now;
+	assert (AnyCast<std::size_t>(session.getProperty("statementCacheEvictions")) == evictions + 1);
+
+	session.close();
+	session.open();
+	session << "SELECT COUNT(*) FROM Person", into(count), now;
+	assert (5 == count);
+
+	SessionPool pool(Poco::Data::SQLite::Connector::KEY, "dummy.db", 1, 1);
+	{
+		Session s1(pool.get());
+		s1 << "SELECT COUNT(*) FROM Person", into(count), now;
+	}
+	{
+		Session s2(pool.get());
+		hits = AnyCast<std::size_t>(s2.getProperty("statementCacheHits"));
+		s2 << "SELECT COUNT(*) FROM Person", into(count), now;
+		assert (AnyCast<std::size_t>(s2.getProperty("statementCacheHits")) == hits + 1);
+		assert (5 == count);
+	}
+}
+
+
+void SQLiteTest::testPreparedStatements()
+{
+	Session tmp (Poco::Data::SQLite::Connector::KEY, "dummy.db");
+	tmp << "DROP TABLE IF EXISTS Person", now;
+	tmp << "CREATE TABLE IF NOT EXISTS Person (LastName VARCHAR(30), FirstName VARCHAR, Address VARCHAR, Age INTEGER(3))", now;
+	tmp << "INSERT INTO Person VALUES ('Simpson', 'Bart', 'Springfield', 10)", now;
+
+	int count = 0;
+	Statement stmt = (tmp << "SELECT COUNT(*) FROM Person", into(count));
+	assert (stmt.initialized());
+	stmt.prepare();
+	assert (stmt.prepared());
+	assert (!stmt.initialized());
+	assert (0 == count);
+	stmt.execute();
+	assert (1 == count);
+	assert (!stmt.prepared());
+	try
+	{
+		stmt.prepare();
+		fail ("must fail");
+	}
+	catch (InvalidAccessException&) { }
+
+	const std::string countSQL("SELECT COUNT(*) FROM Person WHERE Age > ?");
+	const std::string ageSQL("SELECT Age FROM Person WHERE LastName = ?");
+	SessionPool pool(Poco::Data::SQLite::Connector::KEY, "dummy.db", 2, 3);
+	pool.addStatement(countSQL);
+	pool.addStatement(ageSQL);
+	assert (2 == pool.warmUp());
+	assert (2 == pool.idle());
+	{
+		Session s1(pool.get());
+		Session s2(pool.get());
+		// the registered statements were prepared by each new session
+		std::size_t hits = AnyCast<std::size_t>(s1.getProperty("statementCacheHits"));
+		std::size_t misses = AnyCast<std::size_t>(s1.getProperty("statementCacheMisses"));
+		int age = 5;
+		s1 << countSQL, use(age), into(count), now;
+		assert (1 == count);
+		std::string lastName("Simpson");
+		s2 << ageSQL, use(lastName), into(age), now;
+		assert (10 == age);
+		s1 << ageSQL, use(lastName), into(age), now;
+		assert (AnyCast<std::size_t>(s1.getProperty("statementCacheHits")) == hits + 2);
+		assert (AnyCast<std::size_t>(s1.getProperty("statementCacheMisses")) == misses);
+
+		Session s3(pool.get());
+		hits = AnyCast<std::size_t>(s3.getProperty("statementCacheHits"));
+		s3 << countSQL, use(age), into(count), now;
+		assert (AnyCast<std::size_t>(s3.getProperty("statementCacheHits")) == hits + 1);
+	}
+
+	SessionPool badPool(Poco::Data::SQLite::Connector::KEY, "dummy.db", 2, 3);
+	badPool.addStatement("SELECT * FROM NoSuchTable");
+	try
+	{
+		badPool.warmUp();
+		fail ("must fail");
+	}
+	catch (Poco::Exception&) { }
+	assert (0 == badPool.allocated());
+}
+
 
 void SQLiteTest::setUp()
 {
@@ -3323,6 +4149,8 @@ CppUnit::Test* SQLiteTest::suite()
 	CppUnit_addTest(pSuite, SQLiteTest, testAffectedRows);
 	CppUnit_addTest(pSuite, SQLiteTest, testInsertSingleBulk);
 	CppUnit_addTest(pSuite, SQLiteTest, testInsertSingleBulkVec);
+	CppUnit_addTest(pSuite, SQLiteTest, testInsertBulk);
+//	CppUnit_addTest(pSuite, SQLiteTest, benchmarkBulkInsert);
 	CppUnit_addTest(pSuite, SQLiteTest, testLimit);
 	CppUnit_addTest(pSuite, SQLiteTest, testLimitOnce);
 	CppUnit_addTest(pSuite, SQLiteTest, testLimitPrepare);
@@ -3348,6 +4176,7 @@ CppUnit::Test* SQLiteTest::suite()
 	CppUnit_addTest(pSuite, SQLiteTest, testSingleSelect);
 	CppUnit_addTest(pSuite, SQLiteTest, testEmptyDB);
 	CppUnit_addTest(pSuite, SQLiteTest, testCLOB);
+	CppUnit_addTest(pSuite, SQLiteTest, testBLOBStream);
 	CppUnit_addTest(pSuite, SQLiteTest, testTuple10);
 	CppUnit_addTest(pSuite, SQLiteTest, testTupleVector10);
 	CppUnit_addTest(pSuite, SQLiteTest, testTuple9);
@@ -3374,10 +4203,16 @@ CppUnit::Test* SQLiteTest::suite()
 	CppUnit_addTest(pSuite, SQLiteTest, testNullable);
 	CppUnit_addTest(pSuite, SQLiteTest, testNull);
 	CppUnit_addTest(pSuite, SQLiteTest, testRowIterator);
+	CppUnit_addTest(pSuite, SQLiteTest, testColumnData);
+	CppUnit_addTest(pSuite, SQLiteTest, testCursor);
+	CppUnit_addTest(pSuite, SQLiteTest, testRecordSetExporter);
 	CppUnit_addTest(pSuite, SQLiteTest, testAsync);
+	CppUnit_addTest(pSuite, SQLiteTest, testAsyncExecutor);
 	CppUnit_addTest(pSuite, SQLiteTest, testAny);
 	CppUnit_addTest(pSuite, SQLiteTest, testDynamicAny);
 	CppUnit_addTest(pSuite, SQLiteTest, testSQLChannel);
+	CppUnit_addTest(pSuite, SQLiteTest, testSQLChannelBatch);
+	CppUnit_addTest(pSuite, SQLiteTest, testSQLChannelBatchReconnect);
 	CppUnit_addTest(pSuite, SQLiteTest, testSQLLogger);
 	CppUnit_addTest(pSuite, SQLiteTest, testExternalBindingAndExtraction);
 	CppUnit_addTest(pSuite, SQLiteTest, testBindingCount);
@@ -3392,6 +4227,8 @@ CppUnit::Test* SQLiteTest::suite()
 	CppUnit_addTest(pSuite, SQLiteTest, testSessionTransaction);
 	CppUnit_addTest(pSuite, SQLiteTest, testTransaction);
 	CppUnit_addTest(pSuite, SQLiteTest, testTransactor);
+	CppUnit_addTest(pSuite, SQLiteTest, testStatementCache);
+	CppUnit_addTest(pSuite, SQLiteTest, testPreparedStatements);
 
 	return pSuite;
 }
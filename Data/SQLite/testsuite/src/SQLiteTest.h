@@ -69,6 +69,8 @@ public:
 	void testAffectedRows();
 	void testInsertSingleBulk();
 	void testInsertSingleBulkVec();
+	void testInsertBulk();
+	void benchmarkBulkInsert();
 
 	void testLimit();
 	void testLimitOnce();
@@ -97,6 +99,7 @@ public:
 	void testEmptyDB();
 
 	void testCLOB();
+	void testBLOBStream();
 
 	void testTuple1();
 	void testTupleVector1();
@@ -126,13 +129,19 @@ public:
 	void testNullable();
 	void testNull();
 	void testRowIterator();
+	void testColumnData();
+	void testCursor();
+	void testRecordSetExporter();
 	void testAsync();
+	void testAsyncExecutor();
 
 	void testAny();
 	void testDynamicAny();
 	void testPair();
 
 	void testSQLChannel();
+	void testSQLChannelBatch();
+	void testSQLChannelBatchReconnect();
 	void testSQLLogger();
 
 	void testExternalBindingAndExtraction();
@@ -151,6 +160,8 @@ public:
 	void testSessionTransaction();
 	void testTransaction();
 	void testTransactor();
+	void testStatementCache();
+	void testPreparedStatements();
 
 	void setUp();
 	void tearDown();
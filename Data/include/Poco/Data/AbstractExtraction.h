@@ -126,6 +126,12 @@ public:
 		/// null values and be able to later provide information about them.
 		/// Here, this function throws NotImplementedException.
 
+	virtual const std::vector<bool>& nulls() const;
+		/// In implementations, this function returns the null indicators
+		/// of all extracted rows, with one bit per row that is true if the
+		/// value in that row is null.
+		/// Here, this function throws NotImplementedException.
+
 	bool isBulk() const;
 		/// Returns true if this is bulk extraction.
 
@@ -212,6 +218,12 @@ inline bool AbstractExtraction::isNull(std::size_t row) const
 }
 
 
+inline const std::vector<bool>& AbstractExtraction::nulls() const
+{
+	throw NotImplementedException("Null indicators not implemented.");
+}
+
+
 inline Poco::UInt32 AbstractExtraction::position() const
 {
 	return _position;
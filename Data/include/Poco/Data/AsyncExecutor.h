@@ -0,0 +1,238 @@
+//
+// AsyncExecutor.h
+//
+// $Id: //poco/Main/Data/include/Poco/Data/AsyncExecutor.h#1 $
+//
+// Library: Data
+// Package: DataCore
+// Module:  AsyncExecutor
+//
+// Definition of the AsyncExecutor class.
+//
+// Copyright (c) 2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#ifndef Data_AsyncExecutor_INCLUDED
+#define Data_AsyncExecutor_INCLUDED
+
+
+#include "Poco/Data/Data.h"
+#include "Poco/Data/Session.h"
+#include "Poco/ActiveResult.h"
+#include "Poco/RefCountedObject.h"
+#include "Poco/AutoPtr.h"
+#include "Poco/Runnable.h"
+#include "Poco/Thread.h"
+#include "Poco/Mutex.h"
+#include "Poco/Condition.h"
+#include <vector>
+#include <deque>
+
+
+namespace Poco {
+namespace Data {
+
+
+class SessionPool;
+
+
+class Data_API AsyncExecutor: private Poco::Runnable
+	/// AsyncExecutor executes jobs on sessions taken from a SessionPool,
+	/// using a fixed number of worker threads.
+	///
+	/// Unlike Statement::executeAsync(), which runs every statement
+	/// in a thread of its own, AsyncExecutor queues jobs and runs them
+	/// on at most the given number of workers, and therefore on at
+	/// most that many connections at a time.
+	///
+	/// A worker takes up to maxBatch() queued jobs at once and runs
+	/// them back to back on a single session, so that a burst of small,
+	/// independent statements needs only one pool round trip per batch.
+	/// The queued jobs are shared evenly among the idle workers, so that
+	/// a burst is not run on a single session while other workers wait.
+	///
+	/// Every job returns an ActiveResult<std::size_t>, which can be
+	/// waited for, polled with available(), or collected with waitAll().
+	///
+	/// Usage example:
+	///
+	///     SessionPool pool("SQLite", "sample.db");
+	///     AsyncExecutor executor(pool, 4);
+	///     std::vector<AsyncExecutor::Result> results;
+	///     for (int i = 0; i < 100; ++i)
+	///         results.push_back(executor.execute(format("INSERT INTO T VALUES(%d)", i)));
+	///     std::size_t rows = AsyncExecutor::waitAll(results);
+{
+public:
+	typedef ActiveResult<std::size_t> Result;
+	typedef std::vector<Result>       ResultVec;
+	typedef std::vector<std::string>  SQLVec;
+
+	class Data_API Job: public Poco::RefCountedObject
+		/// A unit of work executed by the AsyncExecutor.
+	{
+	public:
+		typedef Poco::AutoPtr<Job> Ptr;
+
+		Job();
+			/// Creates the Job.
+
+		virtual std::size_t execute(Session& session) = 0;
+			/// Executes the job on the given session and returns
+			/// the number of affected or extracted rows.
+			/// Exceptions are reported through the job's Result.
+
+	protected:
+		virtual ~Job();
+			/// Destroys the Job.
+	};
+
+	enum
+	{
+		DEFAULT_WORKERS         = 4,
+		DEFAULT_MAX_BATCH       = 16,
+		DEFAULT_SESSION_TIMEOUT = 30000 /// milliseconds
+	};
+
+	AsyncExecutor(SessionPool& pool, int workers = DEFAULT_WORKERS, std::size_t maxBatch = DEFAULT_MAX_BATCH, long sessionTimeout = DEFAULT_SESSION_TIMEOUT);
+		/// Creates the AsyncExecutor and starts the given number of workers.
+		///
+		/// If the pool is exhausted, a worker waits up to sessionTimeout
+		/// milliseconds for a session to be returned to it (see
+		/// SessionPool::get(long)), after which the jobs of its batch
+		/// fail with a SessionPoolExhaustedException. The number of
+		/// workers should therefore not exceed the capacity of the pool.
+
+	~AsyncExecutor();
+		/// Stops the AsyncExecutor, waiting for all queued jobs to complete.
+
+	Result execute(const std::string& sql);
+		/// Queues the given SQL statement for execution and returns
+		/// the number of affected rows as the result.
+
+	Result execute(const SQLVec& sql, bool transaction = false);
+		/// Queues the given SQL statements for execution, in order,
+		/// on a single session, and returns the total number of affected
+		/// rows. If transaction is true, the statements are executed
+		/// in a transaction, which is rolled back if any of them fails.
+
+	Result execute(Job::Ptr pJob);
+		/// Queues the given job for execution.
+
+	void wait();
+		/// Waits until all queued jobs have completed.
+
+	void stop();
+		/// Completes all queued jobs and stops the workers.
+		/// Subsequent calls to execute() throw an InvalidAccessException.
+
+	std::size_t pending() const;
+		/// Returns the number of queued jobs not yet started.
+
+	int workers() const;
+		/// Returns the number of worker threads.
+
+	std::size_t maxBatch() const;
+		/// Returns the maximum number of jobs a worker runs on a single session.
+
+	long sessionTimeout() const;
+		/// Returns the time, in milliseconds, a worker waits
+		/// for a session from an exhausted pool.
+
+	std::size_t executed() const;
+		/// Returns the number of jobs completed so far.
+
+	std::size_t batches() const;
+		/// Returns the number of sessions taken from the pool so far.
+
+	static std::size_t waitAll(ResultVec& results);
+		/// Waits for all given results and returns the sum of their values.
+		/// If any of the jobs failed, rethrows the first exception
+		/// after all results are available.
+
+private:
+	struct Entry
+	{
+		Entry(Job::Ptr pJ, const Result& res): pJob(pJ), result(res)
+		{
+		}
+
+		Job::Ptr pJob;
+		Result   result;
+	};
+
+	typedef std::deque<Entry>              EntryQueue;
+	typedef std::vector<Entry>             EntryVec;
+	typedef std::vector<Poco::Thread*>     ThreadVec;
+
+	AsyncExecutor();
+	AsyncExecutor(const AsyncExecutor&);
+	AsyncExecutor& operator = (const AsyncExecutor&);
+
+	void run();
+	void runBatch(EntryVec& batch);
+
+	SessionPool&    _pool;
+	std::size_t     _maxBatch;
+	long            _sessionTimeout;
+	ThreadVec       _threads;
+	EntryQueue      _queue;
+	int             _workers;
+	int             _active;
+	bool            _stopped;
+	std::size_t     _executed;
+	std::size_t     _batches;
+	Poco::Condition _ready;
+	Poco::Condition _idle;
+	mutable Poco::FastMutex _mutex;
+};
+
+
+//
+// inlines
+//
+inline int AsyncExecutor::workers() const
+{
+	return static_cast<int>(_threads.size());
+}
+
+
+inline std::size_t AsyncExecutor::maxBatch() const
+{
+	return _maxBatch;
+}
+
+
+inline long AsyncExecutor::sessionTimeout() const
+{
+	return _sessionTimeout;
+}
+
+
+} } // namespace Poco::Data
+
+
+#endif // Data_AsyncExecutor_INCLUDED
@@ -110,10 +110,16 @@ public:
 		}
 	}
 
+	const std::vector<bool>& nulls() const
+	{
+		return _nulls;
+	}
+
 	std::size_t extract(std::size_t col)
 	{
 		AbstractExtractor* pExt = getExtractor();
 		TypeHandler<C>::extract(col, _rResult, _default, pExt);
+		_nulls.clear();
 		typename C::iterator it = _rResult.begin();
 		typename C::iterator end = _rResult.end();
 		for (int row = 0; it !=end; ++it, ++row)
@@ -146,7 +152,7 @@ protected:
 private:
 	C&               _rResult;
 	T                _default;
-	std::deque<bool> _nulls;
+	std::vector<bool> _nulls;
 };
 
 
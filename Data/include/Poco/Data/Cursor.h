@@ -0,0 +1,222 @@
+//
+// Cursor.h
+//
+// $Id: //poco/Main/Data/include/Poco/Data/Cursor.h#1 $
+//
+// Library: Data
+// Package: DataCore
+// Module:  Cursor
+//
+// Definition of the Cursor class.
+//
+// Copyright (c) 2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#ifndef Data_Cursor_INCLUDED
+#define Data_Cursor_INCLUDED
+
+
+#include "Poco/Data/Data.h"
+#include "Poco/Data/Statement.h"
+#include "Poco/Data/RecordSet.h"
+#include "Poco/Dynamic/Var.h"
+
+
+namespace Poco {
+namespace Data {
+
+
+class Session;
+
+
+class Data_API Cursor
+	/// Cursor provides forward-only access to the result of a query,
+	/// without extracting the complete result set first.
+	///
+	/// The Cursor executes the statement with an extraction limit equal
+	/// to the batch size and fetches the next batch of rows only when
+	/// the rows of the current batch have been consumed. Only the
+	/// current batch is held in memory, so the memory needed does not
+	/// depend on the size of the result. The connector continues
+	/// stepping through the native result (e.g., sqlite3_step())
+	/// with every batch.
+	///
+	/// Rows are extracted into vector storage, so the current batch
+	/// can also be processed column by column with RecordSet::columnData().
+	///
+	/// Usage example:
+	///
+	///     Cursor cursor(session, "SELECT LastName, Age FROM Person", 1000);
+	///     while (cursor.next())
+	///     {
+	///         std::cout << cursor["LastName"].convert<std::string>() << std::endl;
+	///     }
+	///
+	/// or, processing a batch at a time:
+	///
+	///     while (cursor.fetch())
+	///     {
+	///         const std::vector<int>& ages = cursor.batch().columnData<int>(1);
+	///         ...
+	///     }
+{
+public:
+	enum
+	{
+		DEFAULT_BATCH_SIZE = 1024
+	};
+
+	Cursor(Session& session, const std::string& query, std::size_t batchSize = DEFAULT_BATCH_SIZE);
+		/// Creates the Cursor for the given query.
+
+	Cursor(const Statement& statement, std::size_t batchSize = DEFAULT_BATCH_SIZE);
+		/// Creates the Cursor for the given statement, which
+		/// must not have been executed yet and must not have
+		/// any output (into) extractions.
+
+	~Cursor();
+		/// Destroys the Cursor.
+
+	bool next();
+		/// Advances the Cursor to the next row, fetching the
+		/// next batch if necessary.
+		///
+		/// Returns true if the row is available, or false if
+		/// there are no more rows.
+
+	bool fetch();
+		/// Fetches the next batch of rows, skipping any
+		/// unconsumed rows of the current batch, and positions
+		/// the Cursor at the first row of the batch.
+		///
+		/// Returns true if the batch contains at least one row,
+		/// or false if there are no more rows.
+
+	const RecordSet& batch() const;
+		/// Returns the current batch. Row numbers of the
+		/// RecordSet are relative to the batch.
+		///
+		/// Throws InvalidAccessException if no batch has been fetched.
+
+	std::size_t batchSize() const;
+		/// Returns the maximum number of rows per batch.
+
+	std::size_t batchRowCount() const;
+		/// Returns the number of rows in the current batch.
+
+	std::size_t position() const;
+		/// Returns the position (row number) of the current row
+		/// within the whole result.
+
+	std::size_t columnCount() const;
+		/// Returns the number of columns.
+
+	Poco::Dynamic::Var value(std::size_t col) const;
+		/// Returns the value in the given column of the current row.
+
+	Poco::Dynamic::Var value(const std::string& name) const;
+		/// Returns the value in the named column of the current row.
+
+	template <class T>
+	const T& value(std::size_t col) const
+		/// Returns the reference to the value in the given
+		/// column of the current row.
+	{
+		return batch().value<T>(col, _row, false);
+	}
+
+	template <class T>
+	const T& value(const std::string& name) const
+		/// Returns the reference to the value in the named
+		/// column of the current row.
+	{
+		return batch().value<T>(name, _row, false);
+	}
+
+	Poco::Dynamic::Var operator [] (std::size_t col) const;
+		/// Returns the value in the given column of the current row.
+
+	Poco::Dynamic::Var operator [] (const std::string& name) const;
+		/// Returns the value in the named column of the current row.
+
+	bool isNull(std::size_t col) const;
+		/// Returns true iff the value in the given
+		/// column of the current row is null.
+
+private:
+	Cursor();
+	Cursor(const Cursor&);
+	Cursor& operator = (const Cursor&);
+
+	void init();
+
+	Statement   _statement;
+	RecordSet*  _pBatch;
+	std::size_t _batchSize;
+	std::size_t _rows;
+	std::size_t _row;
+	std::size_t _offset;
+};
+
+
+//
+// inlines
+//
+inline std::size_t Cursor::batchSize() const
+{
+	return _batchSize;
+}
+
+
+inline std::size_t Cursor::batchRowCount() const
+{
+	return _rows;
+}
+
+
+inline std::size_t Cursor::position() const
+{
+	return _offset + _row;
+}
+
+
+inline Poco::Dynamic::Var Cursor::operator [] (std::size_t col) const
+{
+	return value(col);
+}
+
+
+inline Poco::Dynamic::Var Cursor::operator [] (const std::string& name) const
+{
+	return value(name);
+}
+
+
+} } // namespace Poco::Data
+
+
+#endif // Data_Cursor_INCLUDED
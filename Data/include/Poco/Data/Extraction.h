@@ -195,6 +195,11 @@ public:
 		}
 	}
 
+	const std::vector<bool>& nulls() const
+	{
+		return _nulls;
+	}
+
 	std::size_t extract(std::size_t pos)
 	{
 		AbstractExtractor* pExt = getExtractor();
@@ -216,10 +221,16 @@ protected:
 		return _rResult;
 	}
 
+	void resetNulls()
+		/// Clears the null indicators.
+	{
+		_nulls.clear();
+	}
+
 private:
 	std::vector<T>&  _rResult;
 	T                _default;
-	std::deque<bool> _nulls;
+	std::vector<bool> _nulls;
 };
 
 
@@ -274,6 +285,11 @@ public:
 		}
 	}
 
+	const std::vector<bool>& nulls() const
+	{
+		return _nulls;
+	}
+
 	std::size_t extract(std::size_t pos)
 	{
 		AbstractExtractor* pExt = getExtractor();
@@ -297,10 +313,16 @@ protected:
 		return _rResult;
 	}
 
+	void resetNulls()
+		/// Clears the null indicators.
+	{
+		_nulls.clear();
+	}
+
 private:
 	std::vector<bool>& _rResult;
 	bool               _default;
-	std::deque<bool>   _nulls;
+	std::vector<bool>  _nulls;
 };
 
 
@@ -355,6 +377,11 @@ public:
 		}
 	}
 
+	const std::vector<bool>& nulls() const
+	{
+		return _nulls;
+	}
+
 	std::size_t extract(std::size_t pos)
 	{
 		AbstractExtractor* pExt = getExtractor();
@@ -376,10 +403,16 @@ protected:
 		return _rResult;
 	}
 
+	void resetNulls()
+		/// Clears the null indicators.
+	{
+		_nulls.clear();
+	}
+
 private:
 	std::list<T>&    _rResult;
 	T                _default;
-	std::deque<bool> _nulls;
+	std::vector<bool> _nulls;
 };
 
 
@@ -434,6 +467,11 @@ public:
 		}
 	}
 
+	const std::vector<bool>& nulls() const
+	{
+		return _nulls;
+	}
+
 	std::size_t extract(std::size_t pos)
 	{
 		AbstractExtractor* pExt = getExtractor();
@@ -455,10 +493,16 @@ protected:
 		return _rResult;
 	}
 
+	void resetNulls()
+		/// Clears the null indicators.
+	{
+		_nulls.clear();
+	}
+
 private:
 	std::deque<T>&   _rResult;
 	T                _default;
-	std::deque<bool> _nulls;
+	std::vector<bool> _nulls;
 };
 
 
@@ -492,6 +536,7 @@ public:
 
 	void reset()
 	{
+		Extraction<C>::resetNulls();
 		_pColumn->reset();
 	}	
 
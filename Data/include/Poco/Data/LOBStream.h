@@ -44,6 +44,7 @@
 #include "Poco/UnbufferedStreamBuf.h"
 #include "Poco/Data/LOB.h"
 #include <istream>
+#include <algorithm>
 #include <ostream>
 
 
@@ -85,6 +86,30 @@ protected:
 		return 1;
 	}
 
+	std::streamsize xsgetn(T* p, std::streamsize count)
+		/// Copies up to count characters directly from the LOB
+		/// into the given buffer.
+	{
+		if (count <= 0) return 0;
+
+		typename BaseType::int_type c = this->uflow();
+		if (c == TraitsType::eof()) return 0;
+		*p++ = TraitsType::to_char_type(c);
+
+		std::streamsize avail = static_cast<std::streamsize>(_lob.end() - _it);
+		std::streamsize n = (count - 1 < avail) ? count - 1 : avail;
+		std::copy(_it, _it + n, p);
+		_it += n;
+		return n + 1;
+	}
+
+	std::streamsize xsputn(const T* p, std::streamsize count)
+		/// Appends count characters from the given buffer to the LOB.
+	{
+		if (count > 0) _lob.appendRaw(p, static_cast<std::size_t>(count));
+		return count;
+	}
+
 private:
 	LOB<T>& _lob;
 	typename LOB<T>::Iterator _it;
@@ -45,6 +45,7 @@
 #include "Poco/AutoPtr.h"
 #include "Poco/Timestamp.h"
 #include "Poco/Mutex.h"
+#include "Poco/Thread.h"
 
 
 namespace Poco {
@@ -64,7 +65,7 @@ public:
 	~PooledSessionHolder();
 		/// Destroys the PooledSessionHolder.
 
-	SessionImpl* session();
+	SessionImpl* session() const;
 		/// Returns a pointer to the SessionImpl.
 
 	SessionPool& owner();
@@ -76,10 +77,17 @@ public:
 	int idle() const;
 		/// Returns the number of seconds the session has not been used.
 
+	void setThread(Poco::Thread::TID tid);
+		/// Sets the ID of the thread that used the session last.
+
+	Poco::Thread::TID thread() const;
+		/// Returns the ID of the thread that used the session last.
+
 private:
 	SessionPool& _owner;
 	Poco::AutoPtr<SessionImpl> _pImpl;
 	Poco::Timestamp _lastUsed;
+	Poco::Thread::TID _thread;
 	mutable Poco::FastMutex _mutex;
 };
 
@@ -87,9 +95,10 @@ private:
 //
 // inlines
 //
-inline SessionImpl* PooledSessionHolder::session()
+inline SessionImpl* PooledSessionHolder::session() const
 {
-	return _pImpl;
+	// the holder manages the session, constness does not extend to it
+	return const_cast<SessionImpl*>(_pImpl.get());
 }
 
 
@@ -115,6 +124,18 @@ inline int PooledSessionHolder::idle() const
 }
 
 
+inline void PooledSessionHolder::setThread(Poco::Thread::TID tid)
+{
+	_thread = tid;
+}
+
+
+inline Poco::Thread::TID PooledSessionHolder::thread() const
+{
+	return _thread;
+}
+
+
 } } // namespace Poco::Data
 
 
@@ -101,6 +101,8 @@ protected:
 				
 private:	
 	mutable Poco::AutoPtr<PooledSessionHolder> _pHolder;
+
+	friend class SessionPool;
 };
 
 
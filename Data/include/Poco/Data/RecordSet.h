@@ -86,6 +86,19 @@ class Data_API RecordSet: private Statement
 	/// 
 	/// The number of rows in the RecordSet can be limited by specifying
 	/// a limit for the Statement.
+	///
+	/// For large result sets, the statement should use vector storage
+	///
+	///     Statement select(session);
+	///     select << "SELECT * FROM Person", vector, now;
+	///     RecordSet rs(select);
+	///
+	/// (or the session "storage" property set to "vector"). Each column
+	/// is then kept in a contiguous, typed buffer which can be accessed
+	/// directly with columnData(), without any per-value conversion
+	/// to Poco::Dynamic::Var. Row objects are only created on demand;
+	/// with row caching disabled (see setRowCaching()), a single Row
+	/// object is reused when iterating through the RecordSet.
 {
 public:
 	typedef std::map<std::size_t, Row*> RowMap;
@@ -94,6 +107,7 @@ public:
 
 	using Statement::isNull;
 	using Statement::subTotalRowCount;
+	using Statement::storage;
 
 	static const std::size_t UNKNOWN_TOTAL_ROW_COUNT;
 
@@ -187,9 +201,60 @@ public:
 		}
 	}
 
+	template <class T>
+	const std::vector<T>& columnData(std::size_t pos) const
+		/// Returns the contiguous typed storage of the column at the
+		/// specified position. No data is copied or converted.
+		///
+		/// Values that are NULL hold a default-constructed value
+		/// and can be identified with isNull(). Row filters are not
+		/// applied.
+		///
+		/// Throws InvalidAccessException if the statement does not
+		/// use vector storage.
+	{
+		if (STORAGE_VECTOR != storage())
+			throw InvalidAccessException("Column data requires vector storage.");
+
+		return column<std::vector<T> >(pos).data();
+	}
+
+	template <class T>
+	const std::vector<T>& columnData(const std::string& name) const
+		/// Returns the contiguous typed storage of the column with
+		/// the specified name. See columnData(std::size_t).
+	{
+		if (STORAGE_VECTOR != storage())
+			throw InvalidAccessException("Column data requires vector storage.");
+
+		return column<std::vector<T> >(name).data();
+	}
+
+	const std::vector<bool>& nullBitmap(std::size_t pos) const;
+		/// Returns the null indicators of the column at the specified
+		/// position, with one bit per row that is true if the value in
+		/// that row is NULL. Row indexes are the same as for columnData().
+		/// Row filters are not applied.
+
+	const std::vector<bool>& nullBitmap(const std::string& name) const;
+		/// Returns the null indicators of the column with the specified
+		/// name. See nullBitmap(std::size_t).
+
 	Row& row(std::size_t pos);
 		/// Returns reference to row at position pos.
-		/// Rows are lazy-created and cached.
+		/// Rows are lazy-created and, if row caching is
+		/// enabled, cached.
+
+	void setRowCaching(bool flag);
+		/// Enables or disables row caching (enabled by default).
+		///
+		/// If row caching is disabled, row() and the row iterators
+		/// return a reference to a single Row object that is refilled
+		/// with the values of the requested row. The reference is only
+		/// valid until the next row is requested.
+
+	bool getRowCaching() const;
+		/// Returns true iff row caching is enabled.
 
 	template <class T>
 	const T& value(std::size_t col, std::size_t row, bool useFilter = true) const
@@ -469,10 +534,16 @@ private:
 	const RowFilter* getFilter() const;
 		/// Returns the filter associated with the RecordSet.
 
+	Row& transientRow(std::size_t pos) const;
+		/// Fills the reusable row with the values at position pos
+		/// and returns it.
+
 	std::size_t  _currentRow;
 	RowIterator* _pBegin;
 	RowIterator* _pEnd;
 	RowMap       _rowMap;
+	mutable Row* _pRow;
+	bool         _rowCaching;
 	RowFilter*   _pFilter;
 	std::size_t  _totalRowCount;
 
@@ -524,10 +595,15 @@ inline std::size_t RecordSet::columnCount() const
 }
 
 
-inline Statement& RecordSet::operator = (const Statement& stmt)
+inline void RecordSet::setRowCaching(bool flag)
+{
+	_rowCaching = flag;
+}
+
+
+inline bool RecordSet::getRowCaching() const
 {
-	_currentRow = 0;
-	return Statement::operator = (stmt);
+	return _rowCaching;
 }
 
 
@@ -0,0 +1,251 @@
+//
+// RecordSetExporter.h
+//
+// $Id: //poco/Main/Data/include/Poco/Data/RecordSetExporter.h#1 $
+//
+// Library: Data
+// Package: DataCore
+// Module:  RecordSetExporter
+//
+// Definition of the RecordSetExporter class.
+//
+// Copyright (c) 2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#ifndef Data_RecordSetExporter_INCLUDED
+#define Data_RecordSetExporter_INCLUDED
+
+
+#include "Poco/Data/Data.h"
+#include <ostream>
+
+
+namespace Poco {
+namespace Data {
+
+
+class RecordSet;
+
+
+class Data_API RecordSetExporter
+	/// RecordSetExporter writes the contents of a RecordSet to an
+	/// output stream as CSV or as JSON lines (one JSON object per row).
+	///
+	/// Unlike RecordSet::copy(), which converts every value into a
+	/// Poco::Dynamic::Var and formats each row through a RowFormatter,
+	/// the exporter reads the typed column storage directly and appends
+	/// the formatted values to a large output buffer, which is written
+	/// to the stream whenever it is full.
+	///
+	/// Rows can optionally be formatted in parallel: the rows are split
+	/// into chunks, which are formatted by a number of threads. Every
+	/// chunk is written to the stream as soon as it and all chunks
+	/// before it have been formatted, so the rows keep their original
+	/// order and the output does not wait for the slowest thread.
+	///
+	/// Row filters set on the RecordSet are honored. Columns stored
+	/// in lists are indexed in a single pass before the export, which
+	/// takes one pointer per value; vector or deque storage avoids this.
+	///
+	/// Values are formatted as follows:
+	///   - numbers and booleans are written as-is (true/false);
+	///     non-finite floating point values are written as null in JSON
+	///   - strings and CLOBs are written as text; CSV fields containing the
+	///     delimiter, quotes or line breaks are quoted
+	///   - BLOBs are written Base64-encoded
+	///   - dates, times and timestamps are written as YYYY-MM-DD, HH:MM:SS
+	///     and ISO 8601 respectively
+	///   - NULL values are written as null in JSON and as the null value
+	///     string (empty by default) in CSV
+	///
+	/// Usage example:
+	///
+	///     RecordSet rs(session, "SELECT * FROM Person");
+	///     RecordSetExporter exporter(RecordSetExporter::FORMAT_JSON_LINES);
+	///     exporter.setThreads(4);
+	///     std::ofstream ostr("person.json");
+	///     exporter.exportTo(rs, ostr);
+{
+public:
+	enum Format
+	{
+		FORMAT_CSV,
+		FORMAT_JSON_LINES
+	};
+
+	enum
+	{
+		DEFAULT_BUFFER_SIZE = 65536,
+		DEFAULT_CHUNK_SIZE  = 4096
+	};
+
+	explicit RecordSetExporter(Format format = FORMAT_CSV);
+		/// Creates the RecordSetExporter.
+
+	~RecordSetExporter();
+		/// Destroys the RecordSetExporter.
+
+	std::size_t exportTo(const RecordSet& recordSet, std::ostream& ostr) const;
+		/// Writes all (allowed) rows of the RecordSet to the stream
+		/// and returns the number of rows written.
+
+	Format getFormat() const;
+		/// Returns the output format.
+
+	void setDelimiter(char delimiter);
+		/// Sets the CSV field delimiter (default is ',').
+
+	char getDelimiter() const;
+		/// Returns the CSV field delimiter.
+
+	void setHeader(bool header);
+		/// If true (default), a CSV header line with the column names is written.
+
+	bool getHeader() const;
+		/// Returns true if a CSV header line is written.
+
+	void setNullValue(const std::string& nullValue);
+		/// Sets the string written for NULL values in CSV (default is empty).
+
+	const std::string& getNullValue() const;
+		/// Returns the string written for NULL values in CSV.
+
+	void setBufferSize(std::size_t size);
+		/// Sets the size of the output buffer.
+
+	std::size_t getBufferSize() const;
+		/// Returns the size of the output buffer.
+
+	void setThreads(int threads);
+		/// Sets the number of threads formatting rows in parallel.
+		/// The default is 1, which formats all rows in the calling thread.
+
+	int getThreads() const;
+		/// Returns the number of threads formatting rows in parallel.
+
+	void setChunkSize(std::size_t rows);
+		/// Sets the number of rows formatted by a thread at a time
+		/// in parallel mode.
+
+	std::size_t getChunkSize() const;
+		/// Returns the number of rows formatted by a thread at a time.
+
+private:
+	Format      _format;
+	char        _delimiter;
+	bool        _header;
+	std::string _nullValue;
+	std::size_t _bufferSize;
+	int         _threads;
+	std::size_t _chunkSize;
+};
+
+
+//
+// inlines
+//
+inline RecordSetExporter::Format RecordSetExporter::getFormat() const
+{
+	return _format;
+}
+
+
+inline void RecordSetExporter::setDelimiter(char delimiter)
+{
+	_delimiter = delimiter;
+}
+
+
+inline char RecordSetExporter::getDelimiter() const
+{
+	return _delimiter;
+}
+
+
+inline void RecordSetExporter::setHeader(bool header)
+{
+	_header = header;
+}
+
+
+inline bool RecordSetExporter::getHeader() const
+{
+	return _header;
+}
+
+
+inline void RecordSetExporter::setNullValue(const std::string& nullValue)
+{
+	_nullValue = nullValue;
+}
+
+
+inline const std::string& RecordSetExporter::getNullValue() const
+{
+	return _nullValue;
+}
+
+
+inline void RecordSetExporter::setBufferSize(std::size_t size)
+{
+	_bufferSize = size;
+}
+
+
+inline std::size_t RecordSetExporter::getBufferSize() const
+{
+	return _bufferSize;
+}
+
+
+inline void RecordSetExporter::setThreads(int threads)
+{
+	_threads = threads > 0 ? threads : 1;
+}
+
+
+inline int RecordSetExporter::getThreads() const
+{
+	return _threads;
+}
+
+
+inline void RecordSetExporter::setChunkSize(std::size_t rows)
+{
+	_chunkSize = rows ? rows : 1;
+}
+
+
+inline std::size_t RecordSetExporter::getChunkSize() const
+{
+	return _chunkSize;
+}
+
+
+} } // namespace Poco::Data
+
+
+#endif // Data_RecordSetExporter_INCLUDED
@@ -117,6 +117,9 @@ public:
 	void swap(RowIterator& other);
 		/// Swaps the RowIterator with another one.
 
+	std::size_t position() const;
+		/// Returns the current position (row number) of the iterator.
+
 private:
 	RowIterator();
 
@@ -142,6 +145,12 @@ private:
 ///
 
 
+inline std::size_t RowIterator::position() const
+{
+	return _position;
+}
+
+
 inline bool RowIterator::operator == (const RowIterator& other) const
 {
 	return _pRecordSet == other._pRecordSet && _position == other._position;
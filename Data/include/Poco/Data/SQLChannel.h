@@ -49,6 +49,11 @@
 #include "Poco/Message.h"
 #include "Poco/AutoPtr.h"
 #include "Poco/String.h"
+#include "Poco/Thread.h"
+#include "Poco/Event.h"
+#include "Poco/Mutex.h"
+#include "Poco/RunnableAdapter.h"
+#include <vector>
 
 
 namespace Poco {
@@ -81,6 +86,13 @@ class Data_API SQLChannel: public Poco::Channel
 	/// If throw property is false, insertion timeouts are ignored, otherwise a TimeoutException is thrown.
 	/// To force insertion of every entry, set timeout to 0. This setting, however, introduces
 	/// a risk of long blocking periods in case of remote server communication delays.
+	///
+	/// For high message rates, the channel can operate in bulk mode (see bulk, flush
+	/// and capacity properties). In bulk mode, log() only appends the message to
+	/// preallocated column vectors. A background thread inserts the accumulated
+	/// entries with a single statement inside a transaction whenever the bulk size
+	/// is reached or the flush interval elapses. If the backlog reaches the capacity,
+	/// further messages are dropped and counted (see backlog() and dropped()).
 {
 public:
 	SQLChannel();
@@ -139,6 +151,18 @@ public:
 		///                  Setting this property to false may result in log entries being lost.
 		///                  True values are (case insensitive) "true", "t", "yes", "y".
 		///                  Anything else yields false.
+		///
+		///     * bulk:      Number of entries inserted at once in bulk mode. Values "0"
+		///                  and "" (default) disable bulk mode. When enabled, async and
+		///                  timeout are not used.
+		///
+		///     * flush:     Interval (ms) after which accumulated entries are inserted
+		///                  in bulk mode, even if fewer than bulk entries are available.
+		///                  Defaults to 1000.
+		///
+		///     * capacity:  Maximum number of entries waiting to be inserted in bulk mode.
+		///                  Messages logged while the backlog is full are dropped.
+		///                  Values "0" and "" (default) mean no limit.
 		
 	std::string getProperty(const std::string& name) const;
 		/// Returns the value of the property with the given name.
@@ -147,6 +171,23 @@ public:
 		/// Waits for the completion of the previous operation and returns
 		/// the result. If chanel is in synchronous mode, returns 0 immediately.
 
+	std::size_t flush();
+		/// In bulk mode, inserts all accumulated entries and returns
+		/// their number. Returns 0 if the channel is not in bulk mode.
+		/// If the insert fails, the entries are counted as dropped and,
+		/// if throw property is true, the exception is rethrown.
+
+	std::size_t backlog() const;
+		/// Returns the number of entries accumulated in bulk mode,
+		/// including entries currently being inserted.
+
+	std::size_t dropped() const;
+		/// Returns the number of entries dropped in bulk mode, either
+		/// because the backlog was full or because the insert failed.
+
+	std::size_t logged() const;
+		/// Returns the number of entries inserted in bulk mode.
+
 	static void registerChannel();
 		/// Registers the channel with the global LoggingFactory.
 
@@ -159,6 +200,9 @@ public:
 	static const std::string PROP_ASYNC;
 	static const std::string PROP_TIMEOUT;
 	static const std::string PROP_THROW;
+	static const std::string PROP_BULK;
+	static const std::string PROP_FLUSH;
+	static const std::string PROP_CAPACITY;
 
 protected:
 	~SQLChannel();
@@ -169,6 +213,24 @@ private:
 	typedef Poco::Message::Priority          Priority;
 	typedef Poco::SharedPtr<ArchiveStrategy> StrategyPtr;
 
+	struct LogBatch
+		/// Column vectors holding the accumulated log entries.
+	{
+		std::vector<std::string> source;
+		std::vector<std::string> name;
+		std::vector<long>        pid;
+		std::vector<std::string> thread;
+		std::vector<long>        tid;
+		std::vector<int>         priority;
+		std::vector<std::string> text;
+		std::vector<DateTime>    dateTime;
+
+		std::size_t size() const;
+		void reserve(std::size_t n);
+		void clear();
+		void swap(LogBatch& other);
+	};
+
 	void initLogStatement();
 		/// Initiallizes the log statement.
 
@@ -184,6 +246,21 @@ private:
 	void logSync(const Message& msg);
 		/// Inserts the message in the target database.
 
+	void logBulk(const Message& msg);
+		/// Appends the message to the current batch.
+
+	void insertBatch();
+		/// Inserts the batch being flushed in a single statement.
+
+	void startFlusher();
+		/// Starts the background flush thread, if bulk mode is enabled.
+
+	void stopFlusher();
+		/// Stops the background flush thread.
+
+	void runFlusher();
+		/// Flushes the accumulated entries at the flush interval.
+
 	bool isTrue(const std::string& value) const;
 		/// Returns true is value is "true", "t", "yes" or "y".
 		/// Case insensitive.
@@ -208,6 +285,22 @@ private:
 	DateTime    _dateTime;
 
 	StrategyPtr _pArchiveStrategy;
+
+	// members for bulk mode
+	std::size_t   _bulk;
+	long          _flushInterval;
+	std::size_t   _capacity;
+	LogBatch      _batch;
+	LogBatch      _flushBatch;
+	std::size_t   _inFlight;
+	std::size_t   _dropped;
+	std::size_t   _logged;
+	bool          _stopFlusher;
+	Poco::Thread  _flushThread;
+	Poco::Event   _flushEvent;
+	Poco::RunnableAdapter<SQLChannel> _flushRunnable;
+	mutable Poco::FastMutex _mutex;
+	Poco::FastMutex _flushMutex;
 };
 
 
@@ -48,7 +48,13 @@
 #include "Poco/Any.h"
 #include "Poco/Timer.h"
 #include "Poco/Mutex.h"
+#include "Poco/Condition.h"
+#include "Poco/Thread.h"
+#include "Poco/Timestamp.h"
 #include <list>
+#include <map>
+#include <set>
+#include <vector>
 
 
 namespace Poco {
@@ -73,13 +79,35 @@ class Data_API SessionPool: public RefCountedObject
 	/// To avoid excessive creation of SessionImpl objects, a limit
 	/// can be set on the maximum number of objects.
 	/// Sessions found not to be connected to the database are purged
-	/// from the pool whenever one of the following events occurs:
-	/// 
-	///   - JanitorTimer event
-	///   - get() request
-	///   - putBack() request
+	/// from the pool by the janitor timer, which validates the idle
+	/// sessions in the background, one at a time. Neither get() nor
+	/// putBack() checks the connection, so a session that has died
+	/// since the last janitor run can be handed out; using it fails
+	/// and closing it returns it to the pool, where the janitor purges
+	/// it. While a session is being validated, get() hands out another
+	/// idle session or creates a new one, and waits for the validation
+	/// only if the pool is exhausted otherwise.
 	///
-	/// Not connected idle sessions can not exist.
+	/// The default pool settings are restored by the janitor as well;
+	/// settings changed with get(name, value) are reverted by putBack().
+	/// Session creation, validation and the restoration of session
+	/// settings are done without holding the pool lock; the lock only
+	/// protects the bookkeeping.
+	///
+	/// With thread affinity enabled (see setThreadAffinity()), get()
+	/// prefers the idle session that was last returned by the calling
+	/// thread, so that per-session caches (e.g., prepared statements)
+	/// stay warm for a thread that repeatedly executes the same work.
+	///
+	/// The pool keeps statistics about requests, wait times and
+	/// utilization, which can be used to tune the pool size.
+	///
+	/// To avoid paying connection and preparation costs on the first
+	/// requests after startup, the pool can be pre-warmed to minSessions
+	/// sessions (see warmUp()), and SQL statements can be registered
+	/// (see addStatement()) that every newly created session prepares
+	/// before it is handed out. Connectors that cache prepared statements
+	/// per session (e.g., SQLite) then reuse the prepared statements.
 	///
 	/// Usage example:
 	///
@@ -114,6 +142,15 @@ public:
 		/// If the maximum number of sessions for this pool has
 		/// already been created, a SessionPoolExhaustedException
 		/// is thrown.
+
+	Session get(long milliseconds);
+		/// Returns a Session.
+		///
+		/// Works like get(), but if the maximum number of sessions
+		/// for this pool has already been created, waits up to the
+		/// given number of milliseconds for a session to be returned
+		/// to the pool, before a SessionPoolExhaustedException
+		/// is thrown.
 	
 	template <typename T>
 	Session get(const std::string& name, const T& value)
@@ -123,8 +160,13 @@ public:
 		/// value when the session is reclaimed by the pool.
 	{
 		Session s = get();
-		_addPropertyMap.insert(AddPropertyMap::value_type(s.impl(),
-			std::make_pair(name, s.getProperty(name))));
+		Poco::Any oldValue = s.getProperty(name);
+		{
+			// putBack() looks the setting up by the pooled session
+			Poco::Mutex::ScopedLock lock(_mutex);
+			_addPropertyMap.insert(AddPropertyMap::value_type(static_cast<PooledSessionImpl*>(s.impl())->impl(),
+				std::make_pair(name, oldValue)));
+		}
 		s.setProperty(name, value);
 
 		return s;
@@ -173,31 +215,96 @@ public:
 	Poco::Any getProperty(const std::string& name);
 		/// Returns the requested property.
 
+	void setThreadAffinity(bool flag);
+		/// Enables or disables thread affinity. If enabled,
+		/// get() returns the idle session that was last used
+		/// by the calling thread, if there is one.
+		/// Thread affinity is disabled by default.
+
+	bool getThreadAffinity() const;
+		/// Returns true iff thread affinity is enabled.
+
+	int requests() const;
+		/// Returns the number of successful get() requests.
+
+	int affinityHits() const;
+		/// Returns the number of get() requests that were satisfied
+		/// with the session last used by the requesting thread.
+
+	int peakUsed() const;
+		/// Returns the maximum number of sessions that were
+		/// in use at the same time.
+
+	Poco::Timestamp::TimeDiff totalWaitTime() const;
+		/// Returns the total time, in microseconds, spent in
+		/// successful get() requests, including lock contention
+		/// and session creation.
+
+	Poco::Timestamp::TimeDiff maxWaitTime() const;
+		/// Returns the longest time, in microseconds, spent in
+		/// a single successful get() request.
+
+	double utilization() const;
+		/// Returns the ratio of sessions in use to the capacity
+		/// of the pool (0.0 to 1.0).
+
+	int warmUp();
+		/// Creates sessions, in parallel, until the pool holds minSessions
+		/// sessions and puts them into the pool as idle sessions.
+		/// Returns the number of sessions created.
+		///
+		/// Features and properties must be set before calling warmUp().
+		/// If a session can not be created, the sessions that were created
+		/// successfully are kept and the exception is rethrown.
+
+	void addStatement(const std::string& sql);
+		/// Registers an SQL statement that is prepared by every session
+		/// created by the pool from now on.
+
+	std::vector<std::string> statements() const;
+		/// Returns the registered SQL statements.
+
 	void shutdown();
+		/// Shuts down the pool and closes all sessions.
 
 protected:
 	typedef Poco::AutoPtr<PooledSessionHolder>    PooledSessionHolderPtr;
 	typedef Poco::AutoPtr<PooledSessionImpl>      PooledSessionImplPtr;
 	typedef std::list<PooledSessionHolderPtr>     SessionList;
+	typedef std::set<PooledSessionHolderPtr>      SessionSet;
 	typedef Poco::HashMap<std::string, bool>      FeatureMap;
 	typedef Poco::HashMap<std::string, Poco::Any> PropertyMap;
 
 	void purgeDeadSessions();
-	int deadImpl(SessionList& rSessions);
 	void applySettings(SessionImpl* pImpl);
+	void prepareStatements(Session& session);
+	Session newSession();
 	void putBack(PooledSessionHolderPtr pHolder);
 	void onJanitorTimer(Poco::Timer&);
 
+	void runJanitor();
+		/// Closes the sessions that have been idle for too long and
+		/// validates the remaining idle sessions, one at a time.
+		/// Called by the janitor timer. Concurrent calls are serialized.
+
 private:
 	typedef std::pair<std::string, Poco::Any> PropertyPair; 
 	typedef std::pair<std::string, bool> FeaturePair; 
 	typedef std::map<SessionImpl*, PropertyPair> AddPropertyMap;
 	typedef std::map<SessionImpl*, FeaturePair> AddFeatureMap;
+	typedef std::map<Poco::Thread::TID, SessionList::iterator> AffinityMap;
+	typedef std::vector<std::string> StatementVec;
+
+	class WarmUpTask;
 
 	SessionPool(const SessionPool&);
 	SessionPool& operator = (const SessionPool&);
 		
 	void closeAll(SessionList& sessionList);
+	void closeAll(SessionSet& sessionSet);
+	void pushIdle(PooledSessionHolderPtr pHolder, bool front);
+	PooledSessionHolderPtr popIdle();
+	void eraseIdle(SessionList::iterator it);
 
 	std::string    _connector;
 	std::string    _connectionString;
@@ -205,14 +312,26 @@ private:
 	int            _maxSessions;
 	int            _idleTime;
 	int            _nSessions;
+	int            _nValidating;
 	SessionList    _idleSessions;
-	SessionList    _activeSessions;
+	SessionList::iterator _validatingIt;
+	SessionSet     _activeSessions;
+	AffinityMap    _affinityMap;
+	bool           _threadAffinity;
+	Poco::Condition _available;
 	Poco::Timer    _janitorTimer;
 	FeatureMap     _featureMap;
 	PropertyMap    _propertyMap;
 	bool           _shutdown;
 	AddPropertyMap _addPropertyMap;
 	AddFeatureMap  _addFeatureMap;
+	StatementVec   _statements;
+	int            _requests;
+	int            _affinityHits;
+	int            _peakUsed;
+	Poco::Timestamp::TimeDiff _totalWaitTime;
+	Poco::Timestamp::TimeDiff _maxWaitTime;
+	Poco::FastMutex _janitorMutex;
 	mutable
 	Poco::Mutex _mutex;
 	
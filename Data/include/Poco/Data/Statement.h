@@ -323,6 +323,16 @@ public:
 		/// The result of execution (i.e. number of returned or affected rows) can be 
 		/// obtained by calling wait() on the statement at a later point in time.
 
+	Statement& prepare();
+		/// Compiles the statement without executing it, so that a
+		/// subsequent execute() does not pay the preparation cost.
+		/// Connectors that cache prepared statements per session keep
+		/// the prepared statement in the cache when the statement is
+		/// destroyed without being executed.
+		///
+		/// Throws InvalidAccessException if the statement has already
+		/// been executed.
+
 	const Result& executeAsync(bool reset = true);
 		/// Executes the statement asynchronously. 
 		/// Stops when either a limit is hit or the whole statement was executed.
@@ -349,6 +359,9 @@ public:
 	bool initialized();
 		/// Returns true if the statement was initialized (i.e. not executed yet).
 
+	bool prepared();
+		/// Returns true if the statement was prepared but not executed yet.
+
 	bool paused();
 		/// Returns true if the statement was paused (a range limit stopped it
 		/// and there is more work to do).
@@ -426,7 +439,7 @@ protected:
 	StatementImplPtr impl() const;
 		/// Returns pointer to statement implementation.
 
-	const RowFormatterPtr& getRowFormatter();
+	const RowFormatterPtr& getRowFormatter() const;
 		/// Returns the row formatter for this statement.
 
 	Session session();
@@ -451,7 +464,7 @@ private:
 	Mutex               _mutex;
 	AsyncExecMethodPtr  _pAsyncExec;
 	std::vector<Any>    _arguments;
-	RowFormatterPtr     _pRowFormatter;
+	mutable RowFormatterPtr _pRowFormatter;
 	mutable std::string _stmtString;
 };
 
@@ -781,6 +794,13 @@ inline bool Statement::initialized()
 }
 
 
+inline bool Statement::prepared()
+{
+	return _pImpl->getState() == StatementImpl::ST_COMPILED &&
+		(!_pResult || _pResult->available());
+}
+
+
 inline bool Statement::paused()
 {
 	return _pImpl->getState() == StatementImpl::ST_PAUSED;
@@ -817,7 +837,7 @@ inline void Statement::setRowFormatter(RowFormatter* pRowFormatter)
 }
 
 
-inline const RowFormatterPtr& Statement::getRowFormatter()
+inline const RowFormatterPtr& Statement::getRowFormatter() const
 {
 	if (!_pRowFormatter) _pRowFormatter = new SimpleRowFormatter;
 	return _pRowFormatter;
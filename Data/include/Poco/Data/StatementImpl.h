@@ -364,6 +364,9 @@ private:
 		/// session setting is used.
 		/// If neither this statement nor the session have the storage
 		/// type set, std::deque is the default container type used.
+		///
+		/// The storage type used is remembered, so that RecordSet
+		/// accesses the columns with the matching container type.
 	{
 		std::string storage;
 	
@@ -384,6 +387,7 @@ private:
 
 		if (0 == icompare(DEQUE, storage))
 		{
+			_storage = STORAGE_DEQUE_IMPL;
 			if (!isBulkExtraction())
 				addExtract(createExtract<std::deque<T> >(mc));
 			else
@@ -391,6 +395,7 @@ private:
 		}
 		else if (0 == icompare(VECTOR, storage))
 		{
+			_storage = STORAGE_VECTOR_IMPL;
 			if (!isBulkExtraction())
 				addExtract(createExtract<std::vector<T> >(mc));
 			else
@@ -398,6 +403,7 @@ private:
 		}
 		else if (0 == icompare(LIST, storage))
 		{
+			_storage = STORAGE_LIST_IMPL;
 			if (!isBulkExtraction())
 				addExtract(createExtract<std::list<T> >(mc));
 			else
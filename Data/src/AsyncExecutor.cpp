@@ -0,0 +1,321 @@
+//
+// AsyncExecutor.cpp
+//
+// $Id: //poco/Main/Data/src/AsyncExecutor.cpp#1 $
+//
+// Library: Data
+// Package: DataCore
+// Module:  AsyncExecutor
+//
+// Copyright (c) 2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+
+#include "Poco/Data/AsyncExecutor.h"
+#include "Poco/Data/SessionPool.h"
+#include "Poco/Data/Statement.h"
+#include "Poco/Exception.h"
+#include "Poco/Format.h"
+#include <exception>
+
+
+namespace Poco {
+namespace Data {
+
+
+namespace
+{
+	class SQLJob: public AsyncExecutor::Job
+	{
+	public:
+		SQLJob(const AsyncExecutor::SQLVec& sql, bool transaction):
+			_sql(sql),
+			_transaction(transaction)
+		{
+		}
+
+		std::size_t execute(Session& session)
+		{
+			if (_transaction) session.begin();
+			try
+			{
+				std::size_t rows = 0;
+				AsyncExecutor::SQLVec::const_iterator it  = _sql.begin();
+				AsyncExecutor::SQLVec::const_iterator end = _sql.end();
+				for (; it != end; ++it)
+				{
+					Statement stmt(session);
+					stmt << *it;
+					rows += stmt.execute();
+				}
+				if (_transaction) session.commit();
+				return rows;
+			}
+			catch (...)
+			{
+				if (_transaction && session.isTransaction()) session.rollback();
+				throw;
+			}
+		}
+
+	private:
+		AsyncExecutor::SQLVec _sql;
+		bool _transaction;
+	};
+}
+
+
+AsyncExecutor::Job::Job()
+{
+}
+
+
+AsyncExecutor::Job::~Job()
+{
+}
+
+
+AsyncExecutor::AsyncExecutor(SessionPool& pool, int workers, std::size_t maxBatch, long sessionTimeout):
+	_pool(pool),
+	_maxBatch(maxBatch ? maxBatch : 1),
+	_sessionTimeout(sessionTimeout),
+	_workers(workers),
+	_active(0),
+	_stopped(false),
+	_executed(0),
+	_batches(0)
+{
+	poco_assert (workers > 0);
+
+	try
+	{
+		for (int i = 0; i < workers; ++i)
+		{
+			Poco::Thread* pThread = new Poco::Thread(Poco::format("AsyncExecutor[#%d]", i));
+			_threads.push_back(pThread);
+			pThread->start(*this);
+		}
+	}
+	catch (...)
+	{
+		stop();
+		throw;
+	}
+}
+
+
+AsyncExecutor::~AsyncExecutor()
+{
+	stop();
+}
+
+
+AsyncExecutor::Result AsyncExecutor::execute(const std::string& sql)
+{
+	return execute(SQLVec(1, sql), false);
+}
+
+
+AsyncExecutor::Result AsyncExecutor::execute(const SQLVec& sql, bool transaction)
+{
+	return execute(Job::Ptr(new SQLJob(sql, transaction)));
+}
+
+
+AsyncExecutor::Result AsyncExecutor::execute(Job::Ptr pJob)
+{
+	poco_check_ptr (pJob);
+
+	Entry entry(pJob, Result(new ActiveResultHolder<std::size_t>()));
+
+	Poco::FastMutex::ScopedLock lock(_mutex);
+	if (_stopped)
+		throw InvalidAccessException("AsyncExecutor has been stopped.");
+
+	_queue.push_back(entry);
+	_ready.signal();
+	return entry.result;
+}
+
+
+void AsyncExecutor::wait()
+{
+	Poco::FastMutex::ScopedLock lock(_mutex);
+	while (!_queue.empty() || _active > 0)
+		_idle.wait(_mutex);
+}
+
+
+void AsyncExecutor::stop()
+{
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+		_stopped = true;
+		_ready.broadcast();
+	}
+
+	for (ThreadVec::iterator it = _threads.begin(); it != _threads.end(); ++it)
+	{
+		(*it)->join();
+		delete *it;
+	}
+	_threads.clear();
+}
+
+
+std::size_t AsyncExecutor::pending() const
+{
+	Poco::FastMutex::ScopedLock lock(_mutex);
+	return _queue.size();
+}
+
+
+std::size_t AsyncExecutor::executed() const
+{
+	Poco::FastMutex::ScopedLock lock(_mutex);
+	return _executed;
+}
+
+
+std::size_t AsyncExecutor::batches() const
+{
+	Poco::FastMutex::ScopedLock lock(_mutex);
+	return _batches;
+}
+
+
+std::size_t AsyncExecutor::waitAll(ResultVec& results)
+{
+	std::size_t total = 0;
+	const Exception* pExc = 0;
+	for (ResultVec::iterator it = results.begin(); it != results.end(); ++it)
+	{
+		it->wait();
+		if (it->failed())
+		{
+			if (!pExc) pExc = it->exception();
+		}
+		else total += it->data();
+	}
+	if (pExc) pExc->rethrow();
+	return total;
+}
+
+
+void AsyncExecutor::run()
+{
+	EntryVec batch;
+	for (;;)
+	{
+		{
+			Poco::FastMutex::ScopedLock lock(_mutex);
+			while (_queue.empty() && !_stopped)
+				_ready.wait(_mutex);
+			if (_queue.empty()) return;
+
+			// leave a share of the queued jobs to every idle worker,
+			// including the ones that are still starting up
+			std::size_t idle = _workers - _active;
+			std::size_t share = (_queue.size() + idle - 1)/idle;
+			if (share > _maxBatch) share = _maxBatch;
+			while (batch.size() < share)
+			{
+				batch.push_back(_queue.front());
+				_queue.pop_front();
+			}
+			if (!_queue.empty()) _ready.signal();
+			++_active;
+		}
+
+		runBatch(batch);
+
+		Poco::FastMutex::ScopedLock lock(_mutex);
+		_executed += batch.size();
+		++_batches;
+		--_active;
+		if (_queue.empty() && _active == 0) _idle.broadcast();
+		batch.clear();
+	}
+}
+
+
+void AsyncExecutor::runBatch(EntryVec& batch)
+{
+	EntryVec::iterator it  = batch.begin();
+	EntryVec::iterator end = batch.end();
+	try
+	{
+		Session session(_pool.get(_sessionTimeout));
+		for (; it != end; ++it)
+		{
+			try
+			{
+				it->result.data(new std::size_t(it->pJob->execute(session)));
+			}
+			catch (Exception& exc)
+			{
+				it->result.error(exc);
+			}
+			catch (std::exception& exc)
+			{
+				it->result.error(exc.what());
+			}
+			catch (...)
+			{
+				it->result.error("unknown exception");
+			}
+			it->result.notify();
+		}
+	}
+	catch (Exception& exc)
+	{
+		for (; it != end; ++it)
+		{
+			it->result.error(exc);
+			it->result.notify();
+		}
+	}
+	catch (std::exception& exc)
+	{
+		for (; it != end; ++it)
+		{
+			it->result.error(exc.what());
+			it->result.notify();
+		}
+	}
+	catch (...)
+	{
+		for (; it != end; ++it)
+		{
+			it->result.error("unknown exception");
+			it->result.notify();
+		}
+	}
+}
+
+
+} } // namespace Poco::Data
@@ -0,0 +1,154 @@
+//
+// Cursor.cpp
+//
+// $Id: //poco/Main/Data/src/Cursor.cpp#1 $
+//
+// Library: Data
+// Package: DataCore
+// Module:  Cursor
+//
+// Copyright (c) 2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#include "Poco/Data/Cursor.h"
+#include "Poco/Data/Session.h"
+#include "Poco/Exception.h"
+
+
+namespace Poco {
+namespace Data {
+
+
+Cursor::Cursor(Session& session, const std::string& query, std::size_t batchSize):
+	_statement(session),
+	_pBatch(0),
+	_batchSize(batchSize),
+	_rows(0),
+	_row(0),
+	_offset(0)
+{
+	_statement << query;
+	init();
+}
+
+
+Cursor::Cursor(const Statement& statement, std::size_t batchSize):
+	_statement(statement),
+	_pBatch(0),
+	_batchSize(batchSize),
+	_rows(0),
+	_row(0),
+	_offset(0)
+{
+	if (_statement.extractionCount() > 0)
+		throw InvalidArgumentException("Cursor statement must not have output extractions.");
+	if (!_statement.initialized())
+		throw InvalidAccessException("Cursor statement must not have been executed.");
+
+	init();
+}
+
+
+Cursor::~Cursor()
+{
+	delete _pBatch;
+}
+
+
+void Cursor::init()
+{
+	if (0 == _batchSize)
+		throw InvalidArgumentException("Cursor batch size must be greater than zero.");
+
+	_statement.setStorage("vector");
+	_statement, Keywords::limit(_batchSize);
+}
+
+
+bool Cursor::fetch()
+{
+	_offset += _rows;
+	_rows = 0;
+	_row = 0;
+	if (_pBatch && _statement.done()) return false;
+
+	_statement.execute();
+	_rows = _statement.rowsExtracted();
+	if (!_pBatch)
+	{
+		_pBatch = new RecordSet(_statement);
+		_pBatch->setRowCaching(false);
+	}
+
+	return _rows > 0;
+}
+
+
+bool Cursor::next()
+{
+	if (_row + 1 < _rows)
+	{
+		++_row;
+		return true;
+	}
+	else return fetch();
+}
+
+
+const RecordSet& Cursor::batch() const
+{
+	if (!_pBatch) throw InvalidAccessException("No batch has been fetched.");
+
+	return *_pBatch;
+}
+
+
+std::size_t Cursor::columnCount() const
+{
+	return batch().columnCount();
+}
+
+
+Poco::Dynamic::Var Cursor::value(std::size_t col) const
+{
+	return batch().value(col, _row, false);
+}
+
+
+Poco::Dynamic::Var Cursor::value(const std::string& name) const
+{
+	return batch().value(name, _row, false);
+}
+
+
+bool Cursor::isNull(std::size_t col) const
+{
+	return batch().isNull(col, _row);
+}
+
+
+} } // namespace Poco::Data
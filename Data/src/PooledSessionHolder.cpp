@@ -43,7 +43,8 @@ namespace Data {
 
 PooledSessionHolder::PooledSessionHolder(SessionPool& owner, SessionImpl* pSessionImpl):
 	_owner(owner),
-	_pImpl(pSessionImpl, true)
+	_pImpl(pSessionImpl, true),
+	_thread(Poco::Thread::currentTid())
 {
 }
 
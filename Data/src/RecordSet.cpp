@@ -60,6 +60,8 @@ RecordSet::RecordSet(const Statement& rStatement,
 	_currentRow(0),
 	_pBegin(new RowIterator(this, 0 == rowsExtracted())),
 	_pEnd(new RowIterator(this, true)),
+	_pRow(0),
+	_rowCaching(true),
 	_pFilter(0),
 	_totalRowCount(UNKNOWN_TOTAL_ROW_COUNT)
 {
@@ -74,6 +76,8 @@ RecordSet::RecordSet(Session& rSession,
 	_currentRow(0),
 	_pBegin(new RowIterator(this, 0 == rowsExtracted())),
 	_pEnd(new RowIterator(this, true)),
+	_pRow(0),
+	_rowCaching(true),
 	_pFilter(0),
 	_totalRowCount(UNKNOWN_TOTAL_ROW_COUNT)
 {
@@ -86,6 +90,8 @@ RecordSet::RecordSet(const RecordSet& other):
 	_currentRow(other._currentRow),
 	_pBegin(new RowIterator(this, 0 == rowsExtracted())),
 	_pEnd(new RowIterator(this, true)),
+	_pRow(0),
+	_rowCaching(other._rowCaching),
 	_pFilter(other._pFilter),
 	_totalRowCount(other._totalRowCount)
 {
@@ -96,6 +102,7 @@ RecordSet::~RecordSet()
 {
 	delete _pBegin;
 	delete _pEnd;
+	delete _pRow;
 	if(_pFilter) _pFilter->release();
 
 	RowMap::iterator it = _rowMap.begin();
@@ -167,8 +174,19 @@ Poco::Dynamic::Var RecordSet::value(const std::string& name, std::size_t row, bo
 }
 
 
+Statement& RecordSet::operator = (const Statement& stmt)
+{
+	_currentRow = 0;
+	delete _pRow;
+	_pRow = 0;
+	return Statement::operator = (stmt);
+}
+
+
 Row& RecordSet::row(std::size_t pos)
 {
+	if (!_rowCaching) return transientRow(pos);
+
 	std::size_t rowCnt = rowCount();
 	if (0 == rowCnt || pos > rowCnt - 1)
 		throw RangeException("Invalid recordset row requested.");
@@ -208,6 +226,59 @@ Row& RecordSet::row(std::size_t pos)
 }
 
 
+Row& RecordSet::transientRow(std::size_t pos) const
+{
+	if (pos >= subTotalRowCount())
+		throw RangeException("Invalid recordset row requested.");
+
+	std::size_t columns = columnCount();
+	if (!_pRow || _pRow->fieldCount() != columns)
+	{
+		delete _pRow;
+		_pRow = 0;
+		Row* pRow = new Row;
+		try
+		{
+			pRow->setFormatter(getRowFormatter());
+			for (std::size_t col = 0; col < columns; ++col)
+				pRow->append(metaColumn(static_cast<UInt32>(col)).name(), value(col, pos));
+		}
+		catch (...)
+		{
+			delete pRow;
+			throw;
+		}
+		_pRow = pRow;
+	}
+	else
+	{
+		for (std::size_t col = 0; col < columns; ++col)
+			_pRow->set(col, value(col, pos));
+	}
+
+	return *_pRow;
+}
+
+
+const std::vector<bool>& RecordSet::nullBitmap(std::size_t pos) const
+{
+	try
+	{
+		return extractions().at(pos)->nulls();
+	}
+	catch (std::out_of_range& ex)
+	{
+		throw RangeException(ex.what());
+	}
+}
+
+
+const std::vector<bool>& RecordSet::nullBitmap(const std::string& name) const
+{
+	return nullBitmap(metaColumn(name).position());
+}
+
+
 std::size_t RecordSet::rowCount() const
 {
 	poco_assert (extractions().size());
@@ -316,6 +387,7 @@ void RecordSet::setRowFormatter(RowFormatter* pRowFormatter)
 	RowMap::iterator it = _rowMap.begin();
 	RowMap::iterator end = _rowMap.end();
 	for (; it != end; ++it) it->second->setFormatter(getRowFormatter());
+	if (_pRow) _pRow->setFormatter(getRowFormatter());
 }
 
 
@@ -331,7 +403,8 @@ std::ostream& RecordSet::copyValues(std::ostream& os, std::size_t offset, std::s
 {
 	RowIterator it = *_pBegin + offset;
 	RowIterator end = (RowIterator::POSITION_END != length) ? it + length : *_pEnd;
-	std::copy(it, end, std::ostream_iterator<Row>(os));
+	// rows are only needed for formatting, so they are not cached
+	for (; it != end; ++it) os << transientRow(it.position());
 	return os;
 }
 
@@ -340,14 +413,14 @@ void RecordSet::formatValues(std::size_t offset, std::size_t length) const
 {
 	RowIterator it = *_pBegin + offset;
 	RowIterator end = (RowIterator::POSITION_END != length) ? it + length : *_pEnd;
-	std::string val;
-	for (; it != end; ++it) it->formatValues();
+	for (; it != end; ++it) transientRow(it.position()).formatValues();
 }
 
 
 std::ostream& RecordSet::copy(std::ostream& os, std::size_t offset, std::size_t length) const
 {
-	RowFormatter& rf = const_cast<RowFormatter&>((*_pBegin)->getFormatter());
+	RowFormatterPtr pFormatter = getRowFormatter();
+	RowFormatter& rf = *pFormatter;
 	rf.setTotalRowCount(static_cast<int>(getTotalRowCount()));
 	if (RowFormatter::FORMAT_PROGRESSIVE == rf.getMode())
 	{
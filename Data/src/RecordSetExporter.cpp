@@ -0,0 +1,613 @@
+//
+// RecordSetExporter.cpp
+//
+// $Id: //poco/Main/Data/src/RecordSetExporter.cpp#1 $
+//
+// Library: Data
+// Package: DataCore
+// Module:  RecordSetExporter
+//
+// Copyright (c) 2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+
+#include "Poco/Data/RecordSetExporter.h"
+#include "Poco/Data/RecordSet.h"
+#include "Poco/Data/Column.h"
+#include "Poco/Data/LOB.h"
+#include "Poco/Data/Date.h"
+#include "Poco/Data/Time.h"
+#include "Poco/Data/DataException.h"
+#include "Poco/DateTime.h"
+#include "Poco/DateTimeFormatter.h"
+#include "Poco/DateTimeFormat.h"
+#include "Poco/NumberFormatter.h"
+#include "Poco/FPEnvironment.h"
+#include "Poco/Base64Encoder.h"
+#include "Poco/SharedPtr.h"
+#include "Poco/Runnable.h"
+#include "Poco/ThreadPool.h"
+#include "Poco/Event.h"
+#include <sstream>
+#include <vector>
+#include <deque>
+#include <list>
+
+
+namespace Poco {
+namespace Data {
+
+
+namespace
+{
+	struct FormatSpec
+	{
+		bool        json;
+		char        delimiter;
+		std::string nullValue;
+	};
+
+
+	void appendText(std::string& out, const char* p, std::size_t n, const FormatSpec& spec)
+	{
+		if (spec.json)
+		{
+			static const char HEX[] = "0123456789abcdef";
+			out += '"';
+			for (const char* end = p + n; p != end; ++p)
+			{
+				unsigned char c = static_cast<unsigned char>(*p);
+				switch (c)
+				{
+				case '"':  out += "\\\""; break;
+				case '\\': out += "\\\\"; break;
+				case '\b': out += "\\b"; break;
+				case '\f': out += "\\f"; break;
+				case '\n': out += "\\n"; break;
+				case '\r': out += "\\r"; break;
+				case '\t': out += "\\t"; break;
+				default:
+					if (c < 0x20)
+					{
+						out += "\\u00";
+						out += HEX[c >> 4];
+						out += HEX[c & 0x0F];
+					}
+					else out += static_cast<char>(c);
+				}
+			}
+			out += '"';
+		}
+		else
+		{
+			bool quote = false;
+			for (std::size_t i = 0; i < n && !quote; ++i)
+			{
+				char c = p[i];
+				quote = (c == spec.delimiter || c == '"' || c == '\n' || c == '\r');
+			}
+			if (!quote)
+			{
+				out.append(p, n);
+				return;
+			}
+			out += '"';
+			for (const char* end = p + n; p != end; ++p)
+			{
+				if (*p == '"') out += '"';
+				out += *p;
+			}
+			out += '"';
+		}
+	}
+
+
+	void appendValue(std::string& out, bool val, const FormatSpec&)
+	{
+		out += val ? "true" : "false";
+	}
+
+
+	void appendValue(std::string& out, Poco::Int8 val, const FormatSpec&)
+	{
+		NumberFormatter::append(out, static_cast<int>(val));
+	}
+
+
+	void appendValue(std::string& out, Poco::UInt8 val, const FormatSpec&)
+	{
+		NumberFormatter::append(out, static_cast<unsigned>(val));
+	}
+
+
+	void appendValue(std::string& out, Poco::Int16 val, const FormatSpec&)
+	{
+		NumberFormatter::append(out, static_cast<int>(val));
+	}
+
+
+	void appendValue(std::string& out, Poco::UInt16 val, const FormatSpec&)
+	{
+		NumberFormatter::append(out, static_cast<unsigned>(val));
+	}
+
+
+	void appendValue(std::string& out, Poco::Int32 val, const FormatSpec&)
+	{
+		NumberFormatter::append(out, static_cast<int>(val));
+	}
+
+
+	void appendValue(std::string& out, Poco::UInt32 val, const FormatSpec&)
+	{
+		NumberFormatter::append(out, static_cast<unsigned>(val));
+	}
+
+
+	void appendValue(std::string& out, Poco::Int64 val, const FormatSpec&)
+	{
+		NumberFormatter::append(out, val);
+	}
+
+
+	void appendValue(std::string& out, Poco::UInt64 val, const FormatSpec&)
+	{
+		NumberFormatter::append(out, val);
+	}
+
+
+	void appendValue(std::string& out, double val, const FormatSpec& spec)
+	{
+		if (spec.json && (FPEnvironment::isNaN(val) || FPEnvironment::isInfinite(val)))
+			out += "null";
+		else
+			NumberFormatter::append(out, val);
+	}
+
+
+	void appendValue(std::string& out, float val, const FormatSpec& spec)
+	{
+		if (spec.json && (FPEnvironment::isNaN(val) || FPEnvironment::isInfinite(val)))
+			out += "null";
+		else
+			NumberFormatter::append(out, val);
+	}
+
+
+	void appendValue(std::string& out, const std::string& val, const FormatSpec& spec)
+	{
+		appendText(out, val.data(), val.size(), spec);
+	}
+
+
+	void appendValue(std::string& out, const CLOB& val, const FormatSpec& spec)
+	{
+		appendText(out, val.rawContent(), val.size(), spec);
+	}
+
+
+	void appendValue(std::string& out, const BLOB& val, const FormatSpec& spec)
+	{
+		std::ostringstream ostr;
+		Base64Encoder encoder(ostr);
+		encoder.rdbuf()->setLineLength(0);
+		encoder.write(reinterpret_cast<const char*>(val.rawContent()), static_cast<std::streamsize>(val.size()));
+		encoder.close();
+		std::string encoded = ostr.str();
+		appendText(out, encoded.data(), encoded.size(), spec);
+	}
+
+
+	void appendValue(std::string& out, const Date& val, const FormatSpec& spec)
+	{
+		if (spec.json) out += '"';
+		NumberFormatter::append0(out, val.year(), 4);
+		out += '-';
+		NumberFormatter::append0(out, val.month(), 2);
+		out += '-';
+		NumberFormatter::append0(out, val.day(), 2);
+		if (spec.json) out += '"';
+	}
+
+
+	void appendValue(std::string& out, const Time& val, const FormatSpec& spec)
+	{
+		if (spec.json) out += '"';
+		NumberFormatter::append0(out, val.hour(), 2);
+		out += ':';
+		NumberFormatter::append0(out, val.minute(), 2);
+		out += ':';
+		NumberFormatter::append0(out, val.second(), 2);
+		if (spec.json) out += '"';
+	}
+
+
+	void appendValue(std::string& out, const DateTime& val, const FormatSpec& spec)
+	{
+		if (spec.json) out += '"';
+		DateTimeFormatter::append(out, val, DateTimeFormat::ISO8601_FORMAT);
+		if (spec.json) out += '"';
+	}
+
+
+	class ColumnWriter
+		/// Appends the formatted values of a single column.
+	{
+	public:
+		ColumnWriter(const RecordSet& recordSet, std::size_t col):
+			_recordSet(recordSet),
+			_col(col)
+		{
+		}
+
+		virtual ~ColumnWriter()
+		{
+		}
+
+		void write(std::size_t row, std::string& out, const FormatSpec& spec) const
+		{
+			if (_recordSet.isNull(_col, row))
+			{
+				if (spec.json) out += "null";
+				else out += spec.nullValue;
+			}
+			else writeValue(row, out, spec);
+		}
+
+	protected:
+		virtual void writeValue(std::size_t row, std::string& out, const FormatSpec& spec) const = 0;
+
+	private:
+		const RecordSet& _recordSet;
+		std::size_t      _col;
+	};
+
+
+	template <class C>
+	class TypedColumnWriter: public ColumnWriter
+	{
+	public:
+		TypedColumnWriter(const RecordSet& recordSet, std::size_t col):
+			ColumnWriter(recordSet, col),
+			_column(recordSet.column<C>(col))
+		{
+		}
+
+	protected:
+		void writeValue(std::size_t row, std::string& out, const FormatSpec& spec) const
+		{
+			appendValue(out, _column.value(row), spec);
+		}
+
+	private:
+		const Column<C>& _column;
+	};
+
+
+	template <class T>
+	class TypedColumnWriter<std::list<T> >: public ColumnWriter
+		/// Lists cannot be accessed by position in constant time,
+		/// so the values are indexed in a single pass over the
+		/// list before any row is written.
+	{
+	public:
+		TypedColumnWriter(const RecordSet& recordSet, std::size_t col):
+			ColumnWriter(recordSet, col)
+		{
+			const Column<std::list<T> >& column = recordSet.column<std::list<T> >(col);
+			_values.reserve(column.rowCount());
+			typename Column<std::list<T> >::Iterator it = column.begin();
+			typename Column<std::list<T> >::Iterator end = column.end();
+			for (; it != end; ++it) _values.push_back(&*it);
+		}
+
+	protected:
+		void writeValue(std::size_t row, std::string& out, const FormatSpec& spec) const
+		{
+			appendValue(out, *_values[row], spec);
+		}
+
+	private:
+		std::vector<const T*> _values;
+	};
+
+
+	typedef SharedPtr<ColumnWriter>   ColumnWriterPtr;
+	typedef std::vector<ColumnWriterPtr> ColumnWriterVec;
+	typedef std::vector<std::size_t>  RowVec;
+
+
+	template <class T>
+	ColumnWriter* createWriter(const RecordSet& recordSet, std::size_t col)
+	{
+		switch (recordSet.storage())
+		{
+		case Statement::STORAGE_VECTOR:
+			return new TypedColumnWriter<std::vector<T> >(recordSet, col);
+		case Statement::STORAGE_LIST:
+			return new TypedColumnWriter<std::list<T> >(recordSet, col);
+		case Statement::STORAGE_DEQUE:
+		case Statement::STORAGE_UNKNOWN:
+			return new TypedColumnWriter<std::deque<T> >(recordSet, col);
+		default:
+			throw IllegalStateException("Invalid storage setting.");
+		}
+	}
+
+
+	ColumnWriter* createWriter(const RecordSet& recordSet, std::size_t col)
+	{
+		switch (recordSet.columnType(col))
+		{
+		case MetaColumn::FDT_BOOL:      return createWriter<bool>(recordSet, col);
+		case MetaColumn::FDT_INT8:      return createWriter<Int8>(recordSet, col);
+		case MetaColumn::FDT_UINT8:     return createWriter<UInt8>(recordSet, col);
+		case MetaColumn::FDT_INT16:     return createWriter<Int16>(recordSet, col);
+		case MetaColumn::FDT_UINT16:    return createWriter<UInt16>(recordSet, col);
+		case MetaColumn::FDT_INT32:     return createWriter<Int32>(recordSet, col);
+		case MetaColumn::FDT_UINT32:    return createWriter<UInt32>(recordSet, col);
+		case MetaColumn::FDT_INT64:     return createWriter<Int64>(recordSet, col);
+		case MetaColumn::FDT_UINT64:    return createWriter<UInt64>(recordSet, col);
+		case MetaColumn::FDT_FLOAT:     return createWriter<float>(recordSet, col);
+		case MetaColumn::FDT_DOUBLE:    return createWriter<double>(recordSet, col);
+		case MetaColumn::FDT_STRING:    return createWriter<std::string>(recordSet, col);
+		case MetaColumn::FDT_BLOB:      return createWriter<BLOB>(recordSet, col);
+		case MetaColumn::FDT_CLOB:      return createWriter<CLOB>(recordSet, col);
+		case MetaColumn::FDT_DATE:      return createWriter<Date>(recordSet, col);
+		case MetaColumn::FDT_TIME:      return createWriter<Time>(recordSet, col);
+		case MetaColumn::FDT_TIMESTAMP: return createWriter<DateTime>(recordSet, col);
+		default:
+			throw UnknownTypeException("Data type not supported.");
+		}
+	}
+
+
+	class RowWriter
+		/// Formats complete rows, using the column writers
+		/// and the precomputed field separators.
+	{
+	public:
+		RowWriter(const ColumnWriterVec& writers, const std::vector<std::string>& separators, const std::string& rowEnd, const FormatSpec& spec):
+			_writers(writers),
+			_separators(separators),
+			_rowEnd(rowEnd),
+			_spec(spec)
+		{
+		}
+
+		void write(std::size_t row, std::string& out) const
+		{
+			std::size_t cols = _writers.size();
+			for (std::size_t col = 0; col < cols; ++col)
+			{
+				out += _separators[col];
+				_writers[col]->write(row, out, _spec);
+			}
+			out += _rowEnd;
+		}
+
+	private:
+		const ColumnWriterVec&          _writers;
+		const std::vector<std::string>& _separators;
+		const std::string&              _rowEnd;
+		const FormatSpec&               _spec;
+	};
+
+
+	class ChunkFormatter: public Runnable
+		/// Formats every n-th chunk of rows, starting with the given
+		/// one, and hands each finished chunk over to the exporting
+		/// thread before it starts with the next one.
+	{
+	public:
+		ChunkFormatter(const RowWriter& writer, const RowVec& rows, std::size_t first, std::size_t stride, std::size_t chunkSize):
+			_writer(writer),
+			_rows(rows),
+			_first(first),
+			_stride(stride),
+			_chunkSize(chunkSize),
+			_stop(false)
+		{
+			_free.set();
+		}
+
+		void run()
+		{
+			for (std::size_t begin = _first*_chunkSize; begin < _rows.size(); begin += _stride*_chunkSize)
+			{
+				_free.wait();
+				if (_stop) return;
+				_out.clear();
+				try
+				{
+					std::size_t end = begin + _chunkSize;
+					if (end > _rows.size()) end = _rows.size();
+					for (std::size_t i = begin; i < end; ++i)
+						_writer.write(_rows[i], _out);
+				}
+				catch (Exception& exc)
+				{
+					_error = exc.displayText();
+				}
+				catch (std::exception& exc)
+				{
+					_error = exc.what();
+				}
+				_ready.set();
+				if (!_error.empty()) return;
+			}
+		}
+
+		const std::string& take()
+			/// Waits until the next chunk has been formatted and
+			/// returns it. The chunk must be given back with
+			/// release() once it has been written.
+		{
+			_ready.wait();
+			if (!_error.empty()) throw DataException(_error);
+			return _out;
+		}
+
+		void release()
+		{
+			_free.set();
+		}
+
+		void stop()
+		{
+			_stop = true;
+			_free.set();
+		}
+
+	private:
+		const RowWriter& _writer;
+		const RowVec&    _rows;
+		std::size_t      _first;
+		std::size_t      _stride;
+		std::size_t      _chunkSize;
+		std::string      _out;
+		std::string      _error;
+		Event            _free;
+		Event            _ready;
+		bool             _stop;
+	};
+}
+
+
+RecordSetExporter::RecordSetExporter(Format format):
+	_format(format),
+	_delimiter(','),
+	_header(true),
+	_bufferSize(DEFAULT_BUFFER_SIZE),
+	_threads(1),
+	_chunkSize(DEFAULT_CHUNK_SIZE)
+{
+}
+
+
+RecordSetExporter::~RecordSetExporter()
+{
+}
+
+
+std::size_t RecordSetExporter::exportTo(const RecordSet& recordSet, std::ostream& ostr) const
+{
+	FormatSpec spec;
+	spec.json = (_format == FORMAT_JSON_LINES);
+	spec.delimiter = _delimiter;
+	spec.nullValue = _nullValue;
+
+	std::size_t cols = recordSet.columnCount();
+	ColumnWriterVec writers;
+	std::vector<std::string> separators;
+	std::string out;
+	out.reserve(_bufferSize);
+	for (std::size_t col = 0; col < cols; ++col)
+	{
+		writers.push_back(createWriter(recordSet, col));
+
+		std::string sep;
+		const std::string& name = recordSet.columnName(col);
+		if (spec.json)
+		{
+			sep += col ? ",": "{";
+			appendText(sep, name.data(), name.size(), spec);
+			sep += ':';
+		}
+		else
+		{
+			if (col) sep += _delimiter;
+			if (_header)
+			{
+				out += sep;
+				appendText(out, name.data(), name.size(), spec);
+			}
+		}
+		separators.push_back(sep);
+	}
+	if (!spec.json && _header && cols) out += '\n';
+	std::string rowEnd(spec.json ? (cols ? "}\n" : "{}\n") : "\n");
+
+	RowVec rows;
+	rows.reserve(recordSet.rowCount());
+	RecordSet::ConstIterator it = recordSet.begin();
+	RecordSet::ConstIterator end = recordSet.end();
+	for (; it != end; ++it) rows.push_back(it.position());
+
+	RowWriter writer(writers, separators, rowEnd, spec);
+	if (_threads <= 1 || rows.size() <= _chunkSize)
+	{
+		for (RowVec::const_iterator rIt = rows.begin(); rIt != rows.end(); ++rIt)
+		{
+			writer.write(*rIt, out);
+			if (out.size() >= _bufferSize)
+			{
+				ostr.write(out.data(), static_cast<std::streamsize>(out.size()));
+				out.clear();
+			}
+		}
+	}
+	else
+	{
+		ostr.write(out.data(), static_cast<std::streamsize>(out.size()));
+		out.clear();
+
+		std::size_t chunks = (rows.size() + _chunkSize - 1)/_chunkSize;
+		std::size_t threads = static_cast<std::size_t>(_threads) < chunks ? _threads : chunks;
+		std::vector<SharedPtr<ChunkFormatter> > formatters;
+		for (std::size_t i = 0; i < threads; ++i)
+			formatters.push_back(new ChunkFormatter(writer, rows, i, threads, _chunkSize));
+
+		ThreadPool pool(static_cast<int>(threads), static_cast<int>(threads));
+		for (std::size_t i = 0; i < threads; ++i)
+			pool.start(*formatters[i]);
+		try
+		{
+			for (std::size_t chunk = 0; chunk < chunks; ++chunk)
+			{
+				ChunkFormatter& formatter = *formatters[chunk % threads];
+				const std::string& formatted = formatter.take();
+				ostr.write(formatted.data(), static_cast<std::streamsize>(formatted.size()));
+				formatter.release();
+			}
+		}
+		catch (...)
+		{
+			for (std::size_t i = 0; i < threads; ++i)
+				formatters[i]->stop();
+			pool.joinAll();
+			throw;
+		}
+		pool.joinAll();
+	}
+	ostr.write(out.data(), static_cast<std::streamsize>(out.size()));
+
+	return rows.size();
+}
+
+
+} } // namespace Poco::Data
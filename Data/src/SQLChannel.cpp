@@ -36,6 +36,7 @@
 
 #include "Poco/Data/SQLChannel.h"
 #include "Poco/Data/SessionFactory.h"
+#include "Poco/Data/BulkBinding.h"
 #include "Poco/DateTime.h"
 #include "Poco/LoggingFactory.h"
 #include "Poco/Instantiator.h"
@@ -60,6 +61,9 @@ const std::string SQLChannel::PROP_MAX_AGE("keep");
 const std::string SQLChannel::PROP_ASYNC("async");
 const std::string SQLChannel::PROP_TIMEOUT("timeout");
 const std::string SQLChannel::PROP_THROW("throw");
+const std::string SQLChannel::PROP_BULK("bulk");
+const std::string SQLChannel::PROP_FLUSH("flush");
+const std::string SQLChannel::PROP_CAPACITY("capacity");
 
 
 SQLChannel::SQLChannel():
@@ -67,7 +71,15 @@ SQLChannel::SQLChannel():
 	_table("T_POCO_LOG"),
 	_timeout(1000),
 	_throw(true),
-	_async(true)
+	_async(true),
+	_bulk(0),
+	_flushInterval(1000),
+	_capacity(0),
+	_inFlight(0),
+	_dropped(0),
+	_logged(0),
+	_stopFlusher(false),
+	_flushRunnable(*this, &SQLChannel::runFlusher)
 {
 }
 
@@ -81,7 +93,15 @@ SQLChannel::SQLChannel(const std::string& connector,
 	_table("T_POCO_LOG"),
 	_timeout(1000),
 	_throw(true),
-	_async(true)
+	_async(true),
+	_bulk(0),
+	_flushInterval(1000),
+	_capacity(0),
+	_inFlight(0),
+	_dropped(0),
+	_logged(0),
+	_stopFlusher(false),
+	_flushRunnable(*this, &SQLChannel::runFlusher)
 {
 	open();
 }
@@ -89,7 +109,13 @@ SQLChannel::SQLChannel(const std::string& connector,
 
 SQLChannel::~SQLChannel()
 {
-	close();
+	try
+	{
+		close();
+	}
+	catch (...)
+	{
+	}
 }
 
 
@@ -100,18 +126,22 @@ void SQLChannel::open()
 
 	_pSession = new Session(_connector, _connect);
 	initLogStatement();
+	startFlusher();
 }
 
 	
 void SQLChannel::close()
 {
+	stopFlusher();
+	flush();
 	wait();
 }
 
 
 void SQLChannel::log(const Message& msg)
 {
-	if (_async) logAsync(msg);
+	if (_bulk) logBulk(msg);
+	else if (_async) logAsync(msg);
 	else logSync(msg);
 }
 
@@ -154,6 +184,175 @@ void SQLChannel::logSync(const Message& msg)
 	}
 }
 
+
+void SQLChannel::logBulk(const Message& msg)
+{
+	bool full = false;
+	{
+		FastMutex::ScopedLock lock(_mutex);
+		if (_capacity && _batch.size() + _inFlight >= _capacity)
+		{
+			++_dropped;
+			return;
+		}
+
+		const std::string& source = msg.getSource();
+		_batch.source.push_back(source.empty() ? _name : source);
+		_batch.name.push_back(_name);
+		_batch.pid.push_back(msg.getPid());
+		_batch.thread.push_back(msg.getThread());
+		_batch.tid.push_back(msg.getTid());
+		_batch.priority.push_back(msg.getPriority());
+		_batch.text.push_back(msg.getText());
+		_batch.dateTime.push_back(msg.getTime());
+		full = _batch.size() >= _bulk;
+	}
+	if (full) _flushEvent.set();
+}
+
+
+std::size_t SQLChannel::flush()
+{
+	FastMutex::ScopedLock flushLock(_flushMutex);
+
+	std::size_t count = 0;
+	{
+		FastMutex::ScopedLock lock(_mutex);
+		_flushBatch.swap(_batch);
+		count = _inFlight = _flushBatch.size();
+	}
+	if (0 == count) return 0;
+
+	try
+	{
+		insertBatch();
+	}
+	catch (Exception&)
+	{
+		{
+			FastMutex::ScopedLock lock(_mutex);
+			_dropped += count;
+			_inFlight = 0;
+		}
+		_flushBatch.clear();
+		if (_throw) throw;
+		return 0;
+	}
+
+	FastMutex::ScopedLock lock(_mutex);
+	_logged += count;
+	_inFlight = 0;
+	_flushBatch.clear();
+	return count;
+}
+
+
+void SQLChannel::insertBatch()
+{
+	if (_pArchiveStrategy) _pArchiveStrategy->archive();
+	if (!_pSession || !_pSession->isConnected()) open();
+
+	std::string sql;
+	Poco::format(sql, "INSERT INTO %s VALUES (?,?,?,?,?,?,?,?)", _table);
+
+	Statement stmt(*_pSession);
+	if (_pSession->getFeature("bulk"))
+	{
+		stmt << sql,
+			use(_flushBatch.source, bulk),
+			use(_flushBatch.name, bulk),
+			use(_flushBatch.pid, bulk),
+			use(_flushBatch.thread, bulk),
+			use(_flushBatch.tid, bulk),
+			use(_flushBatch.priority, bulk),
+			use(_flushBatch.text, bulk),
+			use(_flushBatch.dateTime, bulk);
+	}
+	else
+	{
+		stmt << sql,
+			use(_flushBatch.source),
+			use(_flushBatch.name),
+			use(_flushBatch.pid),
+			use(_flushBatch.thread),
+			use(_flushBatch.tid),
+			use(_flushBatch.priority),
+			use(_flushBatch.text),
+			use(_flushBatch.dateTime);
+	}
+
+	bool transact = _pSession->canTransact() && !_pSession->isTransaction();
+	if (transact) _pSession->begin();
+	try
+	{
+		stmt.execute();
+		if (transact) _pSession->commit();
+	}
+	catch (Exception&)
+	{
+		if (transact) _pSession->rollback();
+		throw;
+	}
+}
+
+
+std::size_t SQLChannel::backlog() const
+{
+	FastMutex::ScopedLock lock(_mutex);
+	return _batch.size() + _inFlight;
+}
+
+
+std::size_t SQLChannel::dropped() const
+{
+	FastMutex::ScopedLock lock(_mutex);
+	return _dropped;
+}
+
+
+std::size_t SQLChannel::logged() const
+{
+	FastMutex::ScopedLock lock(_mutex);
+	return _logged;
+}
+
+
+void SQLChannel::startFlusher()
+{
+	if (!_bulk || _flushThread.isRunning()) return;
+
+	_stopFlusher = false;
+	_flushThread.start(_flushRunnable);
+}
+
+
+void SQLChannel::stopFlusher()
+{
+	if (!_flushThread.isRunning()) return;
+
+	_stopFlusher = true;
+	_flushEvent.set();
+	_flushThread.join();
+}
+
+
+void SQLChannel::runFlusher()
+{
+	while (!_stopFlusher)
+	{
+		_flushEvent.tryWait(_flushInterval);
+		if (_stopFlusher) break;
+		try
+		{
+			flush();
+		}
+		catch (Exception&)
+		{
+			// failed entries have been counted as dropped
+		}
+	}
+}
+
 	
 void SQLChannel::setProperty(const std::string& name, const std::string& value)
 {
@@ -225,6 +424,32 @@ void SQLChannel::setProperty(const std::string& name, const std::string& value)
 	{
 		_throw = isTrue(value);
 	}
+	else if (name == PROP_BULK)
+	{
+		stopFlusher();
+		flush();
+		if (value.empty() || '0' == value[0])
+			_bulk = 0;
+		else
+			_bulk = NumberParser::parseUnsigned(value);
+		_batch.reserve(_bulk);
+		_flushBatch.reserve(_bulk);
+		startFlusher();
+	}
+	else if (name == PROP_FLUSH)
+	{
+		_flushInterval = NumberParser::parse(value);
+		if (_flushInterval <= 0)
+			throw InvalidArgumentException("Flush interval must be positive.");
+	}
+	else if (name == PROP_CAPACITY)
+	{
+		FastMutex::ScopedLock lock(_mutex);
+		if (value.empty() || '0' == value[0])
+			_capacity = 0;
+		else
+			_capacity = NumberParser::parseUnsigned(value);
+	}
 	else
 	{
 		Channel::setProperty(name, value);
@@ -268,6 +493,18 @@ std::string SQLChannel::getProperty(const std::string& name) const
 		if (_throw) return "true";
 		else return "false";
 	}
+	else if (name == PROP_BULK)
+	{
+		return NumberFormatter::format(_bulk);
+	}
+	else if (name == PROP_FLUSH)
+	{
+		return NumberFormatter::format(_flushInterval);
+	}
+	else if (name == PROP_CAPACITY)
+	{
+		return NumberFormatter::format(_capacity);
+	}
 	else
 	{
 		return Channel::getProperty(name);
@@ -295,6 +532,51 @@ void SQLChannel::initLogStatement()
 }
 
 
+std::size_t SQLChannel::LogBatch::size() const
+{
+	return text.size();
+}
+
+
+void SQLChannel::LogBatch::reserve(std::size_t n)
+{
+	source.reserve(n);
+	name.reserve(n);
+	pid.reserve(n);
+	thread.reserve(n);
+	tid.reserve(n);
+	priority.reserve(n);
+	text.reserve(n);
+	dateTime.reserve(n);
+}
+
+
+void SQLChannel::LogBatch::clear()
+{
+	source.clear();
+	name.clear();
+	pid.clear();
+	thread.clear();
+	tid.clear();
+	priority.clear();
+	text.clear();
+	dateTime.clear();
+}
+
+
+void SQLChannel::LogBatch::swap(LogBatch& other)
+{
+	source.swap(other.source);
+	name.swap(other.name);
+	pid.swap(other.pid);
+	thread.swap(other.thread);
+	tid.swap(other.tid);
+	priority.swap(other.priority);
+	text.swap(other.text);
+	dateTime.swap(other.dateTime);
+}
+
+
 void SQLChannel::registerChannel()
 {
 	Poco::LoggingFactory::defaultFactory().registerChannelClass("SQLChannel", 
@@ -37,6 +37,8 @@
 #include "Poco/Data/SessionPool.h"
 #include "Poco/Data/SessionFactory.h"
 #include "Poco/Data/DataException.h"
+#include "Poco/Data/Statement.h"
+#include "Poco/SharedPtr.h"
 #include <algorithm>
 
 
@@ -44,6 +46,51 @@ namespace Poco {
 namespace Data {
 
 
+class SessionPool::WarmUpTask: public Poco::Runnable
+	/// Creates one session for SessionPool::warmUp().
+{
+public:
+	WarmUpTask(SessionPool& pool): _pool(pool)
+	{
+	}
+
+	void run()
+	{
+		try
+		{
+			_session = new Session(_pool.newSession());
+		}
+		catch (Poco::Exception& exc)
+		{
+			_pException = exc.clone();
+		}
+		catch (std::exception& exc)
+		{
+			_pException = new Poco::Exception(exc.what());
+		}
+		catch (...)
+		{
+			_pException = new Poco::Exception("Unknown exception");
+		}
+	}
+
+	Poco::SharedPtr<Session> session() const
+	{
+		return _session;
+	}
+
+	Poco::SharedPtr<Poco::Exception> exception() const
+	{
+		return _pException;
+	}
+
+private:
+	SessionPool& _pool;
+	Poco::SharedPtr<Session> _session;
+	Poco::SharedPtr<Poco::Exception> _pException;
+};
+
+
 SessionPool::SessionPool(const std::string& connector, const std::string& connectionString, int minSessions, int maxSessions, int idleTime):
 	_connector(connector),
 	_connectionString(connectionString),
@@ -51,8 +98,15 @@ SessionPool::SessionPool(const std::string& connector, const std::string& connec
 	_maxSessions(maxSessions),
 	_idleTime(idleTime),
 	_nSessions(0),
+	_nValidating(0),
+	_threadAffinity(false),
 	_janitorTimer(1000*idleTime, 1000*idleTime/4),
-	_shutdown(false)
+	_shutdown(false),
+	_requests(0),
+	_affinityHits(0),
+	_peakUsed(0),
+	_totalWaitTime(0),
+	_maxWaitTime(0)
 {
 	Poco::TimerCallback<SessionPool> callback(*this, &SessionPool::onJanitorTimer);
 	_janitorTimer.start(callback);
@@ -68,8 +122,12 @@ SessionPool::~SessionPool()
 Session SessionPool::get(const std::string& name, bool value)
 {
 	Session s = get();
-	_addFeatureMap.insert(AddFeatureMap::value_type(s.impl(),
-		std::make_pair(name, s.getFeature(name))));
+	bool oldValue = s.getFeature(name);
+	{
+		Poco::Mutex::ScopedLock lock(_mutex);
+		_addFeatureMap.insert(AddFeatureMap::value_type(static_cast<PooledSessionImpl*>(s.impl())->impl(),
+			std::make_pair(name, oldValue)));
+	}
 	s.setFeature(name, value);
 
 	return s;
@@ -78,34 +136,140 @@ Session SessionPool::get(const std::string& name, bool value)
 
 Session SessionPool::get()
 {
-	Poco::Mutex::ScopedLock lock(_mutex);
-    if (_shutdown) throw InvalidAccessException("Session pool has been shut down.");
-	
-	purgeDeadSessions();
+	return get(0);
+}
 
-	if (_idleSessions.empty())
+
+Session SessionPool::get(long milliseconds)
+{
+	Poco::Timestamp start;
+	PooledSessionHolderPtr pHolder;
+	while (!pHolder)
 	{
-		if (_nSessions < _maxSessions)
+		bool create = false;
 		{
-			Session newSession(SessionFactory::instance().create(_connector, _connectionString));
-			applySettings(newSession.impl());
+			Poco::Mutex::ScopedLock lock(_mutex);
+			for (;;)
+			{
+				if (_shutdown) throw InvalidAccessException("Session pool has been shut down.");
+
+				if (_idleSessions.size() > static_cast<std::size_t>(_nValidating))
+				{
+					pHolder = popIdle();
+					break;
+				}
+				else if (_nSessions < _maxSessions)
+				{
+					// reserve the slot, the session is created without holding the lock
+					++_nSessions;
+					create = true;
+					break;
+				}
+				else if (_nValidating > 0)
+				{
+					// the session being validated is handed out when it turns out to be alive
+					_available.wait(_mutex);
+				}
+				else
+				{
+					Poco::Timestamp::TimeDiff remaining = Poco::Timestamp::TimeDiff(milliseconds)*1000 - start.elapsed();
+					if (remaining <= 0) throw SessionPoolExhaustedException(_connector, _connectionString);
+					_available.tryWait(_mutex, static_cast<long>(remaining/1000) + 1);
+				}
+			}
+		}
 
-			PooledSessionHolderPtr pHolder(new PooledSessionHolder(*this, newSession.impl()));
-			_idleSessions.push_front(pHolder);
-			++_nSessions;
+		if (create)
+		{
+			try
+			{
+				Session session(newSession());
+				pHolder = new PooledSessionHolder(*this, session.impl());
+			}
+			catch (...)
+			{
+				Poco::Mutex::ScopedLock lock(_mutex);
+				--_nSessions;
+				_available.broadcast();
+				throw;
+			}
 		}
-		else throw SessionPoolExhaustedException(_connector, _connectionString);
 	}
 
-	PooledSessionHolderPtr pHolder(_idleSessions.front());
+	Poco::Mutex::ScopedLock lock(_mutex);
+	if (_shutdown)
+	{
+		try	{ pHolder->session()->close(); }
+		catch (...) { }
+		if (_nSessions > 0) --_nSessions;
+		throw InvalidAccessException("Session pool has been shut down.");
+	}
+
 	PooledSessionImplPtr pPSI(new PooledSessionImpl(pHolder));
-	
-	_activeSessions.push_front(pHolder);
-	_idleSessions.pop_front();
+	_activeSessions.insert(pHolder);
+
+	++_requests;
+	int nUsed = static_cast<int>(_activeSessions.size());
+	if (nUsed > _peakUsed) _peakUsed = nUsed;
+	Poco::Timestamp::TimeDiff waitTime = start.elapsed();
+	_totalWaitTime += waitTime;
+	if (waitTime > _maxWaitTime) _maxWaitTime = waitTime;
+
 	return Session(pPSI);
 }
 
 
+SessionPool::PooledSessionHolderPtr SessionPool::popIdle()
+{
+	// the session being validated by the janitor is skipped
+	SessionList::iterator it = _idleSessions.begin();
+	if (_nValidating > 0 && it == _validatingIt) ++it;
+	if (_threadAffinity)
+	{
+		AffinityMap::iterator aIt = _affinityMap.find(Poco::Thread::currentTid());
+		if (aIt != _affinityMap.end() && !(_nValidating > 0 && aIt->second == _validatingIt))
+		{
+			it = aIt->second;
+			++_affinityHits;
+		}
+	}
+	PooledSessionHolderPtr pHolder(*it);
+	eraseIdle(it);
+	return pHolder;
+}
+
+
+void SessionPool::pushIdle(PooledSessionHolderPtr pHolder, bool front)
+{
+	SessionList::iterator it;
+	if (front)
+	{
+		_idleSessions.push_front(pHolder);
+		it = _idleSessions.begin();
+	}
+	else
+	{
+		it = _idleSessions.insert(_idleSessions.end(), pHolder);
+	}
+
+	// the most recently returned session of a thread wins
+	AffinityMap::iterator aIt = _affinityMap.find(pHolder->thread());
+	if (aIt == _affinityMap.end())
+		_affinityMap.insert(AffinityMap::value_type(pHolder->thread(), it));
+	else if (front)
+		aIt->second = it;
+}
+
+
+void SessionPool::eraseIdle(SessionList::iterator it)
+{
+	AffinityMap::iterator aIt = _affinityMap.find((*it)->thread());
+	if (aIt != _affinityMap.end() && aIt->second == it)
+		_affinityMap.erase(aIt);
+	_idleSessions.erase(it);
+}
+
+
 void SessionPool::purgeDeadSessions()
 {
 	Poco::Mutex::ScopedLock lock(_mutex);
@@ -116,7 +280,8 @@ void SessionPool::purgeDeadSessions()
 	{
 		if (!(*it)->session()->isConnected())
 		{
-			it = _idleSessions.erase(it);
+			SessionList::iterator dead = it++;
+			eraseIdle(dead);
 			--_nSessions;
 		}
 		else ++it;
@@ -149,8 +314,8 @@ int SessionPool::dead()
 	Poco::Mutex::ScopedLock lock(_mutex);
 	int count = 0;
 
-	SessionList::iterator it = _activeSessions.begin();
-	SessionList::iterator itEnd = _activeSessions.end();
+	SessionSet::iterator it = _activeSessions.begin();
+	SessionSet::iterator itEnd = _activeSessions.end();
 	for (; it != itEnd; ++it)
 	{
 		if (!(*it)->session()->isConnected())
@@ -222,6 +387,62 @@ Poco::Any SessionPool::getProperty(const std::string& name)
 }
 
 
+void SessionPool::setThreadAffinity(bool flag)
+{
+	Poco::Mutex::ScopedLock lock(_mutex);
+	_threadAffinity = flag;
+}
+
+
+bool SessionPool::getThreadAffinity() const
+{
+	Poco::Mutex::ScopedLock lock(_mutex);
+	return _threadAffinity;
+}
+
+
+int SessionPool::requests() const
+{
+	Poco::Mutex::ScopedLock lock(_mutex);
+	return _requests;
+}
+
+
+int SessionPool::affinityHits() const
+{
+	Poco::Mutex::ScopedLock lock(_mutex);
+	return _affinityHits;
+}
+
+
+int SessionPool::peakUsed() const
+{
+	Poco::Mutex::ScopedLock lock(_mutex);
+	return _peakUsed;
+}
+
+
+Poco::Timestamp::TimeDiff SessionPool::totalWaitTime() const
+{
+	Poco::Mutex::ScopedLock lock(_mutex);
+	return _totalWaitTime;
+}
+
+
+Poco::Timestamp::TimeDiff SessionPool::maxWaitTime() const
+{
+	Poco::Mutex::ScopedLock lock(_mutex);
+	return _maxWaitTime;
+}
+
+
+double SessionPool::utilization() const
+{
+	if (_maxSessions <= 0) return 0.0;
+	return double(used())/_maxSessions;
+}
+
+
 void SessionPool::applySettings(SessionImpl* pImpl)
 {
 	FeatureMap::Iterator fmIt = _featureMap.begin();
@@ -234,68 +455,295 @@ void SessionPool::applySettings(SessionImpl* pImpl)
 }
 
 
-void SessionPool::putBack(PooledSessionHolderPtr pHolder)
+void SessionPool::prepareStatements(Session& session)
 {
-	Poco::Mutex::ScopedLock lock(_mutex);
-	if (_shutdown) return;
+	StatementVec statements;
+	{
+		Poco::Mutex::ScopedLock lock(_mutex);
+		statements = _statements;
+	}
+
+	StatementVec::const_iterator it = statements.begin();
+	StatementVec::const_iterator end = statements.end();
+	for (; it != end; ++it)
+	{
+		Statement stmt(session);
+		stmt << *it;
+		stmt.prepare();
+	}
+}
+
+
+Session SessionPool::newSession()
+{
+	Session session(SessionFactory::instance().create(_connector, _connectionString));
+	applySettings(session.impl());
+	prepareStatements(session);
+	return session;
+}
+
+
+int SessionPool::warmUp()
+{
+	int count = 0;
+	{
+		Poco::Mutex::ScopedLock lock(_mutex);
+		if (_shutdown) throw InvalidAccessException("Session pool has been shut down.");
+
+		count = std::min(_minSessions, _maxSessions) - _nSessions;
+		if (count <= 0) return 0;
+		// reserve the slots, the sessions are created without holding the lock
+		_nSessions += count;
+	}
 
-	SessionList::iterator it = std::find(_activeSessions.begin(), _activeSessions.end(), pHolder);
-	if (it != _activeSessions.end())
+	std::vector<Poco::SharedPtr<WarmUpTask> > tasks;
+	std::vector<Poco::SharedPtr<Poco::Thread> > threads;
+	for (int i = 0; i < count; ++i)
+		tasks.push_back(new WarmUpTask(*this));
+
+	// the first session is created by the calling thread
+	for (int i = 1; i < count; ++i)
 	{
-		if (pHolder->session()->isConnected())
+		Poco::SharedPtr<Poco::Thread> pThread = new Poco::Thread;
+		try
+		{
+			pThread->start(*tasks[i]);
+			threads.push_back(pThread);
+		}
+		catch (Poco::Exception&)
 		{
-			// reverse settings applied at acquisition time, if any
-			AddPropertyMap::iterator pIt = _addPropertyMap.find(pHolder->session());
-			if (pIt != _addPropertyMap.end())
-				pHolder->session()->setProperty(pIt->second.first, pIt->second.second);
+			tasks[i]->run();
+		}
+	}
+	tasks[0]->run();
+
+	std::vector<Poco::SharedPtr<Poco::Thread> >::iterator tIt = threads.begin();
+	for (; tIt != threads.end(); ++tIt) (*tIt)->join();
 
-			AddFeatureMap::iterator fIt = _addFeatureMap.find(pHolder->session());
-			if (fIt != _addFeatureMap.end())
-				pHolder->session()->setFeature(fIt->second.first, fIt->second.second);
+	int created = 0;
+	Poco::SharedPtr<Poco::Exception> pException;
+	Poco::Mutex::ScopedLock lock(_mutex);
+	std::vector<Poco::SharedPtr<WarmUpTask> >::iterator it = tasks.begin();
+	for (; it != tasks.end(); ++it)
+	{
+		Poco::SharedPtr<Session> pSession = (*it)->session();
+		if (pSession && !_shutdown)
+		{
+			pushIdle(new PooledSessionHolder(*this, pSession->impl()), false);
+			++created;
+		}
+		else
+		{
+			if (pSession)
+			{
+				try	{ pSession->close(); }
+				catch (...) { }
+			}
+			if (!pException) pException = (*it)->exception();
+			if (_nSessions > 0) --_nSessions;
+		}
+	}
 
-			// re-apply the default pool settings
-			applySettings(pHolder->session());
+	_available.broadcast();
+	if (pException) pException->rethrow();
+	return created;
+}
 
-			pHolder->access();
-			_idleSessions.push_front(pHolder);
+
+void SessionPool::addStatement(const std::string& sql)
+{
+	Poco::Mutex::ScopedLock lock(_mutex);
+	if (_shutdown) throw InvalidAccessException("Session pool has been shut down.");
+
+	_statements.push_back(sql);
+}
+
+
+std::vector<std::string> SessionPool::statements() const
+{
+	Poco::Mutex::ScopedLock lock(_mutex);
+	return _statements;
+}
+
+
+void SessionPool::putBack(PooledSessionHolderPtr pHolder)
+{
+	bool hasProperty = false;
+	bool hasFeature = false;
+	PropertyPair property;
+	FeaturePair feature;
+	{
+		Poco::Mutex::ScopedLock lock(_mutex);
+		if (_shutdown) return;
+
+		if (_activeSessions.find(pHolder) == _activeSessions.end())
+		{
+			poco_bugcheck_msg("Unknown session passed to SessionPool::putBack()");
+		}
+
+		AddPropertyMap::iterator pIt = _addPropertyMap.find(pHolder->session());
+		if (pIt != _addPropertyMap.end())
+		{
+			property = pIt->second;
+			hasProperty = true;
+			_addPropertyMap.erase(pIt);
 		}
-		else --_nSessions;
 
-		_activeSessions.erase(it);
+		AddFeatureMap::iterator fIt = _addFeatureMap.find(pHolder->session());
+		if (fIt != _addFeatureMap.end())
+		{
+			feature = fIt->second;
+			hasFeature = true;
+			_addFeatureMap.erase(fIt);
+		}
 	}
-	else
+
+	// The session is still owned by the returning thread, so the
+	// settings applied at acquisition time, if any, can be reversed
+	// without holding the lock. Dead sessions are left to the janitor.
+	bool reset = true;
+	try
 	{
-		poco_bugcheck_msg("Unknown session passed to SessionPool::putBack()");
+		if (hasProperty)
+			pHolder->session()->setProperty(property.first, property.second);
+
+		if (hasFeature)
+			pHolder->session()->setFeature(feature.first, feature.second);
 	}
+	catch (...)
+	{
+		// the session is unusable
+		reset = false;
+		try	{ pHolder->session()->close(); }
+		catch (...) { }
+	}
+	pHolder->access();
+	pHolder->setThread(Poco::Thread::currentTid());
+
+	Poco::Mutex::ScopedLock lock(_mutex);
+	if (_shutdown) return;
+
+	_activeSessions.erase(pHolder);
+	if (reset)
+		pushIdle(pHolder, true);
+	else
+		--_nSessions;
+	_available.broadcast();
 }
 
 
 void SessionPool::onJanitorTimer(Poco::Timer&)
 {
-	Poco::Mutex::ScopedLock lock(_mutex);
-	if (_shutdown) return;
+	runJanitor();
+}
+
 
-	SessionList::iterator it = _idleSessions.begin(); 
-	while (_nSessions > _minSessions && it != _idleSessions.end())
+void SessionPool::runJanitor()
+{
+	Poco::FastMutex::ScopedLock janitorLock(_janitorMutex);
+	SessionList expired;
+	std::size_t candidates = 0;
+	PooledSessionHolderPtr pHolder;
 	{
-		if ((*it)->idle() > _idleTime || !(*it)->session()->isConnected())
-		{	
-			try	{ (*it)->session()->close(); }
+		Poco::Mutex::ScopedLock lock(_mutex);
+		if (_shutdown) return;
+
+		SessionList::iterator it = _idleSessions.begin(); 
+		while (it != _idleSessions.end())
+		{
+			SessionList::iterator cur = it++;
+			if (_nSessions > _minSessions && (*cur)->idle() > _idleTime)
+			{
+				expired.push_back(*cur);
+				eraseIdle(cur);
+				--_nSessions;
+			}
+			else ++candidates;
+		}
+		if (!expired.empty()) _available.broadcast();
+
+		// The idle sessions are validated one at a time, starting with
+		// the least recently used one. The session being validated stays
+		// in place, so that the order of the idle sessions is kept;
+		// get() skips it while _nValidating is set.
+		if (candidates > 0)
+		{
+			_validatingIt = --_idleSessions.end();
+			_nValidating = 1;
+			pHolder = *_validatingIt;
+		}
+	}
+
+	// Expired sessions are closed and idle sessions are validated
+	// without holding the lock, so that get() and putBack() are
+	// not blocked by the database round trips.
+	SessionList::iterator it = expired.begin();
+	for (; it != expired.end(); ++it)
+	{
+		try	{ (*it)->session()->close(); }
+		catch (...) { }
+	}
+
+	while (pHolder)
+	{
+		bool connected = false;
+		try
+		{
+			connected = pHolder->session()->isConnected();
+			// restore the default pool settings, in case they
+			// have been changed through the session
+			if (connected) applySettings(pHolder->session());
+		}
+		catch (...)
+		{
+			connected = false;
+		}
+		if (!connected)
+		{
+			try	{ pHolder->session()->close(); }
 			catch (...) { }
-			it = _idleSessions.erase(it);
+		}
+
+		Poco::Mutex::ScopedLock lock(_mutex);
+		_nValidating = 0;
+		// shutdown() closes the session along with the other idle sessions
+		if (_shutdown) return;
+
+		SessionList::iterator cur = _validatingIt;
+		bool more = --candidates > 0 && cur != _idleSessions.begin();
+		if (more) --_validatingIt;
+		if (!connected)
+		{
+			eraseIdle(cur);
 			--_nSessions;
 		}
-		else ++it;
+		_available.broadcast();
+		if (more)
+		{
+			_nValidating = 1;
+			pHolder = *_validatingIt;
+		}
+		else pHolder = 0;
 	}
 }
 
 
 void SessionPool::shutdown()
 {
-	Poco::Mutex::ScopedLock lock(_mutex);
-	if (_shutdown) return;
-	_shutdown = true;
+	{
+		Poco::Mutex::ScopedLock lock(_mutex);
+		if (_shutdown) return;
+		_shutdown = true;
+		_available.broadcast();
+	}
+
+	// the timer callback may be waiting for the lock
 	_janitorTimer.stop();
+	// a validation in progress ends before the sessions are closed
+	Poco::FastMutex::ScopedLock janitorLock(_janitorMutex);
+
+	Poco::Mutex::ScopedLock lock(_mutex);
+	_affinityMap.clear();
 	closeAll(_idleSessions);
 	closeAll(_activeSessions);
 }
@@ -314,4 +762,17 @@ void SessionPool::closeAll(SessionList& sessionList)
 }
 
 
+void SessionPool::closeAll(SessionSet& sessionSet)
+{
+	SessionSet::iterator it = sessionSet.begin(); 
+	for (; it != sessionSet.end(); ++it)
+	{
+		try	{ (*it)->session()->close(); }
+		catch (...) { }
+		if (_nSessions > 0) --_nSessions;
+	}
+	sessionSet.clear();
+}
+
+
 } } // namespace Poco::Data
@@ -113,7 +113,7 @@ std::size_t Statement::execute(bool reset)
 {
 	Mutex::ScopedLock lock(_mutex);
 	bool isDone = done();
-	if (initialized() || paused() || isDone)
+	if (initialized() || prepared() || paused() || isDone)
 	{
 		if (_arguments.size()) 
 		{
@@ -136,10 +136,26 @@ std::size_t Statement::execute(bool reset)
 }
 
 
+Statement& Statement::prepare()
+{
+	Mutex::ScopedLock lock(_mutex);
+	if (!initialized())
+		throw InvalidAccessException("Statement already executed.");
+
+	if (_arguments.size()) 
+	{
+		_pImpl->formatSQL(_arguments);
+		_arguments.clear();
+	}
+	_pImpl->compile();
+	return *this;
+}
+
+
 const Statement::Result& Statement::executeAsync(bool reset)
 {
 	Mutex::ScopedLock lock(_mutex);
-	if (initialized() || paused() || done())
+	if (initialized() || prepared() || paused() || done())
 		return doAsyncExec(reset);
 	else
 		throw InvalidAccessException("Statement still executing.");
@@ -33,6 +33,7 @@
 #include "SessionImpl.h"
 #include "TestStatementImpl.h"
 #include "Connector.h"
+#include "Poco/Thread.h"
 
 
 namespace Poco {
@@ -43,7 +44,8 @@ namespace Test {
 SessionImpl::SessionImpl(const std::string& init, std::size_t timeout):
 	Poco::Data::AbstractSessionImpl<SessionImpl>(init, timeout),
 	_f(false),
-	_connected(true)
+	_connected(true),
+	_pingDelay(0)
 {
 	addFeature("f1", &SessionImpl::setF, &SessionImpl::getF);
 	addFeature("f2", 0, &SessionImpl::getF);
@@ -52,6 +54,7 @@ SessionImpl::SessionImpl(const std::string& init, std::size_t timeout):
 	addProperty("p1", &SessionImpl::setP, &SessionImpl::getP);
 	addProperty("p2", 0, &SessionImpl::getP);
 	addProperty("p3", &SessionImpl::setP, &SessionImpl::getP);
+	addProperty("pingDelay", &SessionImpl::setPingDelay, &SessionImpl::getPingDelay);
 }
 
 
@@ -74,6 +77,7 @@ void SessionImpl::close()
 
 bool SessionImpl::isConnected()
 {
+	if (_pingDelay > 0) Poco::Thread::sleep(_pingDelay);
 	return _connected;
 }
 
@@ -187,4 +191,16 @@ Poco::Any SessionImpl::getP(const std::string& name)
 }
 
 
+void SessionImpl::setPingDelay(const std::string& name, const Poco::Any& value)
+{
+	_pingDelay = Poco::AnyCast<int>(value);
+}
+
+
+Poco::Any SessionImpl::getPingDelay(const std::string& name)
+{
+	return _pingDelay;
+}
+
+
 } } } // namespace Poco::Data::Test
@@ -118,11 +118,15 @@ public:
 	bool getF(const std::string& name);
 	void setP(const std::string& name, const Poco::Any& value);
 	Poco::Any getP(const std::string& name);
+	void setPingDelay(const std::string& name, const Poco::Any& value);
+	Poco::Any getPingDelay(const std::string& name);
+		/// Sets/gets the time, in milliseconds, isConnected() takes.
 
 private:
 	bool         _f;
 	Poco::Any    _p;
 	bool         _connected;
+	int          _pingDelay;
 	std::string  _connectionString;
 };
 
@@ -36,13 +36,20 @@
 #include "Poco/Data/SessionPool.h"
 #include "Poco/Data/SessionPoolContainer.h"
 #include "Poco/Thread.h"
+#include "Poco/Runnable.h"
+#include "Poco/RunnableAdapter.h"
+#include "Poco/Event.h"
 #include "Poco/AutoPtr.h"
 #include "Poco/Exception.h"
+#include "Poco/Timestamp.h"
 #include "Connector.h"
 
 
 using namespace Poco::Data::Keywords;
 using Poco::Thread;
+using Poco::Runnable;
+using Poco::RunnableAdapter;
+using Poco::Event;
 using Poco::AutoPtr;
 using Poco::NotFoundException;
 using Poco::InvalidAccessException;
@@ -54,6 +61,56 @@ using Poco::Data::SessionPoolExistsException;
 using Poco::Data::SessionUnavailableException;
 
 
+namespace
+{
+	class SessionUser: public Runnable
+	{
+	public:
+		SessionUser(SessionPool& pool): _pool(pool)
+		{
+		}
+
+		void run()
+		{
+			Session s(_pool.get());
+			s.setProperty("p1", 2);
+			_acquired.set();
+			_release.wait();
+		}
+
+		Event& acquired()
+		{
+			return _acquired;
+		}
+
+		Event& release()
+		{
+			return _release;
+		}
+
+	private:
+		SessionPool& _pool;
+		Event _acquired;
+		Event _release;
+	};
+
+	class JanitorPool: public SessionPool
+		/// Lets the tests run the janitor instead of waiting for its timer.
+	{
+	public:
+		JanitorPool(const std::string& connector, const std::string& connectionString, int minSessions, int maxSessions, int idleTime):
+			SessionPool(connector, connectionString, minSessions, maxSessions, idleTime)
+		{
+		}
+
+		void runJanitor()
+		{
+			SessionPool::runJanitor();
+		}
+	};
+}
+
+
 SessionPoolTest::SessionPoolTest(const std::string& name): CppUnit::TestCase(name)
 {
 	Poco::Data::Test::Connector::addToFactory();
@@ -68,7 +125,7 @@ SessionPoolTest::~SessionPoolTest()
 
 void SessionPoolTest::testSessionPool()
 {
-	SessionPool pool("test", "cs", 1, 4, 2);
+	JanitorPool pool("test", "cs", 1, 4, 2);
 	
 	pool.setFeature("f1", true);
 	assert (pool.getFeature("f1"));
@@ -207,6 +264,8 @@ void SessionPoolTest::testSessionPool()
 	assert (pool.dead() == 1);
 	
 	s6.close();
+	// dead sessions are purged by the janitor
+	pool.runJanitor();
 	assert (pool.capacity() == 4);
 	assert (pool.allocated() == 2);
 	assert (pool.idle() == 0);
@@ -254,6 +313,157 @@ void SessionPoolTest::testSessionPoolContainer()
 }
 
 
+void SessionPoolTest::testThreadAffinity()
+{
+	SessionPool pool("test", "cs", 1, 4, 60);
+	assert (!pool.getThreadAffinity());
+
+	assert (pool.requests() == 0);
+	assert (pool.peakUsed() == 0);
+	assert (pool.utilization() == 0.0);
+
+	SessionUser user(pool);
+	Thread thread;
+	{
+		Session s1(pool.get());
+		s1.setProperty("p1", 1);
+
+		thread.start(user);
+		user.acquired().wait();
+		assert (pool.used() == 2);
+		assert (pool.utilization() == 0.5);
+	}
+	// the other thread returns its session last,
+	// so that session is at the top of the idle stack
+	user.release().set();
+	thread.join();
+	assert (pool.idle() == 2);
+	assert (pool.peakUsed() == 2);
+
+	pool.setThreadAffinity(true);
+	assert (pool.getThreadAffinity());
+	{
+		// the session last used by this thread is taken, although
+		// the other session is at the top of the idle stack
+		Session s2(pool.get());
+		assert (1 == Poco::AnyCast<int>(s2.getProperty("p1")));
+		assert (pool.affinityHits() == 1);
+
+		pool.setThreadAffinity(false);
+		Session s3(pool.get());
+		assert (2 == Poco::AnyCast<int>(s3.getProperty("p1")));
+		assert (pool.affinityHits() == 1);
+	}
+
+	assert (pool.requests() == 4);
+	assert (pool.peakUsed() == 2);
+	assert (pool.maxWaitTime() >= 0);
+	assert (pool.totalWaitTime() >= pool.maxWaitTime());
+	assert (pool.allocated() == 2);
+	assert (pool.allocated() == pool.used() + pool.idle());
+}
+
+
+void SessionPoolTest::testWarmUp()
+{
+	SessionPool pool("test", "cs", 3, 4, 60);
+	pool.setProperty("p1", 1);
+	pool.addStatement("SELECT 1");
+	pool.addStatement("SELECT 2");
+	assert (pool.statements().size() == 2);
+	assert (pool.statements()[1] == "SELECT 2");
+	assert (pool.allocated() == 0);
+
+	assert (pool.warmUp() == 3);
+	assert (pool.allocated() == 3);
+	assert (pool.idle() == 3);
+	assert (pool.used() == 0);
+	assert (pool.warmUp() == 0);
+	assert (pool.allocated() == 3);
+
+	try
+	{
+		pool.setProperty("p2", 2);
+		fail ("must fail");
+	}
+	catch (InvalidAccessException&) { }
+
+	{
+		Session s1(pool.get());
+		assert (1 == Poco::AnyCast<int>(s1.getProperty("p1")));
+		Session s2(pool.get());
+		Session s3(pool.get());
+		assert (pool.allocated() == 3);
+		assert (pool.idle() == 0);
+
+		// pool growth prepares the registered statements as well
+		Session s4(pool.get());
+		assert (pool.allocated() == 4);
+	}
+	assert (pool.idle() == 4);
+
+	pool.shutdown();
+	try
+	{
+		pool.warmUp();
+		fail ("must fail");
+	}
+	catch (InvalidAccessException&) { }
+}
+
+
+void SessionPoolTest::testJanitorValidation()
+{
+	// the janitor timer does not fire during the test
+	JanitorPool pool("test", "cs", 2, 4, 3600);
+	pool.setProperty("pingDelay", 100);
+	assert (pool.warmUp() == 2);
+
+	// while the janitor validates one session,
+	// get() hands out the other one
+	RunnableAdapter<JanitorPool> janitor(pool, &JanitorPool::runJanitor);
+	Thread thread;
+	thread.start(janitor);
+	while (!thread.tryJoin(0))
+	{
+		Session s(pool.get());
+		assert (pool.allocated() == 2);
+	}
+	assert (pool.allocated() == 2);
+	assert (pool.idle() == 2);
+
+	// returning a dead session does not check it, the janitor purges it
+	{
+		Session s(pool.get());
+		s.setFeature("connected", false);
+	}
+	assert (pool.allocated() == 2);
+	assert (pool.idle() == 2);
+	pool.runJanitor();
+	assert (pool.allocated() == 1);
+	assert (pool.idle() == 1);
+
+	// validation keeps the order of the idle sessions
+	{
+		Session s1(pool.get());
+		Session s2(pool.get());
+		assert (pool.allocated() == 2);
+	}
+	pool.setThreadAffinity(true);
+	{
+		Session s(pool.get());
+		assert (pool.affinityHits() == 1);
+	}
+	pool.runJanitor();
+	{
+		Session s(pool.get());
+		assert (pool.affinityHits() == 2);
+	}
+	assert (pool.allocated() == 2);
+	assert (pool.idle() == 2);
+}
+
+
 void SessionPoolTest::setUp()
 {
 }
@@ -270,6 +480,9 @@ CppUnit::Test* SessionPoolTest::suite()
 
 	CppUnit_addTest(pSuite, SessionPoolTest, testSessionPool);
 	CppUnit_addTest(pSuite, SessionPoolTest, testSessionPoolContainer);
+	CppUnit_addTest(pSuite, SessionPoolTest, testThreadAffinity);
+	CppUnit_addTest(pSuite, SessionPoolTest, testWarmUp);
+	CppUnit_addTest(pSuite, SessionPoolTest, testJanitorValidation);
 
 	return pSuite;
 }
@@ -48,6 +48,9 @@ public:
 
 	void testSessionPool();
 	void testSessionPoolContainer();
+	void testThreadAffinity();
+	void testWarmUp();
+	void testJanitorValidation();
 
 	void setUp();
 	void tearDown();
@@ -0,0 +1,167 @@
+//
+// Deflater.h
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Streams
+// Module:  Deflater
+//
+// Definition of the Deflater class.
+//
+// Copyright (c) 2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#ifndef Foundation_Deflater_INCLUDED
+#define Foundation_Deflater_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/DeflatingStream.h"
+
+
+namespace Poco {
+
+
+class Foundation_API Deflater
+	/// This class compresses data from one memory buffer into another,
+	/// using zlib's deflate algorithm, without the overhead of a stream.
+	/// It produces the same output as DeflatingOutputStream.
+	///
+	/// Input is passed with setInput() and compressed with deflate() until
+	/// needsInput() returns true. After the last input has been passed,
+	/// finish() must be called and deflate() called until finished()
+	/// returns true.
+	/// Example:
+	///     Deflater deflater(DeflatingStreamBuf::STREAM_GZIP);
+	///     deflater.setInput(data.data(), data.size());
+	///     deflater.finish();
+	///     char buffer[8192];
+	///     while (!deflater.finished())
+	///     {
+	///         std::size_t n = deflater.deflate(buffer, sizeof(buffer));
+	///         ostr.write(buffer, n);
+	///     }
+{
+public:
+	Deflater(DeflatingStreamBuf::StreamType type = DeflatingStreamBuf::STREAM_ZLIB, int level = Z_DEFAULT_COMPRESSION);
+		/// Creates a Deflater with the given stream type and compression level.
+
+	Deflater(int windowBits, int level);
+		/// Creates a Deflater with the given windowBits and compression level.
+		///
+		/// Please refer to the zlib documentation of deflateInit2() for a description
+		/// of the windowBits parameter.
+
+	~Deflater();
+		/// Destroys the Deflater.
+
+	void setInput(const char* buffer, std::size_t length);
+		/// Sets the data to be compressed next. The buffer must remain
+		/// valid until needsInput() returns true.
+		///
+		/// Throws an InvalidArgumentException if length is too large for zlib.
+
+	bool needsInput() const;
+		/// Returns true if all input has been consumed.
+
+	void finish();
+		/// Tells the Deflater that the current input is the last one.
+		/// Subsequent calls to deflate() complete the compressed data.
+
+	bool finished() const;
+		/// Returns true if the compressed data is complete.
+
+	std::size_t deflate(char* buffer, std::size_t length);
+		/// Compresses pending input into the given buffer, and returns
+		/// the number of bytes stored in it. Returns 0 if more input is
+		/// needed or the compressed data is complete.
+		///
+		/// Throws an IOException if zlib reports an error.
+
+	std::size_t maxDeflatedSize(std::size_t length);
+		/// Returns an upper bound for the size of the compressed data
+		/// for length bytes of input, if passed in a single call
+		/// before any other data.
+
+	void reset();
+		/// Resets the Deflater, so that a new stream can be compressed
+		/// with the same settings.
+
+	Poco::UInt64 totalIn() const;
+		/// Returns the number of bytes consumed so far.
+
+	Poco::UInt64 totalOut() const;
+		/// Returns the number of compressed bytes produced so far.
+
+private:
+	Deflater(const Deflater&);
+	Deflater& operator = (const Deflater&);
+
+	z_stream _zstr;
+	bool     _finish;
+	bool     _finished;
+};
+
+
+//
+// inlines
+//
+inline bool Deflater::needsInput() const
+{
+	return _zstr.avail_in == 0;
+}
+
+
+inline void Deflater::finish()
+{
+	_finish = true;
+}
+
+
+inline bool Deflater::finished() const
+{
+	return _finished;
+}
+
+
+inline Poco::UInt64 Deflater::totalIn() const
+{
+	return _zstr.total_in;
+}
+
+
+inline Poco::UInt64 Deflater::totalOut() const
+{
+	return _zstr.total_out;
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_Deflater_INCLUDED
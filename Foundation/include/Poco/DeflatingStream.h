@@ -61,6 +61,12 @@ class Foundation_API DeflatingStreamBuf: public BufferedStreamBuf
 	/// Output streams should always call close() to ensure
 	/// proper completion of compression.
 	/// A compression level (0 to 9) can be specified in the constructor.
+	///
+	/// The size of the stream buffer, which is also the size of the
+	/// buffer holding compressed data, can be given in the constructor.
+	/// Larger buffers mean fewer calls into zlib and into the underlying
+	/// stream. Writes and reads of at least the buffer size bypass the
+	/// stream buffer and go directly to zlib.
 {
 public:
 	enum StreamType
@@ -69,22 +75,27 @@ public:
 		STREAM_GZIP  /// Create a gzip header, use CRC-32 checksum.
 	};
 
-	DeflatingStreamBuf(std::istream& istr, StreamType type, int level);
+	enum
+	{
+		DEFAULT_BUFFER_SIZE = 32768
+	};
+
+	DeflatingStreamBuf(std::istream& istr, StreamType type, int level, std::size_t bufferSize = DEFAULT_BUFFER_SIZE);
 		/// Creates a DeflatingStreamBuf for compressing data read
 		/// from the given input stream.
 
-	DeflatingStreamBuf(std::istream& istr, int windowBits, int level);
+	DeflatingStreamBuf(std::istream& istr, int windowBits, int level, std::size_t bufferSize = DEFAULT_BUFFER_SIZE);
 		/// Creates a DeflatingStreamBuf for compressing data read
 		/// from the given input stream.
 		///
 		/// Please refer to the zlib documentation of deflateInit2() for a description
 		/// of the windowBits parameter.
 		
-	DeflatingStreamBuf(std::ostream& ostr, StreamType type, int level);
+	DeflatingStreamBuf(std::ostream& ostr, StreamType type, int level, std::size_t bufferSize = DEFAULT_BUFFER_SIZE);
 		/// Creates a DeflatingStreamBuf for compressing data passed
 		/// through and forwarding it to the given output stream.
 
-	DeflatingStreamBuf(std::ostream& ostr, int windowBits, int level);
+	DeflatingStreamBuf(std::ostream& ostr, int windowBits, int level, std::size_t bufferSize = DEFAULT_BUFFER_SIZE);
 		/// Creates a DeflatingStreamBuf for compressing data passed
 		/// through and forwarding it to the given output stream.
 		///
@@ -103,12 +114,13 @@ protected:
 	int readFromDevice(char* buffer, std::streamsize length);
 	int writeToDevice(const char* buffer, std::streamsize length);
 	virtual int sync();
+	virtual std::streamsize xsgetn(char* buffer, std::streamsize length);
+	virtual std::streamsize xsputn(const char* buffer, std::streamsize length);
 
 private:
-	enum 
+	enum
 	{
-		STREAM_BUFFER_SIZE  = 1024,
-		DEFLATE_BUFFER_SIZE = 32768
+		MAX_CHUNK_SIZE = 0x40000000
 	};
 
 	std::istream* _pIstr;
@@ -116,6 +128,7 @@ private:
 	char*    _buffer;
 	z_stream _zstr;
 	bool     _eof;
+	std::size_t _bufferSize;
 };
 
 
@@ -126,22 +139,22 @@ class Foundation_API DeflatingIOS: public virtual std::ios
 	/// order of the stream buffer and base classes.
 {
 public:
-	DeflatingIOS(std::ostream& ostr, DeflatingStreamBuf::StreamType type = DeflatingStreamBuf::STREAM_ZLIB, int level = Z_DEFAULT_COMPRESSION);
+	DeflatingIOS(std::ostream& ostr, DeflatingStreamBuf::StreamType type = DeflatingStreamBuf::STREAM_ZLIB, int level = Z_DEFAULT_COMPRESSION, std::size_t bufferSize = DeflatingStreamBuf::DEFAULT_BUFFER_SIZE);
 		/// Creates a DeflatingIOS for compressing data passed
 		/// through and forwarding it to the given output stream.
 
-	DeflatingIOS(std::ostream& ostr, int windowBits, int level);
+	DeflatingIOS(std::ostream& ostr, int windowBits, int level, std::size_t bufferSize = DeflatingStreamBuf::DEFAULT_BUFFER_SIZE);
 		/// Creates a DeflatingIOS for compressing data passed
 		/// through and forwarding it to the given output stream.
 		///
 		/// Please refer to the zlib documentation of deflateInit2() for a description
 		/// of the windowBits parameter.
 
-	DeflatingIOS(std::istream& istr, DeflatingStreamBuf::StreamType type = DeflatingStreamBuf::STREAM_ZLIB, int level = Z_DEFAULT_COMPRESSION);
+	DeflatingIOS(std::istream& istr, DeflatingStreamBuf::StreamType type = DeflatingStreamBuf::STREAM_ZLIB, int level = Z_DEFAULT_COMPRESSION, std::size_t bufferSize = DeflatingStreamBuf::DEFAULT_BUFFER_SIZE);
 		/// Creates a DeflatingIOS for compressing data read
 		/// from the given input stream.
 
-	DeflatingIOS(std::istream& istr, int windowBits, int level);
+	DeflatingIOS(std::istream& istr, int windowBits, int level, std::size_t bufferSize = DeflatingStreamBuf::DEFAULT_BUFFER_SIZE);
 		/// Creates a DeflatingIOS for compressing data read
 		/// from the given input stream.
 		///
@@ -172,11 +185,11 @@ class Foundation_API DeflatingOutputStream: public DeflatingIOS, public std::ost
 	///     ostr.close();
 {
 public:
-	DeflatingOutputStream(std::ostream& ostr, DeflatingStreamBuf::StreamType type = DeflatingStreamBuf::STREAM_ZLIB, int level = Z_DEFAULT_COMPRESSION);
+	DeflatingOutputStream(std::ostream& ostr, DeflatingStreamBuf::StreamType type = DeflatingStreamBuf::STREAM_ZLIB, int level = Z_DEFAULT_COMPRESSION, std::size_t bufferSize = DeflatingStreamBuf::DEFAULT_BUFFER_SIZE);
 		/// Creates a DeflatingOutputStream for compressing data passed
 		/// through and forwarding it to the given output stream.
 
-	DeflatingOutputStream(std::ostream& ostr, int windowBits, int level);
+	DeflatingOutputStream(std::ostream& ostr, int windowBits, int level, std::size_t bufferSize = DeflatingStreamBuf::DEFAULT_BUFFER_SIZE);
 		/// Creates a DeflatingOutputStream for compressing data passed
 		/// through and forwarding it to the given output stream.
 		///
@@ -201,11 +214,11 @@ class Foundation_API DeflatingInputStream: public DeflatingIOS, public std::istr
 	/// using zlib's deflate algorithm.
 {
 public:
-	DeflatingInputStream(std::istream& istr, DeflatingStreamBuf::StreamType type = DeflatingStreamBuf::STREAM_ZLIB, int level = Z_DEFAULT_COMPRESSION);
+	DeflatingInputStream(std::istream& istr, DeflatingStreamBuf::StreamType type = DeflatingStreamBuf::STREAM_ZLIB, int level = Z_DEFAULT_COMPRESSION, std::size_t bufferSize = DeflatingStreamBuf::DEFAULT_BUFFER_SIZE);
 		/// Creates a DeflatingIOS for compressing data read
 		/// from the given input stream.
 
-	DeflatingInputStream(std::istream& istr, int windowBits, int level);
+	DeflatingInputStream(std::istream& istr, int windowBits, int level, std::size_t bufferSize = DeflatingStreamBuf::DEFAULT_BUFFER_SIZE);
 		/// Creates a DeflatingIOS for compressing data read
 		/// from the given input stream.
 		///
@@ -0,0 +1,167 @@
+//
+// Inflater.h
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Streams
+// Module:  Inflater
+//
+// Definition of the Inflater class.
+//
+// Copyright (c) 2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#ifndef Foundation_Inflater_INCLUDED
+#define Foundation_Inflater_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/InflatingStream.h"
+
+
+namespace Poco {
+
+
+class Foundation_API Inflater
+	/// This class expands compressed data from one memory buffer into
+	/// another, using zlib's inflate algorithm, without the overhead
+	/// of a stream. It accepts the same input as InflatingInputStream.
+	///
+	/// Input is passed with setInput() and expanded with inflate() until
+	/// inflate() returns 0, at which point either finished() returns true,
+	/// or more input must be passed. zlib may still hold output after all
+	/// input has been consumed, so needsInput() alone does not tell whether
+	/// inflate() must be called again. If the input runs out before finished()
+	/// returns true, the compressed data is truncated.
+	/// Example:
+	///     Inflater inflater(InflatingStreamBuf::STREAM_GZIP);
+	///     inflater.setInput(data.data(), data.size());
+	///     char buffer[8192];
+	///     std::size_t n;
+	///     while ((n = inflater.inflate(buffer, sizeof(buffer))) > 0)
+	///     {
+	///         ostr.write(buffer, n);
+	///     }
+	///     if (!inflater.finished()) throw DataFormatException("truncated data");
+{
+public:
+	Inflater(InflatingStreamBuf::StreamType type = InflatingStreamBuf::STREAM_ZLIB);
+		/// Creates an Inflater for the given stream type.
+
+	Inflater(int windowBits);
+		/// Creates an Inflater with the given windowBits.
+		///
+		/// Please refer to the zlib documentation of inflateInit2() for a description
+		/// of the windowBits parameter.
+
+	~Inflater();
+		/// Destroys the Inflater.
+
+	void setInput(const char* buffer, std::size_t length);
+		/// Sets the compressed data to be expanded next. The buffer must
+		/// remain valid until needsInput() returns true.
+		///
+		/// Throws an InvalidArgumentException if length is too large for zlib.
+
+	bool needsInput() const;
+		/// Returns true if all input has been consumed.
+		///
+		/// This does not mean that all output has been produced;
+		/// call inflate() until it returns 0 to drain it.
+
+	bool finished() const;
+		/// Returns true if the end of the compressed data has been reached.
+
+	std::size_t inflate(char* buffer, std::size_t length);
+		/// Expands pending input into the given buffer, and returns
+		/// the number of bytes stored in it. Returns 0 if more input
+		/// is needed or the end of the compressed data has been reached.
+		///
+		/// Throws an IOException if the compressed data is corrupt.
+
+	std::size_t remaining() const;
+		/// Returns the number of input bytes following the end of the
+		/// compressed data, e.g., another gzip member.
+
+	void reset();
+		/// Resets the Inflater, so that a new stream can be expanded.
+		/// Input not yet consumed is kept.
+
+	Poco::UInt64 totalIn() const;
+		/// Returns the number of compressed bytes consumed so far.
+
+	Poco::UInt64 totalOut() const;
+		/// Returns the number of bytes produced so far.
+
+private:
+	Inflater(const Inflater&);
+	Inflater& operator = (const Inflater&);
+
+	z_stream _zstr;
+	bool     _finished;
+	bool     _check;
+};
+
+
+//
+// inlines
+//
+inline bool Inflater::needsInput() const
+{
+	return _zstr.avail_in == 0;
+}
+
+
+inline bool Inflater::finished() const
+{
+	return _finished;
+}
+
+
+inline std::size_t Inflater::remaining() const
+{
+	return _finished ? _zstr.avail_in : 0;
+}
+
+
+inline Poco::UInt64 Inflater::totalIn() const
+{
+	return _zstr.total_in;
+}
+
+
+inline Poco::UInt64 Inflater::totalOut() const
+{
+	return _zstr.total_out;
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_Inflater_INCLUDED
@@ -60,6 +60,11 @@ class Foundation_API InflatingStreamBuf: public BufferedStreamBuf
 	/// Both zlib (deflate) streams and gzip streams are supported.
 	/// Output streams should always call close() to ensure
 	/// proper completion of decompression.
+	///
+	/// The size of the stream buffer, which is also the size of the
+	/// buffer holding compressed data, can be given in the constructor.
+	/// Reads and writes of at least the buffer size bypass the stream
+	/// buffer and go directly to zlib.
 {
 public:
 	enum StreamType
@@ -69,22 +74,27 @@ public:
 		STREAM_ZIP   /// STREAM_ZIP is handled as STREAM_ZLIB, except that we do not check the ADLER32 value (must be checked by caller)
 	};
 
-	InflatingStreamBuf(std::istream& istr, StreamType type);
+	enum
+	{
+		DEFAULT_BUFFER_SIZE = 32768
+	};
+
+	InflatingStreamBuf(std::istream& istr, StreamType type, std::size_t bufferSize = DEFAULT_BUFFER_SIZE);
 		/// Creates an InflatingStreamBuf for expanding the compressed data read from
 		/// the give input stream.
 
-	InflatingStreamBuf(std::istream& istr, int windowBits);
+	InflatingStreamBuf(std::istream& istr, int windowBits, std::size_t bufferSize = DEFAULT_BUFFER_SIZE);
 		/// Creates an InflatingStreamBuf for expanding the compressed data read from
 		/// the given input stream.
 		///
 		/// Please refer to the zlib documentation of inflateInit2() for a description
 		/// of the windowBits parameter.
 
-	InflatingStreamBuf(std::ostream& ostr, StreamType type);
+	InflatingStreamBuf(std::ostream& ostr, StreamType type, std::size_t bufferSize = DEFAULT_BUFFER_SIZE);
 		/// Creates an InflatingStreamBuf for expanding the compressed data passed through
 		/// and forwarding it to the given output stream.
 
-	InflatingStreamBuf(std::ostream& ostr, int windowBits);
+	InflatingStreamBuf(std::ostream& ostr, int windowBits, std::size_t bufferSize = DEFAULT_BUFFER_SIZE);
 		/// Creates an InflatingStreamBuf for expanding the compressed data passed through
 		/// and forwarding it to the given output stream.
 		///
@@ -105,20 +115,22 @@ public:
 protected:
 	int readFromDevice(char* buffer, std::streamsize length);
 	int writeToDevice(const char* buffer, std::streamsize length);
+	virtual std::streamsize xsgetn(char* buffer, std::streamsize length);
+	virtual std::streamsize xsputn(const char* buffer, std::streamsize length);
 
 private:
-	enum 
+	enum
 	{
-		STREAM_BUFFER_SIZE  = 1024,
-		INFLATE_BUFFER_SIZE = 32768
+		MAX_CHUNK_SIZE = 0x40000000
 	};
-	
+
 	std::istream*  _pIstr;
 	std::ostream*  _pOstr;
 	char*    _buffer;
 	z_stream _zstr;
 	bool     _eof;
 	bool     _check;
+	std::size_t _bufferSize;
 };
 
 
@@ -129,22 +141,22 @@ class Foundation_API InflatingIOS: public virtual std::ios
 	/// order of the stream buffer and base classes.
 {
 public:
-	InflatingIOS(std::ostream& ostr, InflatingStreamBuf::StreamType type = InflatingStreamBuf::STREAM_ZLIB);
+	InflatingIOS(std::ostream& ostr, InflatingStreamBuf::StreamType type = InflatingStreamBuf::STREAM_ZLIB, std::size_t bufferSize = InflatingStreamBuf::DEFAULT_BUFFER_SIZE);
 		/// Creates an InflatingIOS for expanding the compressed data passed through
 		/// and forwarding it to the given output stream.
 		
-	InflatingIOS(std::ostream& ostr, int windowBits);
+	InflatingIOS(std::ostream& ostr, int windowBits, std::size_t bufferSize = InflatingStreamBuf::DEFAULT_BUFFER_SIZE);
 		/// Creates an InflatingIOS for expanding the compressed data passed through
 		/// and forwarding it to the given output stream.
 		///
 		/// Please refer to the zlib documentation of inflateInit2() for a description
 		/// of the windowBits parameter.
 
-	InflatingIOS(std::istream& istr, InflatingStreamBuf::StreamType type = InflatingStreamBuf::STREAM_ZLIB);
+	InflatingIOS(std::istream& istr, InflatingStreamBuf::StreamType type = InflatingStreamBuf::STREAM_ZLIB, std::size_t bufferSize = InflatingStreamBuf::DEFAULT_BUFFER_SIZE);
 		/// Creates an InflatingIOS for expanding the compressed data read from 
 		/// the given input stream.
 
-	InflatingIOS(std::istream& istr, int windowBits);
+	InflatingIOS(std::istream& istr, int windowBits, std::size_t bufferSize = InflatingStreamBuf::DEFAULT_BUFFER_SIZE);
 		/// Creates an InflatingIOS for expanding the compressed data read from 
 		/// the given input stream.
 		///
@@ -170,11 +182,11 @@ class Foundation_API InflatingOutputStream: public InflatingIOS, public std::ost
 	/// must be called to ensure completion of decompression.
 {
 public:
-	InflatingOutputStream(std::ostream& ostr, InflatingStreamBuf::StreamType type = InflatingStreamBuf::STREAM_ZLIB);
+	InflatingOutputStream(std::ostream& ostr, InflatingStreamBuf::StreamType type = InflatingStreamBuf::STREAM_ZLIB, std::size_t bufferSize = InflatingStreamBuf::DEFAULT_BUFFER_SIZE);
 		/// Creates an InflatingOutputStream for expanding the compressed data passed through
 		/// and forwarding it to the given output stream.
 		
-	InflatingOutputStream(std::ostream& ostr, int windowBits);
+	InflatingOutputStream(std::ostream& ostr, int windowBits, std::size_t bufferSize = InflatingStreamBuf::DEFAULT_BUFFER_SIZE);
 		/// Creates an InflatingOutputStream for expanding the compressed data passed through
 		/// and forwarding it to the given output stream.
 		///
@@ -206,11 +218,11 @@ class Foundation_API InflatingInputStream: public InflatingIOS, public std::istr
 	/// to inflate the next stream.
 {
 public:
-	InflatingInputStream(std::istream& istr, InflatingStreamBuf::StreamType type = InflatingStreamBuf::STREAM_ZLIB);
+	InflatingInputStream(std::istream& istr, InflatingStreamBuf::StreamType type = InflatingStreamBuf::STREAM_ZLIB, std::size_t bufferSize = InflatingStreamBuf::DEFAULT_BUFFER_SIZE);
 		/// Creates an InflatingInputStream for expanding the compressed data read from 
 		/// the given input stream.
 
-	InflatingInputStream(std::istream& istr, int windowBits);
+	InflatingInputStream(std::istream& istr, int windowBits, std::size_t bufferSize = InflatingStreamBuf::DEFAULT_BUFFER_SIZE);
 		/// Creates an InflatingInputStream for expanding the compressed data read from 
 		/// the given input stream.
 		///
@@ -98,6 +98,64 @@ public:
 	{
 		return 0;
 	}
+
+	virtual pos_type seekoff(off_type off, std::ios_base::seekdir way, std::ios_base::openmode which = std::ios_base::in | std::ios_base::out)
+		/// Sets the read position (for std::ios_base::in) and/or
+		/// the write position (for std::ios_base::out), relative to
+		/// the beginning, the current position or the end of the buffer.
+		/// The current position is taken from the read position if
+		/// both are given.
+	{
+		const pos_type fail = off_type(-1);
+		off_type newoff = off_type(-1);
+
+		if ((which & std::ios_base::in) != 0)
+		{
+			if (this->gptr() == 0) return fail;
+
+			if (way == std::ios_base::beg)
+				newoff = 0;
+			else if (way == std::ios_base::cur)
+				newoff = this->gptr() - this->eback();
+			else if (way == std::ios_base::end)
+				newoff = this->egptr() - this->eback();
+			else
+				return fail;
+
+			if ((newoff + off) < 0 || (this->egptr() - this->eback()) < (newoff + off)) return fail;
+			this->setg(this->eback(), this->eback() + newoff + off, this->egptr());
+		}
+
+		if ((which & std::ios_base::out) != 0)
+		{
+			if (this->pptr() == 0) return fail;
+
+			if ((which & std::ios_base::in) == 0 || newoff == off_type(-1))
+			{
+				if (way == std::ios_base::beg)
+					newoff = 0;
+				else if (way == std::ios_base::cur)
+					newoff = this->pptr() - this->pbase();
+				else if (way == std::ios_base::end)
+					newoff = this->epptr() - this->pbase();
+				else
+					return fail;
+			}
+
+			if ((newoff + off) < 0 || (this->epptr() - this->pbase()) < (newoff + off)) return fail;
+			this->setp(this->pbase(), this->epptr());
+			this->pbump(static_cast<int>(newoff + off));
+		}
+
+		return newoff + off;
+	}
+
+	virtual pos_type seekpos(pos_type pos, std::ios_base::openmode which = std::ios_base::in | std::ios_base::out)
+		/// Sets the read and/or write position to the given
+		/// position from the beginning of the buffer.
+	{
+		return seekoff(off_type(pos), std::ios_base::beg, which);
+	}
 	
 	std::streamsize charsWritten() const
 	{
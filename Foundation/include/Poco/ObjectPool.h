@@ -42,6 +42,8 @@
 
 #include "Poco/Poco.h"
 #include "Poco/Mutex.h"
+#include "Poco/Condition.h"
+#include "Poco/Timestamp.h"
 #include "Poco/AutoPtr.h"
 #include "Poco/SharedPtr.h"
 #include <vector>
@@ -177,7 +179,9 @@ class ObjectPool
 	///     removed from the pool, activated (using the factory) and returned. 
 	///   - Otherwise, if the peak capacity of the pool has not yet been reached, 
 	///     a new object is created and activated, using the object factory, and returned. 
-	///   - If the peak capacity has already been reached, null is returned.
+	///   - If the peak capacity has already been reached, null is returned,
+	///     or, if a timeout is given, the caller waits for an object to be
+	///     returned to the pool.
 	///
 	/// When an object is returned to the pool:
 	///   - If the object is valid (checked by calling validateObject()
@@ -220,31 +224,68 @@ public:
 		}
 	}
 		
-	P borrowObject()
+	P borrowObject(long timeoutMilliseconds = 0)
 		/// Obtains an object from the pool, or creates a new object if
 		/// possible.
 		///
-		/// Returns null if no object is available.
+		/// If no object is available and the peak capacity has been
+		/// reached, waits up to timeoutMilliseconds for an object to
+		/// be returned to the pool. Returns null if no object is available
+		/// after the timeout.
 		///
-		/// If activating the object fails, the object is destroyed and
-		/// the exception is passed on to the caller.
+		/// New objects are created without holding the pool lock, so that
+		/// a slow createObject() does not block other threads.
+		///
+		/// If creating or activating the object fails, the object is destroyed 
+		/// and the exception is passed on to the caller.
 	{
-		Poco::FastMutex::ScopedLock lock(_mutex);
-		
-		if (!_pool.empty())
 		{
-			P pObject = _pool.back();
-			_pool.pop_back();
-			return activateObject(pObject);
+			Poco::FastMutex::ScopedLock lock(_mutex);
+
+			if (_pool.empty() && _size >= _peakCapacity && timeoutMilliseconds > 0)
+			{
+				Poco::Timestamp start;
+				long remaining = timeoutMilliseconds;
+				while (_pool.empty() && _size >= _peakCapacity && remaining > 0)
+				{
+					_availableCondition.tryWait(_mutex, remaining);
+					remaining = timeoutMilliseconds - static_cast<long>(start.elapsed()/1000);
+				}
+			}
+
+			if (!_pool.empty())
+			{
+				P pObject = _pool.back();
+				_pool.pop_back();
+				try
+				{
+					return activateObject(pObject);
+				}
+				catch (...)
+				{
+					_size--;
+					_availableCondition.signal();
+					throw;
+				}
+			}
+			else if (_size >= _peakCapacity)
+			{
+				return 0;
+			}
+			// reserve the slot, the object is created without holding the lock
+			_size++;
 		}
-		else if (_size < _peakCapacity)
+
+		try
 		{
 			P pObject = _factory.createObject();
-			activateObject(pObject);
-			_size++;
-			return pObject;
+			return activateObject(pObject);
+		}
+		catch (...)
+		{
+			releaseSlot();
+			throw;
 		}
-		else return 0;
 	}
 		
 	void returnObject(P pObject)
@@ -258,17 +299,13 @@ public:
 			if (_pool.size() < _capacity)
 			{
 				_pool.push_back(pObject);
-			}
-			else
-			{
-				_factory.destroyObject(pObject);
-				_size--;
+				_availableCondition.signal();
+				return;
 			}
 		}
-		else
-		{
-			_factory.destroyObject(pObject);
-		}
+		_factory.destroyObject(pObject);
+		_size--;
+		_availableCondition.signal();
 	}
 
 	std::size_t capacity() const
@@ -309,6 +346,14 @@ protected:
 		}
 		return pObject;
 	}
+
+	void releaseSlot()
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		_size--;
+		_availableCondition.signal();
+	}
 	
 private:
 	ObjectPool();
@@ -321,6 +366,7 @@ private:
 	std::size_t _size;
 	std::vector<P> _pool;
 	mutable Poco::FastMutex _mutex;
+	Poco::Condition _availableCondition;
 };
 
 
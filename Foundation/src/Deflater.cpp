@@ -0,0 +1,126 @@
+//
+// Deflater.cpp
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Streams
+// Module:  Deflater
+//
+// Copyright (c) 2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#include "Poco/Deflater.h"
+#include "Poco/Exception.h"
+
+
+namespace Poco {
+
+
+Deflater::Deflater(DeflatingStreamBuf::StreamType type, int level):
+	_finish(false),
+	_finished(false)
+{
+	_zstr.zalloc    = Z_NULL;
+	_zstr.zfree     = Z_NULL;
+	_zstr.opaque    = Z_NULL;
+	_zstr.next_in   = 0;
+	_zstr.avail_in  = 0;
+	_zstr.next_out  = 0;
+	_zstr.avail_out = 0;
+
+	int rc = deflateInit2(&_zstr, level, Z_DEFLATED, 15 + (type == DeflatingStreamBuf::STREAM_GZIP ? 16 : 0), 8, Z_DEFAULT_STRATEGY);
+	if (rc != Z_OK) throw IOException(zError(rc));
+}
+
+
+Deflater::Deflater(int windowBits, int level):
+	_finish(false),
+	_finished(false)
+{
+	_zstr.zalloc    = Z_NULL;
+	_zstr.zfree     = Z_NULL;
+	_zstr.opaque    = Z_NULL;
+	_zstr.next_in   = 0;
+	_zstr.avail_in  = 0;
+	_zstr.next_out  = 0;
+	_zstr.avail_out = 0;
+
+	int rc = deflateInit2(&_zstr, level, Z_DEFLATED, windowBits, 8, Z_DEFAULT_STRATEGY);
+	if (rc != Z_OK) throw IOException(zError(rc));
+}
+
+
+Deflater::~Deflater()
+{
+	deflateEnd(&_zstr);
+}
+
+
+void Deflater::setInput(const char* buffer, std::size_t length)
+{
+	if (static_cast<uInt>(length) != length) throw InvalidArgumentException("Deflater input too large");
+
+	_zstr.next_in  = (unsigned char*) buffer;
+	_zstr.avail_in = static_cast<uInt>(length);
+}
+
+
+std::size_t Deflater::deflate(char* buffer, std::size_t length)
+{
+	if (_finished) return 0;
+
+	uInt avail = static_cast<uInt>(length) == length ? static_cast<uInt>(length) : ~uInt(0);
+	_zstr.next_out  = (unsigned char*) buffer;
+	_zstr.avail_out = avail;
+	int rc = ::deflate(&_zstr, _finish ? Z_FINISH : Z_NO_FLUSH);
+	if (rc == Z_STREAM_END)
+		_finished = true;
+	else if (rc != Z_OK && rc != Z_BUF_ERROR) // Z_BUF_ERROR only means no progress was possible
+		throw IOException(zError(rc));
+	return avail - _zstr.avail_out;
+}
+
+
+std::size_t Deflater::maxDeflatedSize(std::size_t length)
+{
+	return deflateBound(&_zstr, static_cast<uLong>(length));
+}
+
+
+void Deflater::reset()
+{
+	int rc = deflateReset(&_zstr);
+	if (rc != Z_OK) throw IOException(zError(rc));
+	_zstr.next_in  = 0;
+	_zstr.avail_in = 0;
+	_finish   = false;
+	_finished = false;
+}
+
+
+} // namespace Poco
@@ -41,11 +41,12 @@
 namespace Poco {
 
 
-DeflatingStreamBuf::DeflatingStreamBuf(std::istream& istr, StreamType type, int level): 
-	BufferedStreamBuf(STREAM_BUFFER_SIZE, std::ios::in),
+DeflatingStreamBuf::DeflatingStreamBuf(std::istream& istr, StreamType type, int level, std::size_t bufferSize): 
+	BufferedStreamBuf(static_cast<std::streamsize>(bufferSize), std::ios::in),
 	_pIstr(&istr),
 	_pOstr(0),
-	_eof(false)
+	_eof(false),
+	_bufferSize(bufferSize)
 {
 	_zstr.zalloc    = Z_NULL;
 	_zstr.zfree     = Z_NULL;
@@ -55,7 +56,9 @@ DeflatingStreamBuf::DeflatingStreamBuf(std::istream& istr, StreamType type, int
 	_zstr.next_out  = 0;
 	_zstr.avail_out = 0;
 
-	_buffer = new char[DEFLATE_BUFFER_SIZE];
+	poco_assert (bufferSize > 4);
+
+	_buffer = new char[_bufferSize];
 
 	int rc = deflateInit2(&_zstr, level, Z_DEFLATED, 15 + (type == STREAM_GZIP ? 16 : 0), 8, Z_DEFAULT_STRATEGY);
 	if (rc != Z_OK) 
@@ -66,11 +69,12 @@ DeflatingStreamBuf::DeflatingStreamBuf(std::istream& istr, StreamType type, int
 }
 
 
-DeflatingStreamBuf::DeflatingStreamBuf(std::istream& istr, int windowBits, int level): 
-	BufferedStreamBuf(STREAM_BUFFER_SIZE, std::ios::in),
+DeflatingStreamBuf::DeflatingStreamBuf(std::istream& istr, int windowBits, int level, std::size_t bufferSize): 
+	BufferedStreamBuf(static_cast<std::streamsize>(bufferSize), std::ios::in),
 	_pIstr(&istr),
 	_pOstr(0),
-	_eof(false)
+	_eof(false),
+	_bufferSize(bufferSize)
 {
 	_zstr.zalloc    = Z_NULL;
 	_zstr.zfree     = Z_NULL;
@@ -80,7 +84,9 @@ DeflatingStreamBuf::DeflatingStreamBuf(std::istream& istr, int windowBits, int l
 	_zstr.next_out  = 0;
 	_zstr.avail_out = 0;
 
-	_buffer = new char[DEFLATE_BUFFER_SIZE];
+	poco_assert (bufferSize > 4);
+
+	_buffer = new char[_bufferSize];
 
 	int rc = deflateInit2(&_zstr, level, Z_DEFLATED, windowBits, 8, Z_DEFAULT_STRATEGY);
 	if (rc != Z_OK) 
@@ -91,11 +97,12 @@ DeflatingStreamBuf::DeflatingStreamBuf(std::istream& istr, int windowBits, int l
 }
 
 
-DeflatingStreamBuf::DeflatingStreamBuf(std::ostream& ostr, StreamType type, int level): 
-	BufferedStreamBuf(STREAM_BUFFER_SIZE, std::ios::out),
+DeflatingStreamBuf::DeflatingStreamBuf(std::ostream& ostr, StreamType type, int level, std::size_t bufferSize): 
+	BufferedStreamBuf(static_cast<std::streamsize>(bufferSize), std::ios::out),
 	_pIstr(0),
 	_pOstr(&ostr),
-	_eof(false)
+	_eof(false),
+	_bufferSize(bufferSize)
 {
 	_zstr.zalloc    = Z_NULL;
 	_zstr.zfree     = Z_NULL;
@@ -105,7 +112,9 @@ DeflatingStreamBuf::DeflatingStreamBuf(std::ostream& ostr, StreamType type, int
 	_zstr.next_out  = 0;
 	_zstr.avail_out = 0;
 
-	_buffer = new char[DEFLATE_BUFFER_SIZE];
+	poco_assert (bufferSize > 4);
+
+	_buffer = new char[_bufferSize];
 
 	int rc = deflateInit2(&_zstr, level, Z_DEFLATED, 15 + (type == STREAM_GZIP ? 16 : 0), 8, Z_DEFAULT_STRATEGY);
 	if (rc != Z_OK) 
@@ -116,11 +125,12 @@ DeflatingStreamBuf::DeflatingStreamBuf(std::ostream& ostr, StreamType type, int
 }
 
 
-DeflatingStreamBuf::DeflatingStreamBuf(std::ostream& ostr, int windowBits, int level): 
-	BufferedStreamBuf(STREAM_BUFFER_SIZE, std::ios::out),
+DeflatingStreamBuf::DeflatingStreamBuf(std::ostream& ostr, int windowBits, int level, std::size_t bufferSize): 
+	BufferedStreamBuf(static_cast<std::streamsize>(bufferSize), std::ios::out),
 	_pIstr(0),
 	_pOstr(&ostr),
-	_eof(false)
+	_eof(false),
+	_bufferSize(bufferSize)
 {
 	_zstr.zalloc    = Z_NULL;
 	_zstr.zfree     = Z_NULL;
@@ -130,7 +140,9 @@ DeflatingStreamBuf::DeflatingStreamBuf(std::ostream& ostr, int windowBits, int l
 	_zstr.next_out  = 0;
 	_zstr.avail_out = 0;
 
-	_buffer = new char[DEFLATE_BUFFER_SIZE];
+	poco_assert (bufferSize > 4);
+
+	_buffer = new char[_bufferSize];
 
 	int rc = deflateInit2(&_zstr, level, Z_DEFLATED, windowBits, 8, Z_DEFAULT_STRATEGY);
 	if (rc != Z_OK) 
@@ -165,18 +177,18 @@ int DeflatingStreamBuf::close()
 		{
 			int rc = deflate(&_zstr, Z_FINISH);
 			if (rc != Z_OK && rc != Z_STREAM_END) throw IOException(zError(rc)); 
-			_pOstr->write(_buffer, DEFLATE_BUFFER_SIZE - _zstr.avail_out);
+			_pOstr->write(_buffer, _bufferSize - _zstr.avail_out);
 			if (!_pOstr->good()) throw IOException(zError(rc)); 
 			_zstr.next_out  = (unsigned char*) _buffer;
-			_zstr.avail_out = DEFLATE_BUFFER_SIZE;
+			_zstr.avail_out = static_cast<unsigned>(_bufferSize);
 			while (rc != Z_STREAM_END)
 			{
 				rc = deflate(&_zstr, Z_FINISH);
 				if (rc != Z_OK && rc != Z_STREAM_END) throw IOException(zError(rc)); 
-				_pOstr->write(_buffer, DEFLATE_BUFFER_SIZE - _zstr.avail_out);
+				_pOstr->write(_buffer, _bufferSize - _zstr.avail_out);
 				if (!_pOstr->good()) throw IOException(zError(rc)); 
 				_zstr.next_out  = (unsigned char*) _buffer;
-				_zstr.avail_out = DEFLATE_BUFFER_SIZE;
+				_zstr.avail_out = static_cast<unsigned>(_bufferSize);
 			}
 		}
 		_pOstr = 0;
@@ -194,19 +206,19 @@ int DeflatingStreamBuf::sync()
 	{
 		int rc = deflate(&_zstr, Z_SYNC_FLUSH);
 		if (rc != Z_OK) throw IOException(zError(rc)); 
-		_pOstr->write(_buffer, DEFLATE_BUFFER_SIZE - _zstr.avail_out);
+		_pOstr->write(_buffer, _bufferSize - _zstr.avail_out);
 		if (!_pOstr->good()) throw IOException(zError(rc)); 
 		while (_zstr.avail_out == 0) 
 		{
 			_zstr.next_out  = (unsigned char*) _buffer;
-			_zstr.avail_out = DEFLATE_BUFFER_SIZE;
+			_zstr.avail_out = static_cast<unsigned>(_bufferSize);
 			rc = deflate(&_zstr, Z_SYNC_FLUSH);
 			if (rc != Z_OK) throw IOException(zError(rc)); 
-			_pOstr->write(_buffer, DEFLATE_BUFFER_SIZE - _zstr.avail_out);
+			_pOstr->write(_buffer, _bufferSize - _zstr.avail_out);
 			if (!_pOstr->good()) throw IOException(zError(rc)); 
 		};
 		_zstr.next_out  = (unsigned char*) _buffer;
-		_zstr.avail_out = DEFLATE_BUFFER_SIZE;
+		_zstr.avail_out = static_cast<unsigned>(_bufferSize);
 	}
 
 	return 0;
@@ -221,7 +233,7 @@ int DeflatingStreamBuf::readFromDevice(char* buffer, std::streamsize length)
 		int n = 0;
 		if (_pIstr->good())
 		{
-			_pIstr->read(_buffer, DEFLATE_BUFFER_SIZE);
+			_pIstr->read(_buffer, _bufferSize);
 			n = static_cast<int>(_pIstr->gcount());
 		}
 		if (n > 0)
@@ -256,7 +268,7 @@ int DeflatingStreamBuf::readFromDevice(char* buffer, std::streamsize length)
 			int n = 0;
 			if (_pIstr->good())
 			{
-				_pIstr->read(_buffer, DEFLATE_BUFFER_SIZE);
+				_pIstr->read(_buffer, _bufferSize);
 				n = static_cast<int>(_pIstr->gcount());
 			}
 			if (n > 0)
@@ -282,24 +294,24 @@ int DeflatingStreamBuf::writeToDevice(const char* buffer, std::streamsize length
 	_zstr.next_in   = (unsigned char*) buffer;
 	_zstr.avail_in  = static_cast<unsigned>(length);
 	_zstr.next_out  = (unsigned char*) _buffer;
-	_zstr.avail_out = DEFLATE_BUFFER_SIZE;
+	_zstr.avail_out = static_cast<unsigned>(_bufferSize);
 	for (;;)
 	{
 		int rc = deflate(&_zstr, Z_NO_FLUSH);
 		if (rc != Z_OK) throw IOException(zError(rc)); 
 		if (_zstr.avail_out == 0)
 		{
-			_pOstr->write(_buffer, DEFLATE_BUFFER_SIZE);
+			_pOstr->write(_buffer, _bufferSize);
 			if (!_pOstr->good()) throw IOException(zError(rc)); 
 			_zstr.next_out  = (unsigned char*) _buffer;
-			_zstr.avail_out = DEFLATE_BUFFER_SIZE;
+			_zstr.avail_out = static_cast<unsigned>(_bufferSize);
 		}
 		if (_zstr.avail_in == 0)
 		{
-			_pOstr->write(_buffer, DEFLATE_BUFFER_SIZE - _zstr.avail_out);
+			_pOstr->write(_buffer, _bufferSize - _zstr.avail_out);
 			if (!_pOstr->good()) throw IOException(zError(rc)); 
 			_zstr.next_out  = (unsigned char*) _buffer;
-			_zstr.avail_out = DEFLATE_BUFFER_SIZE;
+			_zstr.avail_out = static_cast<unsigned>(_bufferSize);
 			break;
 		}
 	}
@@ -307,29 +319,70 @@ int DeflatingStreamBuf::writeToDevice(const char* buffer, std::streamsize length
 }
 
 
-DeflatingIOS::DeflatingIOS(std::ostream& ostr, DeflatingStreamBuf::StreamType type, int level):
-	_buf(ostr, type, level)
+
+std::streamsize DeflatingStreamBuf::xsgetn(char* buffer, std::streamsize length)
+{
+	if (!_pIstr || length < static_cast<std::streamsize>(_bufferSize))
+		return BufferedStreamBuf::xsgetn(buffer, length);
+
+	// large reads take what is left in the stream buffer, then go to zlib directly
+	std::streamsize n = egptr() - gptr();
+	if (n > length) n = length;
+	std::char_traits<char>::copy(buffer, gptr(), static_cast<std::size_t>(n));
+	gbump(static_cast<int>(n));
+	setg(egptr(), egptr(), egptr());
+	while (n < length)
+	{
+		int chunk = length - n < MAX_CHUNK_SIZE ? static_cast<int>(length - n) : MAX_CHUNK_SIZE;
+		int rc = readFromDevice(buffer + n, chunk);
+		if (rc > 0) n += rc;
+		if (rc < chunk) break;
+	}
+	return n;
+}
+
+
+std::streamsize DeflatingStreamBuf::xsputn(const char* buffer, std::streamsize length)
+{
+	if (!_pOstr || length < static_cast<std::streamsize>(_bufferSize))
+		return BufferedStreamBuf::xsputn(buffer, length);
+
+	// large writes flush the stream buffer, then go to zlib directly
+	if (BufferedStreamBuf::sync()) return 0;
+	std::streamsize n = 0;
+	while (n < length)
+	{
+		int chunk = length - n < MAX_CHUNK_SIZE ? static_cast<int>(length - n) : MAX_CHUNK_SIZE;
+		int rc = writeToDevice(buffer + n, chunk);
+		if (rc <= 0) break;
+		n += rc;
+	}
+	return n;
+}
+
+DeflatingIOS::DeflatingIOS(std::ostream& ostr, DeflatingStreamBuf::StreamType type, int level, std::size_t bufferSize):
+	_buf(ostr, type, level, bufferSize)
 {
 	poco_ios_init(&_buf);
 }
 
 
-DeflatingIOS::DeflatingIOS(std::ostream& ostr, int windowBits, int level):
-	_buf(ostr, windowBits, level)
+DeflatingIOS::DeflatingIOS(std::ostream& ostr, int windowBits, int level, std::size_t bufferSize):
+	_buf(ostr, windowBits, level, bufferSize)
 {
 	poco_ios_init(&_buf);
 }
 
 
-DeflatingIOS::DeflatingIOS(std::istream& istr, DeflatingStreamBuf::StreamType type, int level):
-	_buf(istr, type, level)
+DeflatingIOS::DeflatingIOS(std::istream& istr, DeflatingStreamBuf::StreamType type, int level, std::size_t bufferSize):
+	_buf(istr, type, level, bufferSize)
 {
 	poco_ios_init(&_buf);
 }
 
 
-DeflatingIOS::DeflatingIOS(std::istream& istr, int windowBits, int level):
-	_buf(istr, windowBits, level)
+DeflatingIOS::DeflatingIOS(std::istream& istr, int windowBits, int level, std::size_t bufferSize):
+	_buf(istr, windowBits, level, bufferSize)
 {
 	poco_ios_init(&_buf);
 }
@@ -346,15 +399,15 @@ DeflatingStreamBuf* DeflatingIOS::rdbuf()
 }
 
 
-DeflatingOutputStream::DeflatingOutputStream(std::ostream& ostr, DeflatingStreamBuf::StreamType type, int level):
-	DeflatingIOS(ostr, type, level),
+DeflatingOutputStream::DeflatingOutputStream(std::ostream& ostr, DeflatingStreamBuf::StreamType type, int level, std::size_t bufferSize):
+	DeflatingIOS(ostr, type, level, bufferSize),
 	std::ostream(&_buf)
 {
 }
 
 
-DeflatingOutputStream::DeflatingOutputStream(std::ostream& ostr, int windowBits, int level):
-	DeflatingIOS(ostr, windowBits, level),
+DeflatingOutputStream::DeflatingOutputStream(std::ostream& ostr, int windowBits, int level, std::size_t bufferSize):
+	DeflatingIOS(ostr, windowBits, level, bufferSize),
 	std::ostream(&_buf)
 {
 }
@@ -377,15 +430,15 @@ int DeflatingOutputStream::sync()
 }
 
 
-DeflatingInputStream::DeflatingInputStream(std::istream& istr, DeflatingStreamBuf::StreamType type, int level):
-	DeflatingIOS(istr, type, level),
+DeflatingInputStream::DeflatingInputStream(std::istream& istr, DeflatingStreamBuf::StreamType type, int level, std::size_t bufferSize):
+	DeflatingIOS(istr, type, level, bufferSize),
 	std::istream(&_buf)
 {
 }
 
 
-DeflatingInputStream::DeflatingInputStream(std::istream& istr, int windowBits, int level):
-	DeflatingIOS(istr, windowBits, level),
+DeflatingInputStream::DeflatingInputStream(std::istream& istr, int windowBits, int level, std::size_t bufferSize):
+	DeflatingIOS(istr, windowBits, level, bufferSize),
 	std::istream(&_buf)
 {
 }
@@ -0,0 +1,119 @@
+//
+// Inflater.cpp
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Streams
+// Module:  Inflater
+//
+// Copyright (c) 2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#include "Poco/Inflater.h"
+#include "Poco/Exception.h"
+
+
+namespace Poco {
+
+
+Inflater::Inflater(InflatingStreamBuf::StreamType type):
+	_finished(false),
+	_check(type != InflatingStreamBuf::STREAM_ZIP)
+{
+	_zstr.zalloc    = Z_NULL;
+	_zstr.zfree     = Z_NULL;
+	_zstr.opaque    = Z_NULL;
+	_zstr.next_in   = 0;
+	_zstr.avail_in  = 0;
+	_zstr.next_out  = 0;
+	_zstr.avail_out = 0;
+
+	int rc = inflateInit2(&_zstr, 15 + (type == InflatingStreamBuf::STREAM_GZIP ? 16 : 0));
+	if (rc != Z_OK) throw IOException(zError(rc));
+}
+
+
+Inflater::Inflater(int windowBits):
+	_finished(false),
+	_check(false)
+{
+	_zstr.zalloc    = Z_NULL;
+	_zstr.zfree     = Z_NULL;
+	_zstr.opaque    = Z_NULL;
+	_zstr.next_in   = 0;
+	_zstr.avail_in  = 0;
+	_zstr.next_out  = 0;
+	_zstr.avail_out = 0;
+
+	int rc = inflateInit2(&_zstr, windowBits);
+	if (rc != Z_OK) throw IOException(zError(rc));
+}
+
+
+Inflater::~Inflater()
+{
+	inflateEnd(&_zstr);
+}
+
+
+void Inflater::setInput(const char* buffer, std::size_t length)
+{
+	if (static_cast<uInt>(length) != length) throw InvalidArgumentException("Inflater input too large");
+
+	_zstr.next_in  = (unsigned char*) buffer;
+	_zstr.avail_in = static_cast<uInt>(length);
+}
+
+
+std::size_t Inflater::inflate(char* buffer, std::size_t length)
+{
+	if (_finished) return 0;
+
+	uInt avail = static_cast<uInt>(length) == length ? static_cast<uInt>(length) : ~uInt(0);
+	_zstr.next_out  = (unsigned char*) buffer;
+	_zstr.avail_out = avail;
+	int rc = ::inflate(&_zstr, Z_NO_FLUSH);
+	if (rc == Z_DATA_ERROR && !_check && _zstr.avail_in == 0)
+		rc = Z_STREAM_END; // checksum is not verified for STREAM_ZIP
+	if (rc == Z_STREAM_END)
+		_finished = true;
+	else if (rc != Z_OK && rc != Z_BUF_ERROR) // Z_BUF_ERROR only means no progress was possible
+		throw IOException(zError(rc));
+	return avail - _zstr.avail_out;
+}
+
+
+void Inflater::reset()
+{
+	int rc = inflateReset(&_zstr);
+	if (rc != Z_OK) throw IOException(zError(rc));
+	_finished = false;
+}
+
+
+} // namespace Poco
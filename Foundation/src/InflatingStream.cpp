@@ -41,12 +41,13 @@
 namespace Poco {
 
 
-InflatingStreamBuf::InflatingStreamBuf(std::istream& istr, StreamType type): 
-	BufferedStreamBuf(STREAM_BUFFER_SIZE, std::ios::in),
+InflatingStreamBuf::InflatingStreamBuf(std::istream& istr, StreamType type, std::size_t bufferSize): 
+	BufferedStreamBuf(static_cast<std::streamsize>(bufferSize), std::ios::in),
 	_pIstr(&istr),
 	_pOstr(0),
 	_eof(false),
-	_check(type != STREAM_ZIP)
+	_check(type != STREAM_ZIP),
+	_bufferSize(bufferSize)
 {
 	_zstr.zalloc    = Z_NULL;
 	_zstr.zfree     = Z_NULL;
@@ -56,7 +57,9 @@ InflatingStreamBuf::InflatingStreamBuf(std::istream& istr, StreamType type):
 	_zstr.next_out  = 0;
 	_zstr.avail_out = 0;
 
-	_buffer = new char[INFLATE_BUFFER_SIZE];
+	poco_assert (bufferSize > 4);
+
+	_buffer = new char[_bufferSize];
 
 	int rc = inflateInit2(&_zstr, 15 + (type == STREAM_GZIP ? 16 : 0));
 	if (rc != Z_OK) 
@@ -67,12 +70,13 @@ InflatingStreamBuf::InflatingStreamBuf(std::istream& istr, StreamType type):
 }
 
 
-InflatingStreamBuf::InflatingStreamBuf(std::istream& istr, int windowBits): 
-	BufferedStreamBuf(STREAM_BUFFER_SIZE, std::ios::in),
+InflatingStreamBuf::InflatingStreamBuf(std::istream& istr, int windowBits, std::size_t bufferSize): 
+	BufferedStreamBuf(static_cast<std::streamsize>(bufferSize), std::ios::in),
 	_pIstr(&istr),
 	_pOstr(0),
 	_eof(false),
-	_check(false)
+	_check(false),
+	_bufferSize(bufferSize)
 {
 	_zstr.zalloc    = Z_NULL;
 	_zstr.zfree     = Z_NULL;
@@ -82,7 +86,9 @@ InflatingStreamBuf::InflatingStreamBuf(std::istream& istr, int windowBits):
 	_zstr.next_out  = 0;
 	_zstr.avail_out = 0;
 
-	_buffer = new char[INFLATE_BUFFER_SIZE];
+	poco_assert (bufferSize > 4);
+
+	_buffer = new char[_bufferSize];
 
 	int rc = inflateInit2(&_zstr, windowBits);
 	if (rc != Z_OK) 
@@ -93,12 +99,13 @@ InflatingStreamBuf::InflatingStreamBuf(std::istream& istr, int windowBits):
 }
 
 
-InflatingStreamBuf::InflatingStreamBuf(std::ostream& ostr, StreamType type): 
-	BufferedStreamBuf(STREAM_BUFFER_SIZE, std::ios::out),
+InflatingStreamBuf::InflatingStreamBuf(std::ostream& ostr, StreamType type, std::size_t bufferSize): 
+	BufferedStreamBuf(static_cast<std::streamsize>(bufferSize), std::ios::out),
 	_pIstr(0),
 	_pOstr(&ostr),
 	_eof(false),
-	_check(type != STREAM_ZIP)
+	_check(type != STREAM_ZIP),
+	_bufferSize(bufferSize)
 {
 	_zstr.zalloc    = Z_NULL;
 	_zstr.zfree     = Z_NULL;
@@ -108,7 +115,9 @@ InflatingStreamBuf::InflatingStreamBuf(std::ostream& ostr, StreamType type):
 	_zstr.next_out  = 0;
 	_zstr.avail_out = 0;
 
-	_buffer = new char[INFLATE_BUFFER_SIZE];
+	poco_assert (bufferSize > 4);
+
+	_buffer = new char[_bufferSize];
 
 	int rc = inflateInit2(&_zstr, 15 + (type == STREAM_GZIP ? 16 : 0));
 	if (rc != Z_OK) 
@@ -119,12 +128,13 @@ InflatingStreamBuf::InflatingStreamBuf(std::ostream& ostr, StreamType type):
 }
 
 
-InflatingStreamBuf::InflatingStreamBuf(std::ostream& ostr, int windowBits): 
-	BufferedStreamBuf(STREAM_BUFFER_SIZE, std::ios::out),
+InflatingStreamBuf::InflatingStreamBuf(std::ostream& ostr, int windowBits, std::size_t bufferSize): 
+	BufferedStreamBuf(static_cast<std::streamsize>(bufferSize), std::ios::out),
 	_pIstr(0),
 	_pOstr(&ostr),
 	_eof(false),
-	_check(false)
+	_check(false),
+	_bufferSize(bufferSize)
 {
 	_zstr.zalloc    = Z_NULL;
 	_zstr.zfree     = Z_NULL;
@@ -134,7 +144,9 @@ InflatingStreamBuf::InflatingStreamBuf(std::ostream& ostr, int windowBits):
 	_zstr.next_out  = 0;
 	_zstr.avail_out = 0;
 
-	_buffer = new char[INFLATE_BUFFER_SIZE];
+	poco_assert (bufferSize > 4);
+
+	_buffer = new char[_bufferSize];
 
 	int rc = inflateInit2(&_zstr, windowBits);
 	if (rc != Z_OK) 
@@ -187,7 +199,7 @@ int InflatingStreamBuf::readFromDevice(char* buffer, std::streamsize length)
 		int n = 0;
 		if (_pIstr->good())
 		{
-			_pIstr->read(_buffer, INFLATE_BUFFER_SIZE);
+			_pIstr->read(_buffer, _bufferSize);
 			n = static_cast<int>(_pIstr->gcount());
 		}
 		_zstr.next_in   = (unsigned char*) _buffer;
@@ -221,7 +233,7 @@ int InflatingStreamBuf::readFromDevice(char* buffer, std::streamsize length)
 			int n = 0;
 			if (_pIstr->good())
 			{
-				_pIstr->read(_buffer, INFLATE_BUFFER_SIZE);
+				_pIstr->read(_buffer, _bufferSize);
 				n = static_cast<int>(_pIstr->gcount());
 			}
 			if (n > 0)
@@ -242,30 +254,30 @@ int InflatingStreamBuf::writeToDevice(const char* buffer, std::streamsize length
 	_zstr.next_in   = (unsigned char*) buffer;
 	_zstr.avail_in  = static_cast<unsigned>(length);
 	_zstr.next_out  = (unsigned char*) _buffer;
-	_zstr.avail_out = INFLATE_BUFFER_SIZE;
+	_zstr.avail_out = static_cast<unsigned>(_bufferSize);
 	for (;;)
 	{
 		int rc = inflate(&_zstr, Z_NO_FLUSH);
 		if (rc == Z_STREAM_END)
 		{
-			_pOstr->write(_buffer, INFLATE_BUFFER_SIZE - _zstr.avail_out);
+			_pOstr->write(_buffer, _bufferSize - _zstr.avail_out);
 			if (!_pOstr->good()) throw IOException(zError(rc));
 			break;
 		}
 		if (rc != Z_OK) throw IOException(zError(rc)); 
 		if (_zstr.avail_out == 0)
 		{
-			_pOstr->write(_buffer, INFLATE_BUFFER_SIZE);
+			_pOstr->write(_buffer, _bufferSize);
 			if (!_pOstr->good()) throw IOException(zError(rc));
 			_zstr.next_out  = (unsigned char*) _buffer;
-			_zstr.avail_out = INFLATE_BUFFER_SIZE;
+			_zstr.avail_out = static_cast<unsigned>(_bufferSize);
 		}
 		if (_zstr.avail_in == 0)
 		{
-			_pOstr->write(_buffer, INFLATE_BUFFER_SIZE - _zstr.avail_out);
+			_pOstr->write(_buffer, _bufferSize - _zstr.avail_out);
 			if (!_pOstr->good()) throw IOException(zError(rc)); 
 			_zstr.next_out  = (unsigned char*) _buffer;
-			_zstr.avail_out = INFLATE_BUFFER_SIZE;
+			_zstr.avail_out = static_cast<unsigned>(_bufferSize);
 			break;
 		}
 	}
@@ -273,29 +285,70 @@ int InflatingStreamBuf::writeToDevice(const char* buffer, std::streamsize length
 }
 
 
-InflatingIOS::InflatingIOS(std::ostream& ostr, InflatingStreamBuf::StreamType type):
-	_buf(ostr, type)
+
+std::streamsize InflatingStreamBuf::xsgetn(char* buffer, std::streamsize length)
+{
+	if (!_pIstr || length < static_cast<std::streamsize>(_bufferSize))
+		return BufferedStreamBuf::xsgetn(buffer, length);
+
+	// large reads take what is left in the stream buffer, then go to zlib directly
+	std::streamsize n = egptr() - gptr();
+	if (n > length) n = length;
+	std::char_traits<char>::copy(buffer, gptr(), static_cast<std::size_t>(n));
+	gbump(static_cast<int>(n));
+	setg(egptr(), egptr(), egptr());
+	while (n < length)
+	{
+		int chunk = length - n < MAX_CHUNK_SIZE ? static_cast<int>(length - n) : MAX_CHUNK_SIZE;
+		int rc = readFromDevice(buffer + n, chunk);
+		if (rc > 0) n += rc;
+		if (rc < chunk) break;
+	}
+	return n;
+}
+
+
+std::streamsize InflatingStreamBuf::xsputn(const char* buffer, std::streamsize length)
+{
+	if (!_pOstr || length < static_cast<std::streamsize>(_bufferSize))
+		return BufferedStreamBuf::xsputn(buffer, length);
+
+	// large writes flush the stream buffer, then go to zlib directly
+	if (BufferedStreamBuf::sync()) return 0;
+	std::streamsize n = 0;
+	while (n < length)
+	{
+		int chunk = length - n < MAX_CHUNK_SIZE ? static_cast<int>(length - n) : MAX_CHUNK_SIZE;
+		int rc = writeToDevice(buffer + n, chunk);
+		if (rc <= 0) break;
+		n += rc;
+	}
+	return n;
+}
+
+InflatingIOS::InflatingIOS(std::ostream& ostr, InflatingStreamBuf::StreamType type, std::size_t bufferSize):
+	_buf(ostr, type, bufferSize)
 {
 	poco_ios_init(&_buf);
 }
 
 
-InflatingIOS::InflatingIOS(std::ostream& ostr, int windowBits):
-	_buf(ostr, windowBits)
+InflatingIOS::InflatingIOS(std::ostream& ostr, int windowBits, std::size_t bufferSize):
+	_buf(ostr, windowBits, bufferSize)
 {
 	poco_ios_init(&_buf);
 }
 
 
-InflatingIOS::InflatingIOS(std::istream& istr, InflatingStreamBuf::StreamType type):
-	_buf(istr, type)
+InflatingIOS::InflatingIOS(std::istream& istr, InflatingStreamBuf::StreamType type, std::size_t bufferSize):
+	_buf(istr, type, bufferSize)
 {
 	poco_ios_init(&_buf);
 }
 
 
-InflatingIOS::InflatingIOS(std::istream& istr, int windowBits):
-	_buf(istr, windowBits)
+InflatingIOS::InflatingIOS(std::istream& istr, int windowBits, std::size_t bufferSize):
+	_buf(istr, windowBits, bufferSize)
 {
 	poco_ios_init(&_buf);
 }
@@ -312,15 +365,15 @@ InflatingStreamBuf* InflatingIOS::rdbuf()
 }
 
 
-InflatingOutputStream::InflatingOutputStream(std::ostream& ostr, InflatingStreamBuf::StreamType type):
-	InflatingIOS(ostr, type),
+InflatingOutputStream::InflatingOutputStream(std::ostream& ostr, InflatingStreamBuf::StreamType type, std::size_t bufferSize):
+	InflatingIOS(ostr, type, bufferSize),
 	std::ostream(&_buf)
 {
 }
 
 
-InflatingOutputStream::InflatingOutputStream(std::ostream& ostr, int windowBits):
-	InflatingIOS(ostr, windowBits),
+InflatingOutputStream::InflatingOutputStream(std::ostream& ostr, int windowBits, std::size_t bufferSize):
+	InflatingIOS(ostr, windowBits, bufferSize),
 	std::ostream(&_buf)
 {
 }
@@ -337,15 +390,15 @@ int InflatingOutputStream::close()
 }
 
 
-InflatingInputStream::InflatingInputStream(std::istream& istr, InflatingStreamBuf::StreamType type):
-	InflatingIOS(istr, type),
+InflatingInputStream::InflatingInputStream(std::istream& istr, InflatingStreamBuf::StreamType type, std::size_t bufferSize):
+	InflatingIOS(istr, type, bufferSize),
 	std::istream(&_buf)
 {
 }
 
 
-InflatingInputStream::InflatingInputStream(std::istream& istr, int windowBits):
-	InflatingIOS(istr, windowBits),
+InflatingInputStream::InflatingInputStream(std::istream& istr, int windowBits, std::size_t bufferSize):
+	InflatingIOS(istr, windowBits, bufferSize),
 	std::istream(&_buf)
 {
 }
@@ -107,6 +107,35 @@ void MemoryStreamTest::testOutput()
 }
 
 
+void MemoryStreamTest::testSeek()
+{
+	const char* data = "0123456789";
+	MemoryInputStream istr(data, 10);
+	assert (istr.tellg() == std::streampos(0));
+	istr.seekg(4);
+	assert (istr.get() == '4');
+	istr.seekg(2, std::ios::cur);
+	assert (istr.get() == '7');
+	istr.seekg(-1, std::ios::end);
+	assert (istr.get() == '9');
+	assert (istr.tellg() == std::streampos(10));
+	istr.seekg(11);
+	assert (istr.fail());
+	istr.clear();
+	istr.seekg(0);
+	assert (istr.get() == '0');
+
+	char output[10];
+	MemoryOutputStream ostr(output, 10);
+	ostr << "abcdef";
+	ostr.seekp(2);
+	ostr << "XY";
+	assert (ostr.tellp() == std::streampos(4));
+	assert (std::string(output, 6) == "abXYef");
+	assert (ostr.charsWritten() == 4);
+}
+
+
 void MemoryStreamTest::setUp()
 {
 }
@@ -123,6 +152,7 @@ CppUnit::Test* MemoryStreamTest::suite()
 
 	CppUnit_addTest(pSuite, MemoryStreamTest, testInput);
 	CppUnit_addTest(pSuite, MemoryStreamTest, testOutput);
+	CppUnit_addTest(pSuite, MemoryStreamTest, testSeek);
 
 	return pSuite;
 }
@@ -48,6 +48,7 @@ public:
 
 	void testInput();
 	void testOutput();
+	void testSeek();
 
 	void setUp();
 	void tearDown();
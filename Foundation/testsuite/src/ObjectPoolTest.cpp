@@ -35,11 +35,73 @@
 #include "CppUnit/TestSuite.h"
 #include "Poco/ObjectPool.h"
 #include "Poco/Exception.h"
+#include "Poco/Thread.h"
+#include "Poco/Runnable.h"
+#include "Poco/Timestamp.h"
 
 
 using Poco::ObjectPool;
 
 
+namespace
+{
+	class Returner: public Poco::Runnable
+	{
+	public:
+		Returner(ObjectPool<std::string, Poco::SharedPtr<std::string> >& pool, Poco::SharedPtr<std::string> pStr):
+			_pool(pool),
+			_pStr(pStr)
+		{
+		}
+
+		void run()
+		{
+			Poco::Thread::sleep(200);
+			_pool.returnObject(_pStr);
+		}
+
+	private:
+		ObjectPool<std::string, Poco::SharedPtr<std::string> >& _pool;
+		Poco::SharedPtr<std::string> _pStr;
+	};
+}
+
+
+namespace Poco {
+
+
+template <>
+class PoolableObjectFactory<int, Poco::SharedPtr<int> >
+	/// Invalidates negative values.
+{
+public:
+	Poco::SharedPtr<int> createObject()
+	{
+		return new int(0);
+	}
+
+	bool validateObject(Poco::SharedPtr<int> pObject)
+	{
+		return *pObject >= 0;
+	}
+
+	void activateObject(Poco::SharedPtr<int> pObject)
+	{
+	}
+
+	void deactivateObject(Poco::SharedPtr<int> pObject)
+	{
+	}
+
+	void destroyObject(Poco::SharedPtr<int> pObject)
+	{
+	}
+};
+
+
+} // namespace Poco
+
+
 ObjectPoolTest::ObjectPoolTest(const std::string& name): CppUnit::TestCase(name)
 {
 }
@@ -110,6 +172,56 @@ void ObjectPoolTest::testObjectPool()
 }
 
 
+void ObjectPoolTest::testBorrowTimeout()
+{
+	ObjectPool<std::string, Poco::SharedPtr<std::string> > pool(1, 1);
+	
+	Poco::SharedPtr<std::string> pStr1 = pool.borrowObject();
+	pStr1->assign("first");
+	assert (pool.available() == 0);
+
+	Poco::Timestamp start;
+	Poco::SharedPtr<std::string> pStr2 = pool.borrowObject(100);
+	assert (pStr2.isNull());
+	assert (start.elapsed() >= 90000);
+
+	Returner returner(pool, pStr1);
+	Poco::Thread thread;
+	thread.start(returner);
+	pStr2 = pool.borrowObject(10000);
+	thread.join();
+	assert (!pStr2.isNull());
+	assert (*pStr2 == "first");
+	assert (pool.size() == 1);
+	assert (pool.available() == 0);
+}
+
+
+void ObjectPoolTest::testInvalidObject()
+{
+	ObjectPool<int, Poco::SharedPtr<int> > pool(2, 2);
+
+	Poco::SharedPtr<int> pInt1 = pool.borrowObject();
+	Poco::SharedPtr<int> pInt2 = pool.borrowObject();
+	assert (pool.size() == 2);
+	assert (pool.available() == 0);
+
+	*pInt1 = -1;
+	pool.returnObject(pInt1);
+	assert (pool.size() == 1);
+	assert (pool.available() == 1);
+
+	pInt1 = pool.borrowObject();
+	assert (*pInt1 == 0);
+	assert (pool.size() == 2);
+
+	pool.returnObject(pInt1);
+	pool.returnObject(pInt2);
+	assert (pool.size() == 2);
+	assert (pool.available() == 2);
+}
+
+
 void ObjectPoolTest::setUp()
 {
 }
@@ -125,6 +237,8 @@ CppUnit::Test* ObjectPoolTest::suite()
 	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("ObjectPoolTest");
 
 	CppUnit_addTest(pSuite, ObjectPoolTest, testObjectPool);
+	CppUnit_addTest(pSuite, ObjectPoolTest, testBorrowTimeout);
+	CppUnit_addTest(pSuite, ObjectPoolTest, testInvalidObject);
 
 	return pSuite;
 }
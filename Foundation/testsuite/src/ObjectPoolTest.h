@@ -47,6 +47,8 @@ public:
 	~ObjectPoolTest();
 
 	void testObjectPool();
+	void testBorrowTimeout();
+	void testInvalidObject();
 
 	void setUp();
 	void tearDown();
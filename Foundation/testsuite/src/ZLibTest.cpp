@@ -35,10 +35,17 @@
 #include "CppUnit/TestSuite.h"
 #include "Poco/InflatingStream.h"
 #include "Poco/DeflatingStream.h"
+#include "Poco/Inflater.h"
+#include "Poco/Deflater.h"
 #include "Poco/MemoryStream.h"
 #include "Poco/StreamCopier.h"
 #include "Poco/Buffer.h"
+#include "Poco/NumberFormatter.h"
+#include "Poco/Stopwatch.h"
+#include "Poco/Exception.h"
 #include <sstream>
+#include <iostream>
+#include <algorithm>
 
 
 using Poco::InflatingInputStream;
@@ -48,6 +55,8 @@ using Poco::DeflatingInputStream;
 using Poco::InflatingStreamBuf;
 using Poco::DeflatingStreamBuf;
 using Poco::StreamCopier;
+using Poco::Inflater;
+using Poco::Deflater;
 
 
 ZLibTest::ZLibTest(const std::string& name): CppUnit::TestCase(name)
@@ -197,6 +206,223 @@ void ZLibTest::testGzip3()
 }
 
 
+void ZLibTest::testBufferSize()
+{
+	std::string data = createData(300000);
+	std::size_t sizes[] = {64, 1024, 262144};
+	for (int i = 0; i < 3; ++i)
+	{
+		std::stringstream buffer;
+		DeflatingOutputStream deflater(buffer, DeflatingStreamBuf::STREAM_GZIP, Z_DEFAULT_COMPRESSION, sizes[i]);
+		deflater.write(data.data(), 1000);
+		deflater.write(data.data() + 1000, static_cast<std::streamsize>(data.size() - 1000));
+		deflater.close();
+
+		InflatingInputStream inflater(buffer, InflatingStreamBuf::STREAM_GZIP, sizes[i]);
+		std::string data2(data.size(), '\0');
+		inflater.read(&data2[0], 1000);
+		assert (inflater.gcount() == 1000);
+		inflater.read(&data2[1000], static_cast<std::streamsize>(data.size() - 1000));
+		assert (inflater.gcount() == static_cast<std::streamsize>(data.size() - 1000));
+		assert (data2 == data);
+		inflater.get();
+		assert (inflater.eof());
+
+		buffer.clear();
+		buffer.seekg(0);
+		std::stringstream buffer2;
+		InflatingOutputStream inflater2(buffer2, InflatingStreamBuf::STREAM_GZIP, sizes[i]);
+		StreamCopier::copyStream(buffer, inflater2);
+		inflater2.close();
+		assert (buffer2.str() == data);
+
+		std::istringstream istr(data);
+		DeflatingInputStream deflater2(istr, DeflatingStreamBuf::STREAM_ZLIB, Z_DEFAULT_COMPRESSION, sizes[i]);
+		std::string compressed(data.size(), '\0');
+		deflater2.read(&compressed[0], static_cast<std::streamsize>(compressed.size()));
+		compressed.resize(static_cast<std::size_t>(deflater2.gcount()));
+		std::istringstream istr2(compressed);
+		InflatingInputStream inflater3(istr2);
+		std::ostringstream ostr;
+		StreamCopier::copyStream(inflater3, ostr);
+		assert (ostr.str() == data);
+	}
+}
+
+
+void ZLibTest::testDeflater()
+{
+	std::string data = createData(100000);
+	Deflater deflater(DeflatingStreamBuf::STREAM_GZIP);
+	std::string compressed;
+	char buffer[1000];
+	for (std::size_t pos = 0; pos < data.size(); pos += 30000)
+	{
+		deflater.setInput(data.data() + pos, std::min<std::size_t>(30000, data.size() - pos));
+		while (!deflater.needsInput())
+		{
+			std::size_t n = deflater.deflate(buffer, sizeof(buffer));
+			compressed.append(buffer, n);
+		}
+	}
+	deflater.finish();
+	while (!deflater.finished())
+	{
+		std::size_t n = deflater.deflate(buffer, sizeof(buffer));
+		compressed.append(buffer, n);
+	}
+	assert (deflater.deflate(buffer, sizeof(buffer)) == 0);
+	assert (deflater.totalIn() == data.size());
+	assert (deflater.totalOut() == compressed.size());
+	assert (compressed.size() < data.size()/2);
+
+	std::istringstream istr(compressed);
+	InflatingInputStream inflater(istr, InflatingStreamBuf::STREAM_GZIP);
+	std::ostringstream ostr;
+	StreamCopier::copyStream(inflater, ostr);
+	assert (ostr.str() == data);
+
+	deflater.reset();
+	std::string compressed2(deflater.maxDeflatedSize(data.size()), '\0');
+	deflater.setInput(data.data(), data.size());
+	deflater.finish();
+	compressed2.resize(deflater.deflate(&compressed2[0], compressed2.size()));
+	assert (deflater.finished());
+	assert (compressed2 == compressed);
+}
+
+
+void ZLibTest::testInflater()
+{
+	std::string data1 = createData(50000);
+	std::string data2("abcdefabcdefabcdefabcdefabcdefabcdef");
+	std::stringstream buffer;
+	DeflatingOutputStream deflater1(buffer, DeflatingStreamBuf::STREAM_GZIP);
+	deflater1 << data1;
+	deflater1.close();
+	DeflatingOutputStream deflater2(buffer, DeflatingStreamBuf::STREAM_GZIP);
+	deflater2 << data2;
+	deflater2.close();
+	std::string compressed = buffer.str();
+
+	Inflater inflater(InflatingStreamBuf::STREAM_GZIP);
+	std::string result;
+	char out[777];
+	std::size_t pos = 0;
+	while (!inflater.finished())
+	{
+		if (inflater.needsInput())
+		{
+			assert (pos < compressed.size());
+			std::size_t n = std::min<std::size_t>(100, compressed.size() - pos);
+			inflater.setInput(compressed.data() + pos, n);
+			pos += n;
+		}
+		std::size_t n = inflater.inflate(out, sizeof(out));
+		result.append(out, n);
+	}
+	assert (result == data1);
+	assert (inflater.totalOut() == data1.size());
+
+	pos -= inflater.remaining();
+	inflater.reset();
+	inflater.setInput(compressed.data() + pos, compressed.size() - pos);
+	result.assign(out, inflater.inflate(out, sizeof(out)));
+	assert (inflater.finished());
+	assert (inflater.remaining() == 0);
+	assert (result == data2);
+
+	Inflater inflater2;
+	std::string garbage("this is not compressed");
+	inflater2.setInput(garbage.data(), garbage.size());
+	try
+	{
+		inflater2.inflate(out, sizeof(out));
+		fail("corrupt data - must throw");
+	}
+	catch (Poco::IOException&)
+	{
+	}
+}
+
+
+void ZLibTest::benchmarkDeflate()
+{
+	const std::size_t size = 16*1024*1024;
+	std::string data = createData(size);
+	std::string compressed;
+	int levels[] = {Z_BEST_SPEED, Z_DEFAULT_COMPRESSION, Z_BEST_COMPRESSION};
+	std::size_t sizes[] = {1024, 8192, 32768, 262144};
+	Poco::Buffer<char> chunk(8192);
+	for (int l = 0; l < 3; ++l)
+	{
+		for (int s = 0; s < 4; ++s)
+		{
+			Poco::Stopwatch sw;
+			sw.start();
+			std::ostringstream ostr;
+			DeflatingOutputStream deflater(ostr, DeflatingStreamBuf::STREAM_GZIP, levels[l], sizes[s]);
+			for (std::size_t pos = 0; pos < size; pos += 8192)
+				deflater.write(data.data() + pos, 8192);
+			deflater.close();
+			sw.stop();
+			compressed = ostr.str();
+			double deflateRate = size/double(sw.elapsed());
+
+			std::istringstream istr(compressed);
+			sw.restart();
+			InflatingInputStream inflater(istr, InflatingStreamBuf::STREAM_GZIP, sizes[s]);
+			while (inflater.read(chunk.begin(), 8192)) ;
+			sw.stop();
+			double inflateRate = size/double(sw.elapsed());
+			std::cout << std::endl << "stream, level " << levels[l] << ", buffer " << sizes[s] << ": deflate "
+				<< deflateRate << " MB/s, inflate " << inflateRate << " MB/s";
+		}
+
+		Poco::Stopwatch sw;
+		sw.start();
+		Deflater deflater(DeflatingStreamBuf::STREAM_GZIP, levels[l]);
+		compressed.resize(deflater.maxDeflatedSize(size));
+		deflater.setInput(data.data(), size);
+		deflater.finish();
+		compressed.resize(deflater.deflate(&compressed[0], compressed.size()));
+		sw.stop();
+		double deflateRate = size/double(sw.elapsed());
+
+		std::string result(size, '\0');
+		sw.restart();
+		Inflater inflater(InflatingStreamBuf::STREAM_GZIP);
+		inflater.setInput(compressed.data(), compressed.size());
+		inflater.inflate(&result[0], result.size());
+		sw.stop();
+		double inflateRate = size/double(sw.elapsed());
+		assert (inflater.finished() && result == data);
+		std::cout << std::endl << "Deflater/Inflater, level " << levels[l] << ": deflate "
+			<< deflateRate << " MB/s, inflate " << inflateRate << " MB/s, ratio "
+			<< double(compressed.size())/size << std::endl;
+	}
+}
+
+
+std::string ZLibTest::createData(std::size_t size)
+{
+	std::string data;
+	data.reserve(size + 100);
+	Poco::UInt32 seed = 42;
+	while (data.size() < size)
+	{
+		seed = seed*1103515245 + 12345;
+		data += "2013-05-17 12:34:56.";
+		data += Poco::NumberFormatter::format0((seed >> 16) % 1000, 3);
+		data += " [Information] request ";
+		data += Poco::NumberFormatter::format((seed >> 8) % 100000);
+		data += " served\n";
+	}
+	data.resize(size);
+	return data;
+}
+
+
 void ZLibTest::setUp()
 {
 }
@@ -218,6 +444,10 @@ CppUnit::Test* ZLibTest::suite()
 	CppUnit_addTest(pSuite, ZLibTest, testGzip1);
 	CppUnit_addTest(pSuite, ZLibTest, testGzip2);
 	CppUnit_addTest(pSuite, ZLibTest, testGzip3);
+	CppUnit_addTest(pSuite, ZLibTest, testBufferSize);
+	CppUnit_addTest(pSuite, ZLibTest, testDeflater);
+	CppUnit_addTest(pSuite, ZLibTest, testInflater);
+	//CppUnit_addTest(pSuite, ZLibTest, benchmarkDeflate);
 
 	return pSuite;
 }
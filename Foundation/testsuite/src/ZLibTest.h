@@ -53,6 +53,10 @@ public:
 	void testGzip1();
 	void testGzip2();
 	void testGzip3();
+	void testBufferSize();
+	void testDeflater();
+	void testInflater();
+	void benchmarkDeflate();
 
 	void setUp();
 	void tearDown();
@@ -60,6 +64,7 @@ public:
 	static CppUnit::Test* suite();
 
 private:
+	static std::string createData(std::size_t size);
 };
 
 
@@ -55,8 +55,10 @@ class JSON_API DefaultHandler : public Handler
 {
 public:
 
-	DefaultHandler();
-		/// Default Constructor
+	explicit DefaultHandler(bool indexKeys = false);
+		/// Creates the DefaultHandler. If indexKeys is true,
+		/// all objects created by the handler maintain a hash
+		/// index over their property names (see Object).
 
 	virtual ~DefaultHandler();
 		/// Destructor
@@ -113,6 +115,7 @@ private:
 	std::stack<Dynamic::Var> _stack;
 	std::string              _key;
 	Dynamic::Var             _result;
+	bool                     _indexKeys;
 };
 
 
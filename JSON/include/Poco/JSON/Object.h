@@ -43,6 +43,7 @@
 #include "Poco/JSON/JSON.h"
 #include "Poco/JSON/Array.h"
 #include "Poco/SharedPtr.h"
+#include "Poco/HashMap.h"
 #include "Poco/Dynamic/Var.h"
 #include <map>
 #include <vector>
@@ -56,19 +57,36 @@ namespace JSON {
 
 class JSON_API Object
 	/// Represents a JSON object.
+	///
+	/// Properties are kept in a std::map, so they are always
+	/// stringified in key order. Optionally, an Object can
+	/// additionally maintain a hash index over its property
+	/// names. With the index enabled, property lookups are
+	/// done in constant time instead of a logarithmic number
+	/// of string comparisons, which pays off when many values
+	/// are extracted from large objects.
 {
 public:
 	typedef SharedPtr<Object> Ptr;
 
-	Object();
-		/// Default constructor
+	explicit Object(bool indexKeys = false);
+		/// Creates an empty Object. If indexKeys is true,
+		/// a hash index over the property names is maintained.
 
 	Object(const Object& copy);
-		/// Copy constructor
+		/// Copy constructor. The copy uses the same
+		/// storage option as the original.
 
 	virtual ~Object();
 		/// Destructor
 
+	Object& operator = (const Object& other);
+		/// Assignment operator.
+
+	bool isIndexed() const;
+		/// Returns true if the Object maintains a hash
+		/// index over its property names.
+
 	Dynamic::Var get(const std::string& key) const;
 		/// Retrieves a property. An empty value is
 		/// returned when the property doesn't exist.
@@ -117,7 +135,7 @@ public:
 		/// def will be returned.
 	{
 		T value = def;
-		ValueMap::const_iterator it = _values.find(key);
+		ValueMap::const_iterator it = find(key);
 		if (it != _values.end() && ! it->second.isEmpty() )
 		{
 			try
@@ -146,58 +164,77 @@ public:
 		/// Removes the property with the given key
 
 private:
-	//TODO: unordered map
 	typedef std::map<std::string, Dynamic::Var> ValueMap;
-	ValueMap _values;
+
+	struct KeyHash
+	{
+		std::size_t operator () (const std::string& key) const
+		{
+			return Poco::hash(key);
+		}
+	};
+
+	typedef HashMap<std::string, ValueMap::iterator, KeyHash> KeyIndex;
+
+	ValueMap::const_iterator find(const std::string& key) const;
+	void buildIndex();
+
+	ValueMap  _values;
+	KeyIndex* _pIndex;
 };
 
 
+inline bool Object::isIndexed() const
+{
+	return _pIndex != 0;
+}
+
+
+inline Object::ValueMap::const_iterator Object::find(const std::string& key) const
+{
+	if (_pIndex)
+	{
+		KeyIndex::ConstIterator it = _pIndex->find(key);
+		return it != _pIndex->end() ? ValueMap::const_iterator(it->second) : _values.end();
+	}
+	else return _values.find(key);
+}
+
+
 inline bool Object::has(const std::string& key) const
 {
-	ValueMap::const_iterator it = _values.find(key);
+	ValueMap::const_iterator it = find(key);
 	return it != _values.end();
 }
 
 
 inline bool Object::isArray(const std::string& key) const
 {
-	ValueMap::const_iterator it = _values.find(key);
+	ValueMap::const_iterator it = find(key);
 	return it != _values.end() && it->second.type() == typeid(Array::Ptr);
 }
 
 
 inline bool Object::isNull(const std::string& key) const
 {
-	ValueMap::const_iterator it = _values.find(key);
+	ValueMap::const_iterator it = find(key);
 	return it == _values.end() || it->second.isEmpty();
 }
 
 
 inline bool Object::isObject(const std::string& key) const
 {
-	ValueMap::const_iterator it = _values.find(key);
+	ValueMap::const_iterator it = find(key);
 	return it != _values.end() && it->second.type() == typeid(Object::Ptr);
 }
 
 
-inline void Object::set(const std::string& key, const Dynamic::Var& value)
-{
-	_values[key] = value;
-}
-
-
 inline std::size_t Object::size() const
 {
 	return static_cast<std::size_t>(_values.size());
 }
 
 
-inline void Object::remove(const std::string& key)
-{
-	_values.erase(key);
-}
-
-
 }} // Namespace Poco::JSON
 
 
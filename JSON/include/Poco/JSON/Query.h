@@ -42,6 +42,7 @@
 #include "Poco/JSON/JSON.h"
 #include "Poco/JSON/Object.h"
 #include "Poco/JSON/Array.h"
+#include <vector>
 
 
 namespace Poco {
@@ -50,8 +51,51 @@ namespace JSON {
 
 class JSON_API Query
 	/// Class that can be used to search for a value in a JSON object or array.
+	///
+	/// Paths given as strings are parsed on every call. When the same
+	/// path is used repeatedly, compile it once into a Query::Path
+	/// and pass that instead.
 {
 public:
+	class JSON_API Path
+		/// A precompiled query path.
+		///
+		/// A path consists of property names separated by dots,
+		/// each optionally followed by one or more array indexes
+		/// in square brackets, e.g. "person.children[0].name".
+	{
+	public:
+		struct Segment
+		{
+			std::string      name;
+			std::vector<int> indexes;
+		};
+
+		typedef std::vector<Segment> Segments;
+		typedef Segments::const_iterator Iterator;
+
+		explicit Path(const std::string& path);
+			/// Parses the given path.
+
+		~Path();
+			/// Destroys the Path.
+
+		const std::string& toString() const;
+			/// Returns the path in string form.
+
+		Iterator begin() const;
+			/// Returns an iterator to the first path segment.
+
+		Iterator end() const;
+			/// Returns the end iterator for the path segments.
+
+	private:
+		Path();
+
+		std::string _path;
+		Segments    _segments;
+	};
+
 	Query(const Dynamic::Var& source);
 		/// Constructor. Pass the start object/array.
 
@@ -66,17 +110,36 @@ public:
 		/// Search for an array. When the array can't be found, an empty
 		/// SharedPtr is returned.
 
+	Object::Ptr findObject(const Path& path) const;
+		/// Search for an object, using a precompiled path.
+
+	Array::Ptr findArray(const Path& path) const;
+		/// Search for an array, using a precompiled path.
+
 	Dynamic::Var find(const std::string& path) const;
 		/// Searches a value
 		/// For example: "person.children[0].name" will return the
 		/// the name of the first child. When the value can't be found
 		/// an empty value is returned.
 
+	Dynamic::Var find(const Path& path) const;
+		/// Searches a value, using a precompiled path.
+
 	template<typename T>
 	T findValue(const std::string& path, const T& def) const
 		/// Searches for a value will convert it to the given type.
 		/// When the value can't be found or has an invalid type
 		/// the default value will be returned.
+	{
+		return findValue<T>(Path(path), def);
+	}
+
+	template<typename T>
+	T findValue(const Path& path, const T& def) const
+		/// Searches for a value, using a precompiled path,
+		/// and converts it to the given type.
+		/// When the value can't be found or has an invalid type
+		/// the default value will be returned.
 	{
 		T result = def;
 		Dynamic::Var value = find(path);
@@ -104,6 +167,27 @@ private:
 };
 
 
+//
+// inlines
+//
+inline const std::string& Query::Path::toString() const
+{
+	return _path;
+}
+
+
+inline Query::Path::Iterator Query::Path::begin() const
+{
+	return _segments.begin();
+}
+
+
+inline Query::Path::Iterator Query::Path::end() const
+{
+	return _segments.end();
+}
+
+
 }} // namespace Poco::JSON
 
 
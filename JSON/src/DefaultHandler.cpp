@@ -45,7 +45,7 @@ namespace Poco {
 namespace JSON {
 
 
-DefaultHandler::DefaultHandler() : Handler()
+DefaultHandler::DefaultHandler(bool indexKeys) : Handler(), _indexKeys(indexKeys)
 {
 }
 
@@ -57,7 +57,7 @@ DefaultHandler::~DefaultHandler()
 
 void DefaultHandler::startObject()
 {
-	Object::Ptr newObj = new Object();
+	Object::Ptr newObj = new Object(_indexKeys);
 
 	if ( _stack.empty() ) // The first object
 	{
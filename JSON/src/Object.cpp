@@ -48,20 +48,46 @@ namespace Poco {
 namespace JSON {
 
 
-Object::Object()
+Object::Object(bool indexKeys): _pIndex(0)
 {
-
+	if (indexKeys) _pIndex = new KeyIndex;
 }
 
 
-Object::Object(const Object& copy) : _values(copy._values)
+Object::Object(const Object& copy):
+	_values(copy._values),
+	_pIndex(0)
 {
+	if (copy._pIndex) buildIndex();
 }
 
 
 Object::~Object()
 {
+	delete _pIndex;
+}
+
+
+Object& Object::operator = (const Object& other)
+{
+	if (&other != this)
+	{
+		_values = other._values;
+		delete _pIndex;
+		_pIndex = 0;
+		if (other._pIndex) buildIndex();
+	}
+	return *this;
+}
+
 
+void Object::buildIndex()
+{
+	_pIndex = new KeyIndex(_values.size());
+	for (ValueMap::iterator it = _values.begin(); it != _values.end(); ++it)
+	{
+		_pIndex->insert(KeyIndex::PairType(it->first, it));
+	}
 }
 
 
@@ -69,7 +95,7 @@ Var Object::get(const std::string& key) const
 {
 	Var value;
 
-	ValueMap::const_iterator it = _values.find(key);
+	ValueMap::const_iterator it = find(key);
 	if ( it != _values.end() )
 	{
 		value = it->second;
@@ -104,6 +130,40 @@ Object::Ptr Object::getObject(const std::string& key) const
 }
 
 
+void Object::set(const std::string& key, const Dynamic::Var& value)
+{
+	if (_pIndex)
+	{
+		KeyIndex::Iterator it = _pIndex->find(key);
+		if (it != _pIndex->end())
+		{
+			it->second->second = value;
+		}
+		else
+		{
+			ValueMap::iterator vit = _values.insert(ValueMap::value_type(key, value)).first;
+			_pIndex->insert(KeyIndex::PairType(key, vit));
+		}
+	}
+	else _values[key] = value;
+}
+
+
+void Object::remove(const std::string& key)
+{
+	if (_pIndex)
+	{
+		KeyIndex::Iterator it = _pIndex->find(key);
+		if (it != _pIndex->end())
+		{
+			_values.erase(it->second);
+			_pIndex->erase(it);
+		}
+	}
+	else _values.erase(key);
+}
+
+
 void Object::getNames(std::vector<std::string>& names) const
 {
 	names.clear();
@@ -36,9 +36,8 @@
 
 #include "Poco/JSON/Query.h"
 #include "Poco/StringTokenizer.h"
-#include "Poco/RegularExpression.h"
 #include "Poco/NumberParser.h"
-#include <sstream>
+#include "Poco/Ascii.h"
 
 
 using Poco::Dynamic::Var;
@@ -48,6 +47,43 @@ namespace Poco {
 namespace JSON {
 
 
+Query::Path::Path(const std::string& path): _path(path)
+{
+	StringTokenizer tokenizer(path, ".");
+	_segments.reserve(tokenizer.count());
+	for (StringTokenizer::Iterator token = tokenizer.begin(); token != tokenizer.end(); ++token)
+	{
+		Segment segment;
+		std::string::size_type nameLength = std::string::npos;
+		std::string::size_type pos = 0;
+		while (pos < token->size())
+		{
+			// look for an index of the form [digits]
+			if ((*token)[pos] == '[')
+			{
+				std::string::size_type end = pos + 1;
+				while (end < token->size() && Ascii::isDigit((*token)[end])) ++end;
+				if (end > pos + 1 && end < token->size() && (*token)[end] == ']')
+				{
+					if (nameLength == std::string::npos) nameLength = pos;
+					segment.indexes.push_back(NumberParser::parse(token->substr(pos + 1, end - pos - 1)));
+					pos = end + 1;
+					continue;
+				}
+			}
+			++pos;
+		}
+		segment.name.assign(*token, 0, nameLength);
+		_segments.push_back(segment);
+	}
+}
+
+
+Query::Path::~Path()
+{
+}
+
+
 Query::Query(const Var& source): _source(source)
 {
 
@@ -60,6 +96,12 @@ Query::~Query()
 
 
 Object::Ptr Query::findObject(const std::string& path) const
+{
+	return findObject(Path(path));
+}
+
+
+Object::Ptr Query::findObject(const Path& path) const
 {
 	Object::Ptr obj;
 	Var result = find(path);
@@ -72,6 +114,12 @@ Object::Ptr Query::findObject(const std::string& path) const
 
 
 Array::Ptr Query::findArray(const std::string& path) const
+{
+	return findArray(Path(path));
+}
+
+
+Array::Ptr Query::findArray(const Path& path) const
 {
 	Array::Ptr arr;
 	Var result = find(path);
@@ -84,59 +132,28 @@ Array::Ptr Query::findArray(const std::string& path) const
 
 
 Var Query::find(const std::string& path) const
+{
+	return find(Path(path));
+}
+
+
+Var Query::find(const Path& path) const
 {
 	Var result = _source;
-	StringTokenizer tokenizer(path, ".");
-	for(StringTokenizer::Iterator token = tokenizer.begin(); token != tokenizer.end(); token++)
+	for (Path::Iterator it = path.begin(); it != path.end() && !result.isEmpty(); ++it)
 	{
-		if ( !result.isEmpty() )
+		if ( !it->name.empty() && result.type() == typeid(Object::Ptr) )
 		{
-			std::vector<int> indexes;
-			RegularExpression::MatchVec matches;
-			int firstOffset = -1;
-			int offset = 0;
-			RegularExpression regex("\\[([0-9]+)\\]");
-			while(regex.match(*token, offset, matches) > 0 )
-			{
-				if ( firstOffset == -1 )
-				{
-					firstOffset = static_cast<int>(matches[0].offset);
-				}
-				std::string num = token->substr(matches[1].offset, matches[1].length);
-				indexes.push_back(NumberParser::parse(num));
-				offset = static_cast<int>(matches[0].offset + matches[0].length);
-			}
-
-			std::string name(*token);
-			if ( firstOffset != -1 )
-			{
-				name = name.substr(0, firstOffset);
-			}
-
-			if ( name.length() > 0 )
-			{
-				if ( result.type() == typeid(Object::Ptr) )
-				{
-					Object::Ptr o = result.extract<Object::Ptr>();
-					result = o->get(name);
-				}
-			}
+			Object::Ptr o = result.extract<Object::Ptr>();
+			result = o->get(it->name);
+		}
 
-			if (!result.isEmpty()
-			 && !indexes.empty() )
+		for (std::vector<int>::const_iterator idx = it->indexes.begin(); idx != it->indexes.end() && !result.isEmpty(); ++idx)
+		{
+			if ( result.type() == typeid(Array::Ptr) )
 			{
-				for(std::vector<int>::iterator it = indexes.begin(); it != indexes.end(); ++it )
-				{
-					if ( result.type() == typeid(Array::Ptr) )
-					{
-						Array::Ptr array = result.extract<Array::Ptr>();
-						result = array->get(*it);
-						if ( result.isEmpty() )
-						{
-							break;
-						}
-					}
-				}
+				Array::Ptr array = result.extract<Array::Ptr>();
+				result = array->get(*idx);
 			}
 		}
 	}
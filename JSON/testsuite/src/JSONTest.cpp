@@ -801,6 +801,104 @@ void JSONTest::testQuery()
 }
 
 
+void JSONTest::testQueryPath()
+{
+	std::string json = "{ \"name\" : \"Franky\", \"children\" : [ { \"name\" : \"Jonas\", \"grades\" : [ [ 1, 2 ], [ 3, 4 ] ] }, { \"name\" : \"Ellen\" } ] }";
+	Parser parser;
+	Var result;
+
+	try
+	{
+		DefaultHandler handler;
+		parser.setHandler(&handler);
+		parser.parse(json);
+		result = handler.result();
+	}
+	catch(JSONException& jsone)
+	{
+		std::cout << jsone.message() << std::endl;
+		assert(false);
+	}
+
+	Query query(result);
+
+	Query::Path namePath("children[1].name");
+	assert (namePath.toString() == "children[1].name");
+	assert (query.findValue(namePath, std::string()) == "Ellen");
+	assert (query.findValue<std::string>("children[1].name", "") == "Ellen");
+
+	Query::Path gradePath("children[0].grades[1][0]");
+	assert (query.findValue(gradePath, 0) == 3);
+
+	Object::Ptr child = query.findObject(Query::Path("children[0]"));
+	assert (!child.isNull());
+	assert (child->getValue<std::string>("name") == "Jonas");
+
+	Array::Ptr grades = query.findArray(Query::Path("children[0].grades[0]"));
+	assert (!grades.isNull());
+	assert (grades->size() == 2);
+
+	assert (query.find(Query::Path("children[2].name")).isEmpty());
+	assert (query.find(Query::Path("nobody.name")).isEmpty());
+}
+
+
+void JSONTest::testIndexedObject()
+{
+	std::string json = "{ \"name\" : \"Franky\", \"address\" : { \"city\" : \"Graz\", \"zip\" : 8010 } }";
+	Parser parser;
+	Var result;
+
+	try
+	{
+		DefaultHandler handler(true);
+		parser.setHandler(&handler);
+		parser.parse(json);
+		result = handler.result();
+	}
+	catch(JSONException& jsone)
+	{
+		std::cout << jsone.message() << std::endl;
+		assert(false);
+	}
+
+	assert (result.type() == typeid(Object::Ptr));
+	Object::Ptr object = result.extract<Object::Ptr>();
+	assert (object->isIndexed());
+	assert (object->isObject("address"));
+	Object::Ptr address = object->getObject("address");
+	assert (address->isIndexed());
+	assert (address->getValue<int>("zip") == 8010);
+
+	Query query(result);
+	assert (query.findValue("address.city", "") == "Graz");
+
+	object->set("name", "Ellen");
+	assert (object->getValue<std::string>("name") == "Ellen");
+	object->set("age", 42);
+	assert (object->size() == 3);
+	assert (object->has("age"));
+
+	Object copy(*object);
+	assert (copy.isIndexed());
+	object->remove("age");
+	assert (!object->has("age"));
+	assert (object->size() == 2);
+	assert (copy.has("age"));
+	assert (copy.getValue<int>("age") == 42);
+
+	Object plain;
+	assert (!plain.isIndexed());
+	plain = copy;
+	assert (plain.isIndexed());
+	assert (plain.getValue<std::string>("name") == "Ellen");
+
+	std::ostringstream ostr;
+	object->stringify(ostr);
+	assert (ostr.str() == "{\"address\":{\"city\":\"Graz\",\"zip\":8010},\"name\":\"Ellen\"}");
+}
+
+
 void JSONTest::testStringify()
 {
 	std::string json = "{ \"name\" : \"Franky\", \"children\" : [ \"Jonas\", \"Ellen\" ] }";
@@ -1071,6 +1169,8 @@ CppUnit::Test* JSONTest::suite()
 	CppUnit_addTest(pSuite, JSONTest, testDoubleElement);
 	CppUnit_addTest(pSuite, JSONTest, testOptValue);
 	CppUnit_addTest(pSuite, JSONTest, testQuery);
+	CppUnit_addTest(pSuite, JSONTest, testQueryPath);
+	CppUnit_addTest(pSuite, JSONTest, testIndexedObject);
 	CppUnit_addTest(pSuite, JSONTest, testStringify);
 	CppUnit_addTest(pSuite, JSONTest, testValidJanssonFiles);
 	CppUnit_addTest(pSuite, JSONTest, testInvalidJanssonFiles);
@@ -73,6 +73,8 @@ public:
 	void testDoubleElement();
 	void testOptValue();
 	void testQuery();
+	void testQueryPath();
+	void testIndexedObject();
 	void testStringify();
 
 	void testValidJanssonFiles();
@@ -0,0 +1,218 @@
+//
+// BulkInsert.h
+//
+// $Id$
+//
+// Library: MongoDB
+// Package: MongoDB
+// Module:  BulkInsert
+//
+// Definition of the BulkInsert class.
+//
+// Copyright (c) 2012, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#ifndef MongoDB_BulkInsert_INCLUDED
+#define MongoDB_BulkInsert_INCLUDED
+
+
+#include "Poco/MongoDB/MongoDB.h"
+#include "Poco/MongoDB/Connection.h"
+#include "Poco/MongoDB/Document.h"
+#include "Poco/MongoDB/InsertRequest.h"
+#include "Poco/ObjectPool.h"
+#include "Poco/Thread.h"
+#include "Poco/Mutex.h"
+#include "Poco/Condition.h"
+#include "Poco/RunnableAdapter.h"
+#include "Poco/Timestamp.h"
+#include "Poco/Exception.h"
+#include <deque>
+#include <vector>
+
+
+namespace Poco {
+namespace MongoDB {
+
+
+class MongoDB_API BulkInsert
+	/// BulkInsert collects documents for a collection and sends them
+	/// in OP_INSERT messages that are as large as the configured limits
+	/// allow. A message is sent as soon as it holds the maximum number
+	/// of documents, or when the next document would exceed the
+	/// maximum message size. Each document is serialized only once,
+	/// when it is added.
+	///
+	/// A BulkInsert created for a single connection sends the messages
+	/// from the calling thread. A BulkInsert created for a connection pool
+	/// sends the messages from background threads, each of which borrows
+	/// a connection from the pool, so that serialization and sending
+	/// overlap and several messages can be in flight at the same time.
+	/// An error raised by a background thread is rethrown by the next
+	/// call to add() or flush(); the documents of the failed message
+	/// are lost.
+	///
+	/// As with InsertRequest, inserts are not acknowledged by the server.
+	/// Use Database::getLastError() to check for errors.
+	///
+	/// A BulkInsert must only be used by one thread at a time.
+{
+public:
+	typedef Poco::ObjectPool<Connection, Connection::Ptr> ConnectionPool;
+
+	enum
+	{
+		DEFAULT_MAX_DOCUMENTS = 1000,
+			/// Maximum number of documents in a write batch.
+		DEFAULT_MAX_MESSAGE_SIZE = 48000000
+			/// Maximum size of a message accepted by the server.
+	};
+
+	BulkInsert(Connection& connection, const std::string& fullCollectionName, InsertRequest::Flags flags = InsertRequest::INSERT_NONE);
+		/// Creates a BulkInsert that sends messages through the given
+		/// connection, from the thread that adds the documents.
+
+	BulkInsert(ConnectionPool& pool, const std::string& fullCollectionName, int threads = 2, InsertRequest::Flags flags = InsertRequest::INSERT_NONE);
+		/// Creates a BulkInsert that sends messages from the given number
+		/// of background threads, using connections borrowed from the pool.
+		/// At most threads messages are queued in addition to the messages
+		/// being sent; add() blocks while the queue is full.
+
+	~BulkInsert();
+		/// Flushes the remaining documents and destroys the BulkInsert.
+		/// Errors are ignored; call flush() before to detect them.
+
+	void add(const Document::Ptr& pDocument);
+		/// Adds a document for insertion. The document is serialized
+		/// immediately and may be modified or reused afterwards.
+		///
+		/// Throws a RangeException if the document does not fit into
+		/// a message of the maximum message size.
+
+	void flush();
+		/// Sends the documents collected so far and waits until all
+		/// messages have been sent.
+
+	void setMaxDocuments(std::size_t maxDocuments);
+		/// Sets the maximum number of documents per message.
+
+	std::size_t getMaxDocuments() const;
+		/// Returns the maximum number of documents per message.
+
+	void setMaxMessageSize(std::size_t maxMessageSize);
+		/// Sets the maximum size of a message in bytes, including
+		/// the message header.
+
+	std::size_t getMaxMessageSize() const;
+		/// Returns the maximum size of a message in bytes.
+
+	std::size_t pending() const;
+		/// Returns the number of documents that have been added,
+		/// but not yet sent.
+
+	std::size_t inserted() const;
+		/// Returns the number of documents that have been sent.
+
+	std::size_t messages() const;
+		/// Returns the number of messages that have been sent.
+
+	double rate() const;
+		/// Returns the number of documents sent per second, measured
+		/// from the first call to add() to the last message sent.
+
+private:
+	class Batch;
+	typedef Poco::SharedPtr<Batch> BatchPtr;
+
+	BulkInsert(const BulkInsert&);
+	BulkInsert& operator = (const BulkInsert&);
+
+	std::size_t overhead() const;
+	BatchPtr acquireBatch();
+	void submit(BatchPtr pBatch);
+	void send(Connection& connection, Batch& batch);
+	void sent(BatchPtr pBatch);
+	void rethrow();
+	void startThreads();
+	void stopThreads();
+	void run();
+
+	Connection*           _pConnection;
+	ConnectionPool*       _pPool;
+	std::string           _fullCollectionName;
+	Int32                 _flags;
+	std::size_t           _maxDocuments;
+	std::size_t           _maxMessageSize;
+	std::size_t           _threadCount;
+	BatchPtr              _pBatch;
+	std::deque<BatchPtr>  _queue;
+	std::vector<BatchPtr> _free;
+	std::size_t           _sending;
+	std::size_t           _inserted;
+	std::size_t           _messages;
+	Poco::Timestamp       _firstAdded;
+	Poco::Timestamp       _lastSent;
+	bool                  _stop;
+	Poco::SharedPtr<Poco::Exception> _pException;
+	std::vector<Poco::SharedPtr<Poco::Thread> > _threads;
+	Poco::RunnableAdapter<BulkInsert> _runnable;
+	mutable Poco::Mutex   _mutex;
+	Poco::Condition       _changed;
+};
+
+
+//
+// inlines
+//
+inline void BulkInsert::setMaxDocuments(std::size_t maxDocuments)
+{
+	_maxDocuments = maxDocuments > 0 ? maxDocuments : 1;
+}
+
+
+inline std::size_t BulkInsert::getMaxDocuments() const
+{
+	return _maxDocuments;
+}
+
+
+inline void BulkInsert::setMaxMessageSize(std::size_t maxMessageSize)
+{
+	_maxMessageSize = maxMessageSize;
+}
+
+
+inline std::size_t BulkInsert::getMaxMessageSize() const
+{
+	return _maxMessageSize;
+}
+
+
+} } // namespace Poco::MongoDB
+
+
+#endif //MongoDB_BulkInsert_INCLUDED
@@ -42,9 +42,15 @@
 
 #include "Poco/Net/SocketAddress.h"
 #include "Poco/Net/StreamSocket.h"
+#include "Poco/Net/SocketStream.h"
 #include "Poco/Mutex.h"
+#include "Poco/Condition.h"
+#include "Poco/SharedPtr.h"
+#include "Poco/Exception.h"
 #include "Poco/MongoDB/RequestMessage.h"
 #include "Poco/MongoDB/ResponseMessage.h"
+#include "Poco/MongoDB/MessageBuffer.h"
+#include <map>
 
 
 namespace Poco {
@@ -53,6 +59,16 @@ namespace MongoDB {
 
 class MongoDB_API Connection
 	/// Represents a connection to a MongoDB server
+	///
+	/// Every request sent over the connection gets a unique request ID.
+	///
+	/// By default, a connection must only be used by one thread at a time
+	/// and has at most one request in flight. If pipelining is enabled (see
+	/// setPipelining()), the connection can be shared by multiple threads:
+	/// requests are written as soon as they are sent, and the replies
+	/// are matched to the waiting requests by the responseTo field of the
+	/// reply header. Each thread blocks only until its own reply arrives,
+	/// so many small concurrent queries can share one socket.
 {
 public:
 	typedef Poco::SharedPtr<Connection> Ptr;
@@ -98,12 +114,62 @@ public:
 		/// Sends a request to the MongoDB server and receives the response.
 		/// Use this when a response is expected: only a query or getmore
 		/// request will return a response.
+		///
+		/// If pipelining is enabled, this method can be called by
+		/// multiple threads at the same time.
+
+	void setPipelining(bool flag);
+		/// Enables or disables pipelining. Pipelining is disabled
+		/// by default. Must not be changed while requests are pending.
+
+	bool getPipelining() const;
+		/// Returns true iff pipelining is enabled.
+
+	bool isConnected() const;
+		/// Returns true if the connection has been established and
+		/// no I/O error occurred since.
 
 private:
-	Net::SocketAddress _address;
-	Net::StreamSocket _socket;
+	struct PendingReply
+		/// A request waiting for its reply in pipelining mode.
+	{
+		PendingReply(ResponseMessage& response);
+
+		ResponseMessage& response;
+		bool done;
+		Poco::SharedPtr<Poco::Exception> pException;
+	};
+
+	typedef std::map<Int32, PendingReply*> PendingMap;
+
 	void connect();
 		/// Connects to the MongoDB server
+
+	Int32 nextRequestID();
+		/// Returns the ID for the next request.
+		/// Must be called with the write mutex locked.
+
+	void writeRequest(RequestMessage& request);
+		/// Serializes the request into the write buffer and
+		/// sends it with a single socket call.
+		/// Must be called with the write mutex locked.
+
+	void waitForReply(PendingReply& pending);
+		/// Waits until the reply for the pending request has been
+		/// received, reading replies for other requests meanwhile.
+
+	Net::SocketAddress _address;
+	Net::StreamSocket _socket;
+	Poco::SharedPtr<Net::SocketInputStream> _pInput;
+	MessageBuffer _writeBuffer;
+	bool _connected;
+	bool _pipelining;
+	Int32 _lastRequestID;
+	Poco::FastMutex _writeMutex;
+	Poco::FastMutex _readMutex;
+	Poco::Condition _replied;
+	bool _reading;
+	PendingMap _pending;
 };
 
 
@@ -113,6 +179,24 @@ inline Net::SocketAddress Connection::address() const
 }
 
 
+inline void Connection::setPipelining(bool flag)
+{
+	_pipelining = flag;
+}
+
+
+inline bool Connection::getPipelining() const
+{
+	return _pipelining;
+}
+
+
+inline bool Connection::isConnected() const
+{
+	return _connected;
+}
+
+
 } } // namespace Poco::MongoDB
 
 
@@ -44,6 +44,12 @@
 #include "Poco/MongoDB/Connection.h"
 #include "Poco/MongoDB/QueryRequest.h"
 #include "Poco/MongoDB/ResponseMessage.h"
+#include "Poco/Thread.h"
+#include "Poco/Mutex.h"
+#include "Poco/Condition.h"
+#include "Poco/RunnableAdapter.h"
+#include "Poco/Exception.h"
+#include <deque>
 
 
 namespace Poco {
@@ -52,6 +58,11 @@ namespace MongoDB {
 
 class MongoDB_API Cursor : public Document
 	/// Cursor is an helper class for querying multiple documents
+	///
+	/// By default, next() sends a GetMoreRequest only after the previous
+	/// batch has been consumed. With prefetching enabled, a background
+	/// thread requests the following batches while the current batch
+	/// is processed, keeping up to a given number of batches buffered.
 {
 public:
 	Cursor(const std::string& dbname, const std::string& collectionName, QueryRequest::Flags flags = QueryRequest::QUERY_NONE);
@@ -67,16 +78,61 @@ public:
 		/// Try to get the next documents. As long as ResponseMessage has a
 		/// cursor id next can be called to retrieve the next bunch of documents.
 		/// kill must be called when not all documents are needed.
+		///
+		/// When prefetching is enabled, the connection is used by the
+		/// background thread until the last batch has been received or
+		/// kill is called, and must stay valid until then. Since the
+		/// connection is shared with the caller, it must have pipelining
+		/// enabled (see Connection::setPipelining()), otherwise an
+		/// InvalidAccessException is thrown. An exception thrown while
+		/// prefetching is rethrown by the next call.
 
 	QueryRequest& query();
 		/// Returns the associated query
 
 	void kill(Connection& connection);
 		/// Kills the cursor and reset it so that it can be reused.
+		/// A running prefetch is stopped and buffered batches are discarded.
+
+	void setBatchSize(Int32 batchSize);
+		/// Sets the number of documents requested per batch,
+		/// for both the query and the following GetMoreRequests.
+		/// 0 lets the server choose the batch size.
+
+	Int32 getBatchSize() const;
+		/// Returns the number of documents requested per batch.
+
+	void setPrefetch(std::size_t batches);
+		/// Sets the maximum number of batches that are requested
+		/// ahead and buffered. 0, the default, disables prefetching.
+		/// Takes effect with the next query. Prefetching requires
+		/// a connection with pipelining enabled.
+
+	std::size_t getPrefetch() const;
+		/// Returns the maximum number of prefetched batches.
 
 private:
+	typedef Poco::SharedPtr<ResponseMessage> ResponsePtr;
+
+	void startPrefetch(Connection& connection);
+	void stopPrefetch();
+	void prefetch();
+
 	QueryRequest    _query;
 	ResponseMessage _response;
+
+	std::size_t              _prefetch;
+	Connection*              _pConnection;
+	std::deque<ResponsePtr>  _batches;
+	Int64                    _prefetchCursorID;
+	bool                     _prefetching;
+	bool                     _stopPrefetch;
+	bool                     _prefetchDone;
+	Poco::SharedPtr<Poco::Exception> _pPrefetchException;
+	Poco::Thread             _prefetchThread;
+	Poco::RunnableAdapter<Cursor> _prefetchRunnable;
+	Poco::Mutex              _mutex;
+	Poco::Condition          _changed;
 };
 
 
@@ -86,6 +142,30 @@ inline QueryRequest& Cursor::query()
 }
 
 
+inline void Cursor::setBatchSize(Int32 batchSize)
+{
+	_query.setNumberToReturn(batchSize);
+}
+
+
+inline Int32 Cursor::getBatchSize() const
+{
+	return _query.getNumberToReturn();
+}
+
+
+inline void Cursor::setPrefetch(std::size_t batches)
+{
+	_prefetch = batches;
+}
+
+
+inline std::size_t Cursor::getPrefetch() const
+{
+	return _prefetch;
+}
+
+
 } } // namespace Poco::MongoDB
 
 
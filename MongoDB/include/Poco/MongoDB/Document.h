@@ -44,6 +44,8 @@
 #include "Poco/BinaryWriter.h"
 #include "Poco/MongoDB/MongoDB.h"
 #include "Poco/MongoDB/Element.h"
+#include "Poco/HashMap.h"
+#include "Poco/Buffer.h"
 #include <algorithm>
 
 
@@ -69,10 +71,21 @@ private:
 
 class MongoDB_API Document
 	/// Represents a BSON document
+	///
+	/// A document that is read from BSON keeps a reference to the raw
+	/// bytes and only indexes the element names. An element is decoded
+	/// the first time it is accessed, and nested documents share the
+	/// raw bytes of their parent. Elements are looked up by name in a
+	/// hash index.
+	///
+	/// As elements are decoded on access, a Document must not be used
+	/// from multiple threads without synchronization, even if only
+	/// const member functions are called.
 {
 public:
 	typedef SharedPtr<Document> Ptr;
 	typedef std::vector<Document::Ptr> Vector;
+	typedef SharedPtr<Poco::Buffer<char> > BufferPtr;
 
 	Document();
 		/// Constructor
@@ -110,13 +123,15 @@ public:
 		/// Removes all elements from the document.
 
 	void elementNames(std::vector<std::string>& keys) const;
-		/// Puts all element names into std::vector.
+		/// Puts all element names into std::vector, in the same
+		/// order as they are written.
 
 	bool empty() const;
 		/// Returns true when the document doesn't contain any documents.
 
-	bool exists(const std::string& name);
-		/// Returns true when the document has an element with the given name
+	bool exists(const std::string& name) const;
+		/// Returns true when the document has an element with the given name.
+		/// The element is not decoded.
 
 	template<typename T>
 	T get(const std::string& name) const
@@ -169,42 +184,99 @@ public:
 	}
 
 	Element::Ptr get(const std::string& name) const;
-		/// Returns the element with the given name.
+		/// Returns the element with the given name, decoding it
+		/// if necessary.
 		/// An empty element will be returned when the element is not found.
 
 	template<typename T>
 	bool isType(const std::string& name)
-		/// Returns true when the type of the element equals the TypeId of ElementTrait
+		/// Returns true when the type of the element equals the TypeId of ElementTrait.
+		/// The element is not decoded.
 	{
-		Element::Ptr element = get(name);
-		if ( element.isNull() )
+		ElementIndex::ConstIterator it = _index.find(name);
+		if ( it == _index.end() )
 		{
 			return false;
 		}
 
-		return ElementTraits<T>::TypeId == element->type();
+		return ElementTraits<T>::TypeId == it->second.type;
 	}
 
 	void read(BinaryReader& reader);
 		/// Reads a document from the reader
 
+	std::size_t read(const char* pData, std::size_t size);
+		/// Reads a document from the given memory area, which must
+		/// start with the document's length prefix, and returns the
+		/// number of bytes consumed. The document's bytes are copied.
+		///
+		/// Throws a DataFormatException if the data is not a
+		/// valid BSON document.
+
+	std::size_t read(const BufferPtr& pBuffer, std::size_t offset);
+		/// Reads the document that starts at the given offset of
+		/// the buffer and returns the number of bytes consumed.
+		/// The buffer is not copied, but shared by the document
+		/// until all elements have been decoded.
+		///
+		/// Throws a DataFormatException if the data is not a
+		/// valid BSON document.
+
 	size_t size() const;
 		/// Returns the number of elements in the document.
 
 	virtual std::string toString(int indent = 0) const;
 		/// Returns a String representation of the document.
 
-	void write(BinaryWriter& writer);
-		/// Writes a document to the reader
+	void write(BinaryWriter& writer) const;
+		/// Writes a document to the writer.
+		///
+		/// A document that has been read and not accessed since is
+		/// written as a copy of its raw bytes. If the writer writes to
+		/// a MessageBuffer, the document is serialized in place and its
+		/// length prefix is patched afterwards. Otherwise, the elements
+		/// are staged in a temporary stream to compute the length.
 
 protected:
-	ElementSet _elements;
+	void decodeAll() const;
+		/// Decodes all elements that have not been accessed yet.
+
+	void writeElements(BinaryWriter& writer) const;
+		/// Writes the type, name and value of all elements.
+
+	mutable ElementSet _elements;
+
+private:
+	struct Entry
+	{
+		Element::Ptr element;   // null until decoded
+		unsigned char type;
+		std::size_t offset;     // offset of the value in the raw buffer
+	};
+
+	typedef Poco::HashMap<std::string, Entry> ElementIndex;
+
+	Element::Ptr decode(const std::string& name, Entry& entry) const;
+	void releaseBuffer() const;
+
+	mutable ElementIndex _index;
+	mutable BufferPtr _pBuffer;
+	std::size_t _offset;
+	std::size_t _length;
+	mutable std::size_t _undecoded;
 };
 
 
 inline Document& Document::addElement(Element::Ptr element)
 {
-	_elements.insert(element);
+	Entry entry;
+	entry.element = element;
+	entry.type = static_cast<unsigned char>(element->type());
+	entry.offset = 0;
+	if ( _index.insert(ElementIndex::PairType(element->name(), entry)).second )
+	{
+		_elements.insert(element);
+	}
 	return *this;
 }
 
@@ -217,36 +289,21 @@ inline Document& Document::addNewDocument(const std::string& name)
 }
 
 
-inline void Document::clear()
-{
-	_elements.clear();
-}
-
-
 inline bool Document::empty() const
 {
-	return _elements.empty();
-}
-
-
-inline void Document::elementNames(std::vector<std::string>& keys) const
-{
-	for(ElementSet::const_iterator it = _elements.begin(); it != _elements.end(); ++it)
-	{
-		keys.push_back((*it)->name());
-	}
+	return _index.empty();
 }
 
 
-inline bool Document::exists(const std::string& name)
+inline bool Document::exists(const std::string& name) const
 {
-	return std::find_if(_elements.begin(), _elements.end(), ElementFindByName(name)) != _elements.end();
+	return _index.count(name) > 0;
 }
 
 
 inline size_t Document::size() const
 {
-	return _elements.size();
+	return _index.size();
 }
 
 
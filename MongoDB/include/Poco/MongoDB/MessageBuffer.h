@@ -0,0 +1,133 @@
+//
+// MessageBuffer.h
+//
+// $Id$
+//
+// Library: MongoDB
+// Package: MongoDB
+// Module:  MessageBuffer
+//
+// Definition of the MessageBuffer class.
+//
+// Copyright (c) 2012, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#ifndef MongoDB_MessageBuffer_INCLUDED
+#define MongoDB_MessageBuffer_INCLUDED
+
+
+#include "Poco/MongoDB/MongoDB.h"
+#include <streambuf>
+#include <vector>
+
+
+namespace Poco {
+namespace MongoDB {
+
+
+class MongoDB_API MessageBuffer: public std::streambuf
+	/// A growable stream buffer that keeps the written data in one
+	/// contiguous memory area.
+	///
+	/// Requests are serialized into a MessageBuffer, so that a message
+	/// can be sent with a single socket call. Length prefixes are written
+	/// as placeholders and patched in place once the size is known.
+	/// clear() keeps the allocated memory, so the buffer can be reused
+	/// for many messages.
+{
+public:
+	explicit MessageBuffer(std::size_t capacity = 1024);
+		/// Creates the MessageBuffer with the given initial capacity.
+
+	~MessageBuffer();
+		/// Destroys the MessageBuffer.
+
+	const char* begin() const;
+		/// Returns a pointer to the written data.
+
+	std::size_t size() const;
+		/// Returns the number of bytes written.
+
+	std::size_t capacity() const;
+		/// Returns the number of bytes that can be written
+		/// before the buffer must grow.
+
+	void clear();
+		/// Discards the written data, but keeps the allocated memory.
+
+	void truncate(std::size_t size);
+		/// Discards all but the first size bytes of the written data.
+		///
+		/// Throws a RangeException if size is larger than the
+		/// size of the written data.
+
+	void patch(std::size_t pos, Poco::Int32 value);
+		/// Overwrites the four bytes at the given position with
+		/// the little endian representation of value.
+		///
+		/// Throws a RangeException if pos is not within the written data.
+
+protected:
+	int_type overflow(int_type c);
+	std::streamsize xsputn(const char* s, std::streamsize n);
+	int sync();
+
+private:
+	MessageBuffer(const MessageBuffer&);
+	MessageBuffer& operator = (const MessageBuffer&);
+
+	void reserve(std::size_t capacity);
+
+	std::vector<char> _buffer;
+};
+
+
+//
+// inlines
+//
+inline const char* MessageBuffer::begin() const
+{
+	return pbase();
+}
+
+
+inline std::size_t MessageBuffer::size() const
+{
+	return static_cast<std::size_t>(pptr() - pbase());
+}
+
+
+inline std::size_t MessageBuffer::capacity() const
+{
+	return _buffer.size();
+}
+
+
+} } // namespace Poco::MongoDB
+
+
+#endif //MongoDB_MessageBuffer_INCLUDED
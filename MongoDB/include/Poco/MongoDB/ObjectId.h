@@ -81,6 +81,7 @@ private:
 
 	friend class BSONWriter;
 	friend class BSONReader;
+	friend class Document;
 };
 
 
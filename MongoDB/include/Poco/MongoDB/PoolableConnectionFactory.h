@@ -51,9 +51,12 @@ template<>
 class PoolableObjectFactory<MongoDB::Connection, MongoDB::Connection::Ptr>
 	/// PoolableObjectFactory specialisation for Connection. New connections
 	/// are created with the given address.
+	///
+	/// Connections that failed with an I/O error are not returned to
+	/// the pool, but destroyed.
 {
 public:
-	PoolableObjectFactory(Net::SocketAddress& address)
+	PoolableObjectFactory(const Net::SocketAddress& address)
 		: _address(address)
 	{
 	}
@@ -70,7 +73,7 @@ public:
 	
 	bool validateObject(MongoDB::Connection::Ptr pObject)
 	{
-		return true;
+		return pObject->isConnected();
 	}
 
 	void activateObject(MongoDB::Connection::Ptr pObject)
@@ -95,11 +98,21 @@ namespace MongoDB {
 
 class PooledConnection
 	/// Helper class for borrowing and returning a connection automatically from a pool.
+	///
+	/// The pool is thread-safe, so a PooledConnection can be created by
+	/// any number of threads, each of which gets its own connection.
 {
 public:
-	PooledConnection(Poco::ObjectPool<Connection, Connection::Ptr>& pool) : _pool(pool)
+	PooledConnection(Poco::ObjectPool<Connection, Connection::Ptr>& pool, long acquireTimeout = 0) : _pool(pool)
+		/// Borrows a connection from the pool. If no connection is available,
+		/// waits up to acquireTimeout milliseconds for a connection to be
+		/// returned to the pool.
+		///
+		/// Throws a TimeoutException if no connection is available.
 	{
-		_connection = _pool.borrowObject();
+		_connection = _pool.borrowObject(acquireTimeout);
+		if (!_connection)
+			throw Poco::TimeoutException("No MongoDB connection available in pool");
 	}
 
 	virtual ~PooledConnection()
@@ -112,7 +125,15 @@ public:
 		return _connection;
 	}
 
+	Connection* operator -> ()
+	{
+		return _connection.get();
+	}
+
 private:
+	PooledConnection(const PooledConnection&);
+	PooledConnection& operator = (const PooledConnection&);
+
 	Poco::ObjectPool<Connection, Connection::Ptr>& _pool;
 	Connection::Ptr _connection;
 };
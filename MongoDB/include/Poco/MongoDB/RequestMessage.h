@@ -42,6 +42,7 @@
 
 #include "Poco/MongoDB/MongoDB.h"
 #include "Poco/MongoDB/Message.h"
+#include "Poco/MongoDB/MessageBuffer.h"
 #include <ostream>
 
 
@@ -62,6 +63,12 @@ public:
 	void send(std::ostream& ostr);
 		/// Sends the request to stream
 
+	void write(MessageBuffer& buffer);
+		/// Serializes the complete request, including the message
+		/// header, into the given buffer. The buffer is cleared first.
+		/// The message length is patched into the header once the
+		/// request has been built, so no intermediate copy is needed.
+
 protected:
 	virtual void buildRequest(BinaryWriter& ss) = 0;
 };
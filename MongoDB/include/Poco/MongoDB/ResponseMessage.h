@@ -79,7 +79,10 @@ public:
 		/// Returns true when there is at least one document
 
 	void read(std::istream& istr);
-		/// Reads the response from the stream
+		/// Reads the response from the stream.
+		///
+		/// The complete message is read with one call into a
+		/// contiguous buffer, from which the documents are decoded.
 
 private:
 	Int32 _responseFlags;
@@ -60,6 +60,8 @@ Element::Ptr Array::get(int pos) const
 
 std::string Array::toString(int indent) const
 {
+	decodeAll();
+
 	std::ostringstream oss;
 
 	oss << "[";
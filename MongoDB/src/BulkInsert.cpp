@@ -0,0 +1,402 @@
+//
+// BulkInsert.cpp
+//
+// $Id$
+//
+// Library: MongoDB
+// Package: MongoDB
+// Module:  BulkInsert
+//
+// Implementation of the BulkInsert class.
+//
+// Copyright (c) 2012, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#include "Poco/MongoDB/BulkInsert.h"
+#include "Poco/MongoDB/RequestMessage.h"
+#include "Poco/MongoDB/MessageBuffer.h"
+#include "Poco/MongoDB/PoolableConnectionFactory.h"
+#include "Poco/BinaryWriter.h"
+#include <ostream>
+
+
+namespace Poco {
+namespace MongoDB {
+
+
+class BulkInsert::Batch
+	/// The serialized documents of one message.
+{
+public:
+	Batch():
+		stream(&buffer),
+		writer(stream, BinaryWriter::LITTLE_ENDIAN_BYTE_ORDER),
+		documents(0)
+	{
+	}
+
+	void clear()
+	{
+		buffer.clear();
+		documents = 0;
+	}
+
+	MessageBuffer buffer;
+	std::ostream stream;
+	BinaryWriter writer;
+	std::size_t documents;
+};
+
+
+namespace
+{
+	class BatchRequest: public RequestMessage
+		/// An OP_INSERT request for documents that
+		/// have already been serialized.
+	{
+	public:
+		BatchRequest(const std::string& fullCollectionName, Int32 flags, const MessageBuffer& documents):
+			RequestMessage(MessageHeader::Insert),
+			_fullCollectionName(fullCollectionName),
+			_flags(flags),
+			_documents(documents)
+		{
+		}
+
+	protected:
+		void buildRequest(BinaryWriter& writer)
+		{
+			writer << _flags;
+			BSONWriter(writer).writeCString(_fullCollectionName);
+			writer.writeRaw(_documents.begin(), _documents.size());
+		}
+
+	private:
+		const std::string& _fullCollectionName;
+		Int32 _flags;
+		const MessageBuffer& _documents;
+	};
+
+	const long CONNECTION_TIMEOUT = 10000; // milliseconds to wait for a pooled connection
+}
+
+
+BulkInsert::BulkInsert(Connection& connection, const std::string& fullCollectionName, InsertRequest::Flags flags):
+	_pConnection(&connection),
+	_pPool(0),
+	_fullCollectionName(fullCollectionName),
+	_flags(flags),
+	_maxDocuments(DEFAULT_MAX_DOCUMENTS),
+	_maxMessageSize(DEFAULT_MAX_MESSAGE_SIZE),
+	_threadCount(0),
+	_sending(0),
+	_inserted(0),
+	_messages(0),
+	_stop(false),
+	_runnable(*this, &BulkInsert::run)
+{
+	_pBatch = acquireBatch();
+}
+
+
+BulkInsert::BulkInsert(ConnectionPool& pool, const std::string& fullCollectionName, int threads, InsertRequest::Flags flags):
+	_pConnection(0),
+	_pPool(&pool),
+	_fullCollectionName(fullCollectionName),
+	_flags(flags),
+	_maxDocuments(DEFAULT_MAX_DOCUMENTS),
+	_maxMessageSize(DEFAULT_MAX_MESSAGE_SIZE),
+	_threadCount(threads > 0 ? threads : 1),
+	_sending(0),
+	_inserted(0),
+	_messages(0),
+	_stop(false),
+	_runnable(*this, &BulkInsert::run)
+{
+	_pBatch = acquireBatch();
+}
+
+
+BulkInsert::~BulkInsert()
+{
+	try
+	{
+		flush();
+	}
+	catch (...)
+	{
+	}
+	try
+	{
+		stopThreads();
+	}
+	catch (...)
+	{
+	}
+}
+
+
+void BulkInsert::add(const Document::Ptr& pDocument)
+{
+	rethrow();
+
+	{
+		Poco::Mutex::ScopedLock lock(_mutex);
+		if (_inserted == 0 && _pBatch->documents == 0 && _queue.empty() && _sending == 0)
+			_firstAdded.update();
+	}
+
+	Batch& batch = *_pBatch;
+	std::size_t start = batch.buffer.size();
+	pDocument->write(batch.writer);
+	batch.writer.flush();
+	std::size_t size = batch.buffer.size() - start;
+
+	if (overhead() + size > _maxMessageSize)
+	{
+		batch.buffer.truncate(start);
+		throw RangeException("Document exceeds the maximum message size");
+	}
+	if (overhead() + batch.buffer.size() > _maxMessageSize)
+	{
+		// the document does not fit into the current message,
+		// so it starts the next one
+		BatchPtr pNext = acquireBatch();
+		pNext->buffer.sputn(batch.buffer.begin() + start, static_cast<std::streamsize>(size));
+		batch.buffer.truncate(start);
+		submit(_pBatch);
+		_pBatch = pNext;
+	}
+
+	if (++_pBatch->documents >= _maxDocuments)
+	{
+		submit(_pBatch);
+		_pBatch = acquireBatch();
+	}
+}
+
+
+void BulkInsert::flush()
+{
+	if (_pBatch->documents > 0)
+	{
+		submit(_pBatch);
+		_pBatch = acquireBatch();
+	}
+
+	if (_pPool)
+	{
+		Poco::Mutex::ScopedLock lock(_mutex);
+		while (!_queue.empty() || _sending > 0)
+		{
+			_changed.wait(_mutex);
+		}
+	}
+	rethrow();
+}
+
+
+std::size_t BulkInsert::pending() const
+{
+	Poco::Mutex::ScopedLock lock(_mutex);
+	std::size_t documents = _pBatch->documents;
+	for (std::deque<BatchPtr>::const_iterator it = _queue.begin(); it != _queue.end(); ++it)
+	{
+		documents += (*it)->documents;
+	}
+	return documents;
+}
+
+
+std::size_t BulkInsert::inserted() const
+{
+	Poco::Mutex::ScopedLock lock(_mutex);
+	return _inserted;
+}
+
+
+std::size_t BulkInsert::messages() const
+{
+	Poco::Mutex::ScopedLock lock(_mutex);
+	return _messages;
+}
+
+
+double BulkInsert::rate() const
+{
+	Poco::Mutex::ScopedLock lock(_mutex);
+	Poco::Timestamp::TimeDiff elapsed = _lastSent - _firstAdded;
+	if (_inserted == 0 || elapsed <= 0) return 0;
+	return _inserted*1000000.0/elapsed;
+}
+
+
+std::size_t BulkInsert::overhead() const
+{
+	// message header, flags and collection name
+	return MSG_HEADER_SIZE + sizeof(Int32) + _fullCollectionName.size() + 1;
+}
+
+
+BulkInsert::BatchPtr BulkInsert::acquireBatch()
+{
+	Poco::Mutex::ScopedLock lock(_mutex);
+	if (_free.empty()) return new Batch;
+
+	BatchPtr pBatch = _free.back();
+	_free.pop_back();
+	return pBatch;
+}
+
+
+void BulkInsert::submit(BatchPtr pBatch)
+{
+	if (!_pPool)
+	{
+		send(*_pConnection, *pBatch);
+		sent(pBatch);
+		return;
+	}
+
+	startThreads();
+	Poco::Mutex::ScopedLock lock(_mutex);
+	while (_queue.size() >= _threadCount && !_pException)
+	{
+		_changed.wait(_mutex);
+	}
+	_queue.push_back(pBatch);
+	_changed.broadcast();
+}
+
+
+void BulkInsert::send(Connection& connection, Batch& batch)
+{
+	BatchRequest request(_fullCollectionName, _flags, batch.buffer);
+	connection.sendRequest(request);
+}
+
+
+void BulkInsert::sent(BatchPtr pBatch)
+{
+	Poco::Mutex::ScopedLock lock(_mutex);
+	_inserted += pBatch->documents;
+	++_messages;
+	_lastSent.update();
+	pBatch->clear();
+	_free.push_back(pBatch);
+}
+
+
+void BulkInsert::rethrow()
+{
+	Poco::SharedPtr<Poco::Exception> pException;
+	{
+		Poco::Mutex::ScopedLock lock(_mutex);
+		pException = _pException;
+		_pException = 0;
+	}
+	if (pException) pException->rethrow();
+}
+
+
+void BulkInsert::startThreads()
+{
+	if (!_threads.empty()) return;
+
+	for (std::size_t i = 0; i < _threadCount; ++i)
+	{
+		Poco::SharedPtr<Poco::Thread> pThread = new Poco::Thread;
+		pThread->start(_runnable);
+		_threads.push_back(pThread);
+	}
+}
+
+
+void BulkInsert::stopThreads()
+{
+	{
+		Poco::Mutex::ScopedLock lock(_mutex);
+		_stop = true;
+		_changed.broadcast();
+	}
+	for (std::vector<Poco::SharedPtr<Poco::Thread> >::iterator it = _threads.begin(); it != _threads.end(); ++it)
+	{
+		(*it)->join();
+	}
+	_threads.clear();
+}
+
+
+void BulkInsert::run()
+{
+	for (;;)
+	{
+		BatchPtr pBatch;
+		{
+			Poco::Mutex::ScopedLock lock(_mutex);
+			while (_queue.empty() && !_stop)
+			{
+				_changed.wait(_mutex);
+			}
+			if (_queue.empty()) return;
+
+			pBatch = _queue.front();
+			_queue.pop_front();
+			++_sending;
+			_changed.broadcast();
+		}
+
+		try
+		{
+			PooledConnection pooled(*_pPool, CONNECTION_TIMEOUT);
+			Connection::Ptr pConnection = pooled;
+			send(*pConnection, *pBatch);
+			sent(pBatch);
+		}
+		catch (Poco::Exception& exc)
+		{
+			Poco::Mutex::ScopedLock lock(_mutex);
+			if (!_pException) _pException = exc.clone();
+			pBatch->clear();
+			_free.push_back(pBatch);
+		}
+		catch (std::exception& exc)
+		{
+			Poco::Mutex::ScopedLock lock(_mutex);
+			if (!_pException) _pException = new Poco::Exception(exc.what());
+			pBatch->clear();
+			_free.push_back(pBatch);
+		}
+
+		Poco::Mutex::ScopedLock lock(_mutex);
+		--_sending;
+		_changed.broadcast();
+	}
+}
+
+
+} } // namespace Poco::MongoDB
@@ -44,23 +44,30 @@ namespace Poco
 namespace MongoDB
 {
 
-Connection::Connection() : _address(), _socket()
+Connection::PendingReply::PendingReply(ResponseMessage& rResponse):
+	response(rResponse),
+	done(false)
 {
 }
 
 
-Connection::Connection(const std::string& hostAndPort) : _address(hostAndPort), _socket()
+Connection::Connection() : _address(), _socket(), _connected(false), _pipelining(false), _lastRequestID(0), _reading(false)
+{
+}
+
+
+Connection::Connection(const std::string& hostAndPort) : _address(hostAndPort), _socket(), _connected(false), _pipelining(false), _lastRequestID(0), _reading(false)
 {
 	connect();
 }
 
-Connection::Connection(const std::string& host, int port) : _address(host, port), _socket()
+Connection::Connection(const std::string& host, int port) : _address(host, port), _socket(), _connected(false), _pipelining(false), _lastRequestID(0), _reading(false)
 {
 	connect();
 }
 
 
-Connection::Connection(const Net::SocketAddress& addrs) : _address(addrs), _socket()
+Connection::Connection(const Net::SocketAddress& addrs) : _address(addrs), _socket(), _connected(false), _pipelining(false), _lastRequestID(0), _reading(false)
 {
 	connect();
 }
@@ -81,6 +88,10 @@ Connection::~Connection()
 void Connection::connect()
 {
 	_socket.connect(_address);
+	// the input stream is kept for the lifetime of the connection, so
+	// that data buffered beyond the current reply is not lost
+	_pInput = new Net::SocketInputStream(_socket);
+	_connected = true;
 }
 
 
@@ -105,21 +116,149 @@ void Connection::connect(const Net::SocketAddress& addrs)
 
 void Connection::disconnect()
 {
+	_connected = false;
 	_socket.close();
+	_pInput = 0;
 }
 
+
+Int32 Connection::nextRequestID()
+{
+	if (_lastRequestID == 0x7FFFFFFF) _lastRequestID = 0;
+	return ++_lastRequestID;
+}
+
+
+void Connection::writeRequest(RequestMessage& request)
+{
+	if (!_pInput) throw IllegalStateException("Not connected to MongoDB server");
+	request.write(_writeBuffer);
+	try
+	{
+		const char* pData = _writeBuffer.begin();
+		std::size_t remaining = _writeBuffer.size();
+		while (remaining > 0)
+		{
+			int sent = _socket.sendBytes(pData, static_cast<int>(remaining));
+			if (sent <= 0) throw IOException("Failed to send request to MongoDB server");
+			pData += sent;
+			remaining -= sent;
+		}
+	}
+	catch (...)
+	{
+		_connected = false;
+		throw;
+	}
+}
+
+
 void Connection::sendRequest(RequestMessage& request)
 {
-	Net::SocketOutputStream sos(_socket);
-	request.send(sos);
+	Poco::FastMutex::ScopedLock lock(_writeMutex);
+	request.header().setRequestID(nextRequestID());
+	writeRequest(request);
 }
 
 void Connection::sendRequest(RequestMessage& request, ResponseMessage& response)
 {
-	sendRequest(request);
+	if (!_pipelining)
+	{
+		sendRequest(request);
+		try
+		{
+			response.read(*_pInput);
+		}
+		catch (...)
+		{
+			_connected = false;
+			throw;
+		}
+		return;
+	}
+
+	PendingReply pending(response);
+	{
+		Poco::FastMutex::ScopedLock lock(_writeMutex);
+		Int32 requestID = nextRequestID();
+		request.header().setRequestID(requestID);
+		{
+			// register before writing, the reply may be read by another thread
+			Poco::FastMutex::ScopedLock readLock(_readMutex);
+			_pending[requestID] = &pending;
+		}
+		try
+		{
+			writeRequest(request);
+		}
+		catch (...)
+		{
+			Poco::FastMutex::ScopedLock readLock(_readMutex);
+			_pending.erase(requestID);
+			throw;
+		}
+	}
+	waitForReply(pending);
+}
+
+
+void Connection::waitForReply(PendingReply& pending)
+{
+	Poco::FastMutex::ScopedLock lock(_readMutex);
+	while (!pending.done)
+	{
+		if (_reading)
+		{
+			// another thread is reading, it wakes us up when a reply arrives
+			_replied.wait(_readMutex);
+			continue;
+		}
 
-	Net::SocketInputStream sis(_socket);
-	response.read(sis);
+		_reading = true;
+		ResponseMessage reply;
+		Poco::SharedPtr<Poco::Exception> pException;
+		_readMutex.unlock();
+		try
+		{
+			reply.read(*_pInput);
+		}
+		catch (Poco::Exception& exc)
+		{
+			pException = exc.clone();
+		}
+		catch (std::exception& exc)
+		{
+			pException = new IOException(exc.what());
+		}
+		_readMutex.lock();
+		_reading = false;
+
+		if (!pException)
+		{
+			PendingMap::iterator it = _pending.find(reply.header().responseTo());
+			if (it != _pending.end())
+			{
+				it->second->response = reply;
+				it->second->done = true;
+				_pending.erase(it);
+			}
+		}
+		else
+		{
+			// the stream is out of sync, fail all pending requests
+			_connected = false;
+			for (PendingMap::iterator it = _pending.begin(); it != _pending.end(); ++it)
+			{
+				it->second->pException = pException;
+				it->second->done = true;
+			}
+			_pending.clear();
+		}
+		_replied.broadcast();
+	}
+
+	if (pending.pException) pending.pException->rethrow();
 }
 
+
 } } // Poco::MongoDB
@@ -47,24 +47,79 @@ namespace MongoDB
 
 Cursor::Cursor(const std::string& db, const std::string& collection, QueryRequest::Flags flags)
 	: _query(db + '.' + collection, flags)
+	, _prefetch(0)
+	, _pConnection(0)
+	, _prefetchCursorID(0)
+	, _prefetching(false)
+	, _stopPrefetch(false)
+	, _prefetchDone(false)
+	, _prefetchRunnable(*this, &Cursor::prefetch)
 {
 }
 
 
 Cursor::Cursor(const std::string& fullCollectionName, QueryRequest::Flags flags)
 	: _query(fullCollectionName, flags)
+	, _prefetch(0)
+	, _pConnection(0)
+	, _prefetchCursorID(0)
+	, _prefetching(false)
+	, _stopPrefetch(false)
+	, _prefetchDone(false)
+	, _prefetchRunnable(*this, &Cursor::prefetch)
 {
 }
 
 
 Cursor::~Cursor()
 {
+	try
+	{
+		stopPrefetch();
+	}
+	catch (...)
+	{
+	}
 	poco_assert_dbg(!_response.cursorID());
 }
 
 
 ResponseMessage& Cursor::next(Connection& connection)
 {
+	if ( _prefetching )
+	{
+		Poco::Mutex::ScopedLock lock(_mutex);
+		while ( _batches.empty() && !_prefetchDone )
+		{
+			_changed.wait(_mutex);
+		}
+		if ( !_batches.empty() )
+		{
+			_response = *_batches.front();
+			_batches.pop_front();
+			_changed.broadcast();
+			if ( _response.cursorID() == 0 )
+			{
+				Poco::ScopedUnlock<Poco::Mutex> unlock(_mutex);
+				stopPrefetch();
+			}
+			return _response;
+		}
+		Poco::SharedPtr<Poco::Exception> pException = _pPrefetchException;
+		{
+			Poco::ScopedUnlock<Poco::Mutex> unlock(_mutex);
+			stopPrefetch();
+		}
+		_response.clear();
+		if ( pException ) pException->rethrow();
+	}
+
+	if ( _prefetch > 0 && !connection.getPipelining() )
+	{
+		// the prefetch thread shares the connection with the caller
+		throw Poco::InvalidAccessException("Cursor prefetching requires a pipelined connection");
+	}
+
 	if ( _response.cursorID() == 0 )
 	{
 		connection.sendRequest(_query, _response);
@@ -76,20 +131,102 @@ ResponseMessage& Cursor::next(Connection& connection)
 		_response.clear();
 		connection.sendRequest(getMore, _response);
 	}
+
+	if ( _prefetch > 0 && _response.cursorID() != 0 )
+	{
+		startPrefetch(connection);
+	}
 	return _response;
 }
 
 
 void Cursor::kill(Connection& connection)
 {
-	if ( _response.cursorID() != 0 )
+	Int64 cursorID = _response.cursorID();
+	if ( _prefetching )
+	{
+		stopPrefetch();
+		cursorID = _prefetchCursorID;
+	}
+	if ( cursorID != 0 )
 	{
 		KillCursorsRequest killRequest;
-		killRequest.cursors().push_back(_response.cursorID());
+		killRequest.cursors().push_back(cursorID);
 		connection.sendRequest(killRequest);
 	}
 	_response.clear();
 }
 
+
+void Cursor::startPrefetch(Connection& connection)
+{
+	poco_assert (connection.getPipelining());
+
+	_pConnection = &connection;
+	_batches.clear();
+	_prefetchCursorID = _response.cursorID();
+	_stopPrefetch = false;
+	_prefetchDone = false;
+	_pPrefetchException = 0;
+	_prefetching = true;
+	_prefetchThread.start(_prefetchRunnable);
+}
+
+
+void Cursor::stopPrefetch()
+{
+	if ( !_prefetching ) return;
+
+	{
+		Poco::Mutex::ScopedLock lock(_mutex);
+		_stopPrefetch = true;
+		_changed.broadcast();
+	}
+	_prefetchThread.join();
+	_batches.clear();
+	_pPrefetchException = 0;
+	_pConnection = 0;
+	_prefetching = false;
+}
+
+
+void Cursor::prefetch()
+{
+	Poco::Mutex::ScopedLock lock(_mutex);
+	while ( !_stopPrefetch && _prefetchCursorID != 0 )
+	{
+		if ( _batches.size() >= _prefetch )
+		{
+			_changed.wait(_mutex);
+			continue;
+		}
+
+		GetMoreRequest getMore(_query.fullCollectionName(), _prefetchCursorID);
+		getMore.setNumberToReturn(_query.getNumberToReturn());
+		ResponsePtr pResponse = new ResponseMessage();
+		try
+		{
+			Poco::ScopedUnlock<Poco::Mutex> unlock(_mutex);
+			_pConnection->sendRequest(getMore, *pResponse);
+		}
+		catch (Poco::Exception& exc)
+		{
+			_pPrefetchException = exc.clone();
+			break;
+		}
+		catch (std::exception& exc)
+		{
+			_pPrefetchException = new Poco::Exception(exc.what());
+			break;
+		}
+		_prefetchCursorID = pResponse->cursorID();
+		_batches.push_back(pResponse);
+		_changed.broadcast();
+	}
+	_prefetchDone = true;
+	_changed.broadcast();
+}
+
+
 } } // Namespace Poco::MongoDB
 
@@ -43,6 +43,10 @@
 #include "Poco/MongoDB/Array.h"
 #include "Poco/MongoDB/RegularExpression.h"
 #include "Poco/MongoDB/JavaScriptCode.h"
+#include "Poco/MongoDB/MessageBuffer.h"
+#include "Poco/ByteOrder.h"
+#include "Poco/Buffer.h"
+#include <cstring>
 
 namespace Poco
 {
@@ -50,7 +54,112 @@ namespace MongoDB
 {
 
 
-Document::Document()
+namespace
+{
+	class BufferReader
+		/// Reads little endian BSON values from a memory area.
+	{
+	public:
+		BufferReader(const char* pData, std::size_t size):
+			_pData(pData),
+			_pEnd(pData + size)
+		{
+		}
+
+		const char* position() const
+		{
+			return _pData;
+		}
+
+		std::size_t remaining() const
+		{
+			return static_cast<std::size_t>(_pEnd - _pData);
+		}
+
+		void skip(std::size_t n)
+		{
+			need(n);
+			_pData += n;
+		}
+
+		const char* readRaw(std::size_t n)
+		{
+			need(n);
+			const char* p = _pData;
+			_pData += n;
+			return p;
+		}
+
+		unsigned char readByte()
+		{
+			need(1);
+			return static_cast<unsigned char>(*_pData++);
+		}
+
+		Int32 readInt32()
+		{
+			Int32 value;
+			std::memcpy(&value, readRaw(sizeof(value)), sizeof(value));
+			return ByteOrder::fromLittleEndian(value);
+		}
+
+		Int64 readInt64()
+		{
+			Int64 value;
+			std::memcpy(&value, readRaw(sizeof(value)), sizeof(value));
+			return ByteOrder::fromLittleEndian(value);
+		}
+
+		double readDouble()
+		{
+			Int64 bits = readInt64();
+			double value;
+			std::memcpy(&value, &bits, sizeof(value));
+			return value;
+		}
+
+		std::string readCString()
+		{
+			const char* pNull = static_cast<const char*>(std::memchr(_pData, 0, remaining()));
+			if ( !pNull )
+			{
+				throw DataFormatException("Unterminated BSON cstring");
+			}
+			std::string value(_pData, pNull);
+			_pData = pNull + 1;
+			return value;
+		}
+
+		std::string readString()
+		{
+			Int32 size = readInt32();
+			if ( size < 1 )
+			{
+				throw DataFormatException("Invalid BSON string size");
+			}
+			const char* p = readRaw(size);
+			return std::string(p, size - 1); // without terminating 0
+		}
+
+	private:
+		void need(std::size_t n) const
+		{
+			if ( n > remaining() )
+			{
+				throw DataFormatException("Truncated BSON document");
+			}
+		}
+
+		const char* _pData;
+		const char* _pEnd;
+	};
+}
+
+
+Document::Document():
+	_offset(0),
+	_length(0),
+	_undecoded(0)
 {
 }
 
@@ -59,74 +168,153 @@ Document::~Document()
 }
 
 
-Element::Ptr Document::get(const std::string& name) const
+void Document::clear()
 {
-	Element::Ptr element;
+	_elements.clear();
+	_index.clear();
+	_pBuffer = 0;
+	_offset = 0;
+	_length = 0;
+	_undecoded = 0;
+}
 
-	ElementSet::const_iterator it = std::find_if(_elements.begin(), _elements.end(), ElementFindByName(name));
-	if ( it != _elements.end() )
+
+void Document::elementNames(std::vector<std::string>& keys) const
+{
+	std::size_t first = keys.size();
+	for(ElementIndex::ConstIterator it = _index.begin(); it != _index.end(); ++it)
 	{
-		return *it;
+		keys.push_back(it->first);
 	}
+	std::sort(keys.begin() + first, keys.end());
+}
 
-	return element;
+
+Element::Ptr Document::get(const std::string& name) const
+{
+	ElementIndex::Iterator it = _index.find(name);
+	if ( it == _index.end() )
+	{
+		return Element::Ptr();
+	}
+
+	if ( it->second.element.isNull() )
+	{
+		return decode(name, it->second);
+	}
+	return it->second.element;
 }
 
 
 void Document::read(BinaryReader& reader)
 {
-	int size;
+	Int32 size;
 	reader >> size;
+	if ( !reader.good() || size < 5 )
+	{
+		throw DataFormatException("Invalid BSON document size");
+	}
+
+	// read the whole document at once and decode it from memory
+	BufferPtr pBuffer = new Poco::Buffer<char>(size);
+	Int32 prefix = ByteOrder::toLittleEndian(size);
+	std::memcpy(pBuffer->begin(), &prefix, sizeof(prefix));
+	reader.readRaw(pBuffer->begin() + sizeof(prefix), size - sizeof(prefix));
+	if ( !reader.good() )
+	{
+		throw IOException("Failed to read BSON document");
+	}
+	read(pBuffer, 0);
+}
 
-	unsigned char type;
-	reader >> type;
 
-	while( type != '\0' )
+std::size_t Document::read(const char* pData, std::size_t size)
+{
+	BufferReader header(pData, size);
+	Int32 length = header.readInt32();
+	if ( length < 5 || static_cast<std::size_t>(length) > size )
+	{
+		throw DataFormatException("Invalid BSON document size");
+	}
+	return read(new Poco::Buffer<char>(pData, length), 0);
+}
+
+
+std::size_t Document::read(const BufferPtr& pBuffer, std::size_t offset)
+{
+	clear();
+
+	if ( offset > pBuffer->size() )
 	{
-		Element::Ptr element;
+		throw DataFormatException("Invalid BSON document offset");
+	}
+	const char* pData = pBuffer->begin() + offset;
+	std::size_t size = pBuffer->size() - offset;
 
-		std::string name = BSONReader(reader).readCString();
+	BufferReader header(pData, size);
+	Int32 length = header.readInt32();
+	if ( length < 5 || static_cast<std::size_t>(length) > size || pData[length - 1] != '\0' )
+	{
+		throw DataFormatException("Invalid BSON document size");
+	}
+
+	// Only the element names are indexed here. The values are skipped
+	// and decoded on first access.
+	BufferReader reader(pData + sizeof(length), length - sizeof(length));
+	unsigned char type = reader.readByte();
+	while( type != '\0' )
+	{
+		Entry entry;
+		entry.type = type;
+		std::string name = reader.readCString();
+		entry.offset = static_cast<std::size_t>(reader.position() - pBuffer->begin());
 
 		switch(type)
 		{
 		case ElementTraits<double>::TypeId:
-			element = new ConcreteElement<double>(name, 0);
+		case ElementTraits<Poco::Timestamp>::TypeId:
+		case ElementTraits<Int64>::TypeId:
+			reader.skip(8);
 			break;
 		case ElementTraits<Int32>::TypeId:
-			element = new ConcreteElement<Int32>(name, 0);
+			reader.skip(4);
 			break;
 		case ElementTraits<std::string>::TypeId:
-			element = new ConcreteElement<std::string>(name, "");
+		case ElementTraits<JavaScriptCode::Ptr>::TypeId:
+			reader.readString();
 			break;
 		case ElementTraits<Document::Ptr>::TypeId:
-			element = new ConcreteElement<Document::Ptr>(name, new Document());
-			break;
 		case ElementTraits<Array::Ptr>::TypeId:
-			element = new ConcreteElement<Array::Ptr>(name, new Array());
-			break;
+			{
+				Int32 documentSize = reader.readInt32();
+				if ( documentSize < 5 )
+				{
+					throw DataFormatException("Invalid BSON document size");
+				}
+				reader.skip(documentSize - sizeof(documentSize));
+				break;
+			}
 		case ElementTraits<Binary::Ptr>::TypeId:
-			element = new ConcreteElement<Binary::Ptr>(name, new Binary());
-			break;
+			{
+				Int32 binarySize = reader.readInt32();
+				if ( binarySize < 0 )
+				{
+					throw DataFormatException("Invalid BSON binary size");
+				}
+				reader.skip(binarySize + 1);
+				break;
+			}
 		case ElementTraits<ObjectId::Ptr>::TypeId:
-			element = new ConcreteElement<ObjectId::Ptr>(name, new ObjectId());
+			reader.skip(12);
 			break;
 		case ElementTraits<bool>::TypeId:
-			element = new ConcreteElement<bool>(name, false);
-			break;
-		case ElementTraits<Poco::Timestamp>::TypeId:
-			element = new ConcreteElement<Poco::Timestamp>(name, Poco::Timestamp());
+			reader.skip(1);
 			break;
 		case ElementTraits<NullValue>::TypeId:
-			element = new ConcreteElement<NullValue>(name, NullValue(0));
 			break;
 		case ElementTraits<RegularExpression::Ptr>::TypeId:
-			element = new ConcreteElement<RegularExpression::Ptr>(name, new RegularExpression());
-			break;
-		case ElementTraits<JavaScriptCode::Ptr>::TypeId:
-			element = new ConcreteElement<JavaScriptCode::Ptr>(name, new JavaScriptCode());
-			break;
-		case ElementTraits<Int64>::TypeId:
-			element = new ConcreteElement<Int64>(name, 0);
+			reader.readCString();
+			reader.readCString();
 			break;
 		default:
 			{
@@ -139,16 +327,139 @@ void Document::read(BinaryReader& reader)
 		//		x7F -> Max Key
 		}
 
-		element->read(reader);
-		_elements.insert(element);
+		// as with an ElementSet, the first element with a name wins
+		if ( _index.insert(ElementIndex::PairType(name, entry)).second )
+		{
+			++_undecoded;
+		}
+
+		type = reader.readByte();
+	}
+
+	if ( _undecoded > 0 )
+	{
+		_pBuffer = pBuffer;
+		_offset = offset;
+		_length = static_cast<std::size_t>(length);
+	}
+	return static_cast<std::size_t>(length);
+}
+
+
+Element::Ptr Document::decode(const std::string& name, Entry& entry) const
+{
+	const char* pEnd = _pBuffer->begin() + _offset + _length;
+	BufferReader reader(_pBuffer->begin() + entry.offset, pEnd - (_pBuffer->begin() + entry.offset));
+	Element::Ptr element;
+
+	switch(entry.type)
+	{
+	case ElementTraits<double>::TypeId:
+		element = new ConcreteElement<double>(name, reader.readDouble());
+		break;
+	case ElementTraits<Int32>::TypeId:
+		element = new ConcreteElement<Int32>(name, reader.readInt32());
+		break;
+	case ElementTraits<std::string>::TypeId:
+		element = new ConcreteElement<std::string>(name, reader.readString());
+		break;
+	case ElementTraits<Document::Ptr>::TypeId:
+		{
+			Document::Ptr doc = new Document();
+			doc->read(_pBuffer, entry.offset);
+			element = new ConcreteElement<Document::Ptr>(name, doc);
+			break;
+		}
+	case ElementTraits<Array::Ptr>::TypeId:
+		{
+			Array::Ptr array = new Array();
+			array->read(_pBuffer, entry.offset);
+			element = new ConcreteElement<Array::Ptr>(name, array);
+			break;
+		}
+	case ElementTraits<Binary::Ptr>::TypeId:
+		{
+			Int32 binarySize = reader.readInt32();
+			unsigned char subtype = reader.readByte();
+			Binary::Ptr binary = new Binary(binarySize, subtype);
+			std::memcpy(binary->buffer().begin(), reader.readRaw(binarySize), binarySize);
+			element = new ConcreteElement<Binary::Ptr>(name, binary);
+			break;
+		}
+	case ElementTraits<ObjectId::Ptr>::TypeId:
+		{
+			ObjectId::Ptr id = new ObjectId();
+			std::memcpy(id->_id, reader.readRaw(sizeof(id->_id)), sizeof(id->_id));
+			element = new ConcreteElement<ObjectId::Ptr>(name, id);
+			break;
+		}
+	case ElementTraits<bool>::TypeId:
+		element = new ConcreteElement<bool>(name, reader.readByte() != 0);
+		break;
+	case ElementTraits<Poco::Timestamp>::TypeId:
+		{
+			Int64 value = reader.readInt64();
+			Poco::Timestamp timestamp = Timestamp::fromEpochTime(value / 1000);
+			timestamp += (value % 1000 * 1000);
+			element = new ConcreteElement<Poco::Timestamp>(name, timestamp);
+			break;
+		}
+	case ElementTraits<NullValue>::TypeId:
+		element = new ConcreteElement<NullValue>(name, NullValue(0));
+		break;
+	case ElementTraits<RegularExpression::Ptr>::TypeId:
+		{
+			std::string pattern = reader.readCString();
+			std::string options = reader.readCString();
+			element = new ConcreteElement<RegularExpression::Ptr>(name, new RegularExpression(pattern, options));
+			break;
+		}
+	case ElementTraits<JavaScriptCode::Ptr>::TypeId:
+		{
+			JavaScriptCode::Ptr code = new JavaScriptCode();
+			code->setCode(reader.readString());
+			element = new ConcreteElement<JavaScriptCode::Ptr>(name, code);
+			break;
+		}
+	case ElementTraits<Int64>::TypeId:
+		element = new ConcreteElement<Int64>(name, reader.readInt64());
+		break;
+	default:
+		poco_bugcheck_msg("element type was checked when the document was read");
+	}
+
+	entry.element = element;
+	_elements.insert(element);
+	if ( --_undecoded == 0 )
+	{
+		releaseBuffer();
+	}
+	return element;
+}
+
 
-		reader >> type;
+void Document::decodeAll() const
+{
+	for(ElementIndex::Iterator it = _index.begin(); _undecoded > 0 && it != _index.end(); ++it)
+	{
+		if ( it->second.element.isNull() )
+		{
+			decode(it->first, it->second);
+		}
 	}
 }
 
 
+void Document::releaseBuffer() const
+{
+	_pBuffer = 0;
+}
+
+
 std::string Document::toString(int indent) const
 {
+	decodeAll();
+
 	std::ostringstream oss;
 
 	oss << '{';
@@ -186,23 +497,39 @@ std::string Document::toString(int indent) const
 }
 
 
-void Document::write(BinaryWriter& writer)
+void Document::write(BinaryWriter& writer) const
 {
+	if ( _pBuffer && _elements.empty() )
+	{
+		// nothing has been accessed or added since the document was read
+		writer.writeRaw(_pBuffer->begin() + _offset, _length);
+		return;
+	}
+
+	decodeAll();
 	if ( _elements.empty() )
 	{
 		writer << 5;
 	}
 	else
 	{
-		std::stringstream sstream;
-		Poco::BinaryWriter tempWriter(sstream);
-		for(ElementSet::iterator it = _elements.begin(); it != _elements.end(); ++it)
+		MessageBuffer* pBuffer = dynamic_cast<MessageBuffer*>(writer.stream().rdbuf());
+		if ( pBuffer )
 		{
-			tempWriter << (unsigned char) (*it)->type();
-			BSONWriter(tempWriter).writeCString((*it)->name());
-			Element::Ptr element = *it;
-			element->write(tempWriter);
+			// serialize in place and patch the length afterwards
+			writer.flush();
+			std::size_t start = pBuffer->size();
+			writer << (Poco::Int32) 0;
+			writeElements(writer);
+			writer << '\0';
+			writer.flush();
+			pBuffer->patch(start, static_cast<Poco::Int32>(pBuffer->size() - start));
+			return;
 		}
+
+		std::stringstream sstream;
+		Poco::BinaryWriter tempWriter(sstream);
+		writeElements(tempWriter);
 		tempWriter.flush();
 		
 		Poco::Int32 len = 5 + sstream.tellp(); /* 5 = sizeof(len) + 0-byte */
@@ -213,4 +540,16 @@ void Document::write(BinaryWriter& writer)
 }
 
 
+void Document::writeElements(BinaryWriter& writer) const
+{
+	for(ElementSet::iterator it = _elements.begin(); it != _elements.end(); ++it)
+	{
+		writer << (unsigned char) (*it)->type();
+		BSONWriter(writer).writeCString((*it)->name());
+		Element::Ptr element = *it;
+		element->write(writer);
+	}
+}
+
+
 } } // namespace Poco::MongoDB
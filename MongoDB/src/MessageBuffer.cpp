@@ -0,0 +1,128 @@
+//
+// MessageBuffer.cpp
+//
+// $Id$
+//
+// Library: MongoDB
+// Package: MongoDB
+// Module:  MessageBuffer
+//
+// Implementation of the MessageBuffer class.
+//
+// Copyright (c) 2012, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#include "Poco/MongoDB/MessageBuffer.h"
+#include "Poco/ByteOrder.h"
+#include "Poco/Exception.h"
+#include <cstring>
+
+
+namespace Poco {
+namespace MongoDB {
+
+
+MessageBuffer::MessageBuffer(std::size_t capacity): _buffer(capacity > 0 ? capacity : 1)
+{
+	setp(&_buffer[0], &_buffer[0] + _buffer.size());
+}
+
+
+MessageBuffer::~MessageBuffer()
+{
+}
+
+
+void MessageBuffer::clear()
+{
+	setp(&_buffer[0], &_buffer[0] + _buffer.size());
+}
+
+
+void MessageBuffer::truncate(std::size_t size)
+{
+	if (size > this->size())
+		throw RangeException("MessageBuffer::truncate(): size out of range");
+
+	setp(&_buffer[0], &_buffer[0] + _buffer.size());
+	pbump(static_cast<int>(size));
+}
+
+
+void MessageBuffer::patch(std::size_t pos, Poco::Int32 value)
+{
+	if (pos + sizeof(value) > size())
+		throw RangeException("MessageBuffer::patch(): position out of range");
+
+	value = ByteOrder::toLittleEndian(value);
+	std::memcpy(&_buffer[pos], &value, sizeof(value));
+}
+
+
+MessageBuffer::int_type MessageBuffer::overflow(int_type c)
+{
+	if (traits_type::eq_int_type(c, traits_type::eof())) return traits_type::not_eof(c);
+
+	reserve(_buffer.size() + 1);
+	*pptr() = traits_type::to_char_type(c);
+	pbump(1);
+	return c;
+}
+
+
+std::streamsize MessageBuffer::xsputn(const char* s, std::streamsize n)
+{
+	if (n <= 0) return 0;
+
+	std::size_t length = static_cast<std::size_t>(n);
+	if (size() + length > _buffer.size()) reserve(size() + length);
+	std::memcpy(pptr(), s, length);
+	pbump(static_cast<int>(length));
+	return n;
+}
+
+
+int MessageBuffer::sync()
+{
+	return 0;
+}
+
+
+void MessageBuffer::reserve(std::size_t capacity)
+{
+	if (capacity <= _buffer.size()) return;
+
+	std::size_t used = size();
+	std::size_t newCapacity = 2*_buffer.size();
+	if (newCapacity < capacity) newCapacity = capacity;
+	_buffer.resize(newCapacity);
+	setp(&_buffer[0], &_buffer[0] + _buffer.size());
+	pbump(static_cast<int>(used));
+}
+
+
+} } // namespace Poco::MongoDB
@@ -55,7 +55,9 @@ MessageHeader::~MessageHeader()
 
 void MessageHeader::read(BinaryReader& reader)
 {
-	reader >> _messageLength;
+	Int32 messageLength;
+	reader >> messageLength;
+	_messageLength = static_cast<std::size_t>(messageLength);
 	reader >> _requestID;
 	reader >> _responseTo;
 
@@ -71,7 +73,7 @@ void MessageHeader::read(BinaryReader& reader)
 
 void MessageHeader::write(BinaryWriter& writer)
 {
-	writer << _messageLength;
+	writer << static_cast<Int32>(_messageLength);
 	writer << _requestID;
 	writer << _responseTo;
 	writer << (Int32) _opCode;
@@ -36,8 +36,6 @@
 //
 
 #include "Poco/MongoDB/RequestMessage.h"
-#include "Poco/Net/SocketStream.h"
-#include "Poco/StreamCopier.h"
 
 namespace Poco
 {
@@ -56,17 +54,24 @@ RequestMessage::~RequestMessage()
 
 void RequestMessage::send(std::ostream& ostr)
 {
-	std::stringstream ss;
-	BinaryWriter requestWriter(ss);
-	buildRequest(requestWriter);
-	requestWriter.flush();
+	MessageBuffer buffer;
+	write(buffer);
+	ostr.write(buffer.begin(), static_cast<std::streamsize>(buffer.size()));
+	ostr.flush();
+}
 
-	messageLength(static_cast<std::size_t>(ss.tellp()));
 
-	BinaryWriter socketWriter(ostr, BinaryWriter::LITTLE_ENDIAN_BYTE_ORDER);
-	_header.write(socketWriter);
-	StreamCopier::copyStream(ss, ostr);
-	ostr.flush();
+void RequestMessage::write(MessageBuffer& buffer)
+{
+	buffer.clear();
+	std::ostream ostr(&buffer);
+	BinaryWriter writer(ostr, BinaryWriter::LITTLE_ENDIAN_BYTE_ORDER);
+	_header.write(writer);
+	buildRequest(writer);
+	writer.flush();
+
+	messageLength(buffer.size() - MSG_HEADER_SIZE);
+	buffer.patch(0, static_cast<Int32>(_header.getMessageLength()));
 }
 
 }} // Namespace MongoDB
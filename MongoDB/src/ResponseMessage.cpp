@@ -36,13 +36,20 @@
 //
 
 #include "Poco/MongoDB/ResponseMessage.h"
-#include "Poco/Net/SocketStream.h"
+#include "Poco/MemoryStream.h"
+#include "Poco/Buffer.h"
+#include "Poco/Exception.h"
 
 namespace Poco
 {
 namespace MongoDB
 {
 
+
+static const std::size_t REPLY_FIELDS_SIZE = 20; // flags, cursor id, starting from, number returned
+static const std::size_t MIN_DOCUMENT_SIZE = 5;  // length and terminating zero of an empty document
+
+
 ResponseMessage::ResponseMessage() : Message(MessageHeader::Reply), _responseFlags(0), _cursorID(0), _startingFrom(0), _numberReturned(0)
 {
 }
@@ -66,19 +73,48 @@ void ResponseMessage::read(std::istream& istr)
 {
 	clear();
 
-	BinaryReader reader(istr, BinaryReader::LITTLE_ENDIAN_BYTE_ORDER);
-	
-	_header.read(reader);
+	char header[MSG_HEADER_SIZE];
+	istr.read(header, MSG_HEADER_SIZE);
+	if (istr.gcount() != MSG_HEADER_SIZE)
+	{
+		throw IOException("Failed to read from socket");
+	}
+	MemoryInputStream headerStream(header, MSG_HEADER_SIZE);
+	BinaryReader headerReader(headerStream, BinaryReader::LITTLE_ENDIAN_BYTE_ORDER);
+	_header.read(headerReader);
+
+	std::size_t length = _header.getMessageLength();
+	if (length < MSG_HEADER_SIZE + REPLY_FIELDS_SIZE)
+	{
+		throw DataFormatException("Invalid reply length");
+	}
+
+	// the documents share the body and are decoded lazily from it
+	std::size_t bodyLength = length - MSG_HEADER_SIZE;
+	Document::BufferPtr pBody = new Poco::Buffer<char>(bodyLength);
+	istr.read(pBody->begin(), static_cast<std::streamsize>(bodyLength));
+	if (static_cast<std::size_t>(istr.gcount()) != bodyLength)
+	{
+		throw IOException("Failed to read from socket");
+	}
 
+	MemoryInputStream fieldStream(pBody->begin(), REPLY_FIELDS_SIZE);
+	BinaryReader reader(fieldStream, BinaryReader::LITTLE_ENDIAN_BYTE_ORDER);
 	reader >> _responseFlags;
 	reader >> _cursorID;
 	reader >> _startingFrom;
 	reader >> _numberReturned;
 
+	std::size_t offset = REPLY_FIELDS_SIZE;
+	// the document count comes from the wire; never reserve
+	// more documents than the body can possibly contain
+	std::size_t maxDocuments = (bodyLength - REPLY_FIELDS_SIZE)/MIN_DOCUMENT_SIZE;
+	std::size_t numberReturned = _numberReturned > 0 ? static_cast<std::size_t>(_numberReturned) : 0;
+	_documents.reserve(numberReturned < maxDocuments ? numberReturned : maxDocuments);
 	for(int i = 0; i < _numberReturned; ++i)
 	{
 		Document::Ptr doc = new Document();
-		doc->read(reader);
+		offset += doc->read(pBody, offset);
 		_documents.push_back(doc);
 	}
 }
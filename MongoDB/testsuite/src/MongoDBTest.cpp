@@ -40,8 +40,20 @@
 #include "Poco/MongoDB/PoolableConnectionFactory.h"
 #include "Poco/MongoDB/Database.h"
 #include "Poco/MongoDB/Cursor.h"
+#include "Poco/MongoDB/BulkInsert.h"
+#include "Poco/MongoDB/Array.h"
+#include "Poco/MongoDB/Binary.h"
+#include "Poco/MongoDB/ObjectId.h"
+#include "Poco/MongoDB/MessageBuffer.h"
+#include "Poco/BinaryReader.h"
+#include "Poco/BinaryWriter.h"
+#include "Poco/MemoryStream.h"
+#include "Poco/Stopwatch.h"
+#include <sstream>
 
 #include "Poco/Net/NetException.h"
+#include "Poco/Thread.h"
+#include "Poco/Runnable.h"
 
 #include "MongoDBTest.h"
 #include "CppUnit/TestCaller.h"
@@ -50,6 +62,49 @@
 using namespace Poco::MongoDB;
 
 
+namespace
+{
+	class PipelinedQuery: public Poco::Runnable
+	{
+	public:
+		PipelinedQuery(Connection& connection, int value):
+			_connection(connection),
+			_value(value),
+			_matches(0)
+		{
+		}
+
+		void run()
+		{
+			for (int i = 0; i < 50; ++i)
+			{
+				QueryRequest request("team.pipeline");
+				request.selector().add("value", _value);
+				request.setNumberToReturn(1);
+				ResponseMessage response;
+				_connection.sendRequest(request, response);
+				if (response.header().responseTo() == request.header().getRequestID() &&
+					response.documents().size() == 1 &&
+					response.documents()[0]->get<Poco::Int32>("value") == _value)
+				{
+					++_matches;
+				}
+			}
+		}
+
+		int matches() const
+		{
+			return _matches;
+		}
+
+	private:
+		Connection& _connection;
+		int _value;
+		int _matches;
+	};
+}
+
+
 MongoDBTest::MongoDBTest(const std::string& name)
 	: CppUnit::TestCase("MongoDB")
 	, _connected(false)
@@ -115,6 +170,80 @@ void MongoDBTest::testInsertRequest()
 	_mongo.sendRequest(request);
 }
 
+void MongoDBTest::testBulkInsert()
+{
+	if ( ! _connected )
+	{
+		std::cout << "test skipped." << std::endl;
+		return;
+	}
+
+	Poco::MongoDB::Database db("team");
+	{
+		Poco::MongoDB::BulkInsert bulk(_mongo, "team.bulk");
+		bulk.setMaxDocuments(1000);
+		bulk.setMaxMessageSize(64*1024);
+		for (int i = 0; i < 5000; ++i)
+		{
+			Document::Ptr doc = new Document();
+			doc->add("number", i).add("text", std::string(100, 'x'));
+			bulk.add(doc);
+		}
+		assert (bulk.pending() > 0);
+		bulk.flush();
+		assert (bulk.pending() == 0);
+		assert (bulk.inserted() == 5000);
+		// about 130 bytes per document, so the size limit splits first
+		assert (bulk.messages() > 5);
+		std::cout << bulk.rate() << " documents/s, ";
+
+		Document::Ptr tooLarge = new Document();
+		tooLarge->add("text", std::string(64*1024, 'x'));
+		try
+		{
+			bulk.add(tooLarge);
+			fail("document larger than a message must throw");
+		}
+		catch (Poco::RangeException&)
+		{
+		}
+	}
+	assert (db.count(_mongo, "bulk") == 5000);
+
+	Poco::PoolableObjectFactory<Connection, Connection::Ptr> factory("localhost:27017");
+	Poco::ObjectPool<Connection, Connection::Ptr> pool(factory, 4, 4);
+	{
+		Poco::MongoDB::BulkInsert bulk(pool, "team.bulk", 4);
+		bulk.setMaxDocuments(100);
+		for (int i = 0; i < 5000; ++i)
+		{
+			Document::Ptr doc = new Document();
+			doc->add("number", i);
+			bulk.add(doc);
+		}
+		bulk.flush();
+		assert (bulk.inserted() == 5000);
+		assert (bulk.messages() == 50);
+		std::cout << bulk.rate() << " documents/s ";
+	}
+	// the messages were sent on other connections, so the
+	// server may not have processed all of them yet
+	double count = 0;
+	for (int i = 0; i < 100 && count < 10000; ++i)
+	{
+		count = db.count(_mongo, "bulk");
+		if (count < 10000) Poco::Thread::sleep(10);
+	}
+	assert (count == 10000);
+
+	Poco::MongoDB::QueryRequest drop("team.$cmd");
+	drop.setNumberToReturn(1);
+	drop.selector().add("drop", std::string("bulk"));
+	Poco::MongoDB::ResponseMessage responseDrop;
+	_mongo.sendRequest(drop, responseDrop);
+}
+
+
 void MongoDBTest::testQueryRequest()
 {
 	if ( ! _connected )
@@ -343,6 +472,78 @@ void MongoDBTest::testCursorRequest()
 }
 
 
+void MongoDBTest::testCursorPrefetch()
+{
+	{
+		// the prefetch thread must not share a non-pipelined connection
+		Poco::MongoDB::Connection connection;
+		Poco::MongoDB::Cursor cursor("team", "numbers");
+		cursor.setPrefetch(4);
+		try
+		{
+			cursor.next(connection);
+			fail ("must fail");
+		}
+		catch (Poco::InvalidAccessException&)
+		{
+		}
+	}
+
+	if ( ! _connected )
+	{
+		std::cout << "test skipped." << std::endl;
+		return;
+	}
+
+	Poco::MongoDB::Database db("team");
+	Poco::SharedPtr<Poco::MongoDB::InsertRequest> insertRequest = db.createInsertRequest("numbers");
+	for(int i = 0; i < 10000; ++i)
+	{
+		Document::Ptr doc = new Document();
+		doc->add("number", i);
+		insertRequest->documents().push_back(doc);
+	}
+	_mongo.sendRequest(*insertRequest);
+
+	Poco::MongoDB::Cursor cursor("team", "numbers");
+	cursor.setBatchSize(100);
+	cursor.setPrefetch(4);
+	assert (cursor.getBatchSize() == 100);
+	assert (cursor.getPrefetch() == 4);
+
+	_mongo.setPipelining(true);
+	int n = 0;
+	Poco::Int64 sum = 0;
+	Poco::MongoDB::ResponseMessage& response = cursor.next(_mongo);
+	while(1)
+	{
+		for (Document::Vector::const_iterator it = response.documents().begin(); it != response.documents().end(); ++it)
+		{
+			sum += (*it)->get<Poco::Int32>("number");
+		}
+		n += response.documents().size();
+		if ( response.cursorID() == 0 )
+			break;
+		response = cursor.next(_mongo);
+	}
+	assert (n == 10000);
+	assert (sum == Poco::Int64(10000)*9999/2);
+
+	// stop a running prefetch before the end of the result
+	response = cursor.next(_mongo);
+	assert (response.cursorID() != 0);
+	cursor.kill(_mongo);
+	assert (response.cursorID() == 0);
+	_mongo.setPipelining(false);
+
+	Poco::MongoDB::QueryRequest drop("team.$cmd");
+	drop.setNumberToReturn(1);
+	drop.selector().add("drop", std::string("numbers"));
+	Poco::MongoDB::ResponseMessage responseDrop;
+	_mongo.sendRequest(drop, responseDrop);
+}
+
+
 void MongoDBTest::testBuildInfo()
 {
 	if ( ! _connected )
@@ -405,20 +606,303 @@ void MongoDBTest::testConnectionPool()
 	}
 }
 
+void MongoDBTest::testPipelining()
+{
+	if ( ! _connected )
+	{
+		std::cout << "test skipped." << std::endl;
+		return;
+	}
+
+	Poco::MongoDB::Database db("team");
+	Poco::SharedPtr<Poco::MongoDB::InsertRequest> insertRequest = db.createInsertRequest("pipeline");
+	for (int i = 0; i < 4; ++i)
+	{
+		Document::Ptr doc = new Document();
+		doc->add("value", i);
+		insertRequest->documents().push_back(doc);
+	}
+	_mongo.sendRequest(*insertRequest);
+
+	_mongo.setPipelining(true);
+	assert (_mongo.getPipelining());
+
+	std::vector<Poco::SharedPtr<PipelinedQuery> > queries;
+	std::vector<Poco::SharedPtr<Poco::Thread> > threads;
+	for (int i = 0; i < 4; ++i)
+	{
+		queries.push_back(new PipelinedQuery(_mongo, i));
+		threads.push_back(new Poco::Thread);
+		threads.back()->start(*queries.back());
+	}
+	for (int i = 0; i < 4; ++i)
+	{
+		threads[i]->join();
+		assert (queries[i]->matches() == 50);
+	}
+	assert (_mongo.isConnected());
+
+	_mongo.setPipelining(false);
+	Poco::MongoDB::QueryRequest drop("team.$cmd");
+	drop.setNumberToReturn(1);
+	drop.selector().add("drop", std::string("pipeline"));
+	Poco::MongoDB::ResponseMessage responseDrop;
+	_mongo.sendRequest(drop, responseDrop);
+}
+
+
+void MongoDBTest::testBSONRoundTrip()
+{
+	Document::Ptr doc = new Document();
+	doc->add("string", std::string("value"))
+		.add("int32", 42)
+		.add("int64", Poco::Int64(1) << 40)
+		.add("double", 3.25)
+		.add("bool", true)
+		.add("timestamp", Poco::Timestamp(1000000))
+		.add("binary", Poco::MongoDB::Binary::Ptr(new Poco::MongoDB::Binary(8, 0)));
+	doc->addNewDocument("nested").add("a", 1).add("b", std::string("c"));
+	Poco::MongoDB::Array::Ptr array = new Poco::MongoDB::Array();
+	array->add("0", 1).add("1", std::string("two"));
+	doc->add("array", array);
+
+	std::ostringstream ostr;
+	Poco::BinaryWriter streamWriter(ostr, Poco::BinaryWriter::LITTLE_ENDIAN_BYTE_ORDER);
+	doc->write(streamWriter);
+	streamWriter.flush();
+	std::string streamBytes = ostr.str();
+
+	Poco::MongoDB::MessageBuffer buffer(16);
+	std::ostream bufferStream(&buffer);
+	Poco::BinaryWriter bufferWriter(bufferStream, Poco::BinaryWriter::LITTLE_ENDIAN_BYTE_ORDER);
+	doc->write(bufferWriter);
+	bufferWriter.flush();
+	assert (std::string(buffer.begin(), buffer.size()) == streamBytes);
+
+	Document::Ptr fromMemory = new Document();
+	assert (fromMemory->read(buffer.begin(), buffer.size()) == buffer.size());
+	assert (fromMemory->toString() == doc->toString());
+
+	Poco::MemoryInputStream istr(streamBytes.data(), streamBytes.size());
+	Poco::BinaryReader reader(istr, Poco::BinaryReader::LITTLE_ENDIAN_BYTE_ORDER);
+	Document::Ptr fromStream = new Document();
+	fromStream->read(reader);
+	assert (fromStream->toString() == doc->toString());
+	assert (fromStream->get<Poco::Int64>("int64") == Poco::Int64(1) << 40);
+
+	try
+	{
+		Document::Ptr truncated = new Document();
+		truncated->read(buffer.begin(), buffer.size() - 1);
+		fail("truncated document must throw");
+	}
+	catch (Poco::Exception&)
+	{
+	}
+
+	Poco::MongoDB::QueryRequest request("team.players");
+	request.selector() = *doc;
+	Poco::MongoDB::MessageBuffer message;
+	request.write(message);
+	Poco::MemoryInputStream headerStream(message.begin(), message.size());
+	Poco::BinaryReader headerReader(headerStream, Poco::BinaryReader::LITTLE_ENDIAN_BYTE_ORDER);
+	Poco::Int32 length;
+	headerReader >> length;
+	assert (length == static_cast<Poco::Int32>(message.size()));
+
+	std::ostringstream sent;
+	request.send(sent);
+	assert (sent.str().size() == message.size());
+}
+
+
+void MongoDBTest::testLazyDocument()
+{
+	Document doc;
+	for (int i = 0; i < 100; ++i)
+	{
+		doc.add("field" + Poco::NumberFormatter::format(i), i);
+	}
+	doc.addNewDocument("nested").add("a", 1).add("b", std::string("c"));
+
+	Poco::MongoDB::MessageBuffer buffer;
+	std::ostream ostr(&buffer);
+	Poco::BinaryWriter writer(ostr, Poco::BinaryWriter::LITTLE_ENDIAN_BYTE_ORDER);
+	doc.write(writer);
+	writer.flush();
+	std::string bytes(buffer.begin(), buffer.size());
+
+	Document lazy;
+	lazy.read(bytes.data(), bytes.size());
+	assert (lazy.size() == 101);
+	assert (lazy.exists("field42"));
+	assert (!lazy.exists("field100"));
+	assert (lazy.isType<Poco::Int32>("field42"));
+	assert (lazy.isType<Document::Ptr>("nested"));
+
+	// an untouched document is written as a copy of its raw bytes
+	Poco::MongoDB::MessageBuffer copy;
+	std::ostream copyStream(&copy);
+	Poco::BinaryWriter copyWriter(copyStream, Poco::BinaryWriter::LITTLE_ENDIAN_BYTE_ORDER);
+	lazy.write(copyWriter);
+	copyWriter.flush();
+	assert (std::string(copy.begin(), copy.size()) == bytes);
+
+	assert (lazy.get<Poco::Int32>("field42") == 42);
+	assert (lazy.get("field100").isNull());
+	Document::Ptr nested = lazy.get<Document::Ptr>("nested");
+	assert (nested->size() == 2);
+	assert (nested->get<std::string>("b") == "c");
+
+	std::vector<std::string> names;
+	lazy.elementNames(names);
+	assert (names.size() == 101);
+	assert (names[0] == "field0");
+
+	assert (lazy.toString() == doc.toString());
+
+	lazy.add("extra", 1);
+	assert (lazy.size() == 102);
+	lazy.add("extra", 2);
+	assert (lazy.get<Poco::Int32>("extra") == 1);
+
+	lazy.clear();
+	assert (lazy.empty());
+	assert (!lazy.exists("field42"));
+}
+
+
+namespace
+{
+	std::string replyMessage(Poco::Int32 numberReturned, int documents)
+	{
+		std::ostringstream ostr;
+		Poco::BinaryWriter writer(ostr, Poco::BinaryWriter::LITTLE_ENDIAN_BYTE_ORDER);
+		writer << Poco::Int32(16 + 20 + 5*documents);
+		writer << Poco::Int32(1) << Poco::Int32(0) << Poco::Int32(MessageHeader::Reply);
+		writer << Poco::Int32(0) << Poco::Int64(0) << Poco::Int32(0) << numberReturned;
+		for (int i = 0; i < documents; ++i)
+		{
+			writer << Poco::Int32(5) << Poco::UInt8(0);
+		}
+		writer.flush();
+		return ostr.str();
+	}
+}
+
+
+void MongoDBTest::testReplyDocumentCount()
+{
+	ResponseMessage response;
+	std::istringstream valid(replyMessage(2, 2));
+	response.read(valid);
+	assert (response.documents().size() == 2);
+	assert (response.documents()[1]->empty());
+
+	// a forged document count must not make the reader reserve memory for it
+	std::istringstream forged(replyMessage(0x7FFFFFFF, 1));
+	try
+	{
+		response.read(forged);
+		fail ("must fail");
+	}
+	catch (Poco::DataFormatException&)
+	{
+	}
+}
+
+
+void MongoDBTest::benchmarkCursor()
+{
+	if ( ! _connected )
+	{
+		std::cout << "test skipped." << std::endl;
+		return;
+	}
+
+	const int documents = 100000;
+	const int fields = 50;
+	Poco::MongoDB::Database db("team");
+	for (int i = 0; i < documents; i += 1000)
+	{
+		Poco::SharedPtr<Poco::MongoDB::InsertRequest> insertRequest = db.createInsertRequest("wide");
+		for (int j = i; j < i + 1000; ++j)
+		{
+			Document::Ptr doc = new Document();
+			for (int k = 0; k < fields; ++k)
+			{
+				doc->add("field" + Poco::NumberFormatter::format(k), j);
+			}
+			insertRequest->documents().push_back(doc);
+		}
+		_mongo.sendRequest(*insertRequest);
+	}
+
+	Poco::Stopwatch sw;
+	for (int pass = 0; pass < 2; ++pass)
+	{
+		Poco::MongoDB::Cursor cursor("team", "wide");
+		int n = 0;
+		Poco::Int64 sum = 0;
+		sw.restart();
+		Poco::MongoDB::ResponseMessage& response = cursor.next(_mongo);
+		while (1)
+		{
+			for (Document::Vector::const_iterator it = response.documents().begin(); it != response.documents().end(); ++it)
+			{
+				if (pass == 0)
+				{
+					sum += (*it)->get<Poco::Int32>("field25");
+				}
+				else
+				{
+					for (int k = 0; k < fields; ++k)
+					{
+						sum += (*it)->get<Poco::Int32>("field" + Poco::NumberFormatter::format(k));
+					}
+				}
+				++n;
+			}
+			if ( response.cursorID() == 0 )
+				break;
+			response = cursor.next(_mongo);
+		}
+		sw.stop();
+		assert (n == documents);
+		std::cout << std::endl << (pass == 0 ? "one field: " : "all fields: ")
+			<< n*1000000.0/sw.elapsed() << " documents/s (" << sum << ")";
+	}
+	std::cout << std::endl;
+
+	Poco::MongoDB::QueryRequest drop("team.$cmd");
+	drop.setNumberToReturn(1);
+	drop.selector().add("drop", std::string("wide"));
+	Poco::MongoDB::ResponseMessage responseDrop;
+	_mongo.sendRequest(drop, responseDrop);
+}
+
+
 CppUnit::Test* MongoDBTest::suite()
 {
 	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("MongoDBTest");
 
 	CppUnit_addTest(pSuite, MongoDBTest, testInsertRequest);
+	CppUnit_addTest(pSuite, MongoDBTest, testBulkInsert);
 	CppUnit_addTest(pSuite, MongoDBTest, testQueryRequest);
 	CppUnit_addTest(pSuite, MongoDBTest, testDBQueryRequest);
 	CppUnit_addTest(pSuite, MongoDBTest, testCountCommand);
 	CppUnit_addTest(pSuite, MongoDBTest, testDBCountCommand);
 	CppUnit_addTest(pSuite, MongoDBTest, testDBCount2Command);
 	CppUnit_addTest(pSuite, MongoDBTest, testConnectionPool);
+	CppUnit_addTest(pSuite, MongoDBTest, testPipelining);
 	CppUnit_addTest(pSuite, MongoDBTest, testDeleteRequest);
 	CppUnit_addTest(pSuite, MongoDBTest, testBuildInfo);
 	CppUnit_addTest(pSuite, MongoDBTest, testCursorRequest);
+	CppUnit_addTest(pSuite, MongoDBTest, testCursorPrefetch);
+	CppUnit_addTest(pSuite, MongoDBTest, testBSONRoundTrip);
+	CppUnit_addTest(pSuite, MongoDBTest, testLazyDocument);
+	CppUnit_addTest(pSuite, MongoDBTest, testReplyDocumentCount);
+	//CppUnit_addTest(pSuite, MongoDBTest, benchmarkCursor);
 
 	return pSuite;
 }
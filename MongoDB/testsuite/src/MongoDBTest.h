@@ -54,6 +54,9 @@ public:
 	void testInsertRequest();
 
 
+	void testBulkInsert();
+
+
 	void testQueryRequest();
 
 
@@ -78,9 +81,25 @@ public:
 	void testConnectionPool();
 
 
+	void testPipelining();
+
+
 	void testCursorRequest();
 
 
+	void testCursorPrefetch();
+
+
+	void testBSONRoundTrip();
+
+
+	void testLazyDocument();
+	void testReplyDocumentCount();
+
+
+	void benchmarkCursor();
+
+
 	void setUp();
 
 
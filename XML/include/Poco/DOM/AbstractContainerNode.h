@@ -88,6 +88,7 @@ private:
 	AbstractNode* _pFirstChild;
 
 	friend class AbstractNode;
+	friend class Document;
 	friend class NodeAppender;
 };
 
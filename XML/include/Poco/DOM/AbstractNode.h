@@ -53,6 +53,7 @@ namespace XML {
 class AbstractContainerNode;
 class Attr;
 class EventDispatcher;
+class NodeArena;
 
 
 class XML_API AbstractNode: public Node
@@ -117,6 +118,34 @@ protected:
 	void dispatchAttrModified(Attr* pAttr, MutationEvent::AttrChangeType changeType, const XMLString& prevValue, const XMLString& newValue);
 	void dispatchCharacterDataModified(const XMLString& prevValue, const XMLString& newValue);
 	void setOwnerDocument(Document* pOwnerDocument);
+	virtual void treeChanged();
+		/// Must be called whenever the structure of the tree
+		/// changes. Notifies the owner document, which
+		/// invalidates its element index.
+	virtual void attributesChanged();
+		/// Must be called whenever an attribute is added, removed
+		/// or modified. Notifies the owner document, which
+		/// invalidates the ID map of its element index.
+
+	bool inArenaTeardown() const;
+		/// Returns true while the owner document destroys all
+		/// nodes in its NodeArena. Nodes destroyed then must not
+		/// release the nodes they link to, as the arena destroys
+		/// those as well.
+
+	static NodeArena* nodeArena(const Document* pDocument);
+		/// Returns the NodeArena of the given document, or null
+		/// if the document allocates its nodes from the heap.
+
+	template <class N>
+	static N* arenaNode(N* pNode, NodeArena* pArena)
+		/// Marks a node that has just been allocated with
+		/// new (pArena) as being placed in the arena. Does
+		/// nothing if pArena is null.
+	{
+		if (pArena) pNode->setArenaAllocated();
+		return pNode;
+	}
 
 	static const XMLString EMPTY_STRING;
 
@@ -68,9 +68,15 @@ class XML_API DOMBuilder: protected DTDHandler, protected ContentHandler, protec
 	/// must be supplied to the DOMBuilder.
 {
 public:
-	DOMBuilder(XMLReader& xmlReader, NamePool* pNamePool = 0);
+	DOMBuilder(XMLReader& xmlReader, NamePool* pNamePool = 0, bool useNodeArena = false);
 		/// Creates a DOMBuilder using the given XMLReader. 
 		/// If a NamePool is given, it becomes the Document's NamePool.
+		///
+		/// If useNodeArena is true, the nodes of the resulting
+		/// Document are allocated from a NodeArena owned by the
+		/// Document and freed in one step when the Document is
+		/// released. See Document::Document() for the restrictions
+		/// that apply.
 
 	virtual ~DOMBuilder();
 		/// Destroys the DOMBuilder.
@@ -125,6 +131,7 @@ private:
 	AbstractNode*          _pPrevious;
 	bool                   _inCDATA;
 	bool                   _namespaces;
+	bool                   _useNodeArena;
 };
 
 
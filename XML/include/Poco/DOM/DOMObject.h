@@ -41,12 +41,16 @@
 
 
 #include "Poco/XML/XML.h"
+#include <cstddef>
 
 
 namespace Poco {
 namespace XML {
 
 
+class NodeArena;
+
+
 class XML_API DOMObject
 	/// The base class for all objects in the Document Object Model.
 	///
@@ -71,6 +75,13 @@ class XML_API DOMObject
 	/// While DOMObjects are safe for use in multithreaded programs,
 	/// a DOMObject or one of its subclasses must not be accessed
 	/// from multiple threads simultaneously.
+	///
+	/// Nodes created by a Document that uses a NodeArena
+	/// are placed into the document's arena. When the Document
+	/// is destroyed, all of them are destroyed with it, regardless
+	/// of their reference counts. Using such a node, or releasing
+	/// it, after its owner Document has been destroyed results
+	/// in undefined behavior.
 {
 public:
 	DOMObject();
@@ -91,15 +102,46 @@ public:
 		/// AutoReleasePool managed by the Document
 		/// to which this object belongs.
 
+	static void* operator new (std::size_t size);
+		/// Allocates memory for a DOMObject from the heap.
+
+	static void* operator new (std::size_t size, NodeArena* pArena);
+		/// Allocates memory for a DOMObject from the given
+		/// NodeArena, or from the heap if pArena is null.
+
+	static void operator delete (void* ptr);
+		/// Frees memory obtained from the heap.
+
+	static void operator delete (void* ptr, NodeArena* pArena);
+		/// Frees memory obtained from the given NodeArena, or from
+		/// the heap if pArena is null, if construction of an object
+		/// allocated with the arena operator new fails.
+
 protected:
 	virtual ~DOMObject();
 		/// Destroys the DOMObject.
 
+	void setArenaAllocated();
+		/// Marks the object as being placed in a NodeArena.
+		/// Must be called by the factory that allocated the
+		/// object with the arena operator new, right after
+		/// the object has been constructed. When its reference
+		/// count reaches zero, the object is destroyed and its
+		/// memory is returned to the arena.
+
+	bool isArenaAllocated() const;
+		/// Returns true if the object is placed in a NodeArena.
+
 private:
 	DOMObject(const DOMObject&);
 	DOMObject& operator = (const DOMObject&);
+
+	void releaseToArena() const;
 	
 	mutable int _rc;
+	bool        _inArena;
+	
+	friend class NodeArena;
 };
 
 
@@ -115,7 +157,18 @@ inline void DOMObject::duplicate() const
 inline void DOMObject::release() const
 {
 	if (--_rc == 0)
-		delete this;
+	{
+		if (_inArena)
+			releaseToArena();
+		else
+			delete this;
+	}
+}
+
+
+inline bool DOMObject::isArenaAllocated() const
+{
+	return _inArena;
 }
 
 
@@ -79,16 +79,29 @@ public:
 	void addEncoding(const XMLString& name, Poco::TextEncoding* pEncoding);
 		/// Adds an encoding to the parser.
 
+	void setBufferSize(std::size_t size);
+		/// Sets the size of the blocks in which the document
+		/// is read and passed to the underlying parser.
+		/// See ParserEngine::setBufferSize() for details.
+
+	std::size_t getBufferSize() const;
+		/// Returns the size of the blocks in which the document
+		/// is read and passed to the underlying parser.
+
 	void setFeature(const XMLString& name, bool state);
 		/// Set the state of a feature.
 		///
 		/// If a feature is not recognized by the DOMParser, it is
 		/// passed on to the underlying XMLReader.
 		///
-		/// The only currently supported feature is
-		/// http://www.appinf.com/features/no-whitespace-in-element-content
-		/// which, when activated, causes the WhitespaceFilter to
-		/// be used.
+		/// The following features are currently supported:
+		///   - http://www.appinf.com/features/no-whitespace-in-element-content
+		///     which, when activated, causes the WhitespaceFilter to
+		///     be used.
+		///   - http://www.appinf.com/features/node-arena
+		///     which, when activated, causes the nodes of the resulting
+		///     Document to be allocated from a NodeArena owned by the
+		///     Document (see Document::Document()).
 
 	bool getFeature(const XMLString& name) const;
 		/// Look up the value of a feature.
@@ -115,11 +128,13 @@ public:
 		/// Sets the entity resolver on the underlying SAXParser.
 
 	static const XMLString FEATURE_FILTER_WHITESPACE;
+	static const XMLString FEATURE_NODE_ARENA;
 	
 private:
 	SAXParser _saxParser;
 	NamePool* _pNamePool;
 	bool      _filterWhitespace;
+	bool      _useNodeArena;
 };
 
 
@@ -54,6 +54,8 @@ namespace XML {
 
 
 class NamePool;
+class NodeArena;
+class ElementIndex;
 class DocumentType;
 class DOMImplementation;
 class DocumentFragment;
@@ -82,11 +84,31 @@ class XML_API Document: public AbstractContainerNode, public DocumentEvent
 public:
 	typedef Poco::AutoReleasePool<DOMObject> AutoReleasePool;
 
-	Document(NamePool* pNamePool = 0);
+	Document(NamePool* pNamePool = 0, bool useNodeArena = false);
 		/// Creates a new document. If pNamePool == 0, the document
 		/// creates its own name pool, otherwise it uses the given name pool.
 		/// Sharing a name pool makes sense for documents containing instances
 		/// of the same schema, thus reducing memory usage.
+		///
+		/// If useNodeArena is true, all nodes created by the
+		/// document's factory methods, or cloned or imported into
+		/// the document, are allocated from a NodeArena owned by
+		/// the document. Releasing a node returns its memory to
+		/// the arena, where it is reused for new nodes. When the
+		/// document is destroyed, the arena destroys all of its
+		/// nodes in a single pass, without walking the tree, and
+		/// frees their memory in a few large blocks, which is
+		/// considerably faster for large documents.
+		///
+		/// The arena never returns memory to the system before
+		/// the document is destroyed, so it keeps the peak amount
+		/// of memory used by the document's nodes. See NodeArena
+		/// for the size limit of a single allocation.
+		///
+		/// All nodes of such a document are destroyed together
+		/// with the document, even if they are still referenced.
+		/// Using or releasing a node after its document has been
+		/// destroyed results in undefined behavior.
 
 	Document(DocumentType* pDocumentType, NamePool* pNamePool = 0);
 		/// Creates a new document. If pNamePool == 0, the document
@@ -115,6 +137,12 @@ public:
 	bool events() const;
 		/// Returns true if events are not suspeded.
 
+	bool hasNodeArena() const;
+		/// Returns true if the document allocates its nodes
+		/// from a NodeArena.
+		///
+		/// This method is an extension to the W3C Document Object Model.
+
 	const DocumentType* doctype() const;
 		/// The Document Type Declaration (see DocumentType) associated with this document.
 		/// For HTML documents as well as XML documents without a document type declaration
@@ -246,6 +274,20 @@ public:
 		///
 		/// This method is an extension to the W3C Document Object Model.
 
+	unsigned long treeVersion() const;
+		/// Returns a counter that is incremented whenever the
+		/// structure of the document tree changes. Attribute
+		/// changes do not affect it.
+		///
+		/// Element lookups (getElementsByTagName(), getElementById(),
+		/// getNodeByPath()) are served from an index that is built
+		/// on first use and discarded when the tree changes.
+		/// Since the index is built from within const methods,
+		/// lookups count as accesses that must not happen
+		/// simultaneously from multiple threads.
+		///
+		/// This method is an extension to the W3C Document Object Model.
+
 protected:
 	~Document();
 
@@ -254,15 +296,32 @@ protected:
 	DocumentType* getDoctype();
 	void setDoctype(DocumentType* pDoctype);
 
+	ElementIndex& elementIndex() const;
+		/// Returns the element index, building it if necessary.
+
+	void treeChanged();
+		/// Increments the tree version and discards the element index.
+
+	void attributesChanged();
+		/// Discards the ID map of the element index.
+		/// The tree version and the tag name index stay valid.
+
 private:
 	DocumentType*   _pDocumentType;
 	NamePool*       _pNamePool;
 	AutoReleasePool _autoReleasePool;
 	int             _eventSuspendLevel;
+	NodeArena*      _pArena;
+	unsigned long   _treeVersion;
+	mutable ElementIndex* _pIndex;
 
 	static const XMLString NODE_NAME;
 	
+	friend class AbstractNode;
 	friend class DOMBuilder;
+	friend class Element;
+	friend class ElementsByTagNameList;
+	friend class ElementsByTagNameListNS;
 };
 
 
@@ -281,6 +340,18 @@ inline Document::AutoReleasePool& Document::autoReleasePool()
 }
 
 
+inline bool Document::hasNodeArena() const
+{
+	return _pArena != 0;
+}
+
+
+inline unsigned long Document::treeVersion() const
+{
+	return _treeVersion;
+}
+
+
 inline const DocumentType* Document::doctype() const
 {
 	return _pDocumentType;
@@ -216,6 +216,9 @@ protected:
 	void dispatchNodeRemovedFromDocument();
 	void dispatchNodeInsertedIntoDocument();
 
+	Element* findElementById(const XMLString& elementId, const XMLString& idAttribute) const;
+	Element* findElementByIdNS(const XMLString& elementId, const XMLString& idAttributeURI, const XMLString& idAttributeLocalName) const;
+
 private:
 	const Name& _name;
 	Attr*       _pFirstAttr;
@@ -0,0 +1,142 @@
+//
+// ElementIndex.h
+//
+// $Id: //poco/1.4/XML/include/Poco/DOM/ElementIndex.h#1 $
+//
+// Library: XML
+// Package: DOM
+// Module:  DOM
+//
+// Definition of the ElementIndex class.
+//
+// Copyright (c) 2004-2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#ifndef DOM_ElementIndex_INCLUDED
+#define DOM_ElementIndex_INCLUDED
+
+
+#include "Poco/XML/XML.h"
+#include "Poco/XML/XMLString.h"
+#include <vector>
+#include <map>
+#include <cstddef>
+
+
+namespace Poco {
+namespace XML {
+
+
+class Node;
+class Element;
+class Document;
+
+
+class XML_API ElementIndex
+	/// An index of all elements of a Document, used
+	/// to speed up Document::getElementsByTagName(),
+	/// Element::getElementsByTagName(), Node::getNodeByPath()
+	/// and the getElementById() methods.
+	///
+	/// The index records the elements in document order,
+	/// together with the extent of their subtrees, and maps
+	/// qualified names and ID attribute values to positions.
+	/// The ID map is built for one ID attribute at a time,
+	/// on first use.
+	///
+	/// The index is owned by its Document, which rebuilds
+	/// it lazily after the tree has been modified. Attribute
+	/// changes only discard the ID map.
+	/// It is not intended to be used directly.
+{
+public:
+	typedef std::vector<Node*> NodeVec;
+
+	explicit ElementIndex(const Document* pDocument);
+		/// Creates the ElementIndex and indexes all elements
+		/// of the given document.
+
+	~ElementIndex();
+		/// Destroys the ElementIndex.
+
+	bool elementsByTagName(const Node* pParent, const XMLString& name, NodeVec& elements) const;
+		/// Appends all descendant elements of pParent having the
+		/// given qualified name (or all elements if name is "*")
+		/// to elements, in document order.
+		///
+		/// Returns false if pParent is not indexed,
+		/// e.g. because it is not part of the document tree.
+
+	bool elementById(const Node* pParent, const XMLString& elementId, const XMLString& idAttribute, Element*& pElement);
+		/// Looks up the first element, in document order, in the
+		/// subtree rooted at pParent (including pParent itself)
+		/// whose attribute given by idAttribute has the given value.
+		///
+		/// Returns false if pParent is not indexed.
+
+	bool elementByIdNS(const Node* pParent, const XMLString& elementId, const XMLString& idAttributeURI, const XMLString& idAttributeLocalName, Element*& pElement);
+		/// Looks up the first element, in document order, in the
+		/// subtree rooted at pParent (including pParent itself)
+		/// whose attribute given by idAttributeURI and idAttributeLocalName
+		/// has the given value.
+		///
+		/// Returns false if pParent is not indexed.
+
+	void invalidateIds();
+		/// Discards the ID map, which is rebuilt on next use.
+		/// Must be called whenever an attribute changes.
+
+private:
+	typedef std::vector<std::size_t> PosVec;
+	typedef std::map<XMLString, PosVec> ValueMap;
+	typedef std::map<const Node*, std::size_t> NodeMap;
+
+	ElementIndex(const ElementIndex&);
+	ElementIndex& operator = (const ElementIndex&);
+
+	void add(Node* pParent);
+	bool range(const Node* pParent, bool inclusive, std::size_t& begin, std::size_t& end) const;
+	void buildIdMap(bool ns, const XMLString& uri, const XMLString& name);
+	Element* findId(const XMLString& elementId, std::size_t begin, std::size_t end) const;
+
+	const Document*          _pDocument;
+	NodeVec                  _elements;
+	std::vector<std::size_t> _ends;
+	NodeMap                  _positions;
+	ValueMap                 _names;
+	ValueMap                 _ids;
+	bool                     _idMapValid;
+	bool                     _idMapNS;
+	XMLString                _idURI;
+	XMLString                _idName;
+};
+
+
+} } // namespace Poco::XML
+
+
+#endif // DOM_ElementIndex_INCLUDED
@@ -43,16 +43,24 @@
 #include "Poco/XML/XML.h"
 #include "Poco/DOM/NodeList.h"
 #include "Poco/XML/XMLString.h"
+#include <vector>
 
 
 namespace Poco {
 namespace XML {
 
 
+class Document;
+
+
 class XML_API ElementsByTagNameList: public NodeList
 	// This implementation of NodeList is returned
 	// by Document::getElementsByTagName() and
 	// Element::getElementsByTagName().
+	//
+	// The matching elements are obtained from the
+	// owner document's ElementIndex and cached until
+	// the document tree changes.
 {
 public:
 	Node* item(unsigned long index) const;
@@ -63,11 +71,15 @@ protected:
 	ElementsByTagNameList(const Node* pParent, const XMLString& name);
 	~ElementsByTagNameList();
 
-	Node* find(const Node* pParent, unsigned long index) const;
+	void update() const;
+	void find(const Node* pParent) const;
 
-	const Node* _pParent;
-	XMLString   _name;
-	mutable unsigned long _count;
+	const Node*     _pParent;
+	const Document* _pDocument;
+	XMLString       _name;
+	mutable std::vector<Node*> _elements;
+	mutable unsigned long      _version;
+	mutable bool               _valid;
 	
 	friend class AbstractContainerNode;
 	friend class Element;
@@ -79,6 +91,9 @@ class XML_API ElementsByTagNameListNS: public NodeList
 	// This implementation of NodeList is returned
 	// by Document::getElementsByTagNameNS() and
 	// Element::getElementsByTagNameNS().
+	//
+	// The matching elements are cached until the
+	// owner document's tree changes.
 {
 public:
 	virtual Node* item(unsigned long index) const;
@@ -89,12 +104,16 @@ protected:
 	ElementsByTagNameListNS(const Node* pParent, const XMLString& namespaceURI, const XMLString& localName);
 	~ElementsByTagNameListNS();
 
-	Node* find(const Node* pParent, unsigned long index) const;
+	void update() const;
+	void find(const Node* pParent) const;
 
-	const Node* _pParent;
-	XMLString   _localName;
-	XMLString   _namespaceURI;
-	mutable unsigned long _count;
+	const Node*     _pParent;
+	const Document* _pDocument;
+	XMLString       _localName;
+	XMLString       _namespaceURI;
+	mutable std::vector<Node*> _elements;
+	mutable unsigned long      _version;
+	mutable bool               _valid;
 	
 	friend class AbstractContainerNode;
 	friend class Element;
@@ -0,0 +1,167 @@
+//
+// NodeArena.h
+//
+// $Id: //poco/1.4/XML/include/Poco/DOM/NodeArena.h#1 $
+//
+// Library: XML
+// Package: DOM
+// Module:  DOM
+//
+// Definition of the NodeArena class.
+//
+// Copyright (c) 2004-2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#ifndef DOM_NodeArena_INCLUDED
+#define DOM_NodeArena_INCLUDED
+
+
+#include "Poco/XML/XML.h"
+#include <vector>
+#include <cstddef>
+
+
+namespace Poco {
+namespace XML {
+
+
+class DOMObject;
+
+
+class XML_API NodeArena
+	/// A pool allocator used by a Document to allocate its
+	/// nodes from a small number of large memory blocks.
+	///
+	/// Every allocation is preceded by a small header that
+	/// records the arena it belongs to, its size and the
+	/// DOMObject placed into it. Memory given back with
+	/// deallocate() is kept on a free list for its size and
+	/// reused by later allocations of the same size, so a
+	/// document that is edited repeatedly does not grow
+	/// beyond the peak size of its nodes.
+	///
+	/// Allocations are aligned for any fundamental type.
+	/// A single allocation is limited to 4 GB, including its
+	/// header. Requests larger than the block size get a block
+	/// of their own, which is returned to the system as soon
+	/// as the allocation is released. All other blocks are
+	/// kept until the NodeArena is destroyed.
+	///
+	/// NodeArena is not thread-safe.
+{
+public:
+	enum
+	{
+		DEFAULT_BLOCK_SIZE = 64*1024
+	};
+
+	explicit NodeArena(std::size_t blockSize = DEFAULT_BLOCK_SIZE);
+		/// Creates the NodeArena. Memory is requested from
+		/// the system in blocks of the given size.
+
+	~NodeArena();
+		/// Frees all memory blocks. Objects still placed
+		/// in the arena must have been destroyed with
+		/// destroyObjects() before.
+
+	void* allocate(std::size_t size);
+		/// Allocates size bytes of suitably aligned memory.
+		///
+		/// Throws std::bad_alloc if the request exceeds
+		/// the size limit or memory is exhausted.
+
+	static void deallocate(void* ptr);
+		/// Returns memory obtained from allocate() to the
+		/// NodeArena it was allocated from. Any object
+		/// placed into the memory must have been destroyed.
+
+	static void attach(void* ptr, DOMObject* pObject);
+		/// Records that pObject has been constructed in the
+		/// memory at ptr, which must have been obtained from
+		/// allocate(), so that destroyObjects() can destroy it.
+
+	void destroyObjects();
+		/// Destroys all objects attached to memory that has
+		/// not been deallocated, in a single pass over the
+		/// arena's memory blocks and regardless of their
+		/// reference counts. The memory itself is not released
+		/// until the NodeArena is destroyed.
+
+	bool destroyingObjects() const;
+		/// Returns true while destroyObjects() is running.
+		/// Objects that are destroyed then must not release
+		/// other objects in the arena, as those are destroyed
+		/// by the arena as well.
+
+	std::size_t allocated() const;
+		/// Returns the total number of bytes obtained from the system.
+
+private:
+	NodeArena(const NodeArena&);
+	NodeArena& operator = (const NodeArena&);
+
+	struct Slot;
+	struct Block
+	{
+		char* pBegin;
+		char* pEnd;
+	};
+
+	void allocateBlock();
+	void release(Slot* pSlot);
+	static void destroyObject(Slot* pSlot);
+
+	std::size_t        _blockSize;
+	std::vector<Block> _blocks;
+	std::vector<char*> _largeBlocks;
+	std::vector<Slot*> _freeLists;
+	char*              _pCur;
+	char*              _pEnd;
+	std::size_t        _allocated;
+	bool               _destroying;
+};
+
+
+//
+// inlines
+//
+inline bool NodeArena::destroyingObjects() const
+{
+	return _destroying;
+}
+
+
+inline std::size_t NodeArena::allocated() const
+{
+	return _allocated;
+}
+
+
+} } // namespace Poco::XML
+
+
+#endif // DOM_NodeArena_INCLUDED
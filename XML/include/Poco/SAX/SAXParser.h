@@ -86,6 +86,15 @@ public:
 	void addEncoding(const XMLString& name, Poco::TextEncoding* pEncoding);
 		/// Adds an encoding to the parser. Does not take ownership of the pointer!
 
+	void setBufferSize(std::size_t size);
+		/// Sets the size of the blocks in which the document
+		/// is read and passed to the underlying parser.
+		/// See ParserEngine::setBufferSize() for details.
+
+	std::size_t getBufferSize() const;
+		/// Returns the size of the blocks in which the document
+		/// is read and passed to the underlying parser.
+
 	/// XMLReader
 	void setEntityResolver(EntityResolver* pResolver);
 	EntityResolver* getEntityResolver() const;
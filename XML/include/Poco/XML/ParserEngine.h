@@ -174,7 +174,7 @@ public:
 		/// following elements depend upon responses sent back to
 		/// the peer.
 		///
-		/// Normally, the parser always reads blocks of PARSE_BUFFER_SIZE
+		/// Normally, the parser always reads blocks of getBufferSize() bytes
 		/// at a time, and blocks until a complete block has been read (or
 		/// the end of the stream has been reached).
 		/// This allows for efficient parsing of "complete" XML documents,
@@ -184,12 +184,36 @@ public:
 	bool getEnablePartialReads() const;
 		/// Returns true if partial reads are enabled (see
 		/// setEnablePartialReads()), false otherwise.
+
+	void setBufferSize(std::size_t size);
+		/// Sets the size of the blocks in which input is read
+		/// from streams and passed to expat.
+		///
+		/// Larger blocks reduce the per-block overhead when
+		/// parsing large documents. The default is 64 KB.
+		/// Must be set before parsing begins.
+		///
+		/// Throws an InvalidArgumentException if size is 0 or
+		/// larger than the largest block expat can accept.
+
+	std::size_t getBufferSize() const;
+		/// Returns the size of the blocks in which input
+		/// is passed to expat.
 	
 	void parse(InputSource* pInputSource);
 		/// Parse an XML document from the given InputSource.
+		///
+		/// Byte streams are read directly into the input
+		/// buffer of expat, without intermediate copying.
 		
 	void parse(const char* pBuffer, std::size_t size);
 		/// Parses an XML document from the given buffer.
+		///
+		/// The buffer is passed to expat in blocks of
+		/// getBufferSize() bytes, so documents of arbitrary
+		/// size (e.g., files mapped into memory with
+		/// Poco::SharedMemory) can be parsed without expat
+		/// allocating a copy of the entire document.
 	
 	// Locator
 	XMLString getPublicId() const;
@@ -211,6 +235,10 @@ protected:
 	void parseByteInputStream(XMLByteInputStream& istr);
 		/// Parses an entity from the given stream.
 
+	void parseByteInputStream(XML_Parser parser, XMLByteInputStream& istr);
+		/// Parses an entity from the given stream, using the given parser.
+		/// The stream is read directly into the parser's input buffer.
+
 	void parseCharInputStream(XMLCharInputStream& istr);
 		/// Parses an entity from the given stream.
 		
@@ -275,8 +303,9 @@ private:
 	typedef std::map<XMLString, Poco::TextEncoding*> EncodingMap;
 	typedef std::vector<ContextLocator*> ContextStack;
 	
-	XML_Parser _parser;
-	char*      _pBuffer;
+	XML_Parser  _parser;
+	char*       _pBuffer;
+	std::size_t _bufferSize;
 	bool       _encodingSpecified; 
 	XMLString  _encoding;
 	bool       _expandInternalEntities;
@@ -374,6 +403,12 @@ inline bool ParserEngine::getEnablePartialReads() const
 }
 
 
+inline std::size_t ParserEngine::getBufferSize() const
+{
+	return _bufferSize;
+}
+
+
 } } // namespace Poco::XML
 
 
@@ -0,0 +1,328 @@
+//
+// XMLStreamParser.h
+//
+// $Id: //poco/1.4/XML/include/Poco/XML/XMLStreamParser.h#1 $
+//
+// Library: XML
+// Package: XML
+// Module:  XMLStreamParser
+//
+// Definition of the XMLStreamParser class.
+//
+// Copyright (c) 2004-2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#ifndef XML_XMLStreamParser_INCLUDED
+#define XML_XMLStreamParser_INCLUDED
+
+
+#include "Poco/XML/XML.h"
+#if defined(POCO_UNBUNDLED)
+#include <expat.h>
+#else
+#include "Poco/XML/expat.h"
+#endif
+#include "Poco/XML/XMLString.h"
+#include <istream>
+#include <vector>
+#include <cstddef>
+
+
+namespace Poco {
+namespace XML {
+
+
+class XML_API XMLStreamParser
+	/// A pull parser for XML, built directly on expat.
+	///
+	/// Instead of pushing events to handler objects like the SAXParser,
+	/// the XMLStreamParser lets the application pull one event at a
+	/// time by calling next(). Between events, expat is suspended
+	/// (using XML_StopParser() and XML_ResumeParser()), so only the
+	/// current input buffer and the data of the current event are kept
+	/// in memory, regardless of the size of the document.
+	///
+	/// Consecutive character data (including CDATA sections and
+	/// expanded entities) is reported as a single CHARACTERS event.
+	/// Comments, processing instructions and the DTD are skipped.
+	///
+	/// Names, attributes and text are stored in buffers owned by the
+	/// parser that are reused for every event, so references returned
+	/// by the accessors are only valid until the next call to next().
+	///
+	/// Typical usage:
+	///
+	///     std::ifstream istr("export.xml");
+	///     XMLStreamParser parser(istr);
+	///     XMLStreamParser::EventType event;
+	///     while ((event = parser.next()) != XMLStreamParser::END_DOCUMENT)
+	///     {
+	///         if (event == XMLStreamParser::START_ELEMENT && parser.localName() == "row")
+	///         {
+	///             const XMLString& id = parser.getAttribute("id");
+	///             ...
+	///         }
+	///     }
+{
+public:
+	enum EventType
+	{
+		START_DOCUMENT, /// Initial state, before next() has been called.
+		START_ELEMENT,  /// Start tag; name and attributes are available.
+		END_ELEMENT,    /// End tag; name is available.
+		CHARACTERS,     /// Character data; text() is available.
+		END_DOCUMENT    /// The end of the document has been reached.
+	};
+
+	enum
+	{
+		DEFAULT_BUFFER_SIZE = 65536
+	};
+
+	explicit XMLStreamParser(std::istream& istr, bool namespaces = true);
+		/// Creates the XMLStreamParser for reading the given stream.
+		///
+		/// If namespaces is true, namespace processing is enabled and
+		/// namespaceURI() and localName() return the namespace URI and
+		/// the local name of elements and attributes. Otherwise, names
+		/// are reported as they appear in the document, and localName()
+		/// returns the qualified name.
+
+	~XMLStreamParser();
+		/// Destroys the XMLStreamParser.
+
+	EventType next();
+		/// Advances the parser to the next event and returns its type.
+		/// Once the end of the document has been reached, END_DOCUMENT
+		/// is returned on every subsequent call.
+		///
+		/// Throws a SAXParseException if the document is not well-formed.
+
+	EventType event() const;
+		/// Returns the type of the current event.
+
+	int depth() const;
+		/// Returns the nesting level of the current element.
+		/// For START_ELEMENT and END_ELEMENT events, this is the level
+		/// of the element (1 for the document element); for CHARACTERS
+		/// events it is the level of the enclosing element.
+
+	const XMLString& qname() const;
+		/// Returns the qualified name of the current element.
+		/// Valid for START_ELEMENT and END_ELEMENT events.
+
+	const XMLString& localName() const;
+		/// Returns the local name of the current element.
+		/// Valid for START_ELEMENT and END_ELEMENT events.
+
+	const XMLString& namespaceURI() const;
+		/// Returns the namespace URI of the current element.
+		/// Valid for START_ELEMENT and END_ELEMENT events.
+
+	const XMLString& text() const;
+		/// Returns the character data of a CHARACTERS event.
+
+	int attributeCount() const;
+		/// Returns the number of attributes of the current element.
+		/// Valid for START_ELEMENT events.
+
+	const XMLString& attributeQName(int i) const;
+		/// Returns the qualified name of the attribute with the given index.
+
+	const XMLString& attributeLocalName(int i) const;
+		/// Returns the local name of the attribute with the given index.
+
+	const XMLString& attributeNamespaceURI(int i) const;
+		/// Returns the namespace URI of the attribute with the given index.
+
+	const XMLString& attributeValue(int i) const;
+		/// Returns the value of the attribute with the given index.
+
+	bool hasAttribute(const XMLString& qname) const;
+		/// Returns true iff the current element has an attribute
+		/// with the given qualified name.
+
+	const XMLString& getAttribute(const XMLString& qname) const;
+		/// Returns the value of the attribute with the given qualified
+		/// name, or an empty string if there is no such attribute.
+
+	const XMLString& getAttributeNS(const XMLString& namespaceURI, const XMLString& localName) const;
+		/// Returns the value of the attribute with the given namespace
+		/// URI and local name, or an empty string if there is no such
+		/// attribute.
+
+	void setBufferSize(std::size_t size);
+		/// Sets the size of the blocks in which the input stream
+		/// is read. Throws an InvalidArgumentException if size
+		/// is 0 or larger than INT_MAX.
+
+	std::size_t getBufferSize() const;
+		/// Returns the size of the blocks in which the input
+		/// stream is read.
+
+	int getLineNumber() const;
+		/// Returns the line number of the current position in the document.
+
+	int getColumnNumber() const;
+		/// Returns the column number of the current position in the document.
+
+protected:
+	struct Attribute
+	{
+		XMLString qname;
+		XMLString localName;
+		XMLString namespaceURI;
+		XMLString value;
+	};
+	typedef std::vector<Attribute> AttributeVec;
+
+	void parse();
+	void push(EventType event);
+	void queueText();
+	void suspend();
+	void splitName(const XML_Char* name, XMLString& namespaceURI, XMLString& localName, XMLString& qname) const;
+	void handleError();
+
+	static void handleStartElement(void* userData, const XML_Char* name, const XML_Char** atts);
+	static void handleEndElement(void* userData, const XML_Char* name);
+	static void handleCharacterData(void* userData, const XML_Char* s, int len);
+
+private:
+	XMLStreamParser(const XMLStreamParser&);
+	XMLStreamParser& operator = (const XMLStreamParser&);
+
+	enum
+	{
+		MAX_QUEUED_EVENTS = 3
+	};
+
+	std::istream& _istr;
+	XML_Parser    _parser;
+	bool          _namespaces;
+	std::size_t   _bufferSize;
+	EventType     _event;
+	EventType     _queue[MAX_QUEUED_EVENTS];
+	int           _queueBegin;
+	int           _queueEnd;
+	int           _depth;
+	XMLString     _qname;
+	XMLString     _localName;
+	XMLString     _namespaceURI;
+	XMLString     _text;
+	bool          _textQueued;
+	AttributeVec  _attributes;
+	int           _attributeCount;
+};
+
+
+//
+// inlines
+//
+inline XMLStreamParser::EventType XMLStreamParser::event() const
+{
+	return _event;
+}
+
+
+inline int XMLStreamParser::depth() const
+{
+	return _depth;
+}
+
+
+inline const XMLString& XMLStreamParser::qname() const
+{
+	return _qname;
+}
+
+
+inline const XMLString& XMLStreamParser::localName() const
+{
+	return _localName;
+}
+
+
+inline const XMLString& XMLStreamParser::namespaceURI() const
+{
+	return _namespaceURI;
+}
+
+
+inline const XMLString& XMLStreamParser::text() const
+{
+	return _text;
+}
+
+
+inline int XMLStreamParser::attributeCount() const
+{
+	return _event == START_ELEMENT ? _attributeCount : 0;
+}
+
+
+inline const XMLString& XMLStreamParser::attributeQName(int i) const
+{
+	poco_assert (0 <= i && i < _attributeCount);
+
+	return _attributes[i].qname;
+}
+
+
+inline const XMLString& XMLStreamParser::attributeLocalName(int i) const
+{
+	poco_assert (0 <= i && i < _attributeCount);
+
+	return _attributes[i].localName;
+}
+
+
+inline const XMLString& XMLStreamParser::attributeNamespaceURI(int i) const
+{
+	poco_assert (0 <= i && i < _attributeCount);
+
+	return _attributes[i].namespaceURI;
+}
+
+
+inline const XMLString& XMLStreamParser::attributeValue(int i) const
+{
+	poco_assert (0 <= i && i < _attributeCount);
+
+	return _attributes[i].value;
+}
+
+
+inline std::size_t XMLStreamParser::getBufferSize() const
+{
+	return _bufferSize;
+}
+
+
+} } // namespace Poco::XML
+
+
+#endif // XML_XMLStreamParser_INCLUDED
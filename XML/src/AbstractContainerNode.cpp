@@ -64,7 +64,7 @@ AbstractContainerNode::AbstractContainerNode(Document* pOwnerDocument, const Abs
 
 AbstractContainerNode::~AbstractContainerNode()
 {
-	AbstractNode* pChild = static_cast<AbstractNode*>(_pFirstChild);
+	AbstractNode* pChild = inArenaTeardown() ? 0 : static_cast<AbstractNode*>(_pFirstChild);
 	while (pChild)
 	{
 		AbstractNode* pDelNode = pChild;
@@ -107,6 +107,7 @@ Node* AbstractContainerNode::insertBefore(Node* newChild, Node* refChild)
 	if (this == newChild)
 		throw DOMException(DOMException::HIERARCHY_REQUEST_ERR);
 
+	treeChanged();
 	AbstractNode* pFirst = 0;
 	AbstractNode* pLast  = 0;
 	if (newChild->nodeType() == Node::DOCUMENT_FRAGMENT_NODE)
@@ -183,6 +184,7 @@ Node* AbstractContainerNode::replaceChild(Node* newChild, Node* oldChild)
 	if (this == newChild)
 		throw DOMException(DOMException::HIERARCHY_REQUEST_ERR);
 
+	treeChanged();
 	bool doEvents = events();
 	if (newChild->nodeType() == Node::DOCUMENT_FRAGMENT_NODE)
 	{
@@ -250,6 +252,7 @@ Node* AbstractContainerNode::removeChild(Node* oldChild)
 {
 	poco_check_ptr (oldChild);
 
+	treeChanged();
 	bool doEvents = events();
 	if (oldChild == _pFirstChild)
 	{
@@ -44,6 +44,7 @@
 #include "Poco/DOM/Attr.h"
 #include "Poco/XML/Name.h"
 #include "Poco/DOM/AutoPtr.h"
+#include "Poco/DOM/NodeArena.h"
 
 
 namespace Poco {
@@ -75,7 +76,19 @@ AbstractNode::AbstractNode(Document* pOwnerDocument, const AbstractNode& node):
 AbstractNode::~AbstractNode()
 {
 	delete _pEventDispatcher;
-	if (_pNext) _pNext->release();
+	if (_pNext && !inArenaTeardown()) _pNext->release();
+}
+
+
+bool AbstractNode::inArenaTeardown() const
+{
+	return isArenaAllocated() && _pOwner->_pArena->destroyingObjects();
+}
+
+
+NodeArena* AbstractNode::nodeArena(const Document* pDocument)
+{
+	return pDocument ? pDocument->_pArena : 0;
 }
 
 
@@ -380,6 +393,18 @@ bool AbstractNode::eventsSuspended() const
 }
 
 
+void AbstractNode::treeChanged()
+{
+	if (_pOwner) _pOwner->treeChanged();
+}
+
+
+void AbstractNode::attributesChanged()
+{
+	if (_pOwner) _pOwner->attributesChanged();
+}
+
+
 void AbstractNode::setOwnerDocument(Document* pOwnerDocument)
 {
 	_pOwner = pOwnerDocument;
@@ -71,6 +71,7 @@ void Attr::setValue(const XMLString& value)
 	XMLString oldValue = _value;
 	_value     = value;
 	_specified = true;
+	attributesChanged();
 	if (_pParent && !_pOwner->eventsSuspended())
 		_pParent->dispatchAttrModified(this, MutationEvent::MODIFICATION, oldValue, value);
 }
@@ -148,7 +149,8 @@ XMLString Attr::innerText() const
 
 Node* Attr::copyNode(bool deep, Document* pOwnerDocument) const
 {
-	return new Attr(pOwnerDocument, *this);
+	NodeArena* pArena = nodeArena(pOwnerDocument);
+	return arenaNode(new (pArena) Attr(pOwnerDocument, *this), pArena);
 }
 
 
@@ -89,7 +89,8 @@ unsigned short CDATASection::nodeType() const
 
 Node* CDATASection::copyNode(bool deep, Document* pOwnerDocument) const
 {
-	return new CDATASection(pOwnerDocument, *this);
+	NodeArena* pArena = nodeArena(pOwnerDocument);
+	return arenaNode(new (pArena) CDATASection(pOwnerDocument, *this), pArena);
 }
 
 
@@ -75,7 +75,8 @@ unsigned short Comment::nodeType() const
 
 Node* Comment::copyNode(bool deep, Document* pOwnerDocument) const
 {
-	return new Comment(pOwnerDocument, *this);
+	NodeArena* pArena = nodeArena(pOwnerDocument);
+	return arenaNode(new (pArena) Comment(pOwnerDocument, *this), pArena);
 }
 
 
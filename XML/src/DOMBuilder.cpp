@@ -59,14 +59,15 @@ namespace XML {
 const XMLString DOMBuilder::EMPTY_STRING;
 
 
-DOMBuilder::DOMBuilder(XMLReader& xmlReader, NamePool* pNamePool):
+DOMBuilder::DOMBuilder(XMLReader& xmlReader, NamePool* pNamePool, bool useNodeArena):
 	_xmlReader(xmlReader),
 	_pNamePool(pNamePool),
 	_pDocument(0),
 	_pParent(0),
 	_pPrevious(0),
 	_inCDATA(false),
-	_namespaces(true)
+	_namespaces(true),
+	_useNodeArena(useNodeArena)
 {
 	_xmlReader.setContentHandler(this);
 	_xmlReader.setDTDHandler(this);
@@ -150,7 +151,7 @@ Document* DOMBuilder::parseMemoryNP(const char* xml, std::size_t size)
 
 void DOMBuilder::setupParse()
 {
-	_pDocument  = new Document(_pNamePool);
+	_pDocument  = new Document(_pNamePool, _useNodeArena);
 	_pParent    = _pDocument;
 	_pPrevious  = 0;
 	_inCDATA    = false;
@@ -216,7 +217,7 @@ void DOMBuilder::startElement(const XMLString& uri, const XMLString& localName,
 	Attr* pPrevAttr = 0;
 	for (AttributesImpl::iterator it = attrs.begin(); it != attrs.end(); ++it)
 	{
-		AutoPtr<Attr> pAttr = new Attr(_pDocument, 0, it->namespaceURI, it->localName, it->qname, it->value, it->specified);
+		AutoPtr<Attr> pAttr = AbstractNode::arenaNode(new (_pDocument->_pArena) Attr(_pDocument, 0, it->namespaceURI, it->localName, it->qname, it->value, it->specified), _pDocument->_pArena);
 		pPrevAttr = pElem->addAttributeNodeNP(pPrevAttr, pAttr);
 	}
 	appendNode(pElem);
@@ -292,7 +293,7 @@ void DOMBuilder::skippedEntity(const XMLString& name)
 
 void DOMBuilder::startDTD(const XMLString& name, const XMLString& publicId, const XMLString& systemId)
 {
-	AutoPtr<DocumentType> pDoctype = new DocumentType(_pDocument, name, publicId, systemId);
+	AutoPtr<DocumentType> pDoctype = AbstractNode::arenaNode(new (_pDocument->_pArena) DocumentType(_pDocument, name, publicId, systemId), _pDocument->_pArena);
 	_pDocument->setDoctype(pDoctype);
 }
 
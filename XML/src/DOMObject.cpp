@@ -35,13 +35,14 @@
 
 
 #include "Poco/DOM/DOMObject.h"
+#include "Poco/DOM/NodeArena.h"
 
 
 namespace Poco {
 namespace XML {
 
 
-DOMObject::DOMObject(): _rc(1)
+DOMObject::DOMObject(): _rc(1), _inArena(false)
 {
 }
 
@@ -51,4 +52,49 @@ DOMObject::~DOMObject()
 }
 
 
+void* DOMObject::operator new (std::size_t size)
+{
+	return ::operator new(size);
+}
+
+
+void* DOMObject::operator new (std::size_t size, NodeArena* pArena)
+{
+	if (pArena)
+		return pArena->allocate(size);
+	else
+		return ::operator new(size);
+}
+
+
+void DOMObject::operator delete (void* ptr)
+{
+	::operator delete(ptr);
+}
+
+
+void DOMObject::operator delete (void* ptr, NodeArena* pArena)
+{
+	if (pArena)
+		NodeArena::deallocate(ptr);
+	else
+		::operator delete(ptr);
+}
+
+
+void DOMObject::setArenaAllocated()
+{
+	NodeArena::attach(dynamic_cast<void*>(this), this);
+	_inArena = true;
+}
+
+
+void DOMObject::releaseToArena() const
+{
+	void* ptr = const_cast<void*>(dynamic_cast<const void*>(this));
+	const_cast<DOMObject*>(this)->~DOMObject();
+	NodeArena::deallocate(ptr);
+}
+
+
 } } // namespace Poco::XML
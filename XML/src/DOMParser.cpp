@@ -47,11 +47,13 @@ namespace XML {
 
 
 const XMLString DOMParser::FEATURE_FILTER_WHITESPACE = toXMLString("http://www.appinf.com/features/no-whitespace-in-element-content");
+const XMLString DOMParser::FEATURE_NODE_ARENA        = toXMLString("http://www.appinf.com/features/node-arena");
 
 
 DOMParser::DOMParser(NamePool* pNamePool):
 	_pNamePool(pNamePool),
-	_filterWhitespace(false)
+	_filterWhitespace(false),
+	_useNodeArena(false)
 {
 	if (_pNamePool) _pNamePool->duplicate();
 	_saxParser.setFeature(XMLReader::FEATURE_NAMESPACES, true);
@@ -83,10 +85,24 @@ void DOMParser::addEncoding(const XMLString& name, Poco::TextEncoding* pEncoding
 }
 
 
+void DOMParser::setBufferSize(std::size_t size)
+{
+	_saxParser.setBufferSize(size);
+}
+
+
+std::size_t DOMParser::getBufferSize() const
+{
+	return _saxParser.getBufferSize();
+}
+
+
 void DOMParser::setFeature(const XMLString& name, bool state)
 {
 	if (name == FEATURE_FILTER_WHITESPACE)
 		_filterWhitespace = state;
+	else if (name == FEATURE_NODE_ARENA)
+		_useNodeArena = state;
 	else
 		_saxParser.setFeature(name, state);
 }
@@ -96,6 +112,8 @@ bool DOMParser::getFeature(const XMLString& name) const
 {
 	if (name == FEATURE_FILTER_WHITESPACE)
 		return _filterWhitespace;
+	else if (name == FEATURE_NODE_ARENA)
+		return _useNodeArena;
 	else
 		return _saxParser.getFeature(name);
 }
@@ -106,12 +124,12 @@ Document* DOMParser::parse(const XMLString& uri)
 	if (_filterWhitespace)
 	{
 		WhitespaceFilter filter(&_saxParser);
-		DOMBuilder builder(filter, _pNamePool);
+		DOMBuilder builder(filter, _pNamePool, _useNodeArena);
 		return builder.parse(uri);
 	}
 	else
 	{
-		DOMBuilder builder(_saxParser, _pNamePool);
+		DOMBuilder builder(_saxParser, _pNamePool, _useNodeArena);
 		return builder.parse(uri);
 	}
 }
@@ -122,12 +140,12 @@ Document* DOMParser::parse(InputSource* pInputSource)
 	if (_filterWhitespace)
 	{
 		WhitespaceFilter filter(&_saxParser);
-		DOMBuilder builder(filter, _pNamePool);
+		DOMBuilder builder(filter, _pNamePool, _useNodeArena);
 		return builder.parse(pInputSource);
 	}
 	else
 	{
-		DOMBuilder builder(_saxParser, _pNamePool);
+		DOMBuilder builder(_saxParser, _pNamePool, _useNodeArena);
 		return builder.parse(pInputSource);
 	}
 }
@@ -144,12 +162,12 @@ Document* DOMParser::parseMemory(const char* xml, std::size_t size)
 	if (_filterWhitespace)
 	{
 		WhitespaceFilter filter(&_saxParser);
-		DOMBuilder builder(filter, _pNamePool);
+		DOMBuilder builder(filter, _pNamePool, _useNodeArena);
 		return builder.parseMemoryNP(xml, size);
 	}
 	else
 	{
-		DOMBuilder builder(_saxParser, _pNamePool);
+		DOMBuilder builder(_saxParser, _pNamePool, _useNodeArena);
 		return builder.parseMemoryNP(xml, size);
 	}
 }
@@ -49,6 +49,8 @@
 #include "Poco/DOM/ElementsByTagNameList.h"
 #include "Poco/DOM/Entity.h"
 #include "Poco/DOM/Notation.h"
+#include "Poco/DOM/NodeArena.h"
+#include "Poco/DOM/ElementIndex.h"
 #include "Poco/XML/Name.h"
 #include "Poco/XML/NamePool.h"
 
@@ -60,10 +62,13 @@ namespace XML {
 const XMLString Document::NODE_NAME = toXMLString("#document");
 
 
-Document::Document(NamePool* pNamePool): 
+Document::Document(NamePool* pNamePool, bool useNodeArena): 
 	AbstractContainerNode(0),
 	_pDocumentType(0),
-	_eventSuspendLevel(0)
+	_eventSuspendLevel(0),
+	_pArena(useNodeArena ? new NodeArena : 0),
+	_treeVersion(0),
+	_pIndex(0)
 {
 	if (pNamePool)
 	{
@@ -80,7 +85,10 @@ Document::Document(NamePool* pNamePool):
 Document::Document(DocumentType* pDocumentType, NamePool* pNamePool): 
 	AbstractContainerNode(0),
 	_pDocumentType(pDocumentType),
-	_eventSuspendLevel(0)
+	_eventSuspendLevel(0),
+	_pArena(0),
+	_treeVersion(0),
+	_pIndex(0)
 {
 	if (pNamePool)
 	{
@@ -101,7 +109,20 @@ Document::Document(DocumentType* pDocumentType, NamePool* pNamePool):
 
 Document::~Document()
 {
+	delete _pIndex;
+	_pIndex = 0;
 	if (_pDocumentType) _pDocumentType->release();
+	if (_pArena)
+	{
+		// All nodes of the document are placed in the arena.
+		// Instead of releasing the tree node by node, the arena
+		// destroys them in a single pass before it frees its
+		// memory blocks.
+		_autoReleasePool.release();
+		_pArena->destroyObjects();
+		_pFirstChild = 0;
+		delete _pArena;
+	}
 	_pNamePool->release();
 }
 
@@ -154,49 +175,49 @@ Element* Document::documentElement() const
 
 Element* Document::createElement(const XMLString& tagName) const
 {
-	return new Element(const_cast<Document*>(this), EMPTY_STRING, EMPTY_STRING, tagName); 
+	return arenaNode(new (_pArena) Element(const_cast<Document*>(this), EMPTY_STRING, EMPTY_STRING, tagName), _pArena);
 }
 
 
 DocumentFragment* Document::createDocumentFragment() const
 {
-	return new DocumentFragment(const_cast<Document*>(this));
+	return arenaNode(new (_pArena) DocumentFragment(const_cast<Document*>(this)), _pArena);
 }
 
 
 Text* Document::createTextNode(const XMLString& data) const
 {
-	return new Text(const_cast<Document*>(this), data);
+	return arenaNode(new (_pArena) Text(const_cast<Document*>(this), data), _pArena);
 }
 
 
 Comment* Document::createComment(const XMLString& data) const
 {
-	return new Comment(const_cast<Document*>(this), data);
+	return arenaNode(new (_pArena) Comment(const_cast<Document*>(this), data), _pArena);
 }
 
 
 CDATASection* Document::createCDATASection(const XMLString& data) const
 {
-	return new CDATASection(const_cast<Document*>(this), data);
+	return arenaNode(new (_pArena) CDATASection(const_cast<Document*>(this), data), _pArena);
 }
 
 
 ProcessingInstruction* Document::createProcessingInstruction(const XMLString& target, const XMLString& data) const
 {
-	return new ProcessingInstruction(const_cast<Document*>(this), target, data);
+	return arenaNode(new (_pArena) ProcessingInstruction(const_cast<Document*>(this), target, data), _pArena);
 }
 
 
 Attr* Document::createAttribute(const XMLString& name) const
 {
-	return new Attr(const_cast<Document*>(this), 0, EMPTY_STRING, EMPTY_STRING, name, EMPTY_STRING);
+	return arenaNode(new (_pArena) Attr(const_cast<Document*>(this), 0, EMPTY_STRING, EMPTY_STRING, name, EMPTY_STRING), _pArena);
 }
 
 
 EntityReference* Document::createEntityReference(const XMLString& name) const
 {
-	return new EntityReference(const_cast<Document*>(this), name);
+	return arenaNode(new (_pArena) EntityReference(const_cast<Document*>(this), name), _pArena);
 }
 
 
@@ -226,13 +247,13 @@ Node* Document::importNode(Node* importedNode, bool deep)
 
 Element* Document::createElementNS(const XMLString& namespaceURI, const XMLString& qualifiedName) const
 {
-	return new Element(const_cast<Document*>(this), namespaceURI, Name::localName(qualifiedName), qualifiedName);
+	return arenaNode(new (_pArena) Element(const_cast<Document*>(this), namespaceURI, Name::localName(qualifiedName), qualifiedName), _pArena);
 }
 
 
 Attr* Document::createAttributeNS(const XMLString& namespaceURI, const XMLString& qualifiedName) const
 {
-	return new Attr(const_cast<Document*>(this), 0, namespaceURI, Name::localName(qualifiedName), qualifiedName, EMPTY_STRING);
+	return arenaNode(new (_pArena) Attr(const_cast<Document*>(this), 0, namespaceURI, Name::localName(qualifiedName), qualifiedName, EMPTY_STRING), _pArena);
 }
 
 
@@ -296,13 +317,13 @@ bool Document::events() const
 
 Entity* Document::createEntity(const XMLString& name, const XMLString& publicId, const XMLString& systemId, const XMLString& notationName) const
 {
-	return new Entity(const_cast<Document*>(this), name, publicId, systemId, notationName);
+	return arenaNode(new (_pArena) Entity(const_cast<Document*>(this), name, publicId, systemId, notationName), _pArena);
 }
 
 
 Notation* Document::createNotation(const XMLString& name, const XMLString& publicId, const XMLString& systemId) const
 {
-	return new Notation(const_cast<Document*>(this), name, publicId, systemId);
+	return arenaNode(new (_pArena) Notation(const_cast<Document*>(this), name, publicId, systemId), _pArena);
 }
 
 
@@ -322,4 +343,28 @@ Element* Document::getElementByIdNS(const XMLString& elementId, const XMLString&
 }
 
 
+ElementIndex& Document::elementIndex() const
+{
+	if (!_pIndex) _pIndex = new ElementIndex(this);
+	return *_pIndex;
+}
+
+
+void Document::treeChanged()
+{
+	++_treeVersion;
+	if (_pIndex)
+	{
+		delete _pIndex;
+		_pIndex = 0;
+	}
+}
+
+
+void Document::attributesChanged()
+{
+	if (_pIndex) _pIndex->invalidateIds();
+}
+
+
 } } // namespace Poco::XML
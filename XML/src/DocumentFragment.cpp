@@ -75,7 +75,8 @@ unsigned short DocumentFragment::nodeType() const
 
 Node* DocumentFragment::copyNode(bool deep, Document* pOwnerDocument) const
 {
-	DocumentFragment* pClone = new DocumentFragment(pOwnerDocument, *this);
+	NodeArena* pArena = nodeArena(pOwnerDocument);
+	DocumentFragment* pClone = arenaNode(new (pArena) DocumentFragment(pOwnerDocument, *this), pArena);
 	if (deep)
 	{
 		Node* pCur = firstChild();
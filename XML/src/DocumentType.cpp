@@ -99,7 +99,8 @@ const XMLString& DocumentType::internalSubset() const
 
 Node* DocumentType::copyNode(bool deep, Document* pOwnerDocument) const
 {
-	return new DocumentType(pOwnerDocument, *this);
+	NodeArena* pArena = nodeArena(pOwnerDocument);
+	return arenaNode(new (pArena) DocumentType(pOwnerDocument, *this), pArena);
 }
 
 
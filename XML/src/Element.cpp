@@ -41,6 +41,7 @@
 #include "Poco/DOM/ElementsByTagNameList.h"
 #include "Poco/DOM/Text.h"
 #include "Poco/DOM/AttrMap.h"
+#include "Poco/DOM/ElementIndex.h"
 
 
 namespace Poco {
@@ -73,7 +74,7 @@ Element::Element(Document* pOwnerDocument, const Element& element):
 
 Element::~Element()
 {
-	if (_pFirstAttr) _pFirstAttr->release();
+	if (_pFirstAttr && !inArenaTeardown()) _pFirstAttr->release();
 }
 
 
@@ -140,6 +141,7 @@ Attr* Element::setAttributeNode(Attr* newAttr)
 	else _pFirstAttr = newAttr;
 	newAttr->duplicate();
 	newAttr->_pParent = this;
+	attributesChanged();
 	if (_pOwner->events())
 		dispatchAttrModified(newAttr, MutationEvent::ADDITION, EMPTY_STRING, newAttr->getValue());
 
@@ -165,6 +167,7 @@ Attr* Element::removeAttributeNode(Attr* oldAttr)
 		else throw DOMException(DOMException::NOT_FOUND_ERR);
 	}
 	else _pFirstAttr = static_cast<Attr*>(_pFirstAttr->_pNext);
+	attributesChanged();
 	oldAttr->_pNext   = 0;
 	oldAttr->_pParent = 0;
 	oldAttr->autoRelease();
@@ -311,6 +314,7 @@ Attr* Element::setAttributeNodeNS(Attr* newAttr)
 	else _pFirstAttr = newAttr;
 	newAttr->_pParent = this;
 	newAttr->duplicate();
+	attributesChanged();
 	if (_pOwner->events())
 		dispatchAttrModified(newAttr, MutationEvent::ADDITION, EMPTY_STRING, newAttr->getValue());
 
@@ -411,7 +415,8 @@ void Element::dispatchNodeInsertedIntoDocument()
 
 Node* Element::copyNode(bool deep, Document* pOwnerDocument) const
 {
-	Element* pClone = new Element(pOwnerDocument, *this);
+	NodeArena* pArena = nodeArena(pOwnerDocument);
+	Element* pClone = arenaNode(new (pArena) Element(pOwnerDocument, *this), pArena);
 	if (deep)
 	{
 		Node* pNode = firstChild();
@@ -426,6 +431,26 @@ Node* Element::copyNode(bool deep, Document* pOwnerDocument) const
 
 
 Element* Element::getElementById(const XMLString& elementId, const XMLString& idAttribute) const
+{
+	Element* pElem = 0;
+	if (_pOwner && _pOwner->elementIndex().elementById(this, elementId, idAttribute, pElem))
+		return pElem;
+	else
+		return findElementById(elementId, idAttribute);
+}
+
+
+Element* Element::getElementByIdNS(const XMLString& elementId, const XMLString& idAttributeURI, const XMLString& idAttributeLocalName) const
+{
+	Element* pElem = 0;
+	if (_pOwner && _pOwner->elementIndex().elementByIdNS(this, elementId, idAttributeURI, idAttributeLocalName, pElem))
+		return pElem;
+	else
+		return findElementByIdNS(elementId, idAttributeURI, idAttributeLocalName);
+}
+
+
+Element* Element::findElementById(const XMLString& elementId, const XMLString& idAttribute) const
 {
 	if (getAttribute(idAttribute) == elementId)
 		return const_cast<Element*>(this);
@@ -435,7 +460,7 @@ Element* Element::getElementById(const XMLString& elementId, const XMLString& id
 	{
 		if (pNode->nodeType() == Node::ELEMENT_NODE)
 		{
-			Element* pResult = static_cast<Element*>(pNode)->getElementById(elementId, idAttribute);
+			Element* pResult = static_cast<Element*>(pNode)->findElementById(elementId, idAttribute);
 			if (pResult) return pResult;
 		}
 		pNode = pNode->nextSibling();
@@ -444,7 +469,7 @@ Element* Element::getElementById(const XMLString& elementId, const XMLString& id
 }
 
 
-Element* Element::getElementByIdNS(const XMLString& elementId, const XMLString& idAttributeURI, const XMLString& idAttributeLocalName) const
+Element* Element::findElementByIdNS(const XMLString& elementId, const XMLString& idAttributeURI, const XMLString& idAttributeLocalName) const
 {
 	if (getAttributeNS(idAttributeURI, idAttributeLocalName) == elementId)
 		return const_cast<Element*>(this);
@@ -454,7 +479,7 @@ Element* Element::getElementByIdNS(const XMLString& elementId, const XMLString&
 	{
 		if (pNode->nodeType() == Node::ELEMENT_NODE)
 		{
-			Element* pResult = static_cast<Element*>(pNode)->getElementByIdNS(elementId, idAttributeURI, idAttributeLocalName);
+			Element* pResult = static_cast<Element*>(pNode)->findElementByIdNS(elementId, idAttributeURI, idAttributeLocalName);
 			if (pResult) return pResult;
 		}
 		pNode = pNode->nextSibling();
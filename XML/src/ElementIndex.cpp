@@ -0,0 +1,196 @@
+//
+// ElementIndex.cpp
+//
+// $Id: //poco/1.4/XML/src/ElementIndex.cpp#1 $
+//
+// Library: XML
+// Package: DOM
+// Module:  DOM
+//
+// Copyright (c) 2004-2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+
+#include "Poco/DOM/ElementIndex.h"
+#include "Poco/DOM/Document.h"
+#include "Poco/DOM/Element.h"
+#include <algorithm>
+
+
+namespace Poco {
+namespace XML {
+
+
+namespace
+{
+	static const XMLString asterisk = toXMLString("*");
+}
+
+
+ElementIndex::ElementIndex(const Document* pDocument):
+	_pDocument(pDocument),
+	_idMapValid(false),
+	_idMapNS(false)
+{
+	poco_check_ptr (pDocument);
+
+	add(const_cast<Document*>(pDocument));
+}
+
+
+ElementIndex::~ElementIndex()
+{
+}
+
+
+void ElementIndex::add(Node* pParent)
+{
+	// preorder traversal
+	Node* pCur = pParent->firstChild();
+	while (pCur)
+	{
+		if (pCur->nodeType() == Node::ELEMENT_NODE)
+		{
+			std::size_t pos = _elements.size();
+			_elements.push_back(pCur);
+			_ends.push_back(0);
+			_positions[pCur] = pos;
+			_names[pCur->nodeName()].push_back(pos);
+			add(pCur);
+			_ends[pos] = _elements.size();
+		}
+		pCur = pCur->nextSibling();
+	}
+}
+
+
+bool ElementIndex::range(const Node* pParent, bool inclusive, std::size_t& begin, std::size_t& end) const
+{
+	if (pParent == _pDocument)
+	{
+		begin = 0;
+		end   = _elements.size();
+		return true;
+	}
+	NodeMap::const_iterator it = _positions.find(pParent);
+	if (it == _positions.end()) return false;
+	begin = inclusive ? it->second : it->second + 1;
+	end   = _ends[it->second];
+	return true;
+}
+
+
+bool ElementIndex::elementsByTagName(const Node* pParent, const XMLString& name, NodeVec& elements) const
+{
+	std::size_t begin;
+	std::size_t end;
+	if (!range(pParent, false, begin, end)) return false;
+
+	if (name == asterisk)
+	{
+		elements.insert(elements.end(), _elements.begin() + begin, _elements.begin() + end);
+	}
+	else
+	{
+		ValueMap::const_iterator it = _names.find(name);
+		if (it != _names.end())
+		{
+			PosVec::const_iterator itBeg = std::lower_bound(it->second.begin(), it->second.end(), begin);
+			PosVec::const_iterator itEnd = std::lower_bound(itBeg, it->second.end(), end);
+			elements.reserve(elements.size() + (itEnd - itBeg));
+			for (; itBeg != itEnd; ++itBeg)
+			{
+				elements.push_back(_elements[*itBeg]);
+			}
+		}
+	}
+	return true;
+}
+
+
+bool ElementIndex::elementById(const Node* pParent, const XMLString& elementId, const XMLString& idAttribute, Element*& pElement)
+{
+	std::size_t begin;
+	std::size_t end;
+	if (!range(pParent, true, begin, end)) return false;
+
+	if (!_idMapValid || _idMapNS || _idName != idAttribute)
+		buildIdMap(false, XMLString(), idAttribute);
+	pElement = findId(elementId, begin, end);
+	return true;
+}
+
+
+bool ElementIndex::elementByIdNS(const Node* pParent, const XMLString& elementId, const XMLString& idAttributeURI, const XMLString& idAttributeLocalName, Element*& pElement)
+{
+	std::size_t begin;
+	std::size_t end;
+	if (!range(pParent, true, begin, end)) return false;
+
+	if (!_idMapValid || !_idMapNS || _idURI != idAttributeURI || _idName != idAttributeLocalName)
+		buildIdMap(true, idAttributeURI, idAttributeLocalName);
+	pElement = findId(elementId, begin, end);
+	return true;
+}
+
+
+void ElementIndex::buildIdMap(bool ns, const XMLString& uri, const XMLString& name)
+{
+	_ids.clear();
+	for (std::size_t pos = 0; pos < _elements.size(); ++pos)
+	{
+		const Element* pElem = static_cast<const Element*>(_elements[pos]);
+		_ids[ns ? pElem->getAttributeNS(uri, name) : pElem->getAttribute(name)].push_back(pos);
+	}
+	_idMapValid = true;
+	_idMapNS    = ns;
+	_idURI      = uri;
+	_idName     = name;
+}
+
+
+void ElementIndex::invalidateIds()
+{
+	_ids.clear();
+	_idMapValid = false;
+}
+
+
+Element* ElementIndex::findId(const XMLString& elementId, std::size_t begin, std::size_t end) const
+{
+	ValueMap::const_iterator it = _ids.find(elementId);
+	if (it != _ids.end())
+	{
+		PosVec::const_iterator itPos = std::lower_bound(it->second.begin(), it->second.end(), begin);
+		if (itPos != it->second.end() && *itPos < end)
+			return static_cast<Element*>(_elements[*itPos]);
+	}
+	return 0;
+}
+
+
+} } // namespace Poco::XML
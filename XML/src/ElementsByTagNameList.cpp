@@ -37,21 +37,38 @@
 #include "Poco/DOM/ElementsByTagNameList.h"
 #include "Poco/DOM/Node.h"
 #include "Poco/DOM/Document.h"
-#include <climits>
+#include "Poco/DOM/ElementIndex.h"
 
 
 namespace Poco {
 namespace XML {
 
 
+namespace
+{
+	static const XMLString asterisk = toXMLString("*");
+
+	inline const Document* documentOf(const Node* pNode)
+	{
+		if (pNode->nodeType() == Node::DOCUMENT_NODE)
+			return static_cast<const Document*>(pNode);
+		else
+			return pNode->ownerDocument();
+	}
+}
+
+
 ElementsByTagNameList::ElementsByTagNameList(const Node* pParent, const XMLString& name):
 	_pParent(pParent),
+	_pDocument(0),
 	_name(name),
-	_count(0)
+	_version(0),
+	_valid(false)
 {
 	poco_check_ptr (pParent);
 	
 	_pParent->duplicate();
+	_pDocument = documentOf(_pParent);
 }
 
 
@@ -63,43 +80,48 @@ ElementsByTagNameList::~ElementsByTagNameList()
 
 Node* ElementsByTagNameList::item(unsigned long index) const
 {
-	_count = 0;
-	return find(_pParent, index);
+	update();
+	return index < _elements.size() ? _elements[index] : 0;
 }
 
 
 unsigned long ElementsByTagNameList::length() const
 {
-	_count = 0;
-	find(_pParent, ULONG_MAX);
-	return _count;
+	update();
+	return static_cast<unsigned long>(_elements.size());
 }
 
 
-namespace
+void ElementsByTagNameList::update() const
 {
-	static const XMLString asterisk = toXMLString("*");
+	if (_valid && _pDocument && _version == _pDocument->treeVersion()) return;
+
+	_elements.clear();
+	if (!_pDocument || !_pDocument->elementIndex().elementsByTagName(_pParent, _name, _elements))
+	{
+		find(_pParent);
+	}
+	if (_pDocument)
+	{
+		_version = _pDocument->treeVersion();
+		_valid   = true;
+	}
 }
 
 
-Node* ElementsByTagNameList::find(const Node* pParent, unsigned long index) const
+void ElementsByTagNameList::find(const Node* pParent) const
 {
-	if (!pParent) return 0;
-
 	// preorder search
 	Node* pCur = pParent->firstChild();
 	while (pCur)
 	{
 		if (pCur->nodeType() == Node::ELEMENT_NODE && (_name == asterisk || pCur->nodeName() == _name))
 		{
-			if (_count == index) return pCur;
-			_count++;
+			_elements.push_back(pCur);
 		}
-		Node* pNode = find(pCur, index);
-		if (pNode) return pNode;
+		find(pCur);
 		pCur = pCur->nextSibling();
 	}
-	return pCur;
 }
 
 
@@ -111,13 +133,16 @@ void ElementsByTagNameList::autoRelease()
 
 ElementsByTagNameListNS::ElementsByTagNameListNS(const Node* pParent, const XMLString& namespaceURI, const XMLString& localName):
 	_pParent(pParent),
+	_pDocument(0),
 	_localName(localName),
 	_namespaceURI(namespaceURI),
-	_count(0)
+	_version(0),
+	_valid(false)
 {
 	poco_check_ptr (pParent);
 	
 	_pParent->duplicate();
+	_pDocument = documentOf(_pParent);
 }
 
 
@@ -130,37 +155,45 @@ ElementsByTagNameListNS::~ElementsByTagNameListNS()
 
 Node* ElementsByTagNameListNS::item(unsigned long index) const
 {
-	_count = 0;
-	return find(_pParent, index);
+	update();
+	return index < _elements.size() ? _elements[index] : 0;
 }
 
 
 unsigned long ElementsByTagNameListNS::length() const
 {
-	_count = 0;
-	find(_pParent, ULONG_MAX);
-	return _count;
+	update();
+	return static_cast<unsigned long>(_elements.size());
 }
 
 
-Node* ElementsByTagNameListNS::find(const Node* pParent, unsigned long index) const
+void ElementsByTagNameListNS::update() const
 {
-	if (!pParent) return 0;
+	if (_valid && _pDocument && _version == _pDocument->treeVersion()) return;
 
+	_elements.clear();
+	find(_pParent);
+	if (_pDocument)
+	{
+		_version = _pDocument->treeVersion();
+		_valid   = true;
+	}
+}
+
+
+void ElementsByTagNameListNS::find(const Node* pParent) const
+{
 	// preorder search
 	Node* pCur = pParent->firstChild();
 	while (pCur)
 	{
 		if (pCur->nodeType() == Node::ELEMENT_NODE && (_localName == asterisk || pCur->localName() == _localName) && (_namespaceURI == asterisk || pCur->namespaceURI() == _namespaceURI))
 		{
-			if (_count == index) return pCur;
-			_count++;
+			_elements.push_back(pCur);
 		}
-		Node* pNode = find(pCur, index);
-		if (pNode) return pNode;
+		find(pCur);
 		pCur = pCur->nextSibling();
 	}
-	return pCur;
 }
 
 
@@ -83,7 +83,8 @@ unsigned short Entity::nodeType() const
 
 Node* Entity::copyNode(bool deep, Document* pOwnerDocument) const
 {
-	return new Entity(pOwnerDocument, *this);
+	NodeArena* pArena = nodeArena(pOwnerDocument);
+	return arenaNode(new (pArena) Entity(pOwnerDocument, *this), pArena);
 }
 
 
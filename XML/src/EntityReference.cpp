@@ -74,7 +74,8 @@ unsigned short EntityReference::nodeType() const
 
 Node* EntityReference::copyNode(bool deep, Document* pOwnerDocument) const
 {
-	return new EntityReference(pOwnerDocument, *this);
+	NodeArena* pArena = nodeArena(pOwnerDocument);
+	return arenaNode(new (pArena) EntityReference(pOwnerDocument, *this), pArena);
 }
 
 
@@ -65,7 +65,8 @@ void NodeAppender::appendChild(Node* newChild)
 
 	if (static_cast<AbstractNode*>(newChild)->_pOwner != _pParent->_pOwner)
 		throw DOMException(DOMException::WRONG_DOCUMENT_ERR);
-		
+
+	_pParent->treeChanged();
 	if (newChild->nodeType() == Node::DOCUMENT_FRAGMENT_NODE)
 	{
 		AbstractContainerNode* pFrag = static_cast<AbstractContainerNode*>(newChild);
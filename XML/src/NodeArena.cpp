@@ -0,0 +1,252 @@
+//
+// NodeArena.cpp
+//
+// $Id: //poco/1.4/XML/src/NodeArena.cpp#1 $
+//
+// Library: XML
+// Package: DOM
+// Module:  DOM
+//
+// Copyright (c) 2004-2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+
+#include "Poco/DOM/NodeArena.h"
+#include "Poco/DOM/DOMObject.h"
+#include "Poco/Types.h"
+#include "Poco/Bugcheck.h"
+#include <algorithm>
+#include <new>
+
+
+namespace Poco {
+namespace XML {
+
+
+namespace
+{
+	union MaxAlign
+	{
+		long double ld;
+		double      d;
+		Poco::Int64 i64;
+		long        l;
+		void*       p;
+		void        (*pf)();
+	};
+	
+	struct AlignmentProbe
+	{
+		char     c;
+		MaxAlign m;
+	};
+
+	const std::size_t ALIGNMENT     = offsetof(AlignmentProbe, m);
+	const std::size_t MAX_SLOT_SIZE = 0xFFFFFFFF;
+	const Poco::UInt32 NO_OBJECT    = 0xFFFFFFFF;
+
+	inline std::size_t alignedSize(std::size_t size)
+	{
+		return (size + ALIGNMENT - 1)/ALIGNMENT*ALIGNMENT;
+	}
+}
+
+
+struct NodeArena::Slot
+	/// The header in front of every allocation.
+{
+	NodeArena*   pArena;
+	Poco::UInt32 size;   // size of the slot, including the header
+	Poco::UInt32 offset; // offset of the attached object, or NO_OBJECT
+
+	static const std::size_t HEADER_SIZE;
+
+	char* payload()
+	{
+		return reinterpret_cast<char*>(this) + HEADER_SIZE;
+	}
+
+	Slot*& nextFree()
+	{
+		return *reinterpret_cast<Slot**>(payload());
+	}
+
+	static Slot* fromPayload(void* ptr)
+	{
+		return reinterpret_cast<Slot*>(static_cast<char*>(ptr) - HEADER_SIZE);
+	}
+};
+
+
+const std::size_t NodeArena::Slot::HEADER_SIZE = alignedSize(sizeof(NodeArena::Slot));
+
+
+NodeArena::NodeArena(std::size_t blockSize):
+	_blockSize(alignedSize(blockSize)),
+	_pCur(0),
+	_pEnd(0),
+	_allocated(0),
+	_destroying(false)
+{
+}
+
+
+NodeArena::~NodeArena()
+{
+	for (std::vector<Block>::iterator it = _blocks.begin(); it != _blocks.end(); ++it)
+	{
+		delete [] it->pBegin;
+	}
+	for (std::vector<char*>::iterator it = _largeBlocks.begin(); it != _largeBlocks.end(); ++it)
+	{
+		delete [] *it;
+	}
+}
+
+
+void* NodeArena::allocate(std::size_t size)
+{
+	if (size > MAX_SLOT_SIZE - Slot::HEADER_SIZE - ALIGNMENT) throw std::bad_alloc();
+
+	std::size_t slotSize = Slot::HEADER_SIZE + alignedSize(size < sizeof(Slot*) ? sizeof(Slot*) : size);
+	Slot* pSlot;
+	if (slotSize > _blockSize)
+	{
+		_largeBlocks.reserve(_largeBlocks.size() + 1);
+		char* pBlock = new char[slotSize];
+		_largeBlocks.push_back(pBlock);
+		_allocated += slotSize;
+		pSlot = reinterpret_cast<Slot*>(pBlock);
+	}
+	else
+	{
+		std::size_t index = slotSize/ALIGNMENT;
+		if (index >= _freeLists.size()) _freeLists.resize(index + 1, 0);
+		pSlot = _freeLists[index];
+		if (pSlot)
+		{
+			_freeLists[index] = pSlot->nextFree();
+		}
+		else
+		{
+			if (static_cast<std::size_t>(_pEnd - _pCur) < slotSize)
+				allocateBlock();
+			pSlot = reinterpret_cast<Slot*>(_pCur);
+			_pCur += slotSize;
+		}
+	}
+	pSlot->pArena = this;
+	pSlot->size   = static_cast<Poco::UInt32>(slotSize);
+	pSlot->offset = NO_OBJECT;
+	return pSlot->payload();
+}
+
+
+void NodeArena::deallocate(void* ptr)
+{
+	Slot* pSlot = Slot::fromPayload(ptr);
+	pSlot->pArena->release(pSlot);
+}
+
+
+void NodeArena::attach(void* ptr, DOMObject* pObject)
+{
+	Slot* pSlot = Slot::fromPayload(ptr);
+	pSlot->offset = static_cast<Poco::UInt32>(reinterpret_cast<char*>(pObject) - pSlot->payload());
+}
+
+
+void NodeArena::destroyObjects()
+{
+	_destroying = true;
+	if (!_blocks.empty()) _blocks.back().pEnd = _pCur;
+	for (std::vector<Block>::iterator it = _blocks.begin(); it != _blocks.end(); ++it)
+	{
+		char* p = it->pBegin;
+		while (p < it->pEnd)
+		{
+			Slot* pSlot = reinterpret_cast<Slot*>(p);
+			p += pSlot->size;
+			destroyObject(pSlot);
+		}
+	}
+	for (std::vector<char*>::iterator it = _largeBlocks.begin(); it != _largeBlocks.end(); ++it)
+	{
+		destroyObject(reinterpret_cast<Slot*>(*it));
+	}
+	_destroying = false;
+}
+
+
+void NodeArena::allocateBlock()
+{
+	if (!_blocks.empty()) _blocks.back().pEnd = _pCur;
+	_blocks.reserve(_blocks.size() + 1);
+	Block block;
+	block.pBegin = new char[_blockSize];
+	block.pEnd   = block.pBegin;
+	_blocks.push_back(block);
+	_allocated += _blockSize;
+	_pCur = block.pBegin;
+	_pEnd = block.pBegin + _blockSize;
+}
+
+
+void NodeArena::release(Slot* pSlot)
+{
+	pSlot->offset = NO_OBJECT;
+	if (pSlot->size > _blockSize)
+	{
+		char* pBlock = reinterpret_cast<char*>(pSlot);
+		std::vector<char*>::iterator it = std::find(_largeBlocks.begin(), _largeBlocks.end(), pBlock);
+		poco_assert (it != _largeBlocks.end());
+		_largeBlocks.erase(it);
+		_allocated -= pSlot->size;
+		delete [] pBlock;
+	}
+	else
+	{
+		// the free list for this size has been created by allocate()
+		std::size_t index = pSlot->size/ALIGNMENT;
+		pSlot->nextFree() = _freeLists[index];
+		_freeLists[index] = pSlot;
+	}
+}
+
+
+void NodeArena::destroyObject(Slot* pSlot)
+{
+	if (pSlot->offset != NO_OBJECT)
+	{
+		DOMObject* pObject = reinterpret_cast<DOMObject*>(pSlot->payload() + pSlot->offset);
+		pSlot->offset = NO_OBJECT;
+		pObject->~DOMObject();
+	}
+}
+
+
+} } // namespace Poco::XML
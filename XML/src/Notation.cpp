@@ -78,7 +78,8 @@ unsigned short Notation::nodeType() const
 
 Node* Notation::copyNode(bool deep, Document* pOwnerDocument) const
 {
-	return new Notation(pOwnerDocument, *this);
+	NodeArena* pArena = nodeArena(pOwnerDocument);
+	return arenaNode(new (pArena) Notation(pOwnerDocument, *this), pArena);
 }
 
 
@@ -49,7 +49,9 @@
 #include "Poco/SAX/LocatorImpl.h"
 #include "Poco/SAX/SAXException.h"
 #include "Poco/URI.h"
+#include "Poco/Exception.h"
 #include <cstring>
+#include <limits>
 
 
 using Poco::URI;
@@ -101,13 +103,14 @@ private:
 };
 
 
-const int ParserEngine::PARSE_BUFFER_SIZE = 4096;
+const int ParserEngine::PARSE_BUFFER_SIZE = 65536;
 const XMLString ParserEngine::EMPTY_STRING;
 
 
 ParserEngine::ParserEngine():
 	_parser(0),
 	_pBuffer(0),
+	_bufferSize(PARSE_BUFFER_SIZE),
 	_encodingSpecified(false),
 	_expandInternalEntities(true),
 	_externalGeneralEntities(false),
@@ -127,6 +130,7 @@ ParserEngine::ParserEngine():
 ParserEngine::ParserEngine(const XMLString& encoding):
 	_parser(0),
 	_pBuffer(0),
+	_bufferSize(PARSE_BUFFER_SIZE),
 	_encodingSpecified(true),
 	_encoding(encoding),
 	_expandInternalEntities(true),
@@ -240,6 +244,20 @@ void ParserEngine::setEnablePartialReads(bool flag)
 }
 
 
+void ParserEngine::setBufferSize(std::size_t size)
+{
+	if (size == 0 || size > static_cast<std::size_t>(std::numeric_limits<int>::max()))
+		throw Poco::InvalidArgumentException("Invalid parse buffer size");
+
+	if (size != _bufferSize)
+	{
+		delete [] _pBuffer;
+		_pBuffer    = 0;
+		_bufferSize = size;
+	}
+}
+
+
 void ParserEngine::parse(InputSource* pInputSource)
 {
 	init();
@@ -265,7 +283,14 @@ void ParserEngine::parse(const char* pBuffer, std::size_t size)
 	pushContext(_parser, &src);
 	if (_pContentHandler) _pContentHandler->setDocumentLocator(this);
 	if (_pContentHandler) _pContentHandler->startDocument();
-	if (!XML_Parse(_parser, pBuffer, static_cast<int>(size), 1))
+	std::size_t processed = 0;
+	while (size - processed > _bufferSize)
+	{
+		if (!XML_Parse(_parser, pBuffer + processed, static_cast<int>(_bufferSize), 0))
+			handleError(XML_GetErrorCode(_parser));
+		processed += _bufferSize;
+	}
+	if (!XML_Parse(_parser, pBuffer + processed, static_cast<int>(size - processed), 1))
 		handleError(XML_GetErrorCode(_parser));
 	if (_pContentHandler) _pContentHandler->endDocument();
 	popContext();
@@ -274,30 +299,41 @@ void ParserEngine::parse(const char* pBuffer, std::size_t size)
 
 void ParserEngine::parseByteInputStream(XMLByteInputStream& istr)
 {
-	std::streamsize n = readBytes(istr, _pBuffer, PARSE_BUFFER_SIZE);
-	while (n > 0)
+	parseByteInputStream(_parser, istr);
+}
+
+
+void ParserEngine::parseByteInputStream(XML_Parser parser, XMLByteInputStream& istr)
+{
+	// Read directly into expat's buffer, saving a copy of every block.
+	bool first = true;
+	std::streamsize n;
+	do
 	{
-		if (!XML_Parse(_parser, _pBuffer, static_cast<int>(n), 0))
-			handleError(XML_GetErrorCode(_parser));
-		if (istr.good())
-			n = readBytes(istr, _pBuffer, PARSE_BUFFER_SIZE);
-		else 
+		char* pBuffer = static_cast<char*>(XML_GetBuffer(parser, static_cast<int>(_bufferSize)));
+		if (!pBuffer)
+			handleError(XML_GetErrorCode(parser));
+		if (first || istr.good())
+			n = readBytes(istr, pBuffer, static_cast<std::streamsize>(_bufferSize));
+		else
 			n = 0;
+		first = false;
+		if (!XML_ParseBuffer(parser, static_cast<int>(n), n == 0))
+			handleError(XML_GetErrorCode(parser));
 	}
-	if (!XML_Parse(_parser, _pBuffer, 0, 1))
-		handleError(XML_GetErrorCode(_parser));
+	while (n > 0);
 }
 
 
 void ParserEngine::parseCharInputStream(XMLCharInputStream& istr)
 {
-	std::streamsize n = readChars(istr, reinterpret_cast<XMLChar*>(_pBuffer), PARSE_BUFFER_SIZE/sizeof(XMLChar));
+	std::streamsize n = readChars(istr, reinterpret_cast<XMLChar*>(_pBuffer), _bufferSize/sizeof(XMLChar));
 	while (n > 0)
 	{
 		if (!XML_Parse(_parser, _pBuffer, static_cast<int>(n*sizeof(XMLChar)), 0))
 			handleError(XML_GetErrorCode(_parser));
 		if (istr.good())
-			n = readChars(istr, reinterpret_cast<XMLChar*>(_pBuffer), PARSE_BUFFER_SIZE/sizeof(XMLChar));
+			n = readChars(istr, reinterpret_cast<XMLChar*>(_pBuffer), _bufferSize/sizeof(XMLChar));
 		else 
 			n = 0;
 	}
@@ -320,43 +356,22 @@ void ParserEngine::parseExternal(XML_Parser extParser, InputSource* pInputSource
 
 void ParserEngine::parseExternalByteInputStream(XML_Parser extParser, XMLByteInputStream& istr)
 {
-	char *pBuffer = new char[PARSE_BUFFER_SIZE];
-	try
-	{
-		std::streamsize n = readBytes(istr, pBuffer, PARSE_BUFFER_SIZE);
-		while (n > 0)
-		{
-			if (!XML_Parse(extParser, pBuffer, static_cast<int>(n), 0))
-				handleError(XML_GetErrorCode(extParser));
-			if (istr.good())
-				n = readBytes(istr, pBuffer, PARSE_BUFFER_SIZE);
-			else 
-				n = 0;
-		}
-		if (!XML_Parse(extParser, pBuffer, 0, 1))
-			handleError(XML_GetErrorCode(extParser));
-	}
-	catch (...)
-	{
-		delete [] pBuffer;
-		throw;
-	}
-	delete [] pBuffer;
+	parseByteInputStream(extParser, istr);
 }
 
 
 void ParserEngine::parseExternalCharInputStream(XML_Parser extParser, XMLCharInputStream& istr)
 {
-	XMLChar *pBuffer = new XMLChar[PARSE_BUFFER_SIZE/sizeof(XMLChar)];
+	XMLChar *pBuffer = new XMLChar[_bufferSize/sizeof(XMLChar)];
 	try
 	{
-		std::streamsize n = readChars(istr, pBuffer, PARSE_BUFFER_SIZE/sizeof(XMLChar));
+		std::streamsize n = readChars(istr, pBuffer, _bufferSize/sizeof(XMLChar));
 		while (n > 0)
 		{
 			if (!XML_Parse(extParser, reinterpret_cast<char*>(pBuffer), static_cast<int>(n*sizeof(XMLChar)), 0))
 				handleError(XML_GetErrorCode(extParser));
 			if (istr.good())
-				n = readChars(istr, pBuffer, static_cast<int>(PARSE_BUFFER_SIZE/sizeof(XMLChar)));
+				n = readChars(istr, pBuffer, static_cast<int>(_bufferSize/sizeof(XMLChar)));
 			else 
 				n = 0;
 		}
@@ -457,7 +472,7 @@ void ParserEngine::init()
 		XML_ParserFree(_parser);
 
 	if (!_pBuffer)
-		_pBuffer  = new char[PARSE_BUFFER_SIZE];
+		_pBuffer  = new char[_bufferSize];
 
 	if (dynamic_cast<NoNamespacePrefixesStrategy*>(_pNamespaceStrategy))
 	{
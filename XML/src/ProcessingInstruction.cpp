@@ -94,7 +94,8 @@ unsigned short ProcessingInstruction::nodeType() const
 
 Node* ProcessingInstruction::copyNode(bool deep, Document* pOwnerDocument) const
 {
-	return new ProcessingInstruction(pOwnerDocument, *this);
+	NodeArena* pArena = nodeArena(pOwnerDocument);
+	return arenaNode(new (pArena) ProcessingInstruction(pOwnerDocument, *this), pArena);
 }
 
 
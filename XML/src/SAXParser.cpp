@@ -87,6 +87,18 @@ void SAXParser::addEncoding(const XMLString& name, Poco::TextEncoding* pEncoding
 }
 
 
+void SAXParser::setBufferSize(std::size_t size)
+{
+	_engine.setBufferSize(size);
+}
+
+
+std::size_t SAXParser::getBufferSize() const
+{
+	return _engine.getBufferSize();
+}
+
+
 void SAXParser::setEntityResolver(EntityResolver* pResolver)
 {
 	_engine.setEntityResolver(pResolver);
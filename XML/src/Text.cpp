@@ -95,7 +95,8 @@ XMLString Text::innerText() const
 
 Node* Text::copyNode(bool deep, Document* pOwnerDocument) const
 {
-	return new Text(pOwnerDocument, *this);
+	NodeArena* pArena = nodeArena(pOwnerDocument);
+	return arenaNode(new (pArena) Text(pOwnerDocument, *this), pArena);
 }
 
 
@@ -0,0 +1,316 @@
+//
+// XMLStreamParser.cpp
+//
+// $Id: //poco/1.4/XML/src/XMLStreamParser.cpp#1 $
+//
+// Library: XML
+// Package: XML
+// Module:  XMLStreamParser
+//
+// Copyright (c) 2004-2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+
+#include "Poco/XML/XMLStreamParser.h"
+#include "Poco/SAX/SAXException.h"
+#include "Poco/Exception.h"
+#include <limits>
+
+
+namespace Poco {
+namespace XML {
+
+
+namespace
+{
+	static const XMLString EMPTY_STRING;
+}
+
+
+XMLStreamParser::XMLStreamParser(std::istream& istr, bool namespaces):
+	_istr(istr),
+	_parser(0),
+	_namespaces(namespaces),
+	_bufferSize(DEFAULT_BUFFER_SIZE),
+	_event(START_DOCUMENT),
+	_queueBegin(0),
+	_queueEnd(0),
+	_depth(0),
+	_textQueued(false),
+	_attributeCount(0)
+{
+	if (_namespaces)
+	{
+		_parser = XML_ParserCreateNS(0, '\t');
+		if (_parser) XML_SetReturnNSTriplet(_parser, 1);
+	}
+	else
+	{
+		_parser = XML_ParserCreate(0);
+	}
+	if (!_parser) throw XMLException("Cannot create XML parser");
+
+	XML_SetUserData(_parser, this);
+	XML_SetElementHandler(_parser, handleStartElement, handleEndElement);
+	XML_SetCharacterDataHandler(_parser, handleCharacterData);
+	XML_SetParamEntityParsing(_parser, XML_PARAM_ENTITY_PARSING_NEVER);
+}
+
+
+XMLStreamParser::~XMLStreamParser()
+{
+	XML_ParserFree(_parser);
+}
+
+
+XMLStreamParser::EventType XMLStreamParser::next()
+{
+	if (_event == END_DOCUMENT) return _event;
+	if (_event == END_ELEMENT) --_depth;
+	if (_event == CHARACTERS) 
+	{
+		_text.clear();
+		_textQueued = false;
+	}
+
+	if (_queueBegin == _queueEnd)
+	{
+		_queueBegin = _queueEnd = 0;
+		parse();
+	}
+	if (_queueBegin < _queueEnd)
+		_event = _queue[_queueBegin++];
+	else
+		_event = END_DOCUMENT;
+
+	if (_event == START_ELEMENT) ++_depth;
+	return _event;
+}
+
+
+void XMLStreamParser::parse()
+{
+	// Feed expat until one of the handlers has queued
+	// an event and suspended the parser.
+	for (;;)
+	{
+		XML_ParsingStatus status;
+		XML_GetParsingStatus(_parser, &status);
+		XML_Status rc;
+		if (status.parsing == XML_SUSPENDED)
+		{
+			rc = XML_ResumeParser(_parser);
+		}
+		else if (status.parsing == XML_FINISHED)
+		{
+			return;
+		}
+		else
+		{
+			char* pBuffer = static_cast<char*>(XML_GetBuffer(_parser, static_cast<int>(_bufferSize)));
+			if (!pBuffer) handleError();
+			std::streamsize n = 0;
+			if (_istr.good())
+			{
+				_istr.read(pBuffer, static_cast<std::streamsize>(_bufferSize));
+				n = _istr.gcount();
+			}
+			rc = XML_ParseBuffer(_parser, static_cast<int>(n), n == 0);
+		}
+		if (rc == XML_STATUS_ERROR) handleError();
+		if (_queueBegin < _queueEnd) return;
+	}
+}
+
+
+bool XMLStreamParser::hasAttribute(const XMLString& qname) const
+{
+	if (_event == START_ELEMENT)
+	{
+		for (int i = 0; i < _attributeCount; ++i)
+		{
+			if (_attributes[i].qname == qname) return true;
+		}
+	}
+	return false;
+}
+
+
+const XMLString& XMLStreamParser::getAttribute(const XMLString& qname) const
+{
+	if (_event == START_ELEMENT)
+	{
+		for (int i = 0; i < _attributeCount; ++i)
+		{
+			if (_attributes[i].qname == qname) return _attributes[i].value;
+		}
+	}
+	return EMPTY_STRING;
+}
+
+
+const XMLString& XMLStreamParser::getAttributeNS(const XMLString& namespaceURI, const XMLString& localName) const
+{
+	if (_event == START_ELEMENT)
+	{
+		for (int i = 0; i < _attributeCount; ++i)
+		{
+			if (_attributes[i].localName == localName && _attributes[i].namespaceURI == namespaceURI) 
+				return _attributes[i].value;
+		}
+	}
+	return EMPTY_STRING;
+}
+
+
+void XMLStreamParser::setBufferSize(std::size_t size)
+{
+	if (size == 0 || size > static_cast<std::size_t>(std::numeric_limits<int>::max()))
+		throw Poco::InvalidArgumentException("Invalid buffer size");
+
+	_bufferSize = size;
+}
+
+
+int XMLStreamParser::getLineNumber() const
+{
+	return static_cast<int>(XML_GetCurrentLineNumber(_parser));
+}
+
+
+int XMLStreamParser::getColumnNumber() const
+{
+	return static_cast<int>(XML_GetCurrentColumnNumber(_parser) + 1);
+}
+
+
+void XMLStreamParser::push(EventType event)
+{
+	poco_assert (_queueEnd < MAX_QUEUED_EVENTS);
+
+	_queue[_queueEnd++] = event;
+}
+
+
+void XMLStreamParser::queueText()
+{
+	if (!_text.empty() && !_textQueued)
+	{
+		push(CHARACTERS);
+		_textQueued = true;
+	}
+}
+
+
+void XMLStreamParser::suspend()
+{
+	// expat may still report the end tag of an empty element
+	// after having been suspended in the start tag handler.
+	XML_ParsingStatus status;
+	XML_GetParsingStatus(_parser, &status);
+	if (status.parsing == XML_PARSING)
+		XML_StopParser(_parser, XML_TRUE);
+}
+
+
+void XMLStreamParser::splitName(const XML_Char* name, XMLString& namespaceURI, XMLString& localName, XMLString& qname) const
+{
+	if (_namespaces)
+	{
+		// expat reports names as "uri<tab>localName<tab>prefix"
+		const XML_Char* p = name;
+		while (*p && *p != '\t') ++p;
+		if (*p)
+		{
+			namespaceURI.assign(name, p - name);
+			const XML_Char* pLocal = ++p;
+			while (*p && *p != '\t') ++p;
+			localName.assign(pLocal, p - pLocal);
+			if (*p)
+			{
+				qname.assign(++p);
+				qname += ':';
+				qname += localName;
+			}
+			else qname = localName;
+			return;
+		}
+	}
+	namespaceURI.clear();
+	localName.assign(name);
+	qname = localName;
+}
+
+
+void XMLStreamParser::handleError()
+{
+	XML_Error code = XML_GetErrorCode(_parser);
+	throw SAXParseException(XML_ErrorString(code), EMPTY_STRING, EMPTY_STRING, getLineNumber(), getColumnNumber());
+}
+
+
+void XMLStreamParser::handleStartElement(void* userData, const XML_Char* name, const XML_Char** atts)
+{
+	XMLStreamParser* pThis = reinterpret_cast<XMLStreamParser*>(userData);
+
+	pThis->queueText();
+	pThis->splitName(name, pThis->_namespaceURI, pThis->_localName, pThis->_qname);
+	int count = 0;
+	for (const XML_Char** pAtt = atts; *pAtt; pAtt += 2, ++count)
+	{
+		if (count == static_cast<int>(pThis->_attributes.size()))
+			pThis->_attributes.push_back(Attribute());
+		Attribute& attr = pThis->_attributes[count];
+		pThis->splitName(pAtt[0], attr.namespaceURI, attr.localName, attr.qname);
+		attr.value.assign(pAtt[1]);
+	}
+	pThis->_attributeCount = count;
+	pThis->push(START_ELEMENT);
+	pThis->suspend();
+}
+
+
+void XMLStreamParser::handleEndElement(void* userData, const XML_Char* name)
+{
+	XMLStreamParser* pThis = reinterpret_cast<XMLStreamParser*>(userData);
+
+	pThis->queueText();
+	pThis->splitName(name, pThis->_namespaceURI, pThis->_localName, pThis->_qname);
+	pThis->push(END_ELEMENT);
+	pThis->suspend();
+}
+
+
+void XMLStreamParser::handleCharacterData(void* userData, const XML_Char* s, int len)
+{
+	XMLStreamParser* pThis = reinterpret_cast<XMLStreamParser*>(userData);
+
+	pThis->_text.append(s, len);
+}
+
+
+} } // namespace Poco::XML
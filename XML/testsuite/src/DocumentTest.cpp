@@ -35,13 +35,19 @@
 #include "CppUnit/TestSuite.h"
 #include "Poco/DOM/Document.h"
 #include "Poco/DOM/Element.h"
+#include "Poco/DOM/Attr.h"
 #include "Poco/DOM/Text.h"
 #include "Poco/DOM/NodeList.h"
 #include "Poco/DOM/AutoPtr.h"
 #include "Poco/DOM/DOMException.h"
+#include "Poco/DOM/DOMParser.h"
+#include "Poco/DOM/DOMWriter.h"
+#include "Poco/DOM/NodeArena.h"
+#include <sstream>
 
 
 using Poco::XML::Element;
+using Poco::XML::Attr;
 using Poco::XML::Document;
 using Poco::XML::Text;
 using Poco::XML::Node;
@@ -49,6 +55,9 @@ using Poco::XML::NodeList;
 using Poco::XML::AutoPtr;
 using Poco::XML::XMLString;
 using Poco::XML::DOMException;
+using Poco::XML::DOMParser;
+using Poco::XML::DOMWriter;
+using Poco::XML::NodeArena;
 
 
 DocumentTest::DocumentTest(const std::string& name): CppUnit::TestCase(name)
@@ -170,6 +179,78 @@ void DocumentTest::testElementsByTagName()
 }
 
 
+void DocumentTest::testElementIndex()
+{
+	AutoPtr<Document> pDoc = new Document;
+	AutoPtr<Element> pRoot = pDoc->createElement("root");
+	pDoc->appendChild(pRoot);
+	AutoPtr<Element> pSub1 = pDoc->createElement("sub");
+	AutoPtr<Element> pSub2 = pDoc->createElement("sub");
+	pRoot->appendChild(pSub1);
+	pRoot->appendChild(pSub2);
+	for (int i = 0; i < 10; ++i)
+	{
+		AutoPtr<Element> pElem = pDoc->createElement("elem");
+		pElem->setAttribute("id", XMLString(1, 'a' + i));
+		(i % 2 ? pSub2 : pSub1)->appendChild(pElem);
+	}
+	
+	AutoPtr<NodeList> pNL1 = pDoc->getElementsByTagName("elem");
+	AutoPtr<NodeList> pNL2 = pSub2->getElementsByTagName("elem");
+	AutoPtr<NodeList> pNL3 = pSub2->getElementsByTagName("*");
+	assert (pNL1->length() == 10);
+	assert (pNL2->length() == 5);
+	assert (pNL3->length() == 5);
+	assert (pNL1->item(0) == pSub1->firstChild());
+	assert (pNL1->item(5) == pSub2->firstChild());
+	assert (pNL1->item(10) == 0);
+	assert (static_cast<Element*>(pNL2->item(0))->getAttribute("id") == "b");
+	assert (static_cast<Element*>(pNL2->item(4))->getAttribute("id") == "j");
+	
+	assert (pDoc->getElementById("c", "id") == pNL1->item(1));
+	assert (pSub2->getElementById("c", "id") == 0);
+	assert (pSub2->getElementById("d", "id") == pNL2->item(1));
+	assert (pDoc->getElementById("", "id") == pRoot);
+	
+	assert (pDoc->getNodeByPath("//elem[@id=h]") == pSub2->getElementById("h", "id"));
+
+	unsigned long version = pDoc->treeVersion();
+	pSub2->removeChild(pSub2->firstChild());
+	assert (pDoc->treeVersion() != version);
+	assert (pNL1->length() == 9);
+	assert (pNL2->length() == 4);
+	assert (pNL3->length() == 4);
+	assert (pDoc->getElementById("b", "id") == 0);
+	
+	// attribute changes keep the tag name index
+	version = pDoc->treeVersion();
+	static_cast<Element*>(pNL1->item(0))->setAttribute("id", "x");
+	assert (pDoc->treeVersion() == version);
+	assert (pDoc->getElementById("a", "id") == 0);
+	assert (pDoc->getElementById("x", "id") == pNL1->item(0));
+	AutoPtr<Attr> pAttr = pDoc->createAttribute("id");
+	pAttr->setValue("y");
+	static_cast<Element*>(pNL1->item(1))->setAttributeNode(pAttr);
+	assert (pDoc->getElementById("y", "id") == pNL1->item(1));
+	pAttr->setValue("z");
+	assert (pDoc->getElementById("y", "id") == 0);
+	assert (pDoc->getElementById("z", "id") == pNL1->item(1));
+	static_cast<Element*>(pNL1->item(1))->removeAttributeNode(pAttr);
+	assert (pDoc->getElementById("z", "id") == 0);
+	assert (pDoc->treeVersion() == version);
+
+	pRoot->removeChild(pSub2);
+	assert (pNL1->length() == 5);
+	assert (pNL3->length() == 4);
+	assert (pSub2->getElementById("d", "id") == pNL3->item(0));
+	assert (pDoc->getElementById("d", "id") == 0);
+	
+	pRoot->appendChild(pSub2);
+	assert (pNL1->length() == 9);
+	assert (pDoc->getElementById("d", "id") == pNL3->item(0));
+}
+
+
 void DocumentTest::testElementsByTagNameNS()
 {
 	AutoPtr<Document> pDoc = new Document;
@@ -284,6 +365,109 @@ void DocumentTest::testElementByIdNS()
 }
 
 
+void DocumentTest::testNodeArena()
+{
+	AutoPtr<Document> pDoc = new Document(0, true);
+	assert (pDoc->hasNodeArena());
+
+	AutoPtr<Element> pRoot = pDoc->createElement("root");
+	pDoc->appendChild(pRoot);
+	for (int i = 0; i < 100; ++i)
+	{
+		AutoPtr<Element> pElem = pDoc->createElement("elem");
+		pElem->setAttribute("id", XMLString(1, 'a' + i % 26));
+		AutoPtr<Text> pText = pDoc->createTextNode("text");
+		pElem->appendChild(pText);
+		pRoot->appendChild(pElem);
+	}
+	AutoPtr<NodeList> pNL = pRoot->childNodes();
+	assert (pNL->length() == 100);
+
+	// nodes released before the document are destroyed and their memory is returned to the arena
+	pRoot->removeChild(pRoot->firstChild());
+	pDoc->collectGarbage();
+	assert (pNL->length() == 99);
+	
+	Element* pAuto = pDoc->createElement("auto");
+	pAuto->autoRelease();
+	
+	// cloned nodes are allocated from the arena as well
+	AutoPtr<Node> pClone = pRoot->cloneNode(true);
+	AutoPtr<NodeList> pCloneNL = pClone->childNodes();
+	assert (pCloneNL->length() == 99);
+	pRoot->appendChild(pClone);
+
+	AutoPtr<Document> pPlainDoc = new Document;
+	assert (!pPlainDoc->hasNodeArena());
+
+	DOMParser parser;
+	assert (!parser.getFeature(DOMParser::FEATURE_NODE_ARENA));
+	parser.setFeature(DOMParser::FEATURE_NODE_ARENA, true);
+	assert (parser.getFeature(DOMParser::FEATURE_NODE_ARENA));
+	std::string xml = "<root><elem a=\"1\">text</elem><!--comment--><?pi data?><![CDATA[cdata]]></root>";
+	AutoPtr<Document> pParsedDoc = parser.parseString(xml);
+	assert (pParsedDoc->hasNodeArena());
+	
+	std::ostringstream ostr;
+	DOMWriter writer;
+	writer.writeNode(ostr, pParsedDoc);
+	assert (ostr.str() == xml);
+}
+
+
+void DocumentTest::testNodeArenaReuse()
+{
+	NodeArena arena(1024);
+	void* p1 = arena.allocate(40);
+	void* p2 = arena.allocate(40);
+	assert (p1 != p2);
+	assert (reinterpret_cast<std::size_t>(p1) % sizeof(double) == 0);
+	assert (reinterpret_cast<std::size_t>(p2) % sizeof(double) == 0);
+	std::size_t allocated = arena.allocated();
+	assert (allocated == 1024);
+
+	NodeArena::deallocate(p1);
+	void* p3 = arena.allocate(40);
+	assert (p3 == p1);
+	void* p4 = arena.allocate(100);
+	assert (p4 != p1 && p4 != p2);
+
+	void* pLarge = arena.allocate(4096);
+	assert (arena.allocated() > allocated + 4096);
+	NodeArena::deallocate(pLarge);
+	assert (arena.allocated() == allocated);
+	
+	for (int i = 0; i < 1000; ++i)
+	{
+		void* p = arena.allocate(40);
+		NodeArena::deallocate(p);
+	}
+	assert (arena.allocated() == allocated);
+
+	NodeArena::deallocate(p2);
+	NodeArena::deallocate(p3);
+	NodeArena::deallocate(p4);
+
+	// repeatedly editing an arena document reuses the memory of released nodes
+	AutoPtr<Document> pDoc = new Document(0, true);
+	AutoPtr<Element> pRoot = pDoc->createElement("root");
+	pDoc->appendChild(pRoot);
+	for (int i = 0; i < 10000; ++i)
+	{
+		AutoPtr<Element> pElem = pDoc->createElement("elem");
+		pElem->setAttribute("attr", "value");
+		AutoPtr<Text> pText = pDoc->createTextNode("text");
+		pElem->appendChild(pText);
+		pRoot->appendChild(pElem);
+		if (i % 10 == 9)
+		{
+			while (pRoot->firstChild()) pRoot->removeChild(pRoot->firstChild());
+		}
+	}
+	assert (!pRoot->hasChildNodes());
+}
+
+
 void DocumentTest::setUp()
 {
 }
@@ -303,8 +487,11 @@ CppUnit::Test* DocumentTest::suite()
 	CppUnit_addTest(pSuite, DocumentTest, testImportDeep);
 	CppUnit_addTest(pSuite, DocumentTest, testElementsByTagName);
 	CppUnit_addTest(pSuite, DocumentTest, testElementsByTagNameNS);
+	CppUnit_addTest(pSuite, DocumentTest, testElementIndex);
 	CppUnit_addTest(pSuite, DocumentTest, testElementById);
 	CppUnit_addTest(pSuite, DocumentTest, testElementByIdNS);
+	CppUnit_addTest(pSuite, DocumentTest, testNodeArena);
+	CppUnit_addTest(pSuite, DocumentTest, testNodeArenaReuse);
 
 	return pSuite;
 }
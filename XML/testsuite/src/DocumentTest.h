@@ -51,8 +51,11 @@ public:
 	void testImportDeep();
 	void testElementsByTagName();
 	void testElementsByTagNameNS();
+	void testElementIndex();
 	void testElementById();
 	void testElementByIdNS();
+	void testNodeArena();
+	void testNodeArenaReuse();
 
 	void setUp();
 	void tearDown();
@@ -38,10 +38,16 @@
 #include "Poco/SAX/EntityResolver.h"
 #include "Poco/SAX/SAXException.h"
 #include "Poco/SAX/WhitespaceFilter.h"
+#include "Poco/SAX/DefaultHandler.h"
 #include "Poco/XML/XMLWriter.h"
 #include "Poco/Latin9Encoding.h"
 #include "Poco/FileStream.h"
+#include "Poco/Stopwatch.h"
+#include "Poco/Exception.h"
+#include "Poco/NumberFormatter.h"
 #include <sstream>
+#include <iostream>
+#include <iomanip>
 
 
 using Poco::XML::SAXParser;
@@ -335,6 +341,85 @@ void SAXParserTest::testParsePartialReads()
 }
 
 
+void SAXParserTest::testBufferSize()
+{
+	SAXParser parser;
+	assert (parser.getBufferSize() == 65536);
+
+	try
+	{
+		parser.setBufferSize(0);
+		fail("invalid buffer size - must throw");
+	}
+	catch (Poco::InvalidArgumentException&)
+	{
+	}
+
+	static const std::size_t sizes[] = { 1, 7, 512, 4096, 1024*1024 };
+	for (std::size_t i = 0; i < sizeof(sizes)/sizeof(sizes[0]); ++i)
+	{
+		parser.setBufferSize(sizes[i]);
+		assert (parser.getBufferSize() == sizes[i]);
+
+		std::string xml = parse(parser, XMLWriter::CANONICAL | XMLWriter::PRETTY_PRINT, WSDL);
+		assert (xml == WSDL);
+		xml = parseMemory(parser, XMLWriter::CANONICAL | XMLWriter::PRETTY_PRINT, WSDL);
+		assert (xml == WSDL);
+	}
+
+	SAXParser extParser;
+	TestEntityResolver resolver;
+	extParser.setEntityResolver(&resolver);
+	extParser.setFeature(XMLReader::FEATURE_EXTERNAL_GENERAL_ENTITIES, true);
+	extParser.setBufferSize(3);
+	std::string xml = parse(extParser, XMLWriter::CANONICAL, EXTERNAL_PARSED);
+	assert (xml == "<!DOCTYPE test><sample>\n\t<elem>\n\tAn external entity.\n</elem>\n\n</sample>");
+}
+
+
+void SAXParserTest::benchmarkParse()
+{
+	const int records = 2000000;
+	std::string data("<?xml version=\"1.0\"?>\n<feed>\n");
+	for (int i = 0; i < records; ++i)
+	{
+		data.append("\t<record id=\"");
+		data.append(Poco::NumberFormatter::format(i));
+		data.append("\" type=\"entry\"><name>Record</name><value>Lorem ipsum dolor sit amet &amp; more</value></record>\n");
+	}
+	data.append("</feed>\n");
+	double mb = data.size()/(1024.0*1024.0);
+	std::cout << std::endl << "Parsing " << std::fixed << std::setprecision(1) << mb << " MB:" << std::endl;
+
+	Poco::XML::DefaultHandler handler;
+	SAXParser parser;
+	parser.setContentHandler(&handler);
+
+	static const std::size_t sizes[] = { 4096, 65536, 1024*1024 };
+	Poco::Stopwatch sw;
+	for (std::size_t i = 0; i < sizeof(sizes)/sizeof(sizes[0]); ++i)
+	{
+		parser.setBufferSize(sizes[i]);
+
+		std::istringstream istr(data);
+		InputSource source(istr);
+		sw.restart();
+		parser.parse(&source);
+		sw.stop();
+		double streamTime = sw.elapsed()/1000000.0;
+
+		sw.restart();
+		parser.parseMemoryNP(data.data(), data.size());
+		sw.stop();
+		double memoryTime = sw.elapsed()/1000000.0;
+
+		std::cout << "buffer " << std::setw(8) << sizes[i]
+			<< "  stream: " << std::setw(8) << mb/streamTime << " MB/s"
+			<< "  memory: " << std::setw(8) << mb/memoryTime << " MB/s" << std::endl;
+	}
+}
+
+
 void SAXParserTest::setUp()
 {
 }
@@ -400,6 +485,8 @@ CppUnit::Test* SAXParserTest::suite()
 	CppUnit_addTest(pSuite, SAXParserTest, testCharacters);
 	CppUnit_addTest(pSuite, SAXParserTest, testParseMemory);
 	CppUnit_addTest(pSuite, SAXParserTest, testParsePartialReads);
+	CppUnit_addTest(pSuite, SAXParserTest, testBufferSize);
+	//CppUnit_addTest(pSuite, SAXParserTest, benchmarkParse);
 
 	return pSuite;
 }
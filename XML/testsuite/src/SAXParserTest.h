@@ -70,6 +70,8 @@ public:
 	void testParseMemory();
 	void testCharacters();
 	void testParsePartialReads();
+	void testBufferSize();
+	void benchmarkParse();
 
 	void setUp();
 	void tearDown();
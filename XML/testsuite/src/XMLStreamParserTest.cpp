@@ -0,0 +1,339 @@
+//
+// XMLStreamParserTest.cpp
+//
+// $Id: //poco/1.4/XML/testsuite/src/XMLStreamParserTest.cpp#1 $
+//
+// Copyright (c) 2004-2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+
+#include "XMLStreamParserTest.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "Poco/XML/XMLStreamParser.h"
+#include "Poco/SAX/SAXException.h"
+#include "Poco/NumberFormatter.h"
+#include "Poco/NumberParser.h"
+#include "Poco/Exception.h"
+#include <sstream>
+
+
+using Poco::XML::XMLStreamParser;
+using Poco::XML::SAXParseException;
+
+
+XMLStreamParserTest::XMLStreamParserTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+XMLStreamParserTest::~XMLStreamParserTest()
+{
+}
+
+
+void XMLStreamParserTest::testSimple()
+{
+	std::istringstream istr("<?xml version='1.0'?><!-- comment --><root><elem>text</elem><?pi data?></root>");
+	XMLStreamParser parser(istr);
+	assert (parser.event() == XMLStreamParser::START_DOCUMENT);
+	assert (parser.depth() == 0);
+	
+	assert (parser.next() == XMLStreamParser::START_ELEMENT);
+	assert (parser.qname() == "root");
+	assert (parser.localName() == "root");
+	assert (parser.namespaceURI().empty());
+	assert (parser.depth() == 1);
+	assert (parser.attributeCount() == 0);
+
+	assert (parser.next() == XMLStreamParser::START_ELEMENT);
+	assert (parser.qname() == "elem");
+	assert (parser.depth() == 2);
+	
+	assert (parser.next() == XMLStreamParser::CHARACTERS);
+	assert (parser.text() == "text");
+	assert (parser.depth() == 2);
+
+	assert (parser.next() == XMLStreamParser::END_ELEMENT);
+	assert (parser.qname() == "elem");
+	assert (parser.depth() == 2);
+
+	assert (parser.next() == XMLStreamParser::END_ELEMENT);
+	assert (parser.qname() == "root");
+	assert (parser.depth() == 1);
+	
+	assert (parser.next() == XMLStreamParser::END_DOCUMENT);
+	assert (parser.depth() == 0);
+	assert (parser.next() == XMLStreamParser::END_DOCUMENT);
+}
+
+
+void XMLStreamParserTest::testAttributes()
+{
+	std::istringstream istr("<root a='1' b=\"two\" c='&lt;3&gt;'><elem d='4'/></root>");
+	XMLStreamParser parser(istr);
+	
+	assert (parser.next() == XMLStreamParser::START_ELEMENT);
+	assert (parser.attributeCount() == 3);
+	assert (parser.attributeQName(0) == "a");
+	assert (parser.attributeValue(0) == "1");
+	assert (parser.attributeQName(1) == "b");
+	assert (parser.attributeValue(1) == "two");
+	assert (parser.attributeQName(2) == "c");
+	assert (parser.attributeValue(2) == "<3>");
+	assert (parser.hasAttribute("b"));
+	assert (!parser.hasAttribute("d"));
+	assert (parser.getAttribute("b") == "two");
+	assert (parser.getAttribute("d").empty());
+	
+	assert (parser.next() == XMLStreamParser::START_ELEMENT);
+	assert (parser.attributeCount() == 1);
+	assert (parser.getAttribute("d") == "4");
+	assert (parser.getAttribute("a").empty());
+
+	assert (parser.next() == XMLStreamParser::END_ELEMENT);
+	assert (parser.attributeCount() == 0);
+}
+
+
+void XMLStreamParserTest::testNamespaces()
+{
+	std::istringstream istr("<ns1:root xmlns:ns1='urn:ns1' xmlns='urn:default' ns1:a='1' b='2'><elem/></ns1:root>");
+	XMLStreamParser parser(istr);
+	
+	assert (parser.next() == XMLStreamParser::START_ELEMENT);
+	assert (parser.qname() == "ns1:root");
+	assert (parser.localName() == "root");
+	assert (parser.namespaceURI() == "urn:ns1");
+	assert (parser.attributeCount() == 2);
+	assert (parser.attributeQName(0) == "ns1:a");
+	assert (parser.attributeLocalName(0) == "a");
+	assert (parser.attributeNamespaceURI(0) == "urn:ns1");
+	assert (parser.attributeQName(1) == "b");
+	assert (parser.attributeLocalName(1) == "b");
+	assert (parser.attributeNamespaceURI(1).empty());
+	assert (parser.getAttributeNS("urn:ns1", "a") == "1");
+	assert (parser.getAttributeNS("", "b") == "2");
+	assert (parser.getAttributeNS("urn:ns1", "b").empty());
+
+	assert (parser.next() == XMLStreamParser::START_ELEMENT);
+	assert (parser.qname() == "elem");
+	assert (parser.localName() == "elem");
+	assert (parser.namespaceURI() == "urn:default");
+
+	assert (parser.next() == XMLStreamParser::END_ELEMENT);
+	assert (parser.namespaceURI() == "urn:default");
+	assert (parser.next() == XMLStreamParser::END_ELEMENT);
+	assert (parser.qname() == "ns1:root");
+	assert (parser.next() == XMLStreamParser::END_DOCUMENT);
+}
+
+
+void XMLStreamParserTest::testNoNamespaces()
+{
+	std::istringstream istr("<ns1:root xmlns:ns1='urn:ns1' ns1:a='1'/>");
+	XMLStreamParser parser(istr, false);
+	
+	assert (parser.next() == XMLStreamParser::START_ELEMENT);
+	assert (parser.qname() == "ns1:root");
+	assert (parser.localName() == "ns1:root");
+	assert (parser.namespaceURI().empty());
+	assert (parser.attributeCount() == 2);
+	assert (parser.getAttribute("xmlns:ns1") == "urn:ns1");
+	assert (parser.getAttribute("ns1:a") == "1");
+}
+
+
+void XMLStreamParserTest::testCharacters()
+{
+	std::istringstream istr("<!DOCTYPE root [<!ENTITY ent 'entity'>]><root>a &amp; b<![CDATA[<c>]]>&ent;<elem/>  </root>");
+	XMLStreamParser parser(istr);
+	
+	assert (parser.next() == XMLStreamParser::START_ELEMENT);
+	assert (parser.next() == XMLStreamParser::CHARACTERS);
+	assert (parser.text() == "a & b<c>entity");
+	assert (parser.next() == XMLStreamParser::START_ELEMENT);
+	assert (parser.qname() == "elem");
+	assert (parser.next() == XMLStreamParser::END_ELEMENT);
+	assert (parser.next() == XMLStreamParser::CHARACTERS);
+	assert (parser.text() == "  ");
+	assert (parser.next() == XMLStreamParser::END_ELEMENT);
+	assert (parser.qname() == "root");
+	assert (parser.next() == XMLStreamParser::END_DOCUMENT);
+}
+
+
+void XMLStreamParserTest::testEmptyElements()
+{
+	std::istringstream istr("<root>text<a/><b x='1'/></root>");
+	XMLStreamParser parser(istr);
+	
+	assert (parser.next() == XMLStreamParser::START_ELEMENT);
+	assert (parser.next() == XMLStreamParser::CHARACTERS);
+	assert (parser.text() == "text");
+	assert (parser.next() == XMLStreamParser::START_ELEMENT);
+	assert (parser.qname() == "a");
+	assert (parser.depth() == 2);
+	assert (parser.next() == XMLStreamParser::END_ELEMENT);
+	assert (parser.qname() == "a");
+	assert (parser.depth() == 2);
+	assert (parser.next() == XMLStreamParser::START_ELEMENT);
+	assert (parser.qname() == "b");
+	assert (parser.getAttribute("x") == "1");
+	assert (parser.next() == XMLStreamParser::END_ELEMENT);
+	assert (parser.qname() == "b");
+	assert (parser.next() == XMLStreamParser::END_ELEMENT);
+	assert (parser.qname() == "root");
+	assert (parser.depth() == 1);
+	assert (parser.next() == XMLStreamParser::END_DOCUMENT);
+}
+
+
+void XMLStreamParserTest::testSmallBuffer()
+{
+	std::string xml("<root attr='value'>some text<elem>more &amp; text</elem><empty/></root>");
+	std::istringstream istr(xml);
+	XMLStreamParser parser(istr);
+	parser.setBufferSize(1);
+	assert (parser.getBufferSize() == 1);
+	
+	std::string result;
+	XMLStreamParser::EventType event;
+	while ((event = parser.next()) != XMLStreamParser::END_DOCUMENT)
+	{
+		switch (event)
+		{
+		case XMLStreamParser::START_ELEMENT:
+			result += "<" + parser.qname();
+			for (int i = 0; i < parser.attributeCount(); ++i)
+				result += " " + parser.attributeQName(i) + "='" + parser.attributeValue(i) + "'";
+			result += ">";
+			break;
+		case XMLStreamParser::END_ELEMENT:
+			result += "</" + parser.qname() + ">";
+			break;
+		case XMLStreamParser::CHARACTERS:
+			result += "[" + parser.text() + "]";
+			break;
+		default:
+			fail("unexpected event");
+		}
+	}
+	assert (result == "<root attr='value'>[some text]<elem>[more & text]</elem><empty></empty></root>");
+
+	try
+	{
+		parser.setBufferSize(0);
+		fail("invalid buffer size - must throw");
+	}
+	catch (Poco::InvalidArgumentException&)
+	{
+	}
+}
+
+
+void XMLStreamParserTest::testMalformed()
+{
+	std::istringstream istr("<root>\n<elem></root>");
+	XMLStreamParser parser(istr);
+	assert (parser.next() == XMLStreamParser::START_ELEMENT);
+	assert (parser.next() == XMLStreamParser::CHARACTERS);
+	assert (parser.next() == XMLStreamParser::START_ELEMENT);
+	try
+	{
+		parser.next();
+		fail("malformed document - must throw");
+	}
+	catch (SAXParseException& exc)
+	{
+		assert (exc.getLineNumber() == 2);
+	}
+}
+
+
+void XMLStreamParserTest::testLargeDocument()
+{
+	std::ostringstream ostr;
+	ostr << "<rows>";
+	for (int i = 0; i < 10000; ++i)
+	{
+		ostr << "<row id='" << i << "'><value>" << i*2 << "</value></row>";
+	}
+	ostr << "</rows>";
+	std::istringstream istr(ostr.str());
+	XMLStreamParser parser(istr);
+	parser.setBufferSize(4096);
+
+	int rows = 0;
+	long sum = 0;
+	int maxDepth = 0;
+	XMLStreamParser::EventType event;
+	while ((event = parser.next()) != XMLStreamParser::END_DOCUMENT)
+	{
+		if (parser.depth() > maxDepth) maxDepth = parser.depth();
+		if (event == XMLStreamParser::START_ELEMENT && parser.qname() == "row")
+		{
+			assert (parser.getAttribute("id") == Poco::NumberFormatter::format(rows));
+			++rows;
+		}
+		else if (event == XMLStreamParser::CHARACTERS)
+		{
+			sum += Poco::NumberParser::parse(parser.text());
+		}
+	}
+	assert (rows == 10000);
+	assert (sum == 9999L*10000L);
+	assert (maxDepth == 3);
+}
+
+
+void XMLStreamParserTest::setUp()
+{
+}
+
+
+void XMLStreamParserTest::tearDown()
+{
+}
+
+
+CppUnit::Test* XMLStreamParserTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("XMLStreamParserTest");
+
+	CppUnit_addTest(pSuite, XMLStreamParserTest, testSimple);
+	CppUnit_addTest(pSuite, XMLStreamParserTest, testAttributes);
+	CppUnit_addTest(pSuite, XMLStreamParserTest, testNamespaces);
+	CppUnit_addTest(pSuite, XMLStreamParserTest, testNoNamespaces);
+	CppUnit_addTest(pSuite, XMLStreamParserTest, testCharacters);
+	CppUnit_addTest(pSuite, XMLStreamParserTest, testEmptyElements);
+	CppUnit_addTest(pSuite, XMLStreamParserTest, testSmallBuffer);
+	CppUnit_addTest(pSuite, XMLStreamParserTest, testMalformed);
+	CppUnit_addTest(pSuite, XMLStreamParserTest, testLargeDocument);
+
+	return pSuite;
+}
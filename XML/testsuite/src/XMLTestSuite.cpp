@@ -34,6 +34,7 @@
 #include "NameTest.h"
 #include "NamePoolTest.h"
 #include "XMLWriterTest.h"
+#include "XMLStreamParserTest.h"
 #include "SAXTestSuite.h"
 #include "DOMTestSuite.h"
 
@@ -45,6 +46,7 @@ CppUnit::Test* XMLTestSuite::suite()
 	pSuite->addTest(NameTest::suite());
 	pSuite->addTest(NamePoolTest::suite());
 	pSuite->addTest(XMLWriterTest::suite());
+	pSuite->addTest(XMLStreamParserTest::suite());
 	pSuite->addTest(SAXTestSuite::suite());
 	pSuite->addTest(DOMTestSuite::suite());
 
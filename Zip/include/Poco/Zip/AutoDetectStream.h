@@ -54,7 +54,7 @@ class Zip_API AutoDetectStreamBuf: public Poco::BufferedStreamBuf
 	/// A AutoDetectStreamBuf is a class that limits one view on an inputstream to a selected view range
 {
 public:
-	AutoDetectStreamBuf(std::istream& in, const std::string& prefix, const std::string& postfix, bool reposition, Poco::UInt32 start);
+	AutoDetectStreamBuf(std::istream& in, const std::string& prefix, const std::string& postfix, bool reposition, std::streamoff start);
 		/// Creates the AutoDetectStream. 
 		
 
@@ -84,7 +84,7 @@ private:
 	std::string    _prefix;
 	std::string    _postfix;
 	bool           _reposition;
-	Poco::UInt32   _start;
+	std::streamoff _start;
 };
 
 
@@ -95,7 +95,7 @@ class Zip_API AutoDetectIOS: public virtual std::ios
 	/// order of the stream buffer and base classes.
 {
 public:
-	AutoDetectIOS(std::istream& istr, const std::string& prefix, const std::string& postfix, bool reposition, Poco::UInt32 start);
+	AutoDetectIOS(std::istream& istr, const std::string& prefix, const std::string& postfix, bool reposition, std::streamoff start);
 		/// Creates the basic stream and connects it
 		/// to the given input stream.
 
@@ -119,7 +119,7 @@ class Zip_API AutoDetectInputStream: public AutoDetectIOS, public std::istream
 	/// to one or multiple output streams.
 {
 public:
-	AutoDetectInputStream(std::istream& istr, const std::string& prefix = std::string(), const std::string& postfix = std::string(), bool reposition = false, Poco::UInt32 start = 0);
+	AutoDetectInputStream(std::istream& istr, const std::string& prefix = std::string(), const std::string& postfix = std::string(), bool reposition = false, std::streamoff start = 0);
 		/// Creates the AutoDetectInputStream and connects it
 		/// to the given input stream. Bytes read are guaranteed to be in the range [start, end-1]
 		/// If initStream is true the status of the stream will be cleared on the first access, and the stream will be repositioned
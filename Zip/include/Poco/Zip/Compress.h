@@ -43,8 +43,15 @@
 #include "Poco/Zip/Zip.h"
 #include "Poco/Zip/ZipArchive.h"
 #include "Poco/FIFOEvent.h"
+#include "Poco/SharedPtr.h"
+#include "Poco/Thread.h"
+#include "Poco/Mutex.h"
+#include "Poco/Condition.h"
+#include "Poco/RunnableAdapter.h"
 #include <istream>
 #include <ostream>
+#include <deque>
+#include <vector>
 
 
 namespace Poco {
@@ -61,6 +68,17 @@ public:
 		/// seekableOut determines how we write the zip, setting it to true is recommended for local files (smaller zip file),
 		/// if you are compressing directly to a network, you MUST set it to false
 
+	Compress(std::ostream& out, bool seekableOut, int threads);
+		/// Creates a Compress that compresses files added with addFile(const Poco::Path&, ...)
+		/// or addRecursive() on the given number of background threads. Each file is
+		/// compressed into a memory buffer, or into a temporary file if it is large, and
+		/// the entries are written to out in the order in which they were added.
+		/// Entries added from a stream are compressed by the calling thread, after all
+		/// pending entries have been written.
+		///
+		/// An error that occurs while compressing a file is thrown by the call that
+		/// writes the entry, which is a later add call or close().
+
 	~Compress();
 
 	void addFile(std::istream& input, const Poco::DateTime& lastModifiedAt, const Poco::Path& fileName, ZipCommon::CompressionMethod cm = ZipCommon::CM_DEFLATE, ZipCommon::CompressionLevel cl = ZipCommon::CL_MAXIMUM);
@@ -85,6 +103,16 @@ public:
 
 	const std::string& getZipComment() const;
 		/// Returns the Zip file comment.
+
+	void setZip64(bool flag);
+		/// If flag is true, all entries are written with ZIP64 extended information,
+		/// and the archive gets a ZIP64 end of central directory record. This is
+		/// required for entries added from streams that may exceed 4 GB.
+		/// Entries added from files, and archives that have more than 65534 entries
+		/// or exceed 4 GB, use ZIP64 automatically. Must be called before entries are added.
+
+	bool getZip64() const;
+		/// Returns true if all entries are written with ZIP64 extended information.
 		
 	ZipArchive close();
 		/// Finalizes the ZipArchive, closes it.
@@ -92,27 +120,65 @@ public:
 private:
 	enum
 	{
-		COMPRESS_CHUNK_SIZE = 8192
+		COMPRESS_CHUNK_SIZE = 8192,
+		TEMP_FILE_THRESHOLD = 16*1024*1024,
+			/// Files larger than this are compressed into a temporary
+			/// file instead of a memory buffer in parallel mode.
+		ZIP64_FILE_THRESHOLD = 0xFF000000
+			/// Files larger than this get ZIP64 extended information, because
+			/// deflating incompressible data can make it slightly larger.
 	};
 
+	class Job;
+	typedef Poco::SharedPtr<Job> JobPtr;
+
 	Compress(const Compress&);
 	Compress& operator=(const Compress&);
 
-	void addEntry(std::istream& input, const Poco::DateTime& lastModifiedAt, const Poco::Path& fileName, ZipCommon::CompressionMethod cm = ZipCommon::CM_DEFLATE, ZipCommon::CompressionLevel cl = ZipCommon::CL_MAXIMUM);
+	void addEntry(std::istream& input, const Poco::DateTime& lastModifiedAt, const Poco::Path& fileName, ZipCommon::CompressionMethod cm = ZipCommon::CM_DEFLATE, ZipCommon::CompressionLevel cl = ZipCommon::CL_MAXIMUM, bool zip64 = false);
 		/// Either adds a file or a single directory entry (excluding subchildren) to the Zip file. the compression level will be ignored
-		/// for directories.
+		/// for directories. If zip64 is true, the entry gets ZIP64 extended information.
 
 	void addFileRaw(std::istream& in, const ZipLocalFileHeader& hdr, const Poco::Path& fileName);
 		/// copys an already compressed ZipEntry from in
 
+	bool isPending(const std::string& fileName) const;
+		/// Returns true if an entry with the given name has been added,
+		/// but not yet written.
+
+	void enqueue(JobPtr pJob);
+		/// Adds a job for a background thread.
+
+	void writeJobs(std::size_t maxPending);
+		/// Writes the completed entries in the order in which they were added,
+		/// until no more than maxPending entries are left.
+
+	void writeJob(Job& job);
+		/// Writes a compressed entry to the archive.
+
+	void stopThreads();
+	void run();
+
 private:
 	std::ostream&              _out;
 	bool                       _seekableOut;
 	ZipArchive::FileHeaders    _files;
 	ZipArchive::FileInfos      _infos;
 	ZipArchive::DirectoryInfos _dirs;
-	Poco::UInt32               _offset;
+	ZipArchive::DirectoryInfos64 _dirs64;
+	Poco::UInt64               _offset;
     std::string                _comment;
+	bool                       _zip64;
+	std::size_t                _threadCount;
+	std::deque<JobPtr>         _jobs;
+		/// Entries that have been added but not written, in order
+	std::deque<JobPtr>         _queue;
+		/// Entries waiting for a background thread
+	bool                       _stop;
+	std::vector<Poco::SharedPtr<Poco::Thread> > _threads;
+	Poco::RunnableAdapter<Compress> _runnable;
+	Poco::Mutex                _mutex;
+	Poco::Condition            _changed;
 
 	friend class Keep;
 	friend class Rename;
@@ -134,6 +200,18 @@ inline const std::string& Compress::getZipComment() const
 }
 
 
+inline void Compress::setZip64(bool flag)
+{
+	_zip64 = flag;
+}
+
+
+inline bool Compress::getZip64() const
+{
+	return _zip64;
+}
+
+
 } } // namespace Poco::Zip
 
 
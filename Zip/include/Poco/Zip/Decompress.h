@@ -45,6 +45,11 @@
 #include "Poco/Zip/ZipArchive.h"
 #include "Poco/Path.h"
 #include "Poco/FIFOEvent.h"
+#include "Poco/SharedPtr.h"
+#include "Poco/Thread.h"
+#include "Poco/Mutex.h"
+#include "Poco/RunnableAdapter.h"
+#include <vector>
 
 
 namespace Poco {
@@ -72,6 +77,11 @@ public:
 		/// If flattenDirs is set to true, the directory structure of the zip file is not recreated. 
 		/// Instead, all files are extracted into one single directory.
 
+	Decompress(const std::string& zipFile, const Poco::Path& outputDir, bool flattenDirs = false, bool keepIncompleteFiles = false);
+		/// Creates the Decompress for the given zip file. The other arguments are the same as above.
+		/// In addition to sequential extraction, this allows extracting the files in parallel
+		/// with decompressAllFiles(int).
+
 	~Decompress();
 		/// Destroys the Decompress.
 
@@ -79,6 +89,19 @@ public:
 		/// Decompresses all files stored in the zip File. Can only be called once per Decompress object.
 		/// Use mapping to retrieve the location of the decompressed files
 
+	ZipArchive decompressAllFiles(int threads);
+		/// Decompresses all files stored in the zip File on the given number of threads.
+		/// The entries are found through the central directory, and every thread reads
+		/// the archive through its own file handle, so this requires a Decompress created
+		/// for a zip file; otherwise, or if threads is less than 2, this is the same as
+		/// decompressAllFiles(). If the central directory cannot be read, the entries are
+		/// found by scanning the local file headers instead, and are still extracted on
+		/// the worker threads. Can only be called once per Decompress object.
+		///
+		/// The EOk and EError events are fired for every entry, as with sequential
+		/// decompression, but not in archive order. The handlers are never called
+		/// concurrently, but they are called from the worker threads.
+
 	bool handleZipEntry(std::istream& zipStream, const ZipLocalFileHeader& hdr);
 
 	const ZipMapping& mapping() const;
@@ -91,12 +114,33 @@ private:
 
 	void onOk(const void*, std::pair<const ZipLocalFileHeader, const Poco::Path>& val);
 
+	bool extract(std::istream& zipStream, const ZipLocalFileHeader& hdr, bool reposition);
+		/// Extracts a single entry. If reposition is true, the data is
+		/// read from the entry's position, otherwise from the current position.
+
+	void reportError(const ZipLocalFileHeader& hdr, const std::string& message);
+	void reportOk(const ZipLocalFileHeader& hdr, const Poco::Path& file);
+		/// Fire the events, one at a time.
+
+	void run();
+		/// Extracts entries from _pending until none are left.
+
 private:
+	Poco::SharedPtr<std::istream> _pFile;
 	std::istream& _in;
+	std::string   _zipFile;
 	Poco::Path    _outDir;
 	bool          _flattenDirs;
 	bool          _keepIncompleteFiles;
 	ZipMapping    _mapping;
+	std::vector<const ZipLocalFileHeader*> _pending;
+	std::size_t   _next;
+		/// Index of the next entry in _pending to be extracted
+	Poco::FastMutex _mutex;
+		/// Guards _next and directory creation
+	Poco::FastMutex _eventMutex;
+		/// Serializes the EOk and EError handlers
+	Poco::RunnableAdapter<Decompress> _runnable;
 };
 
 
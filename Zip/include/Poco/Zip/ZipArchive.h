@@ -63,9 +63,20 @@ public:
 	typedef std::map<std::string, ZipLocalFileHeader> FileHeaders;
 	typedef std::map<std::string, ZipFileInfo> FileInfos;
 	typedef std::map<Poco::UInt16, ZipArchiveInfo> DirectoryInfos;
+	typedef std::map<Poco::UInt32, ZipArchiveInfo64> DirectoryInfos64;
 
 	ZipArchive(std::istream& in);
-		/// Creates the ZipArchive from a file. Note that the in stream will be in state failed after the constructor is finished
+		/// Creates the ZipArchive from a file.
+		/// ZIP64 archives, with more than 65535 entries or entries
+		/// and offsets larger than 4 GB, are supported.
+		///
+		/// If the stream is seekable, only the central directory at the end
+		/// of the archive and the local file headers are read, so the cost
+		/// depends on the number of entries, not on the size of the archive.
+		/// Entries can then be extracted by seeking, using a ZipInputStream.
+		/// This also works with a MemoryInputStream over a memory mapped file.
+		/// Otherwise, the archive is parsed front to back, and the in stream
+		/// will be in state failed after the constructor is finished.
 
 	ZipArchive(std::istream& in, ParseCallback& callback);
 		/// Creates the ZipArchive from a file or network stream. Note that the in stream will be in state failed after the constructor is finished
@@ -88,7 +99,12 @@ public:
 private:
 	void parse(std::istream& in, ParseCallback& pc);
 
-	ZipArchive(const FileHeaders& entries, const FileInfos& infos, const DirectoryInfos& dirs	);
+	bool parseDirectory(std::istream& in);
+		/// Reads the end of central directory record, the central directory
+		/// and the local file headers. Returns false if the stream is not
+		/// seekable or the archive cannot be read this way.
+
+	ZipArchive(const FileHeaders& entries, const FileInfos& infos, const DirectoryInfos& dirs, const DirectoryInfos64& dirs64);
 
 private:
 	FileHeaders    _entries;
@@ -97,6 +113,8 @@ private:
 		/// Info generated by parsing the directory block of the zip file
 	DirectoryInfos _disks;
 		/// Stores directory info for all found disks
+	DirectoryInfos64 _disks64;
+		/// Stores the ZIP64 directory info for all found disks
 
 	friend class Compress;
 };
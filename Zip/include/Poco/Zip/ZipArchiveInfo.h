@@ -83,6 +83,10 @@ public:
 	std::streamoff getHeaderOffset() const;
 		/// Returns the offset of the header in relation to the begin of this disk
 
+	Poco::UInt32 getCentralDirectoryOffset() const;
+		/// Returns the offset of the central directory from the start
+		/// of the archive, as stored in the record.
+
 	const std::string& getZipComment() const;
 		/// Returns the (optional) Zip Comment
 
@@ -135,6 +139,109 @@ private:
 };
 
 
+class Zip_API ZipArchiveInfo64
+	/// A ZipArchiveInfo64 stores the ZIP64 end of central directory record
+	/// and the ZIP64 end of central directory locator that follows it.
+	/// They are written in front of the end of central directory record
+	/// if the archive has more than 65534 entries, or if the central
+	/// directory's size or offset do not fit into 32 bits.
+{
+public:
+	static const char HEADER[ZipCommon::HEADER_SIZE];
+	static const char LOCATOR_HEADER[ZipCommon::HEADER_SIZE];
+
+	ZipArchiveInfo64();
+		/// Default constructor, everything set to zero or empty
+
+	ZipArchiveInfo64(std::istream& in, bool assumeHeaderRead);
+		/// Creates the ZipArchiveInfo64 by parsing the record and the locator.
+		/// If assumeHeaderRead is true we assume that the first 4 bytes were already read outside.
+
+	~ZipArchiveInfo64();
+		/// Destroys the ZipArchiveInfo64.
+
+	Poco::UInt32 getDiskNumber() const;
+		/// Get the number of the disk where this header can be found
+
+	Poco::UInt32 getFirstDiskForDirectoryHeader() const;
+		/// Returns the number of the disk that contains the start of the directory header
+
+	Poco::UInt64 getNumberOfEntries() const;
+		/// Returns the number of entries on this disk
+
+	Poco::UInt64 getTotalNumberOfEntries() const;
+		/// Returns the total number of entries on all disks
+
+	Poco::UInt64 getCentralDirectorySize() const;
+		/// Returns the size of the central directory in bytes
+
+	Poco::UInt64 getCentralDirectoryOffset() const;
+		/// Returns the offset of the central directory from the start
+		/// of the archive.
+
+	std::streamoff getHeaderOffset() const;
+		/// Returns the offset of the record in relation to the begin of this disk
+
+	void setNumberOfEntries(Poco::UInt64 val);
+
+	void setTotalNumberOfEntries(Poco::UInt64 val);
+
+	void setCentralDirectorySize(Poco::UInt64 val);
+
+	void setCentralDirectoryOffset(Poco::UInt64 val);
+
+	void setHeaderOffset(std::streamoff val);
+		/// Sets the offset of the record, which is stored in the locator.
+
+	std::string createHeader() const;
+		/// Creates the record followed by the locator
+
+private:
+	void parse(std::istream& inp, bool assumeHeaderRead);
+
+private:
+	enum
+	{
+		HEADER_POS = 0,
+		RECORDSIZE_POS = HEADER_POS + ZipCommon::HEADER_SIZE,
+		RECORDSIZE_SIZE = 8,
+		VERSIONMADEBY_POS = RECORDSIZE_POS + RECORDSIZE_SIZE,
+		VERSIONMADEBY_SIZE = 2,
+		VERSION_NEEDED_POS = VERSIONMADEBY_POS + VERSIONMADEBY_SIZE,
+		VERSION_NEEDED_SIZE = 2,
+		NUMBEROFTHISDISK_POS = VERSION_NEEDED_POS + VERSION_NEEDED_SIZE,
+		NUMBEROFTHISDISK_SIZE = 4,
+		NUMBEROFCENTRALDIRDISK_POS = NUMBEROFTHISDISK_POS + NUMBEROFTHISDISK_SIZE,
+		NUMBEROFCENTRALDIRDISK_SIZE = 4,
+		NUMENTRIESTHISDISK_POS = NUMBEROFCENTRALDIRDISK_POS + NUMBEROFCENTRALDIRDISK_SIZE,
+		NUMENTRIESTHISDISK_SIZE = 8,
+		TOTALNUMENTRIES_POS = NUMENTRIESTHISDISK_POS + NUMENTRIESTHISDISK_SIZE,
+		TOTALNUMENTRIES_SIZE = 8,
+		CENTRALDIRSIZE_POS = TOTALNUMENTRIES_POS + TOTALNUMENTRIES_SIZE,
+		CENTRALDIRSIZE_SIZE = 8,
+		CENTRALDIRSTARTOFFSET_POS = CENTRALDIRSIZE_POS + CENTRALDIRSIZE_SIZE,
+		CENTRALDIRSTARTOFFSET_SIZE = 8,
+		FULLHEADER_SIZE = 56
+	};
+
+	enum
+	{
+		LOCATOR_HEADER_POS = 0,
+		LOCATOR_DISK_POS = LOCATOR_HEADER_POS + ZipCommon::HEADER_SIZE,
+		LOCATOR_DISK_SIZE = 4,
+		LOCATOR_OFFSET_POS = LOCATOR_DISK_POS + LOCATOR_DISK_SIZE,
+		LOCATOR_OFFSET_SIZE = 8,
+		LOCATOR_TOTALDISKS_POS = LOCATOR_OFFSET_POS + LOCATOR_OFFSET_SIZE,
+		LOCATOR_TOTALDISKS_SIZE = 4,
+		LOCATOR_SIZE = 20
+	};
+
+	char           _rawInfo[FULLHEADER_SIZE];
+	std::streamoff _startPos;
+	std::string    _extensibleData;
+};
+
+
 inline Poco::UInt16 ZipArchiveInfo::getDiskNumber() const
 {
 	return ZipUtil::get16BitValue(_rawInfo, NUMBEROFTHISDISK_POS);
@@ -201,12 +308,90 @@ inline void ZipArchiveInfo::setCentralDirectorySize(Poco::UInt32 val)
 }
 
 
+inline Poco::UInt32 ZipArchiveInfo::getCentralDirectoryOffset() const
+{
+	return ZipUtil::get32BitValue(_rawInfo, CENTRALDIRSTARTOFFSET_POS);
+}
+
+
 inline void ZipArchiveInfo::setHeaderOffset(Poco::UInt32 val)
 {
 	ZipUtil::set32BitValue(val, _rawInfo, CENTRALDIRSTARTOFFSET_POS);
 }
 
 
+inline Poco::UInt32 ZipArchiveInfo64::getDiskNumber() const
+{
+	return ZipUtil::get32BitValue(_rawInfo, NUMBEROFTHISDISK_POS);
+}
+
+
+inline Poco::UInt32 ZipArchiveInfo64::getFirstDiskForDirectoryHeader() const
+{
+	return ZipUtil::get32BitValue(_rawInfo, NUMBEROFCENTRALDIRDISK_POS);
+}
+
+
+inline Poco::UInt64 ZipArchiveInfo64::getNumberOfEntries() const
+{
+	return ZipUtil::get64BitValue(_rawInfo, NUMENTRIESTHISDISK_POS);
+}
+
+
+inline Poco::UInt64 ZipArchiveInfo64::getTotalNumberOfEntries() const
+{
+	return ZipUtil::get64BitValue(_rawInfo, TOTALNUMENTRIES_POS);
+}
+
+
+inline Poco::UInt64 ZipArchiveInfo64::getCentralDirectorySize() const
+{
+	return ZipUtil::get64BitValue(_rawInfo, CENTRALDIRSIZE_POS);
+}
+
+
+inline Poco::UInt64 ZipArchiveInfo64::getCentralDirectoryOffset() const
+{
+	return ZipUtil::get64BitValue(_rawInfo, CENTRALDIRSTARTOFFSET_POS);
+}
+
+
+inline std::streamoff ZipArchiveInfo64::getHeaderOffset() const
+{
+	return _startPos;
+}
+
+
+inline void ZipArchiveInfo64::setNumberOfEntries(Poco::UInt64 val)
+{
+	ZipUtil::set64BitValue(val, _rawInfo, NUMENTRIESTHISDISK_POS);
+}
+
+
+inline void ZipArchiveInfo64::setTotalNumberOfEntries(Poco::UInt64 val)
+{
+	ZipUtil::set64BitValue(val, _rawInfo, TOTALNUMENTRIES_POS);
+}
+
+
+inline void ZipArchiveInfo64::setCentralDirectorySize(Poco::UInt64 val)
+{
+	ZipUtil::set64BitValue(val, _rawInfo, CENTRALDIRSIZE_POS);
+}
+
+
+inline void ZipArchiveInfo64::setCentralDirectoryOffset(Poco::UInt64 val)
+{
+	ZipUtil::set64BitValue(val, _rawInfo, CENTRALDIRSTARTOFFSET_POS);
+}
+
+
+inline void ZipArchiveInfo64::setHeaderOffset(std::streamoff val)
+{
+	_startPos = val;
+}
+
+
 } } // namespace Poco::Zip
 
 
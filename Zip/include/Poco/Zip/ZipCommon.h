@@ -56,6 +56,16 @@ public:
 		HEADER_SIZE = 4
 	};
 
+	enum
+	{
+		ZIP64_EXTRA_ID = 0x0001,
+			/// Header ID of the ZIP64 extended information extra field
+		ZIP64_MAGIC_SHORT = 0xFFFF,
+			/// Stored in 16-bit fields whose value is in a ZIP64 record
+		ZIP64_MAGIC = 0xFFFFFFFF
+			/// Stored in 32-bit fields whose value is in a ZIP64 record
+	};
+
 	enum CompressionMethod
 	{
 		CM_STORE   = 0,
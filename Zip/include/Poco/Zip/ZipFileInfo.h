@@ -68,7 +68,7 @@ public:
 	~ZipFileInfo();
 		/// Destroys the ZipFileInfo.
 
-	Poco::UInt32 getRelativeOffsetOfLocalHeader() const;
+	Poco::UInt64 getRelativeOffsetOfLocalHeader() const;
 		/// Where on the disk starts the localheader. Combined with the disk number gives the exact location of the header
 
 	ZipCommon::CompressionMethod getCompressionMethod() const;
@@ -82,9 +82,9 @@ public:
 	Poco::UInt32 getHeaderSize() const;
 		/// Returns the total size of the header including filename + other additional fields
 
-	Poco::UInt32 getCompressedSize() const;
+	Poco::UInt64 getCompressedSize() const;
 
-	Poco::UInt32 getUncompressedSize() const;
+	Poco::UInt64 getUncompressedSize() const;
 
 	const std::string& getFileName() const;
 
@@ -114,14 +114,23 @@ public:
 
 	std::string createHeader() const;
 
-	void setOffset(Poco::UInt32 val);
+	void setOffset(Poco::UInt64 val);
+		/// Sets the offset of the local header. Values that do not
+		/// fit into 32 bits are stored in a ZIP64 extra field.
+
+	bool hasZip64Data() const;
+		/// Returns true if the entry has a ZIP64 extended information extra field.
 
 private:
 	void setCRC(Poco::UInt32 val);
 
-	void setCompressedSize(Poco::UInt32 val);
+	void setCompressedSize(Poco::UInt64 val);
+
+	void setUncompressedSize(Poco::UInt64 val);
 
-	void setUncompressedSize(Poco::UInt32 val);
+	void updateZip64Data();
+		/// Moves the sizes and the offset that do not fit into
+		/// 32 bits into the ZIP64 extra field.
 
 	void setCompressionMethod(ZipCommon::CompressionMethod cm);
 
@@ -137,6 +146,8 @@ private:
 
 	void setFileNameLength(Poco::UInt16 size);
 
+	void setExtraFieldLength(Poco::UInt16 size);
+
 	void setFileName(const std::string& str);
 	
 	void setExternalFileAttributes(Poco::UInt32 attrs);
@@ -208,8 +219,9 @@ private:
 
 	char           _rawInfo[FULLHEADER_SIZE];
 	Poco::UInt32   _crc32;
-	Poco::UInt32   _compressedSize;
-	Poco::UInt32   _uncompressedSize;
+	Poco::UInt64   _compressedSize;
+	Poco::UInt64   _uncompressedSize;
+	Poco::UInt64   _localHeaderOffset;
 	std::string    _fileName;
 	Poco::DateTime _lastModifiedAt;
 	std::string    _extraField;
@@ -217,9 +229,9 @@ private:
 };
 
 
-inline Poco::UInt32 ZipFileInfo::getRelativeOffsetOfLocalHeader() const
+inline Poco::UInt64 ZipFileInfo::getRelativeOffsetOfLocalHeader() const
 {
-	return ZipUtil::get32BitValue(_rawInfo, RELATIVEOFFSETLOCALHEADER_POS);
+	return _localHeaderOffset;
 }
 
 
@@ -272,13 +284,13 @@ inline Poco::UInt32 ZipFileInfo::getCRC() const
 }
 
 
-inline Poco::UInt32 ZipFileInfo::getCompressedSize() const
+inline Poco::UInt64 ZipFileInfo::getCompressedSize() const
 {
 	return _compressedSize;
 }
 
 
-inline Poco::UInt32 ZipFileInfo::getUncompressedSize() const
+inline Poco::UInt64 ZipFileInfo::getUncompressedSize() const
 {
 	return _uncompressedSize;
 }
@@ -390,23 +402,31 @@ inline void ZipFileInfo::setCRC(Poco::UInt32 val)
 }
 
 
-inline void ZipFileInfo::setOffset(Poco::UInt32 val)
+inline void ZipFileInfo::setOffset(Poco::UInt64 val)
 {
-	ZipUtil::set32BitValue(val, _rawInfo, RELATIVEOFFSETLOCALHEADER_POS);
+	_localHeaderOffset = val;
+	updateZip64Data();
 }
 
 
-inline void ZipFileInfo::setCompressedSize(Poco::UInt32 val)
+inline void ZipFileInfo::setCompressedSize(Poco::UInt64 val)
 {
 	_compressedSize = val;
-	ZipUtil::set32BitValue(val, _rawInfo, COMPRESSED_SIZE_POS);
+	updateZip64Data();
 }
 
 
-inline void ZipFileInfo::setUncompressedSize(Poco::UInt32 val)
+inline void ZipFileInfo::setUncompressedSize(Poco::UInt64 val)
 {
 	_uncompressedSize = val;
-	ZipUtil::set32BitValue(val, _rawInfo, UNCOMPRESSED_SIZE_POS);
+	updateZip64Data();
+}
+
+
+inline bool ZipFileInfo::hasZip64Data() const
+{
+	Poco::UInt16 length = 0;
+	return ZipUtil::findExtraField(_extraField, ZipCommon::ZIP64_EXTRA_ID, length) != std::string::npos;
 }
 
 
@@ -432,6 +452,12 @@ inline void ZipFileInfo::setFileNameLength(Poco::UInt16 size)
 }
 
 
+inline void ZipFileInfo::setExtraFieldLength(Poco::UInt16 size)
+{
+	ZipUtil::set16BitValue(size, _rawInfo, EXTRAFIELD_LENGTH_POS);
+}
+
+
 inline void ZipFileInfo::setHostSystem(ZipCommon::HostSystem hs)
 {
 	_rawInfo[VERSIONMADEBY_POS + 1] = static_cast<char>(hs);
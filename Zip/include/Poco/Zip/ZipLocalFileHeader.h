@@ -53,6 +53,7 @@ namespace Zip {
 
 
 class ParseCallback;
+class ZipFileInfo;
 
 
 class Zip_API ZipLocalFileHeader
@@ -70,6 +71,12 @@ public:
 		/// If assumeHeaderRead is true we assume that the first 4 bytes were already read outside.
 		/// If skipOverDataBlock is true we position the stream after the data block (either at the next FileHeader or the Directory Entry)
 
+	ZipLocalFileHeader(std::istream& inp, const ZipFileInfo& info);
+		/// Creates the ZipLocalFileHeader by parsing the local file header at the
+		/// current position of the stream, which must be positioned at the signature.
+		/// CRC and sizes are taken from the central directory entry, so the
+		/// data block is not read.
+
 	virtual ~ZipLocalFileHeader();
 		/// Destroys the ZipLocalFileHeader.
 
@@ -110,15 +117,29 @@ public:
 
 	Poco::UInt32 getCRC() const;
 
-	Poco::UInt32 getCompressedSize() const;
+	Poco::UInt64 getCompressedSize() const;
 
-	Poco::UInt32 getUncompressedSize() const;
+	Poco::UInt64 getUncompressedSize() const;
 
 	void setCRC(Poco::UInt32 val);
 
-	void setCompressedSize(Poco::UInt32 val);
+	void setCompressedSize(Poco::UInt64 val);
+		/// Sets the compressed size. Throws a ZipException if the size
+		/// does not fit into 32 bits and the header has no ZIP64 data.
+
+	void setUncompressedSize(Poco::UInt64 val);
+		/// Sets the uncompressed size. Throws a ZipException if the size
+		/// does not fit into 32 bits and the header has no ZIP64 data.
+
+	bool hasZip64Data() const;
+		/// Returns true if the header has a ZIP64 extended information extra field.
+		/// The sizes are then stored as 64-bit values, and the data descriptor
+		/// following the data, if any, is a ZipDataInfo64.
 
-	void setUncompressedSize(Poco::UInt32 val);
+	void setZip64Data();
+		/// Adds a ZIP64 extended information extra field to the header,
+		/// so that the sizes of the entry may exceed 4 GB.
+		/// Must be called before the header is written.
 
 	const std::string& getFileName() const;
 
@@ -174,6 +195,8 @@ private:
 
 	void setCompressionLevel(ZipCommon::CompressionLevel cl);
 
+	void updateZip64Data();
+
 private:
 	enum
 	{
@@ -201,6 +224,14 @@ private:
 		FULLHEADER_SIZE = 30
 	};
 
+	enum
+	{
+		ZIP64_UNCOMPRESSED_POS = 0,
+		ZIP64_COMPRESSED_POS = 8,
+		ZIP64_DATA_SIZE = 16
+			/// The ZIP64 extra field of a local header always stores both sizes.
+	};
+
 	char           _rawHeader[FULLHEADER_SIZE];
 	std::streamoff _startPos;
 	std::streamoff _endPos;
@@ -208,8 +239,9 @@ private:
 	Poco::DateTime _lastModifiedAt;
 	std::string    _extraField;
 	Poco::UInt32   _crc32;
-	Poco::UInt32   _compressedSize;
-	Poco::UInt32   _uncompressedSize;
+	Poco::UInt64   _compressedSize;
+	Poco::UInt64   _uncompressedSize;
+	bool           _zip64;
 };
 
 
@@ -380,36 +412,28 @@ inline Poco::UInt32 ZipLocalFileHeader::getCRC() const
 }
 
 
-inline Poco::UInt32 ZipLocalFileHeader::getCompressedSize() const
+inline Poco::UInt64 ZipLocalFileHeader::getCompressedSize() const
 {
 	return _compressedSize;
 }
 
 
-inline Poco::UInt32 ZipLocalFileHeader::getUncompressedSize() const
+inline Poco::UInt64 ZipLocalFileHeader::getUncompressedSize() const
 {
 	return _uncompressedSize;
 }
 
 
-inline void ZipLocalFileHeader::setCRC(Poco::UInt32 val)
-{
-	_crc32 = val;
-	ZipUtil::set32BitValue(val, _rawHeader, CRC32_POS);
-}
-
-
-inline void ZipLocalFileHeader::setCompressedSize(Poco::UInt32 val)
+inline bool ZipLocalFileHeader::hasZip64Data() const
 {
-	_compressedSize = val;
-	ZipUtil::set32BitValue(val, _rawHeader, COMPRESSEDSIZE_POS);
+	return _zip64;
 }
 
 
-inline void ZipLocalFileHeader::setUncompressedSize(Poco::UInt32 val)
+inline void ZipLocalFileHeader::setCRC(Poco::UInt32 val)
 {
-	_uncompressedSize = val;
-	ZipUtil::set32BitValue(val, _rawHeader, UNCOMPRESSEDSIZE_POS);
+	_crc32 = val;
+	ZipUtil::set32BitValue(val, _rawHeader, CRC32_POS);
 }
 
 
@@ -82,6 +82,8 @@ protected:
 	int writeToDevice(const char* buffer, std::streamsize length);
 
 private:
+	void putbackHeader(const char* rawHeader, Poco::UInt32 size);
+
 	enum
 	{
 		STREAM_BUFFER_SIZE = 1024
@@ -99,7 +101,9 @@ private:
 	Poco::UInt32   _expectedCrc32;
 	bool           _checkCRC;
 		/// Note: we do not check crc if we decompress a streaming zip file and the crc is stored in the directory header
-	Poco::UInt32   _bytesWritten;
+	bool           _zip64;
+		/// The data descriptor, if any, has 64-bit sizes
+	Poco::UInt64   _bytesWritten;
 	ZipLocalFileHeader* _pHeader;
 };
 
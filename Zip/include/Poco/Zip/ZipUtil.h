@@ -59,10 +59,22 @@ public:
 
 	static Poco::UInt32 get32BitValue(const char* pVal, const Poco::UInt32 pos);
 
+	static Poco::UInt64 get64BitValue(const char* pVal, const Poco::UInt32 pos);
+
 	static void set16BitValue(const Poco::UInt16 val, char* pVal, const Poco::UInt32 pos);
 
 	static void set32BitValue(const Poco::UInt32 val, char* pVal, const Poco::UInt32 pos);
 
+	static void set64BitValue(const Poco::UInt64 val, char* pVal, const Poco::UInt32 pos);
+
+	static std::string::size_type findExtraField(const std::string& extraField, Poco::UInt16 id, Poco::UInt16& length);
+		/// Searches the extra field of a header for the record with the given header ID.
+		/// Returns the position of the record data and stores its length in length,
+		/// or returns std::string::npos if there is no such record.
+
+	static std::string removeExtraField(const std::string& extraField, Poco::UInt16 id);
+		/// Returns the extra field without the records with the given header ID.
+
 	static Poco::DateTime parseDateTime(const char* pVal, const Poco::UInt32 timePos, const Poco::UInt32 datePos);
 
 	static void setDateTime(const Poco::DateTime& dt, char* pVal, const Poco::UInt32 timePos, const Poco::UInt32 datePos);
@@ -98,6 +110,12 @@ inline Poco::UInt32 ZipUtil::get32BitValue(const char* pVal, const Poco::UInt32
 }
 
 
+inline Poco::UInt64 ZipUtil::get64BitValue(const char* pVal, const Poco::UInt32 pos)
+{
+	return static_cast<Poco::UInt64>(get32BitValue(pVal, pos)) + (static_cast<Poco::UInt64>(get32BitValue(pVal, pos+4)) << 32);
+}
+
+
 inline void ZipUtil::set16BitValue(const Poco::UInt16 val, char* pVal, const Poco::UInt32 pos)
 {
 	pVal[pos] = static_cast<char>(val);
@@ -114,6 +132,13 @@ inline void ZipUtil::set32BitValue(const Poco::UInt32 val, char* pVal, const Poc
 }
 
 
+inline void ZipUtil::set64BitValue(const Poco::UInt64 val, char* pVal, const Poco::UInt32 pos)
+{
+	set32BitValue(static_cast<Poco::UInt32>(val), pVal, pos);
+	set32BitValue(static_cast<Poco::UInt32>(val >> 32), pVal, pos+4);
+}
+
+
 } } // namespace Poco::Zip
 
 
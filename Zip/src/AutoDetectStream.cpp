@@ -47,7 +47,7 @@ namespace Poco {
 namespace Zip {
 
 
-AutoDetectStreamBuf::AutoDetectStreamBuf(std::istream& in, const std::string& pre, const std::string& post, bool reposition, Poco::UInt32 start):
+AutoDetectStreamBuf::AutoDetectStreamBuf(std::istream& in, const std::string& pre, const std::string& post, bool reposition, std::streamoff start):
 	Poco::BufferedStreamBuf(STREAM_BUFFER_SIZE, std::ios::in),
 	_pIstr(&in),
 	_pOstr(0),
@@ -70,7 +70,7 @@ AutoDetectStreamBuf::AutoDetectStreamBuf(std::ostream& out):
 	_prefix(),
 	_postfix(),
 	_reposition(false),
-	_start(0u)
+	_start(0)
 {
 }
 
@@ -201,7 +201,7 @@ int AutoDetectStreamBuf::writeToDevice(const char* buffer, std::streamsize lengt
 }
 
 
-AutoDetectIOS::AutoDetectIOS(std::istream& istr, const std::string& pre, const std::string& post, bool reposition, Poco::UInt32 start):
+AutoDetectIOS::AutoDetectIOS(std::istream& istr, const std::string& pre, const std::string& post, bool reposition, std::streamoff start):
 	_buf(istr, pre, post, reposition, start)
 {
 	poco_ios_init(&_buf);
@@ -225,7 +225,7 @@ AutoDetectStreamBuf* AutoDetectIOS::rdbuf()
 }
 
 
-AutoDetectInputStream::AutoDetectInputStream(std::istream& istr, const std::string& pre, const std::string& post, bool reposition, Poco::UInt32 start):
+AutoDetectInputStream::AutoDetectInputStream(std::istream& istr, const std::string& pre, const std::string& post, bool reposition, std::streamoff start):
 	AutoDetectIOS(istr, pre, post, reposition, start),
 	std::istream(&_buf)
 {
@@ -43,48 +43,148 @@
 #include "Poco/StreamCopier.h"
 #include "Poco/File.h"
 #include "Poco/FileStream.h"
+#include "Poco/TemporaryFile.h"
+#include "Poco/Exception.h"
+#include <sstream>
 
 
 namespace Poco {
 namespace Zip {
 
 
+namespace
+{
+	std::streamoff dataDescriptorSize(const ZipLocalFileHeader& hdr)
+	{
+		if (!hdr.searchCRCAndSizesAfterData())
+			return 0;
+		else if (hdr.hasZip64Data())
+			return ZipDataInfo64::getFullHeaderSize();
+		else
+			return ZipDataInfo::getFullHeaderSize();
+	}
+}
+
+
+class Compress::Job
+	/// An entry that is compressed in the background.
+	/// The compressed entry, including its local header,
+	/// is written to a buffer that is copied to the archive.
+{
+public:
+	Job(const Poco::Path& file, const Poco::DateTime& lastModifiedAt, const Poco::Path& fileName, ZipCommon::CompressionMethod cm, ZipCommon::CompressionLevel cl, bool zip64):
+		file(file),
+		fileName(fileName),
+		header(fileName, lastModifiedAt, cm, cl),
+		done(false)
+	{
+		if (zip64) header.setZip64Data();
+		header.setStartPos(0);
+	}
+
+	void compress()
+	{
+		try
+		{
+			Poco::File aFile(file);
+			if (aFile.getSize() > TEMP_FILE_THRESHOLD)
+			{
+				pTempFile = new Poco::TemporaryFile;
+				pData = new Poco::FileStream(pTempFile->path(), std::ios::in | std::ios::out | std::ios::trunc);
+			}
+			else
+			{
+				pData = new std::stringstream(std::ios::in | std::ios::out | std::ios::binary);
+			}
+			Poco::FileInputStream in(file.toString());
+			ZipOutputStream zipOut(*pData, header, true);
+			Poco::StreamCopier::copyStream(in, zipOut, COMPRESS_CHUNK_SIZE);
+			zipOut.close();
+			if (!*pData) throw Poco::WriteFileException("Cannot buffer compressed data of " + file.toString());
+		}
+		catch (Poco::Exception& exc)
+		{
+			pException = exc.clone();
+		}
+		catch (std::exception& exc)
+		{
+			pException = new Poco::Exception(exc.what());
+		}
+	}
+
+	Poco::Path file;
+	Poco::Path fileName;
+	ZipLocalFileHeader header;
+	Poco::SharedPtr<std::iostream> pData;
+	Poco::SharedPtr<Poco::TemporaryFile> pTempFile;
+	Poco::SharedPtr<Poco::Exception> pException;
+	bool done;
+};
+
+
 Compress::Compress(std::ostream& out, bool seekableOut):
 	_out(out),
 	_seekableOut(seekableOut),
 	_files(),
 	_infos(),
 	_dirs(),
-	_offset(0)
+	_dirs64(),
+	_offset(0),
+	_zip64(false),
+	_threadCount(0),
+	_stop(false),
+	_runnable(*this, &Compress::run)
+{
+}
+
+
+Compress::Compress(std::ostream& out, bool seekableOut, int threads):
+	_out(out),
+	_seekableOut(seekableOut),
+	_files(),
+	_infos(),
+	_dirs(),
+	_dirs64(),
+	_offset(0),
+	_zip64(false),
+	_threadCount(threads > 1 ? threads : 0),
+	_stop(false),
+	_runnable(*this, &Compress::run)
 {
 }
 
 
 Compress::~Compress()
 {
+	try
+	{
+		stopThreads();
+	}
+	catch (...)
+	{
+	}
 }
 
 
-void Compress::addEntry(std::istream& in, const Poco::DateTime& lastModifiedAt, const Poco::Path& fileName, ZipCommon::CompressionMethod cm, ZipCommon::CompressionLevel cl)
+void Compress::addEntry(std::istream& in, const Poco::DateTime& lastModifiedAt, const Poco::Path& fileName, ZipCommon::CompressionMethod cm, ZipCommon::CompressionLevel cl, bool zip64)
 {
 	std::string fn = ZipUtil::validZipEntryFileName(fileName);
+	writeJobs(0);
 
-	if (_files.size() >= 65535)
-		throw ZipException("Maximum number of entries for a ZIP file reached: 65535");
 	if (!in.good())
 		throw ZipException("Invalid input stream");
 
 	std::streamoff localHeaderOffset = _offset;
 	ZipLocalFileHeader hdr(fileName, lastModifiedAt, cm, cl);
+	if (zip64 || _zip64)
+		hdr.setZip64Data();
 	hdr.setStartPos(localHeaderOffset);
 
 	ZipOutputStream zipOut(_out, hdr, _seekableOut);
 	Poco::StreamCopier::copyStream(in, zipOut);
 	zipOut.close();
 	hdr.setStartPos(localHeaderOffset); // reset again now that compressed Size is known
-	_offset = hdr.getEndPos();
-	if (hdr.searchCRCAndSizesAfterData())
-		_offset += ZipDataInfo::getFullHeaderSize();
+	_offset = hdr.getEndPos() + dataDescriptorSize(hdr);
 	_files.insert(std::make_pair(fileName.toString(Poco::Path::PATH_UNIX), hdr));
 	poco_assert (_out);
 	ZipFileInfo nfo(hdr);
@@ -97,11 +197,10 @@ void Compress::addEntry(std::istream& in, const Poco::DateTime& lastModifiedAt,
 void Compress::addFileRaw(std::istream& in, const ZipLocalFileHeader& h, const Poco::Path& fileName)
 {
 	std::string fn = ZipUtil::validZipEntryFileName(fileName);
+	writeJobs(0);
 	//bypass the header of the input stream and point to the first byte of the data payload
 	in.seekg(h.getDataStartPos(), std::ios_base::beg);
 
-	if (_files.size() >= 65535)
-		throw ZipException("Maximum number of entries for a ZIP file reached: 65535");
 	if (!in.good())
 		throw ZipException("Invalid input stream");
 
@@ -114,11 +213,11 @@ void Compress::addFileRaw(std::istream& in, const ZipLocalFileHeader& h, const P
 	std::string header = hdr.createHeader();
 	_out.write(header.c_str(), static_cast<std::streamsize>(header.size()));
 	// now fwd the payload to _out in chunks of size CHUNKSIZE
-	Poco::UInt32 totalSize = hdr.getCompressedSize();
+	Poco::UInt64 totalSize = hdr.getCompressedSize();
 	if (totalSize > 0)
 	{
 		Poco::Buffer<char> buffer(COMPRESS_CHUNK_SIZE);
-		Poco::UInt32 remaining = totalSize;
+		Poco::UInt64 remaining = totalSize;
 		while(remaining > 0)
 		{
 			if (remaining > COMPRESS_CHUNK_SIZE)
@@ -131,7 +230,7 @@ void Compress::addFileRaw(std::istream& in, const ZipLocalFileHeader& h, const P
 			}
 			else
 			{
-				in.read(buffer.begin(), remaining);
+				in.read(buffer.begin(), static_cast<std::streamsize>(remaining));
 				std::streamsize n = in.gcount();
 				poco_assert_dbg (n == remaining);
 				_out.write(buffer.begin(), n);
@@ -142,13 +241,19 @@ void Compress::addFileRaw(std::istream& in, const ZipLocalFileHeader& h, const P
 	//write optional block afterwards
 	if (hdr.searchCRCAndSizesAfterData())
 	{
-		ZipDataInfo info(in, false);
-		_out.write(info.getRawHeader(), static_cast<std::streamsize>(info.getFullHeaderSize()));
+		if (hdr.hasZip64Data())
+		{
+			ZipDataInfo64 info(in, false);
+			_out.write(info.getRawHeader(), static_cast<std::streamsize>(info.getFullHeaderSize()));
+		}
+		else
+		{
+			ZipDataInfo info(in, false);
+			_out.write(info.getRawHeader(), static_cast<std::streamsize>(info.getFullHeaderSize()));
+		}
 	}
 	hdr.setStartPos(localHeaderOffset); // reset again now that compressed Size is known
-	_offset = hdr.getEndPos();
-	if (hdr.searchCRCAndSizesAfterData())
-		_offset += ZipDataInfo::getFullHeaderSize();
+	_offset = hdr.getEndPos() + dataDescriptorSize(hdr);
 	_files.insert(std::make_pair(fileName.toString(Poco::Path::PATH_UNIX), hdr));
 	poco_assert (_out);
 	ZipFileInfo nfo(hdr);
@@ -173,14 +278,30 @@ void Compress::addFile(std::istream& in, const Poco::DateTime& lastModifiedAt, c
 
 void Compress::addFile(const Poco::Path& file, const Poco::Path& fileName, ZipCommon::CompressionMethod cm, ZipCommon::CompressionLevel cl)
 {
+	if (!fileName.isFile())
+		throw ZipException("Not a file: "+ fileName.toString());
+
 	Poco::File aFile(file);
-	Poco::FileInputStream in(file.toString());
+	bool zip64 = aFile.getSize() >= ZIP64_FILE_THRESHOLD;
+	if (_threadCount == 0)
+	{
+		Poco::FileInputStream in(file.toString());
+		if (fileName.depth() > 1)
+		{
+			Poco::File aParent(file.parent());
+			addDirectory(fileName.parent(), aParent.getLastModified());
+		}
+		addEntry(in, aFile.getLastModified(), fileName, cm, cl, zip64);
+		return;
+	}
+
+	ZipUtil::validZipEntryFileName(fileName);
 	if (fileName.depth() > 1)
 	{
 		Poco::File aParent(file.parent());
 		addDirectory(fileName.parent(), aParent.getLastModified());
 	}
-	addFile(in, aFile.getLastModified(), fileName, cm, cl);
+	enqueue(new Job(file, aFile.getLastModified(), fileName, cm, cl, zip64 || _zip64));
 }
 
 
@@ -190,10 +311,8 @@ void Compress::addDirectory(const Poco::Path& entryName, const Poco::DateTime& l
 		throw ZipException("Not a directory: "+ entryName.toString());
 
 	std::string fileStr = entryName.toString(Poco::Path::PATH_UNIX);
-	if (_files.find(fileStr) != _files.end())
+	if (_files.find(fileStr) != _files.end() || isPending(fileStr))
 		return; // ignore duplicate add
-	if (_files.size() >= 65535)
-		throw ZipException("Maximum number of entries for a ZIP file reached: 65535");
 	if (fileStr == "/")
 		throw ZipException("Illegal entry name /");
 	if (fileStr.empty())
@@ -206,6 +325,19 @@ void Compress::addDirectory(const Poco::Path& entryName, const Poco::DateTime& l
 		addDirectory(entryName.parent(), lastModifiedAt);
 	}
 
+	if (_threadCount > 0)
+	{
+		// a directory has no data, so the entry is built right away
+		JobPtr pJob = new Job(Poco::Path(), lastModifiedAt, entryName, ZipCommon::CM_STORE, ZipCommon::CL_NORMAL, false);
+		pJob->pData = new std::stringstream(std::ios::in | std::ios::out | std::ios::binary);
+		ZipOutputStream zipOut(*pJob->pData, pJob->header, true);
+		zipOut.close();
+		pJob->done = true;
+		Poco::Mutex::ScopedLock lock(_mutex);
+		_jobs.push_back(pJob);
+		return;
+	}
+
 	std::streamoff localHeaderOffset = _offset;
 	ZipCommon::CompressionMethod cm = ZipCommon::CM_STORE;
 	ZipCommon::CompressionLevel cl = ZipCommon::CL_NORMAL;
@@ -214,9 +346,7 @@ void Compress::addDirectory(const Poco::Path& entryName, const Poco::DateTime& l
 	ZipOutputStream zipOut(_out, hdr, _seekableOut);
 	zipOut.close();
 	hdr.setStartPos(localHeaderOffset); // reset again now that compressed Size is known
-	_offset = hdr.getEndPos();
-	if (hdr.searchCRCAndSizesAfterData())
-		_offset += ZipDataInfo::getFullHeaderSize();
+	_offset = hdr.getEndPos() + dataDescriptorSize(hdr);
 	_files.insert(std::make_pair(entryName.toString(Poco::Path::PATH_UNIX), hdr));
 	poco_assert (_out);
 	ZipFileInfo nfo(hdr);
@@ -281,12 +411,14 @@ void Compress::addRecursive(const Poco::Path& entry, ZipCommon::CompressionMetho
 ZipArchive Compress::close()
 {
 	if (!_dirs.empty())
-		return ZipArchive(_files, _infos, _dirs);
+		return ZipArchive(_files, _infos, _dirs, _dirs64);
+
+	writeJobs(0);
+	stopThreads();
 
 	poco_assert (_infos.size() == _files.size());
-	poco_assert (_files.size() < 65536);
-	Poco::UInt32 centralDirStart = _offset;
-	Poco::UInt32 centralDirSize = 0;
+	Poco::UInt64 centralDirStart = _offset;
+	Poco::UInt64 centralDirSize = 0;
 	// write all infos
 	ZipArchive::FileInfos::const_iterator it = _infos.begin();
 	ZipArchive::FileInfos::const_iterator itEnd = _infos.end();
@@ -302,12 +434,27 @@ ZipArchive Compress::close()
 	poco_assert (_out);
 
 	
-	Poco::UInt16 numEntries = static_cast<Poco::UInt16>(_infos.size());
+	Poco::UInt64 numEntries = _infos.size();
+	if (_zip64 || numEntries >= ZipCommon::ZIP64_MAGIC_SHORT || centralDirStart >= ZipCommon::ZIP64_MAGIC || centralDirSize >= ZipCommon::ZIP64_MAGIC)
+	{
+		// values that do not fit into the end of central directory record
+		// are stored in the ZIP64 record in front of it
+		ZipArchiveInfo64 central64;
+		central64.setCentralDirectorySize(centralDirSize);
+		central64.setNumberOfEntries(numEntries);
+		central64.setTotalNumberOfEntries(numEntries);
+		central64.setCentralDirectoryOffset(centralDirStart);
+		central64.setHeaderOffset(_offset);
+		std::string centr64(central64.createHeader());
+		_out.write(centr64.c_str(), static_cast<std::streamsize>(centr64.size()));
+		_offset += centr64.size();
+		_dirs64.insert(std::make_pair(0, central64));
+	}
 	ZipArchiveInfo central;
-	central.setCentralDirectorySize(centralDirSize);
-	central.setNumberOfEntries(numEntries);
-	central.setTotalNumberOfEntries(numEntries);
-	central.setHeaderOffset(centralDirStart);
+	central.setCentralDirectorySize(centralDirSize < ZipCommon::ZIP64_MAGIC ? static_cast<Poco::UInt32>(centralDirSize) : static_cast<Poco::UInt32>(ZipCommon::ZIP64_MAGIC));
+	central.setNumberOfEntries(numEntries < ZipCommon::ZIP64_MAGIC_SHORT ? static_cast<Poco::UInt16>(numEntries) : static_cast<Poco::UInt16>(ZipCommon::ZIP64_MAGIC_SHORT));
+	central.setTotalNumberOfEntries(numEntries < ZipCommon::ZIP64_MAGIC_SHORT ? static_cast<Poco::UInt16>(numEntries) : static_cast<Poco::UInt16>(ZipCommon::ZIP64_MAGIC_SHORT));
+	central.setHeaderOffset(centralDirStart < ZipCommon::ZIP64_MAGIC ? static_cast<Poco::UInt32>(centralDirStart) : static_cast<Poco::UInt32>(ZipCommon::ZIP64_MAGIC));
 	if (!_comment.empty() && _comment.size() <= 65535)
 	{
 		central.setZipComment(_comment);
@@ -316,7 +463,126 @@ ZipArchive Compress::close()
 	_out.write(centr.c_str(), static_cast<std::streamsize>(centr.size()));
 	_out.flush();
 	_dirs.insert(std::make_pair(0, central));
-	return ZipArchive(_files, _infos, _dirs);
+	return ZipArchive(_files, _infos, _dirs, _dirs64);
+}
+
+
+bool Compress::isPending(const std::string& fileName) const
+{
+	for (std::deque<JobPtr>::const_iterator it = _jobs.begin(); it != _jobs.end(); ++it)
+	{
+		if ((*it)->fileName.toString(Poco::Path::PATH_UNIX) == fileName)
+			return true;
+	}
+	return false;
+}
+
+
+void Compress::enqueue(JobPtr pJob)
+{
+	if (_threads.empty())
+	{
+		for (std::size_t i = 0; i < _threadCount; ++i)
+		{
+			Poco::SharedPtr<Poco::Thread> pThread = new Poco::Thread;
+			pThread->start(_runnable);
+			_threads.push_back(pThread);
+		}
+	}
+
+	{
+		Poco::Mutex::ScopedLock lock(_mutex);
+		_jobs.push_back(pJob);
+		_queue.push_back(pJob);
+		_changed.broadcast();
+	}
+	// keep the threads busy, but bound the memory used by finished entries
+	writeJobs(2*_threadCount);
+}
+
+
+void Compress::writeJobs(std::size_t maxPending)
+{
+	for (;;)
+	{
+		JobPtr pJob;
+		{
+			Poco::Mutex::ScopedLock lock(_mutex);
+			while (!_jobs.empty() && !_jobs.front()->done && _jobs.size() > maxPending)
+			{
+				_changed.wait(_mutex);
+			}
+			if (_jobs.empty() || !_jobs.front()->done) return;
+
+			pJob = _jobs.front();
+			_jobs.pop_front();
+		}
+		writeJob(*pJob);
+	}
+}
+
+
+void Compress::writeJob(Job& job)
+{
+	if (job.pException) job.pException->rethrow();
+
+	std::streamoff localHeaderOffset = _offset;
+	job.pData->seekg(0);
+	Poco::StreamCopier::copyStream(*job.pData, _out, COMPRESS_CHUNK_SIZE);
+	poco_assert (_out);
+	job.pData = 0;
+	job.pTempFile = 0;
+
+	ZipLocalFileHeader& hdr = job.header;
+	hdr.setStartPos(localHeaderOffset);
+	_offset = hdr.getEndPos();
+	_files.insert(std::make_pair(job.fileName.toString(Poco::Path::PATH_UNIX), hdr));
+	ZipFileInfo nfo(hdr);
+	nfo.setOffset(localHeaderOffset);
+	_infos.insert(std::make_pair(job.fileName.toString(Poco::Path::PATH_UNIX), nfo));
+	EDone.notify(this, hdr);
+}
+
+
+void Compress::stopThreads()
+{
+	{
+		Poco::Mutex::ScopedLock lock(_mutex);
+		_stop = true;
+		_changed.broadcast();
+	}
+	for (std::vector<Poco::SharedPtr<Poco::Thread> >::iterator it = _threads.begin(); it != _threads.end(); ++it)
+	{
+		(*it)->join();
+	}
+	_threads.clear();
+	_stop = false;
+}
+
+
+void Compress::run()
+{
+	for (;;)
+	{
+		JobPtr pJob;
+		{
+			Poco::Mutex::ScopedLock lock(_mutex);
+			while (_queue.empty() && !_stop)
+			{
+				_changed.wait(_mutex);
+			}
+			if (_queue.empty()) return;
+
+			pJob = _queue.front();
+			_queue.pop_front();
+		}
+
+		pJob->compress();
+
+		Poco::Mutex::ScopedLock lock(_mutex);
+		pJob->done = true;
+		_changed.broadcast();
+	}
 }
 
 
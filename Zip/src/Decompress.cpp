@@ -44,18 +44,32 @@
 #include "Poco/StreamCopier.h"
 #include "Poco/Delegate.h"
 #include "Poco/FileStream.h"
+#include <algorithm>
 
 
 namespace Poco {
 namespace Zip {
 
 
+namespace
+{
+	bool lessStartPos(const ZipLocalFileHeader* pLeft, const ZipLocalFileHeader* pRight)
+	{
+		return pLeft->getStartPos() < pRight->getStartPos();
+	}
+}
+
+
 Decompress::Decompress(std::istream& in, const Poco::Path& outputDir, bool flattenDirs, bool keepIncompleteFiles):
+	_pFile(),
 	_in(in),
+	_zipFile(),
 	_outDir(outputDir),
 	_flattenDirs(flattenDirs),
 	_keepIncompleteFiles(keepIncompleteFiles),
-	_mapping()
+	_mapping(),
+	_next(0),
+	_runnable(*this, &Decompress::run)
 {
 	_outDir.makeAbsolute();
 	_outDir.makeDirectory();
@@ -72,6 +86,31 @@ Decompress::Decompress(std::istream& in, const Poco::Path& outputDir, bool flatt
 }
 
 
+Decompress::Decompress(const std::string& zipFile, const Poco::Path& outputDir, bool flattenDirs, bool keepIncompleteFiles):
+	_pFile(new Poco::FileInputStream(zipFile)),
+	_in(*_pFile),
+	_zipFile(zipFile),
+	_outDir(outputDir),
+	_flattenDirs(flattenDirs),
+	_keepIncompleteFiles(keepIncompleteFiles),
+	_mapping(),
+	_next(0),
+	_runnable(*this, &Decompress::run)
+{
+	_outDir.makeAbsolute();
+	_outDir.makeDirectory();
+	poco_assert (_in.good());
+	Poco::File tmp(_outDir);
+	if (!tmp.exists())
+	{
+		tmp.createDirectories();
+	}
+	if (!tmp.isDirectory())
+		throw Poco::IOException("Failed to create/open directory: " + _outDir.toString());
+	EOk += Poco::Delegate<Decompress, std::pair<const ZipLocalFileHeader, const Poco::Path> >(this, &Decompress::onOk);
+}
+
+
 Decompress::~Decompress()
 {
 	EOk -= Poco::Delegate<Decompress, std::pair<const ZipLocalFileHeader, const Poco::Path> >(this, &Decompress::onOk);
@@ -86,7 +125,76 @@ ZipArchive Decompress::decompressAllFiles()
 }
 
 
+ZipArchive Decompress::decompressAllFiles(int threads)
+{
+	poco_assert (_mapping.empty());
+	if (threads <= 1 || _zipFile.empty())
+		return decompressAllFiles();
+
+	ZipArchive arch(_in);
+	for (ZipArchive::FileHeaders::const_iterator it = arch.headerBegin(); it != arch.headerEnd(); ++it)
+	{
+		if (it->second.isDirectory())
+			extract(_in, it->second, true);
+		else
+			_pending.push_back(&it->second);
+	}
+	// reading each thread's share of the file front to back is faster than random seeks
+	std::sort(_pending.begin(), _pending.end(), lessStartPos);
+
+	std::vector<Poco::SharedPtr<Poco::Thread> > workers;
+	for (int i = 0; i < threads; ++i)
+	{
+		Poco::SharedPtr<Poco::Thread> pThread = new Poco::Thread;
+		pThread->start(_runnable);
+		workers.push_back(pThread);
+	}
+	for (std::vector<Poco::SharedPtr<Poco::Thread> >::iterator it = workers.begin(); it != workers.end(); ++it)
+	{
+		(*it)->join();
+	}
+	// entries left over if no worker could open the file
+	for (; _next < _pending.size(); ++_next)
+	{
+		reportError(*_pending[_next], "Failed to open " + _zipFile);
+	}
+	_pending.clear();
+	return arch;
+}
+
+
+void Decompress::run()
+{
+	Poco::SharedPtr<std::istream> pIn;
+	try
+	{
+		pIn = new Poco::FileInputStream(_zipFile);
+	}
+	catch (Poco::Exception&)
+	{
+		return;
+	}
+	for (;;)
+	{
+		const ZipLocalFileHeader* pHdr = 0;
+		{
+			Poco::FastMutex::ScopedLock lock(_mutex);
+			if (_next == _pending.size()) return;
+			pHdr = _pending[_next++];
+		}
+		pIn->clear();
+		extract(*pIn, *pHdr, true);
+	}
+}
+
+
 bool Decompress::handleZipEntry(std::istream& zipStream, const ZipLocalFileHeader& hdr)
+{
+	return extract(zipStream, hdr, false);
+}
+
+
+bool Decompress::extract(std::istream& zipStream, const ZipLocalFileHeader& hdr, bool reposition)
 {
 	if (hdr.isDirectory())
 	{
@@ -124,17 +232,17 @@ bool Decompress::handleZipEntry(std::istream& zipStream, const ZipLocalFileHeade
 		if (dest.depth() > 0)
 		{
 			Poco::File aFile(dest.parent());
+			Poco::FastMutex::ScopedLock lock(_mutex);
 			aFile.createDirectories();
 		}
 		Poco::FileOutputStream out(dest.toString());
-		ZipInputStream inp(zipStream, hdr, false);
+		ZipInputStream inp(zipStream, hdr, reposition);
 		Poco::StreamCopier::copyStream(inp, out);
 		out.close();
 		Poco::File aFile(dest.toString());
 		if (!aFile.exists() || !aFile.isFile())
 		{
-			std::pair<const ZipLocalFileHeader, const std::string> tmp = std::make_pair(hdr, "Failed to create output stream " + dest.toString());
-			EError.notify(this, tmp);
+			reportError(hdr, "Failed to create output stream " + dest.toString());
 			return false;
 		}
 
@@ -142,8 +250,7 @@ bool Decompress::handleZipEntry(std::istream& zipStream, const ZipLocalFileHeade
 		{
 			if (!_keepIncompleteFiles)
 				aFile.remove();
-			std::pair<const ZipLocalFileHeader, const std::string> tmp = std::make_pair(hdr, "CRC mismatch. Corrupt file: " + dest.toString());
-			EError.notify(this, tmp);
+			reportError(hdr, "CRC mismatch. Corrupt file: " + dest.toString());
 			return false;
 		}
 
@@ -153,24 +260,20 @@ bool Decompress::handleZipEntry(std::istream& zipStream, const ZipLocalFileHeade
 		{
 			if (!_keepIncompleteFiles)
 				aFile.remove();
-			std::pair<const ZipLocalFileHeader, const std::string> tmp = std::make_pair(hdr, "Filesizes do not match. Corrupt file: " + dest.toString());
-			EError.notify(this, tmp);
+			reportError(hdr, "Filesizes do not match. Corrupt file: " + dest.toString());
 			return false;
 		}
 
-		std::pair<const ZipLocalFileHeader, const Poco::Path> tmp = std::make_pair(hdr, file);
-		EOk.notify(this, tmp);
+		reportOk(hdr, file);
 	}
 	catch (Poco::Exception& e)
 	{
-		std::pair<const ZipLocalFileHeader, const std::string> tmp = std::make_pair(hdr, std::string("Exception: " + e.displayText()));
-		EError.notify(this, tmp);
+		reportError(hdr, std::string("Exception: " + e.displayText()));
 		return false;
 	}
 	catch (...)
 	{
-		std::pair<const ZipLocalFileHeader, const std::string> tmp = std::make_pair(hdr, std::string("Unknown Exception"));
-		EError.notify(this, tmp);
+		reportError(hdr, std::string("Unknown Exception"));
 		return false;
 	}
 
@@ -178,6 +281,22 @@ bool Decompress::handleZipEntry(std::istream& zipStream, const ZipLocalFileHeade
 }
 
 
+void Decompress::reportError(const ZipLocalFileHeader& hdr, const std::string& message)
+{
+	Poco::FastMutex::ScopedLock lock(_eventMutex);
+	std::pair<const ZipLocalFileHeader, const std::string> tmp = std::make_pair(hdr, message);
+	EError.notify(this, tmp);
+}
+
+
+void Decompress::reportOk(const ZipLocalFileHeader& hdr, const Poco::Path& file)
+{
+	Poco::FastMutex::ScopedLock lock(_eventMutex);
+	std::pair<const ZipLocalFileHeader, const Poco::Path> tmp = std::make_pair(hdr, file);
+	EOk.notify(this, tmp);
+}
+
+
 void Decompress::onOk(const void*, std::pair<const ZipLocalFileHeader, const Poco::Path>& val)
 {
 	_mapping.insert(std::make_pair(val.first.getFileName(), val.second));
@@ -37,6 +37,7 @@
 #include "Poco/Zip/ZipArchive.h"
 #include "Poco/Zip/SkipCallback.h"
 #include "Poco/Exception.h"
+#include "Poco/Buffer.h"
 #include <cstring>
 
 
@@ -44,21 +45,48 @@ namespace Poco {
 namespace Zip {
 
 
+namespace
+{
+	enum
+	{
+		END_OF_DIRECTORY_COMMENT_LENGTH_POS = 20,
+		END_OF_DIRECTORY_SIZE = 22,
+		ZIP64_LOCATOR_OFFSET_POS = 8,
+		ZIP64_LOCATOR_SIZE = 20
+	};
+}
+
+
 ZipArchive::ZipArchive(std::istream& in):
 	_entries(),
 	_infos(),
-	_disks()
+	_disks(),
+	_disks64()
 {
 	poco_assert_dbg (in);
-	SkipCallback skip;
-	parse(in, skip);
+	std::streamoff start = in.tellg();
+	if (start < 0 || !parseDirectory(in))
+	{
+		if (start >= 0)
+		{
+			_entries.clear();
+			_infos.clear();
+			_disks.clear();
+			_disks64.clear();
+			in.clear();
+			in.seekg(start);
+		}
+		SkipCallback skip;
+		parse(in, skip);
+	}
 }
 
 
-ZipArchive::ZipArchive(const FileHeaders& entries, const FileInfos& infos, const DirectoryInfos& dirs):
+ZipArchive::ZipArchive(const FileHeaders& entries, const FileInfos& infos, const DirectoryInfos& dirs, const DirectoryInfos64& dirs64):
 	_entries(entries),
 	_infos(infos),
-	_disks(dirs)
+	_disks(dirs),
+	_disks64(dirs64)
 {
 }
 
@@ -66,7 +94,8 @@ ZipArchive::ZipArchive(const FileHeaders& entries, const FileInfos& infos, const
 ZipArchive::ZipArchive(std::istream& in, ParseCallback& pc):
 	_entries(),
 	_infos(),
-	_disks()
+	_disks(),
+	_disks64()
 {
 	poco_assert_dbg (in);
 	parse(in, pc);
@@ -107,6 +136,11 @@ void ZipArchive::parse(std::istream& in, ParseCallback& pc)
 			ZipArchiveInfo nfo(in, true);
 			poco_assert (_disks.insert(std::make_pair(nfo.getDiskNumber(), nfo)).second);
 		}
+		else if (std::memcmp(header, ZipArchiveInfo64::HEADER, ZipCommon::HEADER_SIZE) == 0)
+		{
+			ZipArchiveInfo64 nfo(in, true);
+			poco_assert (_disks64.insert(std::make_pair(nfo.getDiskNumber(), nfo)).second);
+		}
 		else
 		{
 			if (_disks.empty())
@@ -118,6 +152,110 @@ void ZipArchive::parse(std::istream& in, ParseCallback& pc)
 }
 
 
+bool ZipArchive::parseDirectory(std::istream& in)
+{
+	std::streamoff start = in.tellg();
+	in.seekg(0, std::ios::end);
+	std::streamoff end = in.tellg();
+	if (!in.good() || end < start + END_OF_DIRECTORY_SIZE)
+	{
+		in.clear();
+		return false;
+	}
+
+	// the end of central directory record is followed by a comment of up to 64K
+	std::streamoff tailSize = end - start;
+	if (tailSize > END_OF_DIRECTORY_SIZE + 0xFFFF)
+		tailSize = END_OF_DIRECTORY_SIZE + 0xFFFF;
+	Poco::Buffer<char> tail(static_cast<std::size_t>(tailSize));
+	in.seekg(end - tailSize);
+	in.read(tail.begin(), tailSize);
+	if (in.gcount() != tailSize)
+	{
+		in.clear();
+		return false;
+	}
+
+	std::streamoff recordPos = -1;
+	for (std::streamoff pos = tailSize - END_OF_DIRECTORY_SIZE; pos >= 0; --pos)
+	{
+		const char* pRecord = tail.begin() + pos;
+		if (std::memcmp(pRecord, ZipArchiveInfo::HEADER, ZipCommon::HEADER_SIZE) == 0 &&
+			pos + END_OF_DIRECTORY_SIZE + ZipUtil::get16BitValue(pRecord, END_OF_DIRECTORY_COMMENT_LENGTH_POS) == tailSize)
+		{
+			recordPos = end - tailSize + pos;
+			break;
+		}
+	}
+	if (recordPos < 0) return false;
+
+	in.seekg(recordPos);
+	ZipArchiveInfo nfo(in, false);
+	// multi-disk archives are left to the sequential parser
+	if (nfo.getDiskNumber() != 0 || nfo.getFirstDiskForDirectoryHeader() != 0 || nfo.getNumberOfEntries() != nfo.getTotalNumberOfEntries())
+		return false;
+	Poco::UInt64 numEntries = nfo.getTotalNumberOfEntries();
+	Poco::UInt64 directoryOffset = nfo.getCentralDirectoryOffset();
+	Poco::UInt64 directorySize = nfo.getCentralDirectorySize();
+	std::streamoff directoryEnd = recordPos;
+
+	// a ZIP64 archive has a locator in front of the record,
+	// which points to the ZIP64 end of central directory record
+	char locator[ZIP64_LOCATOR_SIZE];
+	bool hasLocator = false;
+	if (recordPos - ZIP64_LOCATOR_SIZE >= start)
+	{
+		in.seekg(recordPos - ZIP64_LOCATOR_SIZE);
+		in.read(locator, ZIP64_LOCATOR_SIZE);
+		if (!in.good()) return false;
+		hasLocator = std::memcmp(locator, ZipArchiveInfo64::LOCATOR_HEADER, ZipCommon::HEADER_SIZE) == 0;
+	}
+	if (hasLocator)
+	{
+		std::streamoff record64Pos = start + static_cast<std::streamoff>(ZipUtil::get64BitValue(locator, ZIP64_LOCATOR_OFFSET_POS));
+		if (record64Pos < start || record64Pos >= recordPos)
+			return false;
+		in.seekg(record64Pos);
+		ZipArchiveInfo64 nfo64(in, false);
+		if (nfo64.getDiskNumber() != 0 || nfo64.getFirstDiskForDirectoryHeader() != 0 || nfo64.getNumberOfEntries() != nfo64.getTotalNumberOfEntries())
+			return false;
+		numEntries = nfo64.getTotalNumberOfEntries();
+		directoryOffset = nfo64.getCentralDirectoryOffset();
+		directorySize = nfo64.getCentralDirectorySize();
+		directoryEnd = record64Pos;
+		poco_assert (_disks64.insert(std::make_pair(nfo64.getDiskNumber(), nfo64)).second);
+	}
+	else if (numEntries == ZipCommon::ZIP64_MAGIC_SHORT || directoryOffset == ZipCommon::ZIP64_MAGIC || directorySize == ZipCommon::ZIP64_MAGIC)
+	{
+		return false;
+	}
+
+	std::streamoff directoryPos = start + static_cast<std::streamoff>(directoryOffset);
+	if (directoryPos + static_cast<std::streamoff>(directorySize) != directoryEnd)
+		return false;
+
+	in.seekg(directoryPos);
+	for (Poco::UInt64 i = 0; i < numEntries; ++i)
+	{
+		char header[ZipCommon::HEADER_SIZE];
+		in.read(header, ZipCommon::HEADER_SIZE);
+		if (!in.good() || std::memcmp(header, ZipFileInfo::HEADER, ZipCommon::HEADER_SIZE) != 0)
+			throw Poco::IllegalStateException("Illegal header in zip file central directory");
+		ZipFileInfo info(in, true);
+		poco_assert (_infos.insert(std::make_pair(info.getFileName(), info)).second);
+	}
+
+	for (FileInfos::const_iterator it = _infos.begin(); it != _infos.end(); ++it)
+	{
+		in.seekg(start + static_cast<std::streamoff>(it->second.getRelativeOffsetOfLocalHeader()));
+		ZipLocalFileHeader entry(in, it->second);
+		poco_assert (_entries.insert(std::make_pair(entry.getFileName(), entry)).second);
+	}
+	poco_assert (_disks.insert(std::make_pair(nfo.getDiskNumber(), nfo)).second);
+	return true;
+}
+
+
 const std::string& ZipArchive::getZipComment() const
 {
     // It seems that only the "first" disk is populated (look at Compress::close()), so getting the first ZipArchiveInfo
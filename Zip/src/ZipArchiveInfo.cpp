@@ -118,4 +118,83 @@ void ZipArchiveInfo::setZipComment(const std::string& comment)
 }
 
 
+const char ZipArchiveInfo64::HEADER[ZipCommon::HEADER_SIZE] = {'\x50', '\x4b', '\x06', '\x06'};
+const char ZipArchiveInfo64::LOCATOR_HEADER[ZipCommon::HEADER_SIZE] = {'\x50', '\x4b', '\x06', '\x07'};
+
+
+ZipArchiveInfo64::ZipArchiveInfo64():
+	_rawInfo(),
+	_startPos(0),
+	_extensibleData()
+{
+	std::memset(_rawInfo, 0, FULLHEADER_SIZE);
+	std::memcpy(_rawInfo, HEADER, ZipCommon::HEADER_SIZE);
+	// the record size does not include the leading 12 bytes
+	ZipUtil::set64BitValue(FULLHEADER_SIZE - RECORDSIZE_POS - RECORDSIZE_SIZE, _rawInfo, RECORDSIZE_POS);
+	_rawInfo[VERSIONMADEBY_POS] = 45;
+	_rawInfo[VERSION_NEEDED_POS] = 45;
+}
+
+
+ZipArchiveInfo64::ZipArchiveInfo64(std::istream& in, bool assumeHeaderRead):
+	_rawInfo(),
+	_startPos(in.tellg()),
+	_extensibleData()
+{
+	if (assumeHeaderRead)
+		_startPos -= ZipCommon::HEADER_SIZE;
+	parse(in, assumeHeaderRead);
+}
+
+
+ZipArchiveInfo64::~ZipArchiveInfo64()
+{
+}
+
+
+void ZipArchiveInfo64::parse(std::istream& inp, bool assumeHeaderRead)
+{
+	if (!assumeHeaderRead)
+	{
+		inp.read(_rawInfo, ZipCommon::HEADER_SIZE);
+	}
+	else
+	{
+		std::memcpy(_rawInfo, HEADER, ZipCommon::HEADER_SIZE);
+	}
+	poco_assert (std::memcmp(_rawInfo, HEADER, ZipCommon::HEADER_SIZE) == 0);
+	// read the rest of the header
+	inp.read(_rawInfo + ZipCommon::HEADER_SIZE, FULLHEADER_SIZE - ZipCommon::HEADER_SIZE);
+	Poco::UInt64 recordSize = ZipUtil::get64BitValue(_rawInfo, RECORDSIZE_POS) + RECORDSIZE_POS + RECORDSIZE_SIZE;
+	if (recordSize < FULLHEADER_SIZE || recordSize - FULLHEADER_SIZE > 0xFFFF)
+		throw ZipException("Invalid ZIP64 end of central directory record");
+	std::size_t len = static_cast<std::size_t>(recordSize - FULLHEADER_SIZE);
+	if (len > 0)
+	{
+		Poco::Buffer<char> buf(len);
+		inp.read(buf.begin(), len);
+		_extensibleData = std::string(buf.begin(), len);
+	}
+	// the locator follows the record
+	char locator[LOCATOR_SIZE];
+	inp.read(locator, LOCATOR_SIZE);
+	if (!inp.good() || std::memcmp(locator, LOCATOR_HEADER, ZipCommon::HEADER_SIZE) != 0)
+		throw ZipException("Missing ZIP64 end of central directory locator");
+}
+
+
+std::string ZipArchiveInfo64::createHeader() const
+{
+	std::string result(_rawInfo, FULLHEADER_SIZE);
+	result.append(_extensibleData);
+	char locator[LOCATOR_SIZE];
+	std::memset(locator, 0, LOCATOR_SIZE);
+	std::memcpy(locator, LOCATOR_HEADER, ZipCommon::HEADER_SIZE);
+	ZipUtil::set64BitValue(static_cast<Poco::UInt64>(_startPos), locator, LOCATOR_OFFSET_POS);
+	ZipUtil::set32BitValue(1, locator, LOCATOR_TOTALDISKS_POS);
+	result.append(locator, LOCATOR_SIZE);
+	return result;
+}
+
+
 } } // namespace Poco::Zip
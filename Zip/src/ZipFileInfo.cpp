@@ -53,6 +53,7 @@ ZipFileInfo::ZipFileInfo(const ZipLocalFileHeader& header):
 	_crc32(0),
 	_compressedSize(0),
 	_uncompressedSize(0),
+	_localHeaderOffset(0),
 	_fileName(),
 	_lastModifiedAt(),
 	_extraField()
@@ -80,6 +81,7 @@ ZipFileInfo::ZipFileInfo(std::istream& in, bool assumeHeaderRead):
 	_crc32(0),
 	_compressedSize(0),
 	_uncompressedSize(0),
+	_localHeaderOffset(0),
 	_fileName(),
 	_lastModifiedAt(),
 	_extraField()
@@ -123,6 +125,28 @@ void ZipFileInfo::parse(std::istream& inp, bool assumeHeaderRead)
 		inp.read(xtra.begin(), len);
 		_extraField = std::string(xtra.begin(), len);
 	}
+	_localHeaderOffset = ZipUtil::get32BitValue(_rawInfo, RELATIVEOFFSETLOCALHEADER_POS);
+	Poco::UInt16 zip64Length = 0;
+	std::string::size_type zip64Pos = ZipUtil::findExtraField(_extraField, ZipCommon::ZIP64_EXTRA_ID, zip64Length);
+	if (zip64Pos != std::string::npos)
+	{
+		// the ZIP64 record only holds the values that do not fit into the header, in this order
+		std::string::size_type end = zip64Pos + zip64Length;
+		if (_uncompressedSize == ZipCommon::ZIP64_MAGIC && zip64Pos + 8 <= end)
+		{
+			_uncompressedSize = ZipUtil::get64BitValue(_extraField.data(), static_cast<Poco::UInt32>(zip64Pos));
+			zip64Pos += 8;
+		}
+		if (_compressedSize == ZipCommon::ZIP64_MAGIC && zip64Pos + 8 <= end)
+		{
+			_compressedSize = ZipUtil::get64BitValue(_extraField.data(), static_cast<Poco::UInt32>(zip64Pos));
+			zip64Pos += 8;
+		}
+		if (_localHeaderOffset == ZipCommon::ZIP64_MAGIC && zip64Pos + 8 <= end)
+		{
+			_localHeaderOffset = ZipUtil::get64BitValue(_extraField.data(), static_cast<Poco::UInt32>(zip64Pos));
+		}
+	}
 	len = getFileCommentLength();
 	if (len > 0)
 	{
@@ -143,6 +167,47 @@ std::string ZipFileInfo::createHeader() const
 }
 
 
+void ZipFileInfo::updateZip64Data()
+{
+	std::string zip64;
+	char value[8];
+	if (_uncompressedSize >= ZipCommon::ZIP64_MAGIC)
+	{
+		ZipUtil::set32BitValue(ZipCommon::ZIP64_MAGIC, _rawInfo, UNCOMPRESSED_SIZE_POS);
+		ZipUtil::set64BitValue(_uncompressedSize, value, 0);
+		zip64.append(value, sizeof(value));
+	}
+	else ZipUtil::set32BitValue(static_cast<Poco::UInt32>(_uncompressedSize), _rawInfo, UNCOMPRESSED_SIZE_POS);
+	if (_compressedSize >= ZipCommon::ZIP64_MAGIC)
+	{
+		ZipUtil::set32BitValue(ZipCommon::ZIP64_MAGIC, _rawInfo, COMPRESSED_SIZE_POS);
+		ZipUtil::set64BitValue(_compressedSize, value, 0);
+		zip64.append(value, sizeof(value));
+	}
+	else ZipUtil::set32BitValue(static_cast<Poco::UInt32>(_compressedSize), _rawInfo, COMPRESSED_SIZE_POS);
+	if (_localHeaderOffset >= ZipCommon::ZIP64_MAGIC)
+	{
+		ZipUtil::set32BitValue(ZipCommon::ZIP64_MAGIC, _rawInfo, RELATIVEOFFSETLOCALHEADER_POS);
+		ZipUtil::set64BitValue(_localHeaderOffset, value, 0);
+		zip64.append(value, sizeof(value));
+	}
+	else ZipUtil::set32BitValue(static_cast<Poco::UInt32>(_localHeaderOffset), _rawInfo, RELATIVEOFFSETLOCALHEADER_POS);
+
+	_extraField = ZipUtil::removeExtraField(_extraField, ZipCommon::ZIP64_EXTRA_ID);
+	if (!zip64.empty())
+	{
+		char header[4];
+		ZipUtil::set16BitValue(ZipCommon::ZIP64_EXTRA_ID, header, 0);
+		ZipUtil::set16BitValue(static_cast<Poco::UInt16>(zip64.size()), header, 2);
+		_extraField.append(header, sizeof(header));
+		_extraField.append(zip64);
+		if (_rawInfo[VERSION_NEEDED_POS] < 45)
+			setRequiredVersion(4, 5);
+	}
+	setExtraFieldLength(static_cast<Poco::UInt16>(_extraField.size()));
+}
+
+
 void ZipFileInfo::setUnixAttributes()
 {
 	bool isDir = isDirectory();
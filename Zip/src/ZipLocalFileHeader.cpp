@@ -37,6 +37,8 @@
 #include "Poco/Zip/ZipLocalFileHeader.h"
 #include "Poco/Zip/ZipDataInfo.h"
 #include "Poco/Zip/ParseCallback.h"
+#include "Poco/Zip/ZipFileInfo.h"
+#include "Poco/Zip/ZipException.h"
 #include "Poco/Buffer.h"
 #include "Poco/Exception.h"
 #include "Poco/File.h"
@@ -62,7 +64,8 @@ ZipLocalFileHeader::ZipLocalFileHeader(const Poco::Path& fileName,
 	_extraField(),
 	_crc32(0),
 	_compressedSize(0),
-	_uncompressedSize(0)
+	_uncompressedSize(0),
+	_zip64(false)
 {
 	std::memcpy(_rawHeader, HEADER, ZipCommon::HEADER_SIZE);
 	std::memset(_rawHeader+ZipCommon::HEADER_SIZE, 0, FULLHEADER_SIZE - ZipCommon::HEADER_SIZE);
@@ -94,7 +97,8 @@ ZipLocalFileHeader::ZipLocalFileHeader(std::istream& inp, bool assumeHeaderRead,
 	_extraField(),
 	_crc32(0),
 	_compressedSize(0),
-	_uncompressedSize(0)
+	_uncompressedSize(0),
+	_zip64(false)
 {
 	poco_assert_dbg( (EXTRAFIELD_POS+EXTRAFIELD_LENGTH) == FULLHEADER_SIZE);
 
@@ -109,10 +113,20 @@ ZipLocalFileHeader::ZipLocalFileHeader(std::istream& inp, bool assumeHeaderRead,
 	{
 		if (searchCRCAndSizesAfterData())
 		{
-			ZipDataInfo nfo(inp, false);
-			setCRC(nfo.getCRC32());
-			setCompressedSize(nfo.getCompressedSize());
-			setUncompressedSize(nfo.getUncompressedSize());
+			if (_zip64)
+			{
+				ZipDataInfo64 nfo(inp, false);
+				setCRC(nfo.getCRC32());
+				setCompressedSize(nfo.getCompressedSize());
+				setUncompressedSize(nfo.getUncompressedSize());
+			}
+			else
+			{
+				ZipDataInfo nfo(inp, false);
+				setCRC(nfo.getCRC32());
+				setCompressedSize(nfo.getCompressedSize());
+				setUncompressedSize(nfo.getUncompressedSize());
+			}
 		}
 	}
 	else
@@ -124,6 +138,31 @@ ZipLocalFileHeader::ZipLocalFileHeader(std::istream& inp, bool assumeHeaderRead,
 }
 
 
+ZipLocalFileHeader::ZipLocalFileHeader(std::istream& inp, const ZipFileInfo& info):
+	_rawHeader(),
+	_startPos(inp.tellg()),
+	_endPos(-1),
+	_fileName(),
+	_lastModifiedAt(),
+	_extraField(),
+	_crc32(0),
+	_compressedSize(0),
+	_uncompressedSize(0),
+	_zip64(false)
+{
+	parse(inp, false);
+	if (searchCRCAndSizesAfterData())
+	{
+		// the sizes may only be 64-bit in the central directory,
+		// so they are not stored in the raw header
+		_crc32 = info.getCRC();
+		_compressedSize = info.getCompressedSize();
+		_uncompressedSize = info.getUncompressedSize();
+	}
+	_endPos = _startPos + getHeaderSize() + _compressedSize; // exclude the data block!
+}
+
+
 ZipLocalFileHeader::~ZipLocalFileHeader()
 {
 }
@@ -143,7 +182,7 @@ void ZipLocalFileHeader::parse(std::istream& inp, bool assumeHeaderRead)
 	// read the rest of the header
 	inp.read(_rawHeader + ZipCommon::HEADER_SIZE, FULLHEADER_SIZE - ZipCommon::HEADER_SIZE);
 	poco_assert (_rawHeader[VERSION_POS + 1]>= ZipCommon::HS_FAT && _rawHeader[VERSION_POS + 1] < ZipCommon::HS_UNUSED);
-	poco_assert (getMajorVersionNumber() <= 2);
+	poco_assert (getMajorVersionNumber() <= 4);
 	poco_assert (ZipUtil::get16BitValue(_rawHeader, COMPR_METHOD_POS) < ZipCommon::CM_UNUSED);
 	parseDateTime();
 	Poco::UInt16 len = getFileNameLength();
@@ -157,11 +196,93 @@ void ZipLocalFileHeader::parse(std::istream& inp, bool assumeHeaderRead)
 		inp.read(xtra.begin(), len);
 		_extraField = std::string(xtra.begin(), len);
 	}
+	Poco::UInt16 zip64Length = 0;
+	std::string::size_type zip64Pos = ZipUtil::findExtraField(_extraField, ZipCommon::ZIP64_EXTRA_ID, zip64Length);
+	_zip64 = (zip64Pos != std::string::npos);
 	if (!searchCRCAndSizesAfterData())
 	{
 		_crc32 = getCRCFromHeader();
 		_compressedSize = getCompressedSizeFromHeader();
 		_uncompressedSize = getUncompressedSizeFromHeader();
+		if (_zip64)
+		{
+			// the ZIP64 record only holds the values that do not fit into the header
+			std::string::size_type end = zip64Pos + zip64Length;
+			if (_uncompressedSize == ZipCommon::ZIP64_MAGIC && zip64Pos + 8 <= end)
+			{
+				_uncompressedSize = ZipUtil::get64BitValue(_extraField.data(), static_cast<Poco::UInt32>(zip64Pos));
+				zip64Pos += 8;
+			}
+			if (_compressedSize == ZipCommon::ZIP64_MAGIC && zip64Pos + 8 <= end)
+			{
+				_compressedSize = ZipUtil::get64BitValue(_extraField.data(), static_cast<Poco::UInt32>(zip64Pos));
+			}
+		}
+	}
+}
+
+
+void ZipLocalFileHeader::setCompressedSize(Poco::UInt64 val)
+{
+	if (_zip64)
+	{
+		_compressedSize = val;
+		ZipUtil::set32BitValue(ZipCommon::ZIP64_MAGIC, _rawHeader, COMPRESSEDSIZE_POS);
+		updateZip64Data();
+	}
+	else
+	{
+		if (val >= ZipCommon::ZIP64_MAGIC)
+			throw ZipException("Compressed size of " + _fileName + " exceeds 4 GB, but the entry has no ZIP64 data");
+		_compressedSize = val;
+		ZipUtil::set32BitValue(static_cast<Poco::UInt32>(val), _rawHeader, COMPRESSEDSIZE_POS);
+	}
+}
+
+
+void ZipLocalFileHeader::setUncompressedSize(Poco::UInt64 val)
+{
+	if (_zip64)
+	{
+		_uncompressedSize = val;
+		ZipUtil::set32BitValue(ZipCommon::ZIP64_MAGIC, _rawHeader, UNCOMPRESSEDSIZE_POS);
+		updateZip64Data();
+	}
+	else
+	{
+		if (val >= ZipCommon::ZIP64_MAGIC)
+			throw ZipException("Size of " + _fileName + " exceeds 4 GB, but the entry has no ZIP64 data");
+		_uncompressedSize = val;
+		ZipUtil::set32BitValue(static_cast<Poco::UInt32>(val), _rawHeader, UNCOMPRESSEDSIZE_POS);
+	}
+}
+
+
+void ZipLocalFileHeader::setZip64Data()
+{
+	if (_zip64) return;
+
+	char data[ZIP64_DATA_SIZE + 4];
+	ZipUtil::set16BitValue(ZipCommon::ZIP64_EXTRA_ID, data, 0);
+	ZipUtil::set16BitValue(ZIP64_DATA_SIZE, data, 2);
+	_extraField = ZipUtil::removeExtraField(_extraField, ZipCommon::ZIP64_EXTRA_ID);
+	_extraField.append(data, sizeof(data));
+	setExtraFieldSize(static_cast<Poco::UInt16>(_extraField.size()));
+	setRequiredVersion(4, 5);
+	_zip64 = true;
+	setCompressedSize(_compressedSize);
+	setUncompressedSize(_uncompressedSize);
+}
+
+
+void ZipLocalFileHeader::updateZip64Data()
+{
+	Poco::UInt16 length = 0;
+	std::string::size_type pos = ZipUtil::findExtraField(_extraField, ZipCommon::ZIP64_EXTRA_ID, length);
+	if (pos != std::string::npos && length >= ZIP64_DATA_SIZE)
+	{
+		ZipUtil::set64BitValue(_uncompressedSize, &_extraField[0], static_cast<Poco::UInt32>(pos + ZIP64_UNCOMPRESSED_POS));
+		ZipUtil::set64BitValue(_compressedSize, &_extraField[0], static_cast<Poco::UInt32>(pos + ZIP64_COMPRESSED_POS));
 	}
 }
 
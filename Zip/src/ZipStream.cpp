@@ -65,6 +65,7 @@ ZipStreamBuf::ZipStreamBuf(std::istream& istr, const ZipLocalFileHeader& fileEnt
 	_crc32(Poco::Checksum::TYPE_CRC32),
 	_expectedCrc32(0),
 	_checkCRC(true),
+	_zip64(fileEntry.hasZip64Data()),
 	_bytesWritten(0),
 	_pHeader(0)
 {
@@ -117,6 +118,7 @@ ZipStreamBuf::ZipStreamBuf(std::ostream& ostr, ZipLocalFileHeader& fileEntry, bo
 	_crc32(Poco::Checksum::TYPE_CRC32),
 	_expectedCrc32(0),
 	_checkCRC(false),
+	_zip64(fileEntry.hasZip64Data()),
 	_bytesWritten(0),
 	_pHeader(&fileEntry)
 {
@@ -185,13 +187,18 @@ int ZipStreamBuf::readFromDevice(char* buffer, std::streamsize length)
 			{
 				// the CRC value is written directly after the data block
 				// parse it directly from the input stream
-				ZipDataInfo nfo(*_pIstr, false);
-				// now push back the header to the stream, so that the ZipLocalFileHeader can read it
-				Poco::Int32 size = static_cast<Poco::Int32>(nfo.getFullHeaderSize());
-				_expectedCrc32 = nfo.getCRC32();
-				const char* rawHeader = nfo.getRawHeader();
-				for (Poco::Int32 i = size-1; i >= 0; --i)
-					_pIstr->putback(rawHeader[i]);
+				if (_zip64)
+				{
+					ZipDataInfo64 nfo(*_pIstr, false);
+					_expectedCrc32 = nfo.getCRC32();
+					putbackHeader(nfo.getRawHeader(), nfo.getFullHeaderSize());
+				}
+				else
+				{
+					ZipDataInfo nfo(*_pIstr, false);
+					_expectedCrc32 = nfo.getCRC32();
+					putbackHeader(nfo.getRawHeader(), nfo.getFullHeaderSize());
+				}
 				if (!crcValid())
 					throw ZipException("CRC failure");
 			}
@@ -201,6 +208,14 @@ int ZipStreamBuf::readFromDevice(char* buffer, std::streamsize length)
 }
 
 
+void ZipStreamBuf::putbackHeader(const char* rawHeader, Poco::UInt32 size)
+{
+	// push back the header to the stream, so that the ZipLocalFileHeader can read it
+	for (Poco::Int32 i = static_cast<Poco::Int32>(size)-1; i >= 0; --i)
+		_pIstr->putback(rawHeader[i]);
+}
+
+
 int ZipStreamBuf::writeToDevice(const char* buffer, std::streamsize length)
 {
 	if (!_ptrOBuf) return 0; // directory entry
@@ -228,22 +243,33 @@ void ZipStreamBuf::close()
 		}
 		_ptrOBuf = 0;
 		poco_assert (*_pOstr);
+		// sizes larger than 4 GB are only accepted if the header has ZIP64 data
+		_pHeader->setCRC(_crc32.checksum());
+		_pHeader->setUncompressedSize(_bytesWritten);
+		_pHeader->setCompressedSize(_ptrOHelper->bytesWritten());
 		// write an extra datablock if required
 		// or fix the crc entries
 		if (_pHeader->searchCRCAndSizesAfterData())
 		{
-			ZipDataInfo info;
-			info.setCRC32(_crc32.checksum());
-			info.setUncompressedSize(_bytesWritten);
-			info.setCompressedSize(static_cast<Poco::UInt32>(_ptrOHelper->bytesWritten()));
-			_pOstr->write(info.getRawHeader(), static_cast<std::streamsize>(info.getFullHeaderSize()));
+			if (_zip64)
+			{
+				ZipDataInfo64 info;
+				info.setCRC32(_crc32.checksum());
+				info.setUncompressedSize(_bytesWritten);
+				info.setCompressedSize(_ptrOHelper->bytesWritten());
+				_pOstr->write(info.getRawHeader(), static_cast<std::streamsize>(info.getFullHeaderSize()));
+			}
+			else
+			{
+				ZipDataInfo info;
+				info.setCRC32(_crc32.checksum());
+				info.setUncompressedSize(static_cast<Poco::UInt32>(_bytesWritten));
+				info.setCompressedSize(static_cast<Poco::UInt32>(_ptrOHelper->bytesWritten()));
+				_pOstr->write(info.getRawHeader(), static_cast<std::streamsize>(info.getFullHeaderSize()));
+			}
 		}
 		else
 		{
-			poco_check_ptr (_pHeader);
-			_pHeader->setCRC(_crc32.checksum());
-			_pHeader->setUncompressedSize(_bytesWritten);
-			_pHeader->setCompressedSize(static_cast<Poco::UInt32>(_ptrOHelper->bytesWritten()));
 			_pOstr->seekp(_pHeader->getStartPos(), std::ios_base::beg);
 			poco_assert (*_pOstr);
 			std::string header = _pHeader->createHeader();
@@ -188,6 +188,41 @@ void ZipUtil::sync(std::istream& in)
 }
 
 
+std::string::size_type ZipUtil::findExtraField(const std::string& extraField, Poco::UInt16 id, Poco::UInt16& length)
+{
+	// the extra field is a sequence of records: 2 bytes header ID, 2 bytes data size, data
+	std::string::size_type pos = 0;
+	while (pos + 4 <= extraField.size())
+	{
+		Poco::UInt16 recordId = get16BitValue(extraField.data(), static_cast<Poco::UInt32>(pos));
+		Poco::UInt16 recordLength = get16BitValue(extraField.data(), static_cast<Poco::UInt32>(pos + 2));
+		if (pos + 4 + recordLength > extraField.size())
+			break;
+		if (recordId == id)
+		{
+			length = recordLength;
+			return pos + 4;
+		}
+		pos += 4 + recordLength;
+	}
+	return std::string::npos;
+}
+
+
+std::string ZipUtil::removeExtraField(const std::string& extraField, Poco::UInt16 id)
+{
+	std::string result(extraField);
+	Poco::UInt16 length = 0;
+	std::string::size_type pos = findExtraField(result, id, length);
+	while (pos != std::string::npos)
+	{
+		result.erase(pos - 4, length + 4);
+		pos = findExtraField(result, id, length);
+	}
+	return result;
+}
+
+
 void ZipUtil::verifyZipEntryFileName(const std::string& fn)
 {
 	if (fn.find("\\") != std::string::npos)
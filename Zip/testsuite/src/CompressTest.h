@@ -37,6 +37,7 @@
 
 
 #include "Poco/Zip/Zip.h"
+#include "Poco/Zip/ZipLocalFileHeader.h"
 #include "CppUnit/TestCase.h"
 
 
@@ -52,6 +53,13 @@ public:
 	void testManipulatorDel();
 	void testManipulatorReplace();
     void testSetZipComment();
+	void testParallel();
+	void testZip64();
+	void testZip64Streaming();
+	void testZip64Offsets();
+	void testManyEntries();
+	void testLargeFile();
+	void benchmarkCompress();
 
 	void setUp();
 	void tearDown();
@@ -59,6 +67,10 @@ public:
 	static CppUnit::Test* suite();
 
 private:
+	void createFiles(const std::string& dir, int count, int size);
+	void onDone(const void*, const Poco::Zip::ZipLocalFileHeader& hdr);
+
+	int _done;
 };
 
 
@@ -37,16 +37,23 @@
 #include "Poco/Zip/ZipStream.h"
 #include "Poco/Zip/Decompress.h"
 #include "Poco/Zip/ZipCommon.h"
+#include "Poco/Zip/Compress.h"
 #include "Poco/StreamCopier.h"
 #include "Poco/File.h"
 #include "Poco/URI.h"
 #include "Poco/Path.h"
 #include "Poco/Delegate.h"
 #include "Poco/StreamCopier.h"
+#include "Poco/SharedMemory.h"
+#include "Poco/MemoryStream.h"
+#include "Poco/FileStream.h"
+#include "Poco/NumberFormatter.h"
+#include "Poco/Stopwatch.h"
 #include "CppUnit/TestCaller.h"
 #include "CppUnit/TestSuite.h"
 #include <fstream>
 #include <sstream>
+#include <iostream>
 
 
 using namespace Poco::Zip;
@@ -184,6 +191,147 @@ void ZipTest::testDecompressFlat()
 }
 
 
+void ZipTest::testDirectoryOpen()
+{
+	static const char* files[] = { "test.zip", "data.zip", "doc.zip" };
+	for (std::size_t i = 0; i < sizeof(files)/sizeof(files[0]); ++i)
+	{
+		std::string testFile = getTestFile(files[i]);
+		std::ifstream seqIn(testFile.c_str(), std::ios::binary);
+		SkipCallback skip;
+		ZipArchive sequential(seqIn, skip);
+
+		std::ifstream dirIn(testFile.c_str(), std::ios::binary);
+		ZipArchive directory(dirIn);
+		assert (dirIn.good());
+
+		ZipArchive::FileHeaders::const_iterator seqIt = sequential.headerBegin();
+		ZipArchive::FileHeaders::const_iterator dirIt = directory.headerBegin();
+		for (; seqIt != sequential.headerEnd(); ++seqIt, ++dirIt)
+		{
+			assert (dirIt != directory.headerEnd());
+			assert (dirIt->first == seqIt->first);
+			assert (dirIt->second.getStartPos() == seqIt->second.getStartPos());
+			assert (dirIt->second.getDataStartPos() == seqIt->second.getDataStartPos());
+			assert (dirIt->second.getEndPos() == seqIt->second.getEndPos());
+			assert (dirIt->second.getCompressedSize() == seqIt->second.getCompressedSize());
+			assert (dirIt->second.getUncompressedSize() == seqIt->second.getUncompressedSize());
+			assert (dirIt->second.getCRC() == seqIt->second.getCRC());
+		}
+		assert (dirIt == directory.headerEnd());
+		assert (std::distance(directory.fileInfoBegin(), directory.fileInfoEnd()) == std::distance(sequential.fileInfoBegin(), sequential.fileInfoEnd()));
+		assert (directory.getZipComment() == sequential.getZipComment());
+	}
+
+	// extract a single entry by seeking
+	std::string testFile = getTestFile("data.zip");
+	std::ifstream inp(testFile.c_str(), std::ios::binary);
+	ZipArchive arch(inp);
+	for (ZipArchive::FileHeaders::const_iterator it = arch.headerBegin(); it != arch.headerEnd(); ++it)
+	{
+		if (!it->second.isFile()) continue;
+		ZipInputStream zipin(inp, it->second);
+		std::ostringstream out(std::ios::binary);
+		Poco::StreamCopier::copyStream(zipin, out);
+		assert (out.str().size() == it->second.getUncompressedSize());
+	}
+}
+
+
+void ZipTest::testMappedArchive()
+{
+	std::string testFile = getTestFile("test.zip");
+	Poco::File file(testFile);
+	Poco::SharedMemory mem(file, Poco::SharedMemory::AM_READ);
+	Poco::MemoryInputStream inp(mem.begin(), static_cast<std::streamsize>(file.getSize()));
+	ZipArchive arch(inp);
+	ZipArchive::FileHeaders::const_iterator it = arch.findHeader("testfile.txt");
+	assert (it != arch.headerEnd());
+	ZipInputStream zipin(inp, it->second);
+	std::ostringstream out(std::ios::binary);
+	Poco::StreamCopier::copyStream(zipin, out);
+	assert (out.str().size() == it->second.getUncompressedSize());
+
+	std::ifstream fileIn(testFile.c_str(), std::ios::binary);
+	ZipArchive fileArch(fileIn);
+	ZipInputStream fileZipin(fileIn, fileArch.findHeader("testfile.txt")->second);
+	std::ostringstream fileOut(std::ios::binary);
+	Poco::StreamCopier::copyStream(fileZipin, fileOut);
+	assert (out.str() == fileOut.str());
+}
+
+
+void ZipTest::testDecompressParallel()
+{
+	createArchive("parallel.zip", "parallel/", 30, 20000);
+	Decompress dec("parallel.zip", Poco::Path("parallelout/"));
+	dec.EError += Poco::Delegate<ZipTest, std::pair<const Poco::Zip::ZipLocalFileHeader, const std::string> >(this, &ZipTest::onDecompressError);
+	ZipArchive arch(dec.decompressAllFiles(4));
+	dec.EError -= Poco::Delegate<ZipTest, std::pair<const Poco::Zip::ZipLocalFileHeader, const std::string> >(this, &ZipTest::onDecompressError);
+	assert (_errCnt == 0);
+	assert (dec.mapping().size() == 30);
+	assert (Poco::File("parallelout/sub0").isDirectory());
+	for (int i = 0; i < 30; ++i)
+	{
+		std::string name("sub" + Poco::NumberFormatter::format(i % 3) + "/file" + Poco::NumberFormatter::format(i) + ".txt");
+		assert (arch.findHeader(name) != arch.headerEnd());
+		Poco::FileInputStream orig("parallel/" + name);
+		Poco::FileInputStream extracted("parallelout/" + name);
+		std::ostringstream expected;
+		std::ostringstream actual;
+		Poco::StreamCopier::copyStream(orig, expected);
+		Poco::StreamCopier::copyStream(extracted, actual);
+		assert (expected.str().size() == 20000);
+		assert (actual.str() == expected.str());
+	}
+	Poco::File("parallel/").remove(true);
+	Poco::File("parallelout/").remove(true);
+	Poco::File("parallel.zip").remove();
+}
+
+
+void ZipTest::benchmarkDecompress()
+{
+	createArchive("bench.zip", "bench/", 64, 1000000);
+	for (int threads = 1; threads <= 8; threads *= 2)
+	{
+		Poco::File out("benchout/");
+		if (out.exists())
+			out.remove(true);
+		Poco::Stopwatch sw;
+		sw.start();
+		Decompress dec("bench.zip", Poco::Path("benchout/"));
+		dec.decompressAllFiles(threads);
+		sw.stop();
+		std::cout << std::endl << threads << " thread(s): " << 64*1000000.0/sw.elapsed() << " MB/s" << std::endl;
+	}
+}
+
+
+void ZipTest::createArchive(const std::string& zipFile, const std::string& dir, int count, int size)
+{
+	Poco::File aDir(dir);
+	if (aDir.exists())
+		aDir.remove(true);
+	for (int i = 0; i < count; ++i)
+	{
+		std::string subDir(dir + "sub" + Poco::NumberFormatter::format(i % 3) + "/");
+		Poco::File(subDir).createDirectories();
+		Poco::FileOutputStream fos(subDir + "file" + Poco::NumberFormatter::format(i) + ".txt");
+		Poco::UInt32 seed = i;
+		for (int k = 0; k < size/8; ++k)
+		{
+			seed = seed*1103515245 + 12345;
+			fos << Poco::NumberFormatter::format0((seed >> 16) % 1000, 7) << '\n';
+		}
+	}
+	Poco::FileOutputStream out(zipFile);
+	Compress c(out, true);
+	c.addRecursive(Poco::Path(dir), ZipCommon::CL_NORMAL);
+	c.close();
+}
+
+
 void ZipTest::onDecompressError(const void* pSender, std::pair<const Poco::Zip::ZipLocalFileHeader, const std::string>& info)
 {
 	++_errCnt;
@@ -211,5 +359,9 @@ CppUnit::Test* ZipTest::suite()
 	CppUnit_addTest(pSuite, ZipTest, testDecompressFlat);
 	CppUnit_addTest(pSuite, ZipTest, testCrcAndSizeAfterData);
 	CppUnit_addTest(pSuite, ZipTest, testCrcAndSizeAfterDataWithArchive);
+	CppUnit_addTest(pSuite, ZipTest, testDirectoryOpen);
+	CppUnit_addTest(pSuite, ZipTest, testMappedArchive);
+	CppUnit_addTest(pSuite, ZipTest, testDecompressParallel);
+	//CppUnit_addTest(pSuite, ZipTest, benchmarkDecompress);
 	return pSuite;
 }
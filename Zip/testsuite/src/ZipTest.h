@@ -54,6 +54,10 @@ public:
 	void testCrcAndSizeAfterDataWithArchive();
 
 	void testDecompressFlat();
+	void testDirectoryOpen();
+	void testMappedArchive();
+	void testDecompressParallel();
+	void benchmarkDecompress();
 
 	void setUp();
 	void tearDown();
@@ -63,6 +67,8 @@ public:
 	static std::string getTestFile(const std::string& testFile);
 
 private:
+	static void createArchive(const std::string& zipFile, const std::string& dir, int count, int size);
+
 	void onDecompressError(const void* pSender, std::pair<const Poco::Zip::ZipLocalFileHeader, const std::string>& info);
 	
 	int _errCnt;